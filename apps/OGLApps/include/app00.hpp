@@ -11,6 +11,8 @@
 #ifndef __OGLKIT_APP00__
 #define __OGLKIT_APP00__
 
+#include <future>
+
 #include "base_app.hpp"
 #include "oglkit/ogl/ogl_mesh.hpp"
 #include "oglkit/ogl/camera.hpp"
@@ -141,6 +143,10 @@ class App00 : public BaseApp {
   OGLCamera<float>* camera_;
   /** Technique */
   OGLShader* shader_;
+  /** Pending mesh loading, OpenGL buffers are created once ready */
+  std::future<int> loading_;
+  /** Indicate if the mesh is loaded and uploaded to the GPU */
+  bool mesh_ready_;
 };
   
 /**
@@ -10,6 +10,8 @@
 #ifndef __OGLKIT_APP01__
 #define __OGLKIT_APP01__
 
+#include <future>
+
 #include "base_app.hpp"
 
 #include "oglkit/ogl/ogl_mesh.hpp"
@@ -140,6 +142,10 @@ class App01 : public BaseApp {
   OGLCamera<float>* camera_;
   /** Technique */
   OGLShader* shader_;
+  /** Pending mesh loading, OpenGL buffers are created once ready */
+  std::future<int> loading_;
+  /** Indicate if the mesh is loaded and uploaded to the GPU */
+  bool mesh_ready_;
 };
   
 /**
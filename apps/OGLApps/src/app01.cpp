@@ -10,6 +10,8 @@
 #ifdef __APPLE__
 #include <OpenGL/gl3.h>
 #endif
+#include <chrono>
+#include <iostream>
 
 #include "app01.hpp"
 
@@ -32,7 +34,8 @@ namespace OGLKit {
  *  @param[in]  win_width   View's width
  *  @param[in]  win_height  View's height
  */
-App01::App01(const float win_width, const float win_height) {
+App01::App01(const float win_width,
+             const float win_height) : mesh_ready_(false) {
   // Mesh
   this->mesh_ = new OGLKit::OGLMesh<float>();
   // Camera
@@ -49,6 +52,10 @@ App01::App01(const float win_width, const float win_height) {
  *  @brief  Destructor
  */
 App01::~App01(void) {
+  // Mesh can not be released while being loaded
+  if (loading_.valid()) {
+    loading_.wait();
+  }
   if (this->mesh_) {
     delete mesh_;
     mesh_ = nullptr;
@@ -74,10 +81,16 @@ int App01::Load(const std::string& config) {
   int err = -1;
   std::string dir, file, ext;
   OGLKit::StringUtil::ExtractDirectory(config, &dir, &file, &ext);
-  // Load mesh
-  err = this->mesh_->Load(dir + "bunny.ply");
-  this->mesh_->ComputeVertexNormal();
-  err |= this->mesh_->InitOpenGLContext();
+  // Load mesh in background, reuse binary cache from previous launch if any.
+  // OpenGL context is initialized by the render callback once data are ready
+  this->mesh_->set_use_cache(true);
+  OGLMesh<float>* mesh = this->mesh_;
+  loading_ = mesh->LoadAsync(dir + "bunny.ply", [mesh](const int error) {
+    if (!error) {
+      mesh->ComputeVertexNormal();
+    }
+  });
+  err = loading_.valid() ? 0 : -1;
   if (!err) {
     // Setup technique
     std::vector<std::string> shaders_file = {dir + "app01-vertex-shader.vs",
@@ -121,6 +134,17 @@ void App01::OGLKeyboardCb(const OGLKey& key, const OGLKeyState& state) {
  */
 void App01::OGLRenderCb(void) {
   using namespace std::chrono;
+  // Upload mesh once loaded
+  if (loading_.valid() &&
+      loading_.wait_for(seconds(0)) == std::future_status::ready) {
+    mesh_ready_ = !loading_.get() && !this->mesh_->InitOpenGLContext();
+    if (!mesh_ready_) {
+      std::cout << "Error, unable to load mesh" << std::endl;
+    }
+  }
+  if (!mesh_ready_) {
+    return;
+  }
   
   // Enable VAO
   this->mesh_->Bind();
@@ -74,7 +74,8 @@ int App02::Load(const std::string& config) {
   int err = -1;
   std::string dir, file, ext;
   OGLKit::StringUtil::ExtractDirectory(config, &dir, &file, &ext);
-  // Load mesh
+  // Load mesh, reuse binary cache from previous launch if any
+  this->mesh_->set_use_cache(true);
   err = this->mesh_->Load(dir + "app02-crate.obj");
   err |= this->mesh_->InitOpenGLContext();
   // Load image + texture
@@ -25,4 +25,15 @@ OPTION(WITH_DOCS "Build doxygen documentation" OFF)
 OPTION(WITH_EXAMPLES "Build examples executable" OFF)
 
 # Build unit test
-OPTION(WITH_TESTS "Build unit test targets" ON)
\ No newline at end of file
+OPTION(WITH_TESTS "Build unit test targets" ON)
+
+# Build with AVX, SSE2 is used anyway on x86-64
+OPTION(WITH_AVX "Enable AVX instructions" OFF)
+IF(WITH_AVX)
+  IF(MSVC)
+    SET(SSE_FLAGS "/arch:AVX")
+  ELSE(MSVC)
+    SET(SSE_FLAGS "-mavx")
+  ENDIF(MSVC)
+ENDIF(WITH_AVX)
+mark_as_advanced(WITH_AVX)
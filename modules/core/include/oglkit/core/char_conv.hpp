@@ -0,0 +1,766 @@
+/**
+ *  @file   char_conv.hpp
+ *  @brief  Locale independent conversion between numbers and characters
+ *          working directly on raw buffers (i.e. no allocation)
+ *  @ingroup core
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_CHAR_CONV__
+#define __OGLKIT_CHAR_CONV__
+
+#include <algorithm>
+#include <climits>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "oglkit/core/library_export.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  CharConv
+ *  @brief  Locale independent conversion between numbers and characters, in
+ *          the spirit of C++17 <charconv>. Each function works on the range
+ *          [first, last[ and returns the position where it stopped. On failure
+ *          \p first is returned and the output is left untouched.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup core
+ */
+class OGLKIT_EXPORTS CharConv {
+ public:
+
+#pragma mark -
+#pragma mark Tokenizer
+
+  /**
+   *  @name IsSpace
+   *  @fn static bool IsSpace(const char c)
+   *  @brief  Check if a character is a blank (i.e. not a line break)
+   *  @param[in]  c Character to check
+   *  @return True if space or tab
+   */
+  static bool IsSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  /**
+   *  @name IsDigit
+   *  @fn static bool IsDigit(const char c)
+   *  @brief  Check if a character is a decimal digit
+   *  @param[in]  c Character to check
+   *  @return True if in [0-9]
+   */
+  static bool IsDigit(const char c) {
+    return static_cast<unsigned>(c - '0') < 10u;
+  }
+
+  /**
+   *  @name SkipSpace
+   *  @fn static const char* SkipSpace(const char* first, const char* last)
+   *  @brief  Move forward until something else than a blank is found. Line
+   *          break are not skipped.
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @return Position of the first non blank character
+   */
+  static const char* SkipSpace(const char* first, const char* last) {
+    while (first != last && IsSpace(*first)) {
+      ++first;
+    }
+    return first;
+  }
+
+  /**
+   *  @name SkipToken
+   *  @fn static const char* SkipToken(const char* first, const char* last)
+   *  @brief  Move forward until a blank or a line break is found.
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @return Position following the current token
+   */
+  static const char* SkipToken(const char* first, const char* last) {
+    while (first != last && !IsSpace(*first) && *first != '\n') {
+      ++first;
+    }
+    return first;
+  }
+
+  /**
+   *  @name SkipLine
+   *  @fn static const char* SkipLine(const char* first, const char* last)
+   *  @brief  Move to the beginning of the next line
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @return Position following the next line break, or \p last
+   */
+  static const char* SkipLine(const char* first, const char* last) {
+    while (first != last && *first != '\n') {
+      ++first;
+    }
+    return first != last ? first + 1 : last;
+  }
+
+#pragma mark -
+#pragma mark Parsing
+
+  /**
+   *  @name FromChars
+   *  @fn static const char* FromChars(const char* first,
+                                       const char* last,
+                                       int* value)
+   *  @brief  Parse a signed decimal integer
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @param[out] value Parsed value
+   *  @return Position following the number, \p first if no number was found
+   *          or if it does not fit in an int
+   */
+  static const char* FromChars(const char* first,
+                               const char* last,
+                               int* value) {
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    const char* digit = p;
+    const int64_t limit = negative ? -int64_t(INT_MIN) : int64_t(INT_MAX);
+    int64_t v = 0;
+    while (p != last && IsDigit(*p)) {
+      v = (v * 10) + (*p - '0');
+      if (v > limit) {
+        return first;
+      }
+      ++p;
+    }
+    if (p == digit) {
+      return first;
+    }
+    *value = static_cast<int>(negative ? -v : v);
+    return p;
+  }
+
+  /**
+   *  @name FromChars
+   *  @fn static const char* FromChars(const char* first,
+                                       const char* last,
+                                       double* value)
+   *  @brief  Parse a floating point number (fixed or scientific notation).
+   *          Numbers with less than 16 significant digits and a small
+   *          exponent are converted exactly with a single floating point
+   *          operation, the rest falls back to strtod.
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @param[out] value Parsed value
+   *  @return Position following the number, \p first if no number was found
+   */
+  static const char* FromChars(const char* first,
+                               const char* last,
+                               double* value) {
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    // Mantissa, keep at most 19 significant digits
+    uint64_t mantissa = 0;
+    int n_digit = 0;
+    int exponent = 0;
+    bool has_digit = false;
+    for (; p != last && IsDigit(*p); ++p) {
+      has_digit = true;
+      if (n_digit < 19) {
+        mantissa = (mantissa * 10) + static_cast<uint64_t>(*p - '0');
+        n_digit += mantissa != 0;
+      } else {
+        ++exponent;
+      }
+    }
+    if (p != last && *p == '.') {
+      for (++p; p != last && IsDigit(*p); ++p) {
+        has_digit = true;
+        if (n_digit < 19) {
+          mantissa = (mantissa * 10) + static_cast<uint64_t>(*p - '0');
+          n_digit += mantissa != 0;
+          --exponent;
+        }
+      }
+    }
+    if (!has_digit) {
+      // nan, inf, ...
+      return SlowFromChars(first, last, value);
+    }
+    // Exponent
+    if (p != last && (*p == 'e' || *p == 'E')) {
+      const char* q = p + 1;
+      int e = 0;
+      const char* e_end = FromChars(q, last, &e);
+      if (e_end == q || e > 9999 || e < -9999) {
+        // Missing or huge exponent, let strtod decide
+        return SlowFromChars(first, last, value);
+      }
+      exponent += e;
+      p = e_end;
+    }
+    // Convert
+    double v;
+    if (mantissa == 0) {
+      v = 0.0;
+    } else if (mantissa <= (uint64_t(1) << 53) &&
+               exponent >= -22 && exponent <= 22) {
+      // Both terms are exact, a single rounding happens
+      v = static_cast<double>(mantissa);
+      v = exponent < 0 ? v / Pow10(-exponent) : v * Pow10(exponent);
+    } else {
+      return SlowFromChars(first, last, value);
+    }
+    *value = negative ? -v : v;
+    return p;
+  }
+
+  /**
+   *  @name FromChars
+   *  @fn static const char* FromChars(const char* first,
+                                       const char* last,
+                                       float* value)
+   *  @brief  Parse a floating point number (fixed or scientific notation)
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @param[out] value Parsed value
+   *  @return Position following the number, \p first if no number was found
+   */
+  static const char* FromChars(const char* first,
+                               const char* last,
+                               float* value) {
+    double v = 0.0;
+    const char* p = FromChars(first, last, &v);
+    if (p != first) {
+      *value = static_cast<float>(v);
+    }
+    return p;
+  }
+
+#pragma mark -
+#pragma mark Formatting
+
+  /**
+   *  @name ToChars
+   *  @fn static char* ToChars(char* first, char* last, const int value)
+   *  @brief  Write a signed decimal integer
+   *  @param[in]  first Beginning of the output range
+   *  @param[in]  last  End of the output range
+   *  @param[in]  value Value to write
+   *  @return Position following the number, \p first if the range is too
+   *          small
+   */
+  static char* ToChars(char* first, char* last, const int value) {
+    char buffer[16];
+    char* p = buffer + sizeof(buffer);
+    uint32_t v = (value < 0 ?
+                  0u - static_cast<uint32_t>(value) :
+                  static_cast<uint32_t>(value));
+    do {
+      *--p = static_cast<char>('0' + (v % 10));
+      v /= 10;
+    } while (v != 0);
+    if (value < 0) {
+      *--p = '-';
+    }
+    return Copy(p, buffer + sizeof(buffer), first, last);
+  }
+
+  /**
+   *  @name ToChars
+   *  @fn static char* ToChars(char* first, char* last, const double value)
+   *  @brief  Write a floating point number with the fewest digits that
+   *          convert back to the same value. Up to 15 digits are tried with
+   *          the fast path, then 16 and 17 digits are generated exactly.
+   *          Output does not depend on the locale.
+   *  @param[in]  first Beginning of the output range
+   *  @param[in]  last  End of the output range
+   *  @param[in]  value Value to write
+   *  @return Position following the number, \p first if the range is too
+   *          small
+   */
+  static char* ToChars(char* first, char* last, const double value) {
+    char buffer[32];
+    int n = FormatDigits(value, 15, buffer);
+    double check = 0.0;
+    if (n == 0 || FromChars(buffer, buffer + n, &check) != buffer + n ||
+        check != value) {
+      // 17 digits always convert back
+      n = FormatExact(value, 16, buffer);
+      if (FromChars(buffer, buffer + n, &check) != buffer + n ||
+          check != value) {
+        n = FormatExact(value, 17, buffer);
+      }
+    }
+    return Copy(buffer, buffer + n, first, last);
+  }
+
+  /**
+   *  @name ToChars
+   *  @fn static char* ToChars(char* first, char* last, const float value)
+   *  @brief  Write a floating point number with the fewest digits (6 to 9)
+   *          that convert back to the same value. Output does not depend on
+   *          the locale.
+   *  @param[in]  first Beginning of the output range
+   *  @param[in]  last  End of the output range
+   *  @param[in]  value Value to write
+   *  @return Position following the number, \p first if the range is too
+   *          small
+   */
+  static char* ToChars(char* first, char* last, const float value) {
+    char buffer[32];
+    for (int precision = 6; precision < 9; ++precision) {
+      int n = FormatDigits(value, precision, buffer);
+      if (n == 0) {
+        n = FormatExact(value, precision, buffer);
+      }
+      double check = 0.0;
+      if (FromChars(buffer, buffer + n, &check) == buffer + n &&
+          static_cast<float>(check) == value) {
+        return Copy(buffer, buffer + n, first, last);
+      }
+    }
+    // 9 digits always convert back
+    const int n = FormatExact(value, 9, buffer);
+    return Copy(buffer, buffer + n, first, last);
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+
+  /**
+   *  @name Pow10
+   *  @fn static double Pow10(const int e)
+   *  @brief  Exact power of ten
+   *  @param[in]  e Exponent in [0, 22]
+   *  @return 10^e
+   */
+  static double Pow10(const int e) {
+    static const double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+                                    1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+                                    1e22};
+    return kPow10[e];
+  }
+
+  /**
+   *  @name Copy
+   *  @fn static char* Copy(const char* src_first, const char* src_last,
+                            char* first, char* last)
+   *  @brief  Copy a formatted number into the output range if it fits
+   *  @param[in]  src_first Beginning of the formatted number
+   *  @param[in]  src_last  End of the formatted number
+   *  @param[in]  first     Beginning of the output range
+   *  @param[in]  last      End of the output range
+   *  @return Position following the number, \p first if the range is too
+   *          small
+   */
+  static char* Copy(const char* src_first,
+                    const char* src_last,
+                    char* first,
+                    char* last) {
+    const size_t n = static_cast<size_t>(src_last - src_first);
+    if (n > static_cast<size_t>(last - first)) {
+      return first;
+    }
+    std::memcpy(first, src_first, n);
+    return first + n;
+  }
+
+  /**
+   *  @name FormatDigits
+   *  @fn static int FormatDigits(const double value, const int precision,
+                                  char* buffer)
+   *  @brief  Round a number to a given count of significant digits and write
+   *          it in fixed or scientific notation without trailing zeros. The
+   *          scaling is done with a single floating point operation,
+   *          therefore the caller has to check the result converts back.
+   *  @param[in]  value     Value to write
+   *  @param[in]  precision Number of significant digits, at most 15
+   *  @param[out] buffer    Output buffer, at least 32 characters
+   *  @return Number of character written, 0 if the value is out of reach
+   */
+  static int FormatDigits(const double value,
+                          const int precision,
+                          char* buffer) {
+    char* p = buffer;
+    if (value == 0.0) {
+      if (std::signbit(value)) {
+        *p++ = '-';
+      }
+      *p++ = '0';
+      return static_cast<int>(p - buffer);
+    }
+    if (!std::isfinite(value)) {
+      return 0;
+    }
+    // Scale to an integer of precision digits
+    const double a = std::fabs(value);
+    int e = static_cast<int>(std::floor(std::log10(a)));
+    const int k = precision - 1 - e;
+    if (k < -22 || k > 22) {
+      return 0;
+    }
+    const double s = k < 0 ? a / Pow10(-k) : a * Pow10(k);
+    uint64_t m = static_cast<uint64_t>(s + 0.5);
+    const uint64_t lo = static_cast<uint64_t>(Pow10(precision - 1));
+    if (m >= lo * 10) {
+      m = (m + 5) / 10;
+      ++e;
+    } else if (m < lo) {
+      return 0;
+    }
+    return WriteDigits(value < 0.0, m, e, buffer);
+  }
+
+  /**
+   *  @struct BigInt
+   *  @brief  Unsigned integer large enough to scale any double to 17 digits
+   *          exactly (1280 bits)
+   */
+  struct BigInt {
+    /** Limbs, least significant first */
+    uint32_t limb[40];
+    /** Number of limbs in use, without leading zero */
+    int size;
+
+    /**
+     *  @name BigInt
+     *  @fn explicit BigInt(const uint64_t value)
+     *  @brief  Constructor
+     *  @param[in]  value Initial value
+     */
+    explicit BigInt(const uint64_t value) : size(0) {
+      for (uint64_t v = value; v != 0; v >>= 32) {
+        limb[size++] = static_cast<uint32_t>(v);
+      }
+    }
+
+    /**
+     *  @name Multiply
+     *  @fn void Multiply(const uint32_t factor)
+     *  @brief  In place multiplication
+     *  @param[in]  factor  Factor
+     */
+    void Multiply(const uint32_t factor) {
+      uint64_t carry = 0;
+      for (int i = 0; i < size; ++i) {
+        carry += static_cast<uint64_t>(limb[i]) * factor;
+        limb[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+      }
+      if (carry != 0) {
+        limb[size++] = static_cast<uint32_t>(carry);
+      }
+    }
+
+    /**
+     *  @name MultiplyPow10
+     *  @fn void MultiplyPow10(int e)
+     *  @brief  In place multiplication by 10^e
+     *  @param[in]  e Non negative exponent
+     */
+    void MultiplyPow10(int e) {
+      for (; e >= 9; e -= 9) {
+        this->Multiply(1000000000u);
+      }
+      if (e > 0) {
+        this->Multiply(static_cast<uint32_t>(Pow10(e)));
+      }
+    }
+
+    /**
+     *  @name ShiftLeft
+     *  @fn void ShiftLeft(const int bits)
+     *  @brief  In place multiplication by 2^bits
+     *  @param[in]  bits  Non negative shift
+     */
+    void ShiftLeft(const int bits) {
+      if (size == 0) {
+        return;
+      }
+      const int w = bits / 32;
+      const int b = bits % 32;
+      limb[size + w] = 0;
+      for (int i = size - 1; i >= 0; --i) {
+        const uint64_t v = static_cast<uint64_t>(limb[i]) << b;
+        limb[i + w + 1] |= static_cast<uint32_t>(v >> 32);
+        limb[i + w] = static_cast<uint32_t>(v);
+      }
+      for (int i = 0; i < w; ++i) {
+        limb[i] = 0;
+      }
+      size += w + 1;
+      this->Trim();
+    }
+
+    /**
+     *  @name ShiftRight
+     *  @fn void ShiftRight(void)
+     *  @brief  In place division by 2, the value must be even
+     */
+    void ShiftRight(void) {
+      for (int i = 0; i < size; ++i) {
+        limb[i] = ((limb[i] >> 1) |
+                   (i + 1 < size ? limb[i + 1] << 31 : 0u));
+      }
+      this->Trim();
+    }
+
+    /**
+     *  @name Subtract
+     *  @fn void Subtract(const BigInt& other)
+     *  @brief  In place subtraction, \p other must not be larger
+     *  @param[in]  other Value to subtract
+     */
+    void Subtract(const BigInt& other) {
+      int64_t borrow = 0;
+      for (int i = 0; i < size; ++i) {
+        borrow += static_cast<int64_t>(limb[i]) -
+                  (i < other.size ? static_cast<int64_t>(other.limb[i]) : 0);
+        limb[i] = static_cast<uint32_t>(borrow);
+        borrow = borrow < 0 ? -1 : 0;
+      }
+      this->Trim();
+    }
+
+    /**
+     *  @name Compare
+     *  @fn int Compare(const BigInt& other) const
+     *  @brief  Three way comparison
+     *  @param[in]  other Value to compare with
+     *  @return Negative, zero or positive value
+     */
+    int Compare(const BigInt& other) const {
+      if (size != other.size) {
+        return size < other.size ? -1 : 1;
+      }
+      for (int i = size - 1; i >= 0; --i) {
+        if (limb[i] != other.limb[i]) {
+          return limb[i] < other.limb[i] ? -1 : 1;
+        }
+      }
+      return 0;
+    }
+
+    /**
+     *  @name Trim
+     *  @fn void Trim(void)
+     *  @brief  Drop leading zero limbs
+     */
+    void Trim(void) {
+      while (size > 0 && limb[size - 1] == 0) {
+        --size;
+      }
+    }
+  };
+
+  /**
+   *  @name FormatExact
+   *  @fn static int FormatExact(const double value, const int precision,
+                                 char* buffer)
+   *  @brief  Correctly round a number to a given count of significant digits
+   *          and write it like FormatDigits() does. Digits are generated
+   *          from the binary mantissa with integer arithmetic only, 17
+   *          digits are enough for any double to convert back.
+   *  @param[in]  value     Value to write
+   *  @param[in]  precision Number of significant digits, at most 17
+   *  @param[out] buffer    Output buffer, at least 32 characters
+   *  @return Number of character written
+   */
+  static int FormatExact(const double value,
+                         const int precision,
+                         char* buffer) {
+    if (value == 0.0 || !std::isfinite(value)) {
+      const int n = FormatDigits(value, precision, buffer);
+      if (n != 0) {
+        return n;
+      }
+      const char* str = (std::isnan(value) ? "nan" :
+                         value < 0.0 ? "-inf" : "inf");
+      std::memcpy(buffer, str, std::strlen(str));
+      return static_cast<int>(std::strlen(str));
+    }
+    // value = mantissa * 2^e2, exactly
+    int e2 = 0;
+    const double a = std::fabs(value);
+    const uint64_t mantissa = static_cast<uint64_t>(
+            std::ldexp(std::frexp(a, &e2), 53));
+    e2 -= 53;
+    const uint64_t lo = static_cast<uint64_t>(Pow10(precision - 1));
+    int e = static_cast<int>(std::floor(std::log10(a)));
+    for (;;) {
+      // m = round(mantissa * 2^e2 * 10^k) as num / den
+      const int k = precision - 1 - e;
+      BigInt num(mantissa);
+      BigInt den(1);
+      if (e2 > 0) {
+        num.ShiftLeft(e2);
+      } else {
+        den.ShiftLeft(-e2);
+      }
+      if (k > 0) {
+        num.MultiplyPow10(k);
+      } else {
+        den.MultiplyPow10(-k);
+      }
+      // Long division, the quotient is below 10^18 even if the estimate
+      // of e is one too low
+      uint64_t m = 0;
+      den.ShiftLeft(63);
+      for (int bit = 63; bit >= 0; --bit) {
+        if (num.Compare(den) >= 0) {
+          num.Subtract(den);
+          m |= uint64_t(1) << bit;
+        }
+        if (bit > 0) {
+          den.ShiftRight();
+        }
+      }
+      // log10 estimate off by one
+      if (m >= lo * 10) {
+        ++e;
+        continue;
+      } else if (m < lo) {
+        --e;
+        continue;
+      }
+      // Round half to even on the remainder
+      num.ShiftLeft(1);
+      const int cmp = num.Compare(den);
+      if (cmp > 0 || (cmp == 0 && (m & 1) != 0)) {
+        ++m;
+      }
+      if (m == lo * 10) {
+        m = lo;
+        ++e;
+      }
+      return WriteDigits(value < 0.0, m, e, buffer);
+    }
+  }
+
+  /**
+   *  @name WriteDigits
+   *  @fn static int WriteDigits(const bool negative, const uint64_t m,
+                                 const int e, char* buffer)
+   *  @brief  Write m * 10^(e - digits(m) + 1) in fixed or scientific
+   *          notation without trailing zeros
+   *  @param[in]  negative  True to write a minus sign
+   *  @param[in]  m         Significant digits, at most 17
+   *  @param[in]  e         Decimal exponent of the first digit
+   *  @param[out] buffer    Output buffer, at least 32 characters
+   *  @return Number of character written
+   */
+  static int WriteDigits(const bool negative,
+                         const uint64_t m,
+                         const int e,
+                         char* buffer) {
+    char* p = buffer;
+    // Digits, without trailing zeros
+    char digit[24];
+    int n = 0;
+    for (uint64_t d = m; d != 0; d /= 10) {
+      digit[n++] = static_cast<char>('0' + (d % 10));
+    }
+    std::reverse(digit, digit + n);
+    while (n > 1 && digit[n - 1] == '0') {
+      --n;
+    }
+    if (negative) {
+      *p++ = '-';
+    }
+    if (e >= -5 && e < 15) {
+      // Fixed notation
+      if (e < 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = 0; i < -e - 1; ++i) {
+          *p++ = '0';
+        }
+        std::memcpy(p, digit, n);
+        p += n;
+      } else {
+        for (int i = 0; i <= e; ++i) {
+          *p++ = i < n ? digit[i] : '0';
+        }
+        if (n > e + 1) {
+          *p++ = '.';
+          std::memcpy(p, digit + e + 1, n - e - 1);
+          p += n - e - 1;
+        }
+      }
+    } else {
+      // Scientific notation
+      *p++ = digit[0];
+      if (n > 1) {
+        *p++ = '.';
+        std::memcpy(p, digit + 1, n - 1);
+        p += n - 1;
+      }
+      *p++ = 'e';
+      p = ToChars(p, buffer + 32, e);
+    }
+    return static_cast<int>(p - buffer);
+  }
+
+  /**
+   *  @name SlowFromChars
+   *  @fn static const char* SlowFromChars(const char* first,
+                                           const char* last,
+                                           double* value)
+   *  @brief  Fallback conversion through strtod for numbers out of reach of
+   *          the fast path. The token is copied since the range is not
+   *          required to be null terminated, '.' is swapped for the decimal
+   *          point of the current locale on the way so that strtod reads it
+   *          the same way as in the "C" locale.
+   *  @param[in]  first Beginning of the range
+   *  @param[in]  last  End of the range
+   *  @param[out] value Parsed value
+   *  @return Position following the number, \p first if no number was found
+   */
+  static const char* SlowFromChars(const char* first,
+                                   const char* last,
+                                   double* value) {
+    const char* point = std::localeconv()->decimal_point;
+    const char dp = (point != nullptr && point[0] != '\0' && point[1] == '\0' ?
+                     point[0] :
+                     '.');
+    char buffer[128];
+    size_t n = 0;
+    for (const char* p = first;
+         p != last && n < sizeof(buffer) - 1 && !IsSpace(*p) && *p != '\n' &&
+         *p != '/' && (*p != dp || dp == '.');
+         ++p) {
+      buffer[n++] = *p == '.' ? dp : *p;
+    }
+    buffer[n] = '\0';
+    char* end = nullptr;
+    const double v = std::strtod(buffer, &end);
+    if (end == buffer) {
+      return first;
+    }
+    *value = v;
+    return first + (end - buffer);
+  }
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_CHAR_CONV__ */
@@ -0,0 +1,212 @@
+/**
+ *  @file   json.hpp
+ *  @brief  Minimal JSON document reader
+ *  @ingroup core
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_JSON__
+#define __OGLKIT_JSON__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  JSONValue
+ *  @brief  Node of a parsed JSON document (RFC 8259). Lookups never fail,
+ *          missing members / elements resolve to a null value, therefore
+ *          optional fields can be read with a default value.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup core
+ */
+class OGLKIT_EXPORTS JSONValue {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /**
+   *  @enum Type
+   *  @brief  Kind of value
+   */
+  enum Type {
+    /** null, or missing */
+    kNull,
+    /** true / false */
+    kBool,
+    /** Number */
+    kNumber,
+    /** String */
+    kString,
+    /** Ordered list of value */
+    kArray,
+    /** List of key / value pair */
+    kObject
+  };
+
+  /** Maximum nesting level accepted by the parser */
+  static const int kMaxDepth;
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name JSONValue
+   *  @fn JSONValue(void)
+   *  @brief  Constructor, null value
+   */
+  JSONValue(void);
+
+  /**
+   *  @name Parse
+   *  @fn int Parse(const char* first, const char* last)
+   *  @brief  Parse a JSON document, only blanks can surround the root value
+   *  @param[in]  first Beginning of the document
+   *  @param[in]  last  End of the document
+   *  @return -1 if malformed, 0 otherwise
+   */
+  int Parse(const char* first, const char* last);
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name type
+   *  @fn Type type(void) const
+   *  @brief  Kind of value
+   *  @return Type
+   */
+  Type type(void) const {
+    return type_;
+  }
+
+  /**
+   *  @name size
+   *  @fn size_t size(void) const
+   *  @brief  Number of element (array) or member (object)
+   *  @return Size, 0 for other types
+   */
+  size_t size(void) const {
+    return type_ == kArray ? array_.size() : object_.size();
+  }
+
+  /**
+   *  @name Has
+   *  @fn bool Has(const std::string& key) const
+   *  @brief  Check if an object holds a given member
+   *  @param[in]  key Member's name
+   *  @return True if present
+   */
+  bool Has(const std::string& key) const;
+
+  /**
+   *  @name operator[]
+   *  @fn const JSONValue& operator[](const std::string& key) const
+   *  @brief  Access an object's member
+   *  @param[in]  key Member's name
+   *  @return Member's value, null if not an object or missing
+   */
+  const JSONValue& operator[](const std::string& key) const;
+
+  /**
+   *  @name operator[]
+   *  @fn const JSONValue& operator[](const size_t i) const
+   *  @brief  Access an array's element
+   *  @param[in]  i Element's index
+   *  @return Element's value, null if not an array or out of range
+   */
+  const JSONValue& operator[](const size_t i) const;
+
+  /**
+   *  @name AsBool
+   *  @fn bool AsBool(const bool value) const
+   *  @brief  Read a boolean
+   *  @param[in]  value Default value
+   *  @return Boolean or \p value if of another type
+   */
+  bool AsBool(const bool value) const {
+    return type_ == kBool ? bool_ : value;
+  }
+
+  /**
+   *  @name AsNumber
+   *  @fn double AsNumber(const double value) const
+   *  @brief  Read a number
+   *  @param[in]  value Default value
+   *  @return Number or \p value if of another type
+   */
+  double AsNumber(const double value) const {
+    return type_ == kNumber ? number_ : value;
+  }
+
+  /**
+   *  @name AsString
+   *  @fn const std::string& AsString(void) const
+   *  @brief  Read a string (UTF-8)
+   *  @return String, empty if of another type
+   */
+  const std::string& AsString(void) const {
+    return string_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+
+  /**
+   *  @name ParseValue
+   *  @fn const char* ParseValue(const char* first, const char* last,
+                                 const int depth)
+   *  @brief  Parse a value starting at \p first (no leading blank)
+   *  @param[in]  first Beginning of the value
+   *  @param[in]  last  End of the document
+   *  @param[in]  depth Nesting level
+   *  @return Position following the value, nullptr if malformed
+   */
+  const char* ParseValue(const char* first,
+                         const char* last,
+                         const int depth);
+
+  /**
+   *  @name ParseString
+   *  @fn static const char* ParseString(const char* first, const char* last,
+                                         std::string* str)
+   *  @brief  Parse a quoted string and resolve its escape sequences
+   *  @param[in]  first Opening quote
+   *  @param[in]  last  End of the document
+   *  @param[out] str   Decoded string
+   *  @return Position following the closing quote, nullptr if malformed
+   */
+  static const char* ParseString(const char* first,
+                                 const char* last,
+                                 std::string* str);
+
+  /** Type */
+  Type type_;
+  /** Boolean */
+  bool bool_;
+  /** Number */
+  double number_;
+  /** String */
+  std::string string_;
+  /** Array's elements */
+  std::vector<JSONValue> array_;
+  /** Object's members, in document order */
+  std::vector<std::pair<std::string, JSONValue>> object_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_JSON__ */
@@ -0,0 +1,121 @@
+/**
+ *  @file   memory_map.hpp
+ *  @brief  Read-only view of a file's content
+ *  @ingroup core
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MEMORY_MAP__
+#define __OGLKIT_MEMORY_MAP__
+
+#include <string>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MemoryMap
+ *  @brief  Read-only view of a file's content. The file is memory mapped when
+ *          the platform supports it, otherwise it is read in one go into an
+ *          internal buffer.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup core
+ */
+class OGLKIT_EXPORTS MemoryMap {
+ public:
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name MemoryMap
+   *  @fn MemoryMap(void)
+   *  @brief  Constructor
+   */
+  MemoryMap(void);
+
+  /**
+   *  @name MemoryMap
+   *  @fn MemoryMap(const MemoryMap& other) = delete
+   *  @brief  Copy constructor
+   */
+  MemoryMap(const MemoryMap& other) = delete;
+
+  /**
+   *  @name operator=
+   *  @fn MemoryMap& operator=(const MemoryMap& rhs) = delete
+   *  @brief  Assignment operator
+   */
+  MemoryMap& operator=(const MemoryMap& rhs) = delete;
+
+  /**
+   *  @name ~MemoryMap
+   *  @fn ~MemoryMap(void)
+   *  @brief  Destructor, release the mapping
+   */
+  ~MemoryMap(void);
+
+  /**
+   *  @name Open
+   *  @fn int Open(const std::string& path)
+   *  @brief  Map a given file into memory
+   *  @param[in]  path  Path to the file to map
+   *  @return -1 if error, 0 otherwise
+   */
+  int Open(const std::string& path);
+
+  /**
+   *  @name Close
+   *  @fn void Close(void)
+   *  @brief  Release the mapping
+   */
+  void Close(void);
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name data
+   *  @fn const char* data(void) const
+   *  @brief  Pointer to the first byte of the file
+   *  @return File's content, nullptr if empty
+   */
+  const char* data(void) const {
+    return data_;
+  }
+
+  /**
+   *  @name size
+   *  @fn size_t size(void) const
+   *  @brief  File's size in bytes
+   *  @return Size
+   */
+  size_t size(void) const {
+    return size_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+  /** File's content */
+  const char* data_;
+  /** File's size */
+  size_t size_;
+  /** Indicate if data_ is a memory mapping */
+  bool is_mapped_;
+  /** Fallback storage when mapping is not available */
+  std::vector<char> buffer_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MEMORY_MAP__ */
@@ -0,0 +1,240 @@
+/**
+ *  @file   thread_pool.hpp
+ *  @brief  Pool of worker threads
+ *  @ingroup core
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_THREAD_POOL__
+#define __OGLKIT_THREAD_POOL__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  ThreadPool
+ *  @brief  Pool of worker threads shared by the library. The thread calling
+ *          a parallel loop processes the loop's blocks no worker has picked
+ *          up yet, therefore parallel loops can be nested without deadlock.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup core
+ */
+class OGLKIT_EXPORTS ThreadPool {
+ public:
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name Instance
+   *  @fn static ThreadPool& Instance(void)
+   *  @brief  Provide unique reference to the library's pool (Singleton). The
+   *          pool has one worker less than the number of hardware threads
+   *          since the calling thread takes part in parallel loops.
+   *  @return Thread pool
+   */
+  static ThreadPool& Instance(void);
+
+  /**
+   *  @name ThreadPool
+   *  @fn explicit ThreadPool(const size_t n_worker)
+   *  @brief  Constructor
+   *  @param[in]  n_worker  Number of worker thread, at least one is created
+   */
+  explicit ThreadPool(const size_t n_worker);
+
+  /**
+   *  @name ThreadPool
+   *  @fn ThreadPool(const ThreadPool& other) = delete
+   *  @brief  Copy constructor
+   */
+  ThreadPool(const ThreadPool& other) = delete;
+
+  /**
+   *  @name operator=
+   *  @fn ThreadPool& operator=(const ThreadPool& rhs) = delete
+   *  @brief  Assignment operator
+   */
+  ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+  /**
+   *  @name ~ThreadPool
+   *  @fn ~ThreadPool(void)
+   *  @brief  Destructor, wait for pending tasks to finish
+   */
+  ~ThreadPool(void);
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name Enqueue
+   *  @fn std::future<R> Enqueue(F&& task)
+   *  @brief  Schedule a task for asynchronous execution
+   *  @param[in]  task  Callable object without argument
+   *  @return Future holding the task's result
+   */
+  template<typename F>
+  std::future<typename std::result_of<F()>::type> Enqueue(F&& task) {
+    using R = typename std::result_of<F()>::type;
+    auto job = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+    std::future<R> res = job->get_future();
+    this->Push([job](void) { (*job)(); });
+    return res;
+  }
+
+  /**
+   *  @name ParallelFor
+   *  @fn void ParallelFor(const size_t first, const size_t last,
+                           const size_t grain, const F& fcn)
+   *  @brief  Split the range [first, last[ into contiguous blocks of at least
+   *          \p grain elements and call fcn(begin, end) for each of them in
+   *          parallel. Blocks are claimed by the calling thread and by the
+   *          workers, the calling thread only runs blocks of this loop and
+   *          sleeps until the ones claimed by workers are done. The first
+   *          exception raised by \p fcn, if any, is propagated.
+   *  @param[in]  first First index
+   *  @param[in]  last  Last index (excluded)
+   *  @param[in]  grain Minimum number of element per block
+   *  @param[in]  fcn   Function called with (begin, end)
+   */
+  template<typename F>
+  void ParallelFor(const size_t first,
+                   const size_t last,
+                   const size_t grain,
+                   const F& fcn) {
+    if (last <= first) {
+      return;
+    }
+    const size_t n = last - first;
+    const size_t n_block = std::min(std::max(n / std::max(grain, size_t(1)),
+                                             size_t(1)),
+                                    this->size() + 1);
+    if (n_block == 1) {
+      fcn(first, last);
+      return;
+    }
+    // Blocks are claimed through a shared counter, helpers dequeued once
+    // the loop is over find nothing left and do not touch fcn
+    auto state = std::make_shared<LoopState>();
+    auto run = [state, first, n, n_block, &fcn](void) {
+      for (size_t b = state->next++; b < n_block; b = state->next++) {
+        try {
+          fcn(first + (b * n) / n_block, first + ((b + 1) * n) / n_block);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (!state->error) {
+            state->error = std::current_exception();
+          }
+        }
+        if (++state->done == n_block) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->cond.notify_one();
+        }
+      }
+    };
+    for (size_t b = 1; b < n_block; ++b) {
+      this->Push(run);
+    }
+    run();
+    // Wait for the blocks still running on workers
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [&state, n_block](void) {
+      return state->done.load() == n_block;
+    });
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
+  }
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name size
+   *  @fn size_t size(void) const
+   *  @brief  Number of worker thread
+   *  @return Number of worker
+   */
+  size_t size(void) const {
+    return workers_.size();
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+
+  /**
+   *  @struct LoopState
+   *  @brief  State of one ParallelFor call, shared with its helper tasks
+   */
+  struct LoopState {
+    /** Next block to claim */
+    std::atomic<size_t> next;
+    /** Number of processed block */
+    std::atomic<size_t> done;
+    /** First exception raised */
+    std::exception_ptr error;
+    /** Lock for error and completion */
+    std::mutex mutex;
+    /** Signal the completion of the last block */
+    std::condition_variable cond;
+
+    /**
+     *  @name LoopState
+     *  @fn LoopState(void)
+     *  @brief  Constructor
+     */
+    LoopState(void) : next(0), done(0), error(nullptr) {}
+  };
+
+  /**
+   *  @name Push
+   *  @fn void Push(std::function<void(void)>&& task)
+   *  @brief  Add a task into the queue
+   *  @param[in]  task  Task to execute
+   */
+  void Push(std::function<void(void)>&& task);
+
+  /**
+   *  @name WorkerLoop
+   *  @fn void WorkerLoop(void)
+   *  @brief  Function run by each worker
+   */
+  void WorkerLoop(void);
+
+  /** Workers */
+  std::vector<std::thread> workers_;
+  /** Pending tasks */
+  std::deque<std::function<void(void)>> tasks_;
+  /** Queue's lock */
+  std::mutex mutex_;
+  /** Signal new task or termination */
+  std::condition_variable cond_;
+  /** Termination flag */
+  bool stop_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_THREAD_POOL__ */
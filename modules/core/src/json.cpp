@@ -0,0 +1,367 @@
+/**
+ *  @file   json.cpp
+ *  @brief  Minimal JSON document reader
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <cstring>
+
+#include "oglkit/core/char_conv.hpp"
+#include "oglkit/core/json.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Maximum nesting level accepted by the parser */
+const int JSONValue::kMaxDepth = 256;
+
+/**
+ *  @name SkipBlank
+ *  @fn const char* SkipBlank(const char* first, const char* last)
+ *  @brief  Move forward until something else than a JSON whitespace is found
+ *  @param[in]  first Beginning of the range
+ *  @param[in]  last  End of the range
+ *  @return First non blank position
+ */
+static const char* SkipBlank(const char* first, const char* last) {
+  while (first != last && (*first == ' ' || *first == '\t' ||
+                           *first == '\n' || *first == '\r')) {
+    ++first;
+  }
+  return first;
+}
+
+/**
+ *  @name ParseHex4
+ *  @fn const char* ParseHex4(const char* first, const char* last,
+                              unsigned* code)
+ *  @brief  Parse the four hexadecimal digits of a \\u escape sequence
+ *  @param[in]  first Beginning of the digits
+ *  @param[in]  last  End of the range
+ *  @param[out] code  Code unit
+ *  @return Position following the digits, nullptr if malformed
+ */
+static const char* ParseHex4(const char* first,
+                             const char* last,
+                             unsigned* code) {
+  if (last - first < 4) {
+    return nullptr;
+  }
+  *code = 0;
+  for (int k = 0; k < 4; ++k, ++first) {
+    const char c = *first;
+    unsigned d;
+    if (c >= '0' && c <= '9') {
+      d = static_cast<unsigned>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      d = static_cast<unsigned>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      d = static_cast<unsigned>(c - 'A' + 10);
+    } else {
+      return nullptr;
+    }
+    *code = (*code << 4) | d;
+  }
+  return first;
+}
+
+/**
+ *  @name AppendUTF8
+ *  @fn void AppendUTF8(const unsigned code, std::string* str)
+ *  @brief  Append a code point encoded in UTF-8
+ *  @param[in]  code  Code point
+ *  @param[out] str   String to append to
+ */
+static void AppendUTF8(const unsigned code, std::string* str) {
+  if (code < 0x80) {
+    str->push_back(static_cast<char>(code));
+  } else if (code < 0x800) {
+    str->push_back(static_cast<char>(0xC0 | (code >> 6)));
+    str->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  } else if (code < 0x10000) {
+    str->push_back(static_cast<char>(0xE0 | (code >> 12)));
+    str->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    str->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  } else {
+    str->push_back(static_cast<char>(0xF0 | (code >> 18)));
+    str->push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+    str->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    str->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+}
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name JSONValue
+ *  @fn JSONValue(void)
+ *  @brief  Constructor, null value
+ */
+JSONValue::JSONValue(void) : type_(kNull), bool_(false), number_(0.0) {
+}
+
+/*
+ *  @name Parse
+ *  @fn int Parse(const char* first, const char* last)
+ *  @brief  Parse a JSON document, only blanks can surround the root value
+ *  @param[in]  first Beginning of the document
+ *  @param[in]  last  End of the document
+ *  @return -1 if malformed, 0 otherwise
+ */
+int JSONValue::Parse(const char* first, const char* last) {
+  *this = JSONValue();
+  const char* p = this->ParseValue(SkipBlank(first, last), last, 0);
+  if (!p || SkipBlank(p, last) != last) {
+    *this = JSONValue();
+    return -1;
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Accessors
+
+/*
+ *  @name Has
+ *  @fn bool Has(const std::string& key) const
+ *  @brief  Check if an object holds a given member
+ *  @param[in]  key Member's name
+ *  @return True if present
+ */
+bool JSONValue::Has(const std::string& key) const {
+  for (const auto& member : object_) {
+    if (member.first == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ *  @name operator[]
+ *  @fn const JSONValue& operator[](const std::string& key) const
+ *  @brief  Access an object's member
+ *  @param[in]  key Member's name
+ *  @return Member's value, null if not an object or missing
+ */
+const JSONValue& JSONValue::operator[](const std::string& key) const {
+  static const JSONValue null;
+  for (const auto& member : object_) {
+    if (member.first == key) {
+      return member.second;
+    }
+  }
+  return null;
+}
+
+/*
+ *  @name operator[]
+ *  @fn const JSONValue& operator[](const size_t i) const
+ *  @brief  Access an array's element
+ *  @param[in]  i Element's index
+ *  @return Element's value, null if not an array or out of range
+ */
+const JSONValue& JSONValue::operator[](const size_t i) const {
+  static const JSONValue null;
+  return i < array_.size() ? array_[i] : null;
+}
+
+#pragma mark -
+#pragma mark Private
+
+/*
+ *  @name ParseValue
+ *  @fn const char* ParseValue(const char* first, const char* last,
+                               const int depth)
+ *  @brief  Parse a value starting at \p first (no leading blank)
+ *  @param[in]  first Beginning of the value
+ *  @param[in]  last  End of the document
+ *  @param[in]  depth Nesting level
+ *  @return Position following the value, nullptr if malformed
+ */
+const char* JSONValue::ParseValue(const char* first,
+                                  const char* last,
+                                  const int depth) {
+  if (first == last || depth > kMaxDepth) {
+    return nullptr;
+  }
+  const size_t n = static_cast<size_t>(last - first);
+  const char* p = nullptr;
+  switch (*first) {
+    case '{': {
+      type_ = kObject;
+      p = SkipBlank(first + 1, last);
+      if (p != last && *p == '}') {
+        return p + 1;
+      }
+      while (p) {
+        object_.push_back(std::make_pair(std::string(), JSONValue()));
+        auto& member = object_.back();
+        p = ParseString(p, last, &member.first);
+        p = p ? SkipBlank(p, last) : p;
+        if (!p || p == last || *p != ':') {
+          return nullptr;
+        }
+        p = member.second.ParseValue(SkipBlank(p + 1, last), last, depth + 1);
+        p = p ? SkipBlank(p, last) : p;
+        if (!p || p == last) {
+          return nullptr;
+        }
+        if (*p == '}') {
+          return p + 1;
+        }
+        p = *p == ',' ? SkipBlank(p + 1, last) : nullptr;
+      }
+    }
+      break;
+
+    case '[': {
+      type_ = kArray;
+      p = SkipBlank(first + 1, last);
+      if (p != last && *p == ']') {
+        return p + 1;
+      }
+      while (p) {
+        array_.push_back(JSONValue());
+        p = array_.back().ParseValue(p, last, depth + 1);
+        p = p ? SkipBlank(p, last) : p;
+        if (!p || p == last) {
+          return nullptr;
+        }
+        if (*p == ']') {
+          return p + 1;
+        }
+        p = *p == ',' ? SkipBlank(p + 1, last) : nullptr;
+      }
+    }
+      break;
+
+    case '"': {
+      type_ = kString;
+      p = ParseString(first, last, &string_);
+    }
+      break;
+
+    case 't':
+    case 'f':
+    case 'n': {
+      if (n >= 4 && std::strncmp(first, "true", 4) == 0) {
+        type_ = kBool;
+        bool_ = true;
+        p = first + 4;
+      } else if (n >= 5 && std::strncmp(first, "false", 5) == 0) {
+        type_ = kBool;
+        p = first + 5;
+      } else if (n >= 4 && std::strncmp(first, "null", 4) == 0) {
+        p = first + 4;
+      }
+    }
+      break;
+
+    default: {
+      // Number, must start with a minus sign or a digit (i.e. no nan/inf)
+      if (*first == '-' || CharConv::IsDigit(*first)) {
+        p = CharConv::FromChars(first, last, &number_);
+        if (p == first) {
+          p = nullptr;
+        } else {
+          type_ = kNumber;
+        }
+      }
+    }
+      break;
+  }
+  return p;
+}
+
+/*
+ *  @name ParseString
+ *  @fn static const char* ParseString(const char* first, const char* last,
+                                       std::string* str)
+ *  @brief  Parse a quoted string and resolve its escape sequences
+ *  @param[in]  first Opening quote
+ *  @param[in]  last  End of the document
+ *  @param[out] str   Decoded string
+ *  @return Position following the closing quote, nullptr if malformed
+ */
+const char* JSONValue::ParseString(const char* first,
+                                   const char* last,
+                                   std::string* str) {
+  if (first == last || *first != '"') {
+    return nullptr;
+  }
+  const char* p = first + 1;
+  while (p != last) {
+    // Copy plain characters in one go
+    const char* q = p;
+    while (q != last && *q != '"' && *q != '\\' &&
+           static_cast<unsigned char>(*q) >= 0x20) {
+      ++q;
+    }
+    str->append(p, q);
+    if (q == last || static_cast<unsigned char>(*q) < 0x20) {
+      return nullptr;
+    }
+    if (*q == '"') {
+      return q + 1;
+    }
+    // Escape sequence
+    if (++q == last) {
+      return nullptr;
+    }
+    p = q + 1;
+    switch (*q) {
+      case '"': str->push_back('"');
+        break;
+      case '\\': str->push_back('\\');
+        break;
+      case '/': str->push_back('/');
+        break;
+      case 'b': str->push_back('\b');
+        break;
+      case 'f': str->push_back('\f');
+        break;
+      case 'n': str->push_back('\n');
+        break;
+      case 'r': str->push_back('\r');
+        break;
+      case 't': str->push_back('\t');
+        break;
+      case 'u': {
+        unsigned code = 0;
+        p = ParseHex4(p, last, &code);
+        if (!p) {
+          return nullptr;
+        }
+        if (code >= 0xD800 && code < 0xDC00) {
+          // High surrogate, must be followed by a low one
+          unsigned low = 0;
+          if (last - p < 2 || p[0] != '\\' || p[1] != 'u') {
+            return nullptr;
+          }
+          p = ParseHex4(p + 2, last, &low);
+          if (!p || low < 0xDC00 || low >= 0xE000) {
+            return nullptr;
+          }
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        } else if (code >= 0xDC00 && code < 0xE000) {
+          return nullptr;
+        }
+        AppendUTF8(code, str);
+      }
+        break;
+      default:
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace OGLKit
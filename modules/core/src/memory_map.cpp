@@ -0,0 +1,126 @@
+/**
+ *  @file   memory_map.cpp
+ *  @brief  Read-only view of a file's content
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "oglkit/core/memory_map.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name MemoryMap
+ *  @fn MemoryMap(void)
+ *  @brief  Constructor
+ */
+MemoryMap::MemoryMap(void) : data_(nullptr),
+                             size_(0),
+                             is_mapped_(false) {
+}
+
+/*
+ *  @name ~MemoryMap
+ *  @fn ~MemoryMap(void)
+ *  @brief  Destructor, release the mapping
+ */
+MemoryMap::~MemoryMap(void) {
+  this->Close();
+}
+
+/*
+ *  @name Open
+ *  @fn int Open(const std::string& path)
+ *  @brief  Map a given file into memory
+ *  @param[in]  path  Path to the file to map
+ *  @return -1 if error, 0 otherwise
+ */
+int MemoryMap::Open(const std::string& path) {
+  this->Close();
+#if !defined(_WIN32)
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return -1;
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ > 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      // Parsers walk the content front to back
+      madvise(addr, size_, MADV_SEQUENTIAL);
+      data_ = reinterpret_cast<const char*>(addr);
+      is_mapped_ = true;
+    }
+  }
+  close(fd);
+  if (size_ == 0 || is_mapped_) {
+    return 0;
+  }
+  size_ = 0;
+#endif
+  // Fallback, read everything in one go
+  std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+  if (!stream.is_open()) {
+    return -1;
+  }
+  stream.seekg(0, std::ios_base::end);
+  const std::streamoff length = stream.tellg();
+  stream.seekg(0, std::ios_base::beg);
+  if (length < 0) {
+    return -1;
+  }
+  buffer_.resize(static_cast<size_t>(length));
+  if (length > 0) {
+    stream.read(buffer_.data(), length);
+    if (!stream.good()) {
+      buffer_.clear();
+      return -1;
+    }
+    data_ = buffer_.data();
+  }
+  size_ = buffer_.size();
+  return 0;
+}
+
+/*
+ *  @name Close
+ *  @fn void Close(void)
+ *  @brief  Release the mapping
+ */
+void MemoryMap::Close(void) {
+#if !defined(_WIN32)
+  if (is_mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0;
+  is_mapped_ = false;
+}
+
+}  // namespace OGLKit
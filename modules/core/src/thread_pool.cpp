@@ -0,0 +1,102 @@
+/**
+ *  @file   thread_pool.cpp
+ *  @brief  Pool of worker threads
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include "oglkit/core/thread_pool.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name Instance
+ *  @fn static ThreadPool& Instance(void)
+ *  @brief  Provide unique reference to the library's pool (Singleton)
+ *  @return Thread pool
+ */
+ThreadPool& ThreadPool::Instance(void) {
+  // Singleton, thread safe since C++11
+  static ThreadPool pool(std::thread::hardware_concurrency() > 1 ?
+                         std::thread::hardware_concurrency() - 1 :
+                         1);
+  return pool;
+}
+
+/*
+ *  @name ThreadPool
+ *  @fn explicit ThreadPool(const size_t n_worker)
+ *  @brief  Constructor
+ *  @param[in]  n_worker  Number of worker thread, at least one is created
+ */
+ThreadPool::ThreadPool(const size_t n_worker) : stop_(false) {
+  const size_t n = std::max(n_worker, size_t(1));
+  for (size_t i = 0; i < n; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+/*
+ *  @name ~ThreadPool
+ *  @fn ~ThreadPool(void)
+ *  @brief  Destructor, wait for pending tasks to finish
+ */
+ThreadPool::~ThreadPool(void) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto& w : workers_) {
+    w.join();
+  }
+}
+
+#pragma mark -
+#pragma mark Private
+
+/*
+ *  @name Push
+ *  @fn void Push(std::function<void(void)>&& task)
+ *  @brief  Add a task into the queue
+ *  @param[in]  task  Task to execute
+ */
+void ThreadPool::Push(std::function<void(void)>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+/*
+ *  @name WorkerLoop
+ *  @fn void WorkerLoop(void)
+ *  @brief  Function run by each worker
+ */
+void ThreadPool::WorkerLoop(void) {
+  while (true) {
+    std::function<void(void)> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this](void) { return stop_ || !tasks_.empty(); });
+      if (stop_ && tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace OGLKit
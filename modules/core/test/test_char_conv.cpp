@@ -0,0 +1,208 @@
+/**
+ *  @file   test_char_conv.cpp
+ *  @brief  Unit test for number/characters conversion
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <climits>
+#include <cstdint>
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "oglkit/core/char_conv.hpp"
+
+using CharConv = OGLKit::CharConv;
+
+TEST(FromChars, Integer) {
+  const char* str = "-42/7";
+  int v = 0;
+  const char* p = CharConv::FromChars(str, str + strlen(str), &v);
+  EXPECT_EQ(v, -42);
+  EXPECT_EQ(*p, '/');
+  // Not a number
+  const char* bad = "abc";
+  v = 3;
+  p = CharConv::FromChars(bad, bad + 3, &v);
+  EXPECT_EQ(p, bad);
+  EXPECT_EQ(v, 3);
+}
+
+TEST(FromChars, Real) {
+  const char* values[] = {"0.5", "-1.25e-3", "3", "1E+2", ".75", "-0.0",
+                          "0.0199999995529651641845703125",
+                          "12345678901234567890.5", "1e-300", "inf"};
+  for (const char* str : values) {
+    double v = 0.0;
+    const char* last = str + strlen(str);
+    const char* p = CharConv::FromChars(str, last, &v);
+    EXPECT_EQ(p, last) << str;
+    EXPECT_EQ(v, std::strtod(str, nullptr)) << str;
+  }
+}
+
+TEST(FromChars, IntegerOverflow) {
+  const char* values[] = {"2147483648", "-2147483649", "99999999999999999999"};
+  for (const char* str : values) {
+    int v = 3;
+    const char* p = CharConv::FromChars(str, str + strlen(str), &v);
+    EXPECT_EQ(p, str) << str;
+    EXPECT_EQ(v, 3) << str;
+  }
+  const char* min = "-2147483648";
+  int v = 0;
+  const char* p = CharConv::FromChars(min, min + strlen(min), &v);
+  EXPECT_EQ(p, min + strlen(min));
+  EXPECT_EQ(v, INT_MIN);
+  // Exponent out of int's range
+  const char* huge = "1e99999999999";
+  double d = 0.0;
+  p = CharConv::FromChars(huge, huge + strlen(huge), &d);
+  EXPECT_EQ(p, huge + strlen(huge));
+  EXPECT_TRUE(std::isinf(d));
+}
+
+TEST(FromChars, Locale) {
+  // Slow path must ignore the locale's decimal point
+  const char* locales[] = {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR"};
+  const std::string current = std::setlocale(LC_NUMERIC, nullptr);
+  for (const char* name : locales) {
+    if (std::setlocale(LC_NUMERIC, name) != nullptr) {
+      break;
+    }
+  }
+  const char* str = "1.5e300 12345678901234567890,5";
+  double v = 0.0;
+  const char* p = CharConv::FromChars(str, str + strlen(str), &v);
+  EXPECT_EQ(p, str + 7);
+  EXPECT_EQ(v, 1.5e300);
+  p = CharConv::FromChars(str + 8, str + strlen(str), &v);
+  EXPECT_EQ(p, str + 28);
+  EXPECT_EQ(v, 12345678901234567890.0);
+  std::setlocale(LC_NUMERIC, current.c_str());
+}
+
+TEST(FromChars, RangeNotTerminated) {
+  // Only first 3 characters are valid
+  const char str[] = "1.5999";
+  float v = 0.f;
+  const char* p = CharConv::FromChars(str, str + 3, &v);
+  EXPECT_EQ(p, str + 3);
+  EXPECT_FLOAT_EQ(v, 1.5f);
+}
+
+TEST(ToChars, Integer) {
+  char buffer[16];
+  const int values[] = {0, 7, -42, 2147483647, -2147483647 - 1};
+  const char* expected[] = {"0", "7", "-42", "2147483647", "-2147483648"};
+  for (size_t i = 0; i < 5; ++i) {
+    char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), values[i]);
+    EXPECT_EQ(std::string(buffer, p), expected[i]);
+  }
+  // Not enough room
+  EXPECT_EQ(CharConv::ToChars(buffer, buffer + 2, -42), buffer);
+}
+
+TEST(ToChars, Shortest) {
+  char buffer[32];
+  char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), 0.1f);
+  EXPECT_EQ(std::string(buffer, p), "0.1");
+  p = CharConv::ToChars(buffer, buffer + sizeof(buffer), -2.5);
+  EXPECT_EQ(std::string(buffer, p), "-2.5");
+  p = CharConv::ToChars(buffer, buffer + sizeof(buffer), 1500.0f);
+  EXPECT_EQ(std::string(buffer, p), "1500");
+  p = CharConv::ToChars(buffer, buffer + sizeof(buffer), 0.00025);
+  EXPECT_EQ(std::string(buffer, p), "0.00025");
+  p = CharConv::ToChars(buffer, buffer + sizeof(buffer), 1.25e20);
+  EXPECT_EQ(std::string(buffer, p), "1.25e20");
+}
+
+TEST(ToChars, RoundTrip) {
+  char buffer[32];
+  std::srand(42);
+  for (int i = 0; i < 100000; ++i) {
+    const double mag = std::pow(10.0, (std::rand() % 40) - 20);
+    const double d = mag * (static_cast<double>(std::rand()) / RAND_MAX - 0.5);
+    const float f = static_cast<float>(d);
+    char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), d);
+    double dv = 0.0;
+    EXPECT_EQ(CharConv::FromChars(buffer, p, &dv), p);
+    EXPECT_EQ(dv, d) << std::string(buffer, p);
+    p = CharConv::ToChars(buffer, buffer + sizeof(buffer), f);
+    float fv = 0.f;
+    EXPECT_EQ(CharConv::FromChars(buffer, p, &fv), p);
+    EXPECT_EQ(fv, f) << std::string(buffer, p);
+  }
+}
+
+TEST(ToChars, Exact) {
+  // Every bit pattern, including subnormals and huge exponents
+  char buffer[32];
+  std::srand(7);
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t bits = 0;
+    for (int k = 0; k < 4; ++k) {
+      bits = (bits << 16) ^ static_cast<uint64_t>(std::rand() & 0xFFFF);
+    }
+    double d = 0.0;
+    std::memcpy(&d, &bits, sizeof(d));
+    if (std::isnan(d)) {
+      continue;
+    }
+    char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), d);
+    double dv = 0.0;
+    EXPECT_EQ(CharConv::FromChars(buffer, p, &dv), p);
+    EXPECT_EQ(dv, d) << std::string(buffer, p);
+    uint32_t fbits = static_cast<uint32_t>(bits);
+    float f = 0.f;
+    std::memcpy(&f, &fbits, sizeof(f));
+    if (std::isnan(f)) {
+      continue;
+    }
+    p = CharConv::ToChars(buffer, buffer + sizeof(buffer), f);
+    float fv = 0.f;
+    EXPECT_EQ(CharConv::FromChars(buffer, p, &fv), p);
+    EXPECT_EQ(fv, f) << std::string(buffer, p);
+  }
+}
+
+TEST(ToChars, Locale) {
+  // Output must not use the locale's decimal point
+  const char* locales[] = {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR"};
+  const std::string current = std::setlocale(LC_NUMERIC, nullptr);
+  for (const char* name : locales) {
+    if (std::setlocale(LC_NUMERIC, name) != nullptr) {
+      break;
+    }
+  }
+  const double values[] = {0.1 + 0.2, 1.0 / 3.0, 1.7976931348623157e308,
+                           4.9406564584124654e-324, -2.2250738585072014e-308};
+  const char* expected[] = {"0.30000000000000004", "0.3333333333333333",
+                            "1.7976931348623157e308",
+                            "4.940656458412465e-324",
+                            "-2.2250738585072014e-308"};
+  char buffer[32];
+  for (size_t i = 0; i < 5; ++i) {
+    char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), values[i]);
+    EXPECT_EQ(std::string(buffer, p), expected[i]);
+  }
+  const float fvalues[] = {1e-45f, 3.4028235e38f, 16777217.f};
+  const char* fexpected[] = {"1.4013e-45", "3.4028235e38", "16777216"};
+  for (size_t i = 0; i < 3; ++i) {
+    char* p = CharConv::ToChars(buffer, buffer + sizeof(buffer), fvalues[i]);
+    EXPECT_EQ(std::string(buffer, p), fexpected[i]);
+  }
+  std::setlocale(LC_NUMERIC, current.c_str());
+}
+
+int main(int argc, const char * argv[]) {
+  ::testing::InitGoogleTest(&argc, const_cast<char**>(argv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,86 @@
+/**
+ *  @file   test_json.cpp
+ *  @brief  Unit test for JSON reader
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "oglkit/core/json.hpp"
+
+using JSONValue = OGLKit::JSONValue;
+
+/**
+ *  @name Parse
+ *  @fn int Parse(const std::string& str, JSONValue* value)
+ *  @brief  Parse a document held by a string
+ *  @param[in]  str   Document
+ *  @param[out] value Parsed document
+ *  @return -1 if malformed, 0 otherwise
+ */
+int Parse(const std::string& str, JSONValue* value) {
+  return value->Parse(str.data(), str.data() + str.size());
+}
+
+TEST(JSONValue, Document) {
+  const std::string doc = "{\n"
+                          "  \"asset\": {\"version\": \"2.0\"},\n"
+                          "  \"count\": -12.5e1,\n"
+                          "  \"list\": [1, true, null, [], {}],\n"
+                          "  \"flag\": false\n"
+                          "}\n";
+  JSONValue value;
+  ASSERT_EQ(Parse(doc, &value), 0);
+  EXPECT_EQ(value.type(), JSONValue::kObject);
+  EXPECT_EQ(value.size(), 4);
+  EXPECT_EQ(value["asset"]["version"].AsString(), "2.0");
+  EXPECT_EQ(value["count"].AsNumber(0.0), -125.0);
+  const JSONValue& list = value["list"];
+  ASSERT_EQ(list.type(), JSONValue::kArray);
+  ASSERT_EQ(list.size(), 5);
+  EXPECT_EQ(list[0].AsNumber(0.0), 1.0);
+  EXPECT_TRUE(list[1].AsBool(false));
+  EXPECT_EQ(list[2].type(), JSONValue::kNull);
+  EXPECT_EQ(list[3].type(), JSONValue::kArray);
+  EXPECT_EQ(list[4].type(), JSONValue::kObject);
+  EXPECT_FALSE(value["flag"].AsBool(true));
+  // Missing values fall back to defaults
+  EXPECT_TRUE(value.Has("flag"));
+  EXPECT_FALSE(value.Has("missing"));
+  EXPECT_EQ(value["missing"]["deeper"][3].AsNumber(7.0), 7.0);
+  EXPECT_EQ(list[12].type(), JSONValue::kNull);
+}
+
+TEST(JSONValue, String) {
+  JSONValue value;
+  ASSERT_EQ(Parse("\"a\\\"b\\\\c\\/\\n\\u00e9\\ud83d\\ude00\"", &value), 0);
+  EXPECT_EQ(value.AsString(), "a\"b\\c/\n\xC3\xA9\xF0\x9F\x98\x80");
+  // Lone surrogate, unknown escape, control character
+  EXPECT_EQ(Parse("\"\\ud83d\"", &value), -1);
+  EXPECT_EQ(Parse("\"\\q\"", &value), -1);
+  EXPECT_EQ(Parse("\"a\nb\"", &value), -1);
+}
+
+TEST(JSONValue, Malformed) {
+  const char* docs[] = {"", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "[1 2]",
+                        "nan", "tru", "{} {}", "{\"a\":}", "'a'"};
+  for (const char* doc : docs) {
+    JSONValue value;
+    EXPECT_EQ(Parse(doc, &value), -1) << doc;
+    EXPECT_EQ(value.type(), JSONValue::kNull);
+  }
+  // Nesting limit
+  JSONValue value;
+  const std::string deep(JSONValue::kMaxDepth + 2, '[');
+  EXPECT_EQ(Parse(deep + std::string(deep.size(), ']'), &value), -1);
+}
+
+int main(int argc, const char * argv[]) {
+  ::testing::InitGoogleTest(&argc, const_cast<char**>(argv));
+  return RUN_ALL_TESTS();
+}
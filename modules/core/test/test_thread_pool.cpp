@@ -0,0 +1,84 @@
+/**
+ *  @file   test_thread_pool.cpp
+ *  @brief  Unit test for thread pool
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "oglkit/core/thread_pool.hpp"
+
+using ThreadPool = OGLKit::ThreadPool;
+
+TEST(ThreadPool, Enqueue) {
+  ThreadPool pool(2);
+  auto f = pool.Enqueue([](void) { return 42; });
+  EXPECT_EQ(f.get(), 42);
+}
+
+TEST(ThreadPool, ParallelFor) {
+  ThreadPool pool(3);
+  std::vector<int> data(10001, 0);
+  pool.ParallelFor(0, data.size(), 16, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      data[i] += 1;
+    }
+  });
+  EXPECT_EQ(std::accumulate(data.begin(), data.end(), 0), 10001);
+}
+
+TEST(ThreadPool, NestedParallelFor) {
+  ThreadPool pool(1);
+  std::atomic<int> count(0);
+  pool.ParallelFor(0, 8, 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      pool.ParallelFor(0, 100, 1, [&](size_t b, size_t e) {
+        count += static_cast<int>(e - b);
+      });
+    }
+  });
+  EXPECT_EQ(count.load(), 800);
+}
+
+TEST(ThreadPool, ParallelForOwnBlocks) {
+  // Worker busy, the caller runs every block but no unrelated task
+  ThreadPool pool(1);
+  std::promise<void> release;
+  std::shared_future<void> wait = release.get_future().share();
+  auto busy = pool.Enqueue([wait](void) { wait.wait(); });
+  std::atomic<bool> other(false);
+  auto queued = pool.Enqueue([&other](void) { other = true; });
+  std::atomic<int> count(0);
+  pool.ParallelFor(0, 100, 1, [&](size_t begin, size_t end) {
+    count += static_cast<int>(end - begin);
+  });
+  EXPECT_EQ(count.load(), 100);
+  EXPECT_FALSE(other.load());
+  release.set_value();
+  busy.get();
+  queued.get();
+  EXPECT_TRUE(other.load());
+}
+
+TEST(ThreadPool, Exception) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.ParallelFor(0, 100, 1, [](size_t begin, size_t end) {
+    if (begin > 0 && end > begin) {
+      throw std::runtime_error("error");
+    }
+  }), std::runtime_error);
+}
+
+int main(int argc, const char * argv[]) {
+  ::testing::InitGoogleTest(&argc, const_cast<char**>(argv));
+  return RUN_ALL_TESTS();
+}
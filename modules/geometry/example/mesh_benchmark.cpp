@@ -0,0 +1,294 @@
+/**
+ *  @file   mesh_benchmark.cpp
+ *  @brief  Measure mesh loading, connectivity and export throughput
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "oglkit/core/cmd_parser.hpp"
+#include "oglkit/core/string_util.hpp"
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/mesh.hpp"
+
+using Clock = std::chrono::high_resolution_clock;
+using Mesh = OGLKit::Mesh<float>;
+
+/**
+ *  @name LegacyLoadOBJ
+ *  @fn size_t LegacyLoadOBJ(const std::string& path)
+ *  @brief  Reference line based parser (std::getline + std::stringstream),
+ *          used as baseline
+ *  @param[in]  path  Path to the .obj file
+ *  @return Number of vertex read
+ */
+size_t LegacyLoadOBJ(const std::string& path) {
+  std::ifstream stream(path, std::ios_base::in);
+  std::vector<Mesh::Vertex> vertex;
+  std::vector<Mesh::Normal> normal;
+  std::vector<Mesh::TCoord> tcoord;
+  std::vector<Mesh::Triangle> tri;
+  std::string line, key;
+  std::stringstream str_stream;
+  Mesh::Vertex v;
+  Mesh::Normal n;
+  Mesh::TCoord tc;
+  Mesh::Triangle t;
+  while (!stream.eof()) {
+    std::getline(stream, line);
+    if (!line.empty()) {
+      str_stream.str(line);
+      str_stream >> key;
+      if (key == "v") {
+        str_stream >> v;
+        vertex.push_back(v);
+      } else if (key == "vn") {
+        str_stream >> n;
+        normal.push_back(n);
+      } else if (key == "vt") {
+        str_stream >> tc;
+        tcoord.push_back(tc);
+      } else if (key == "f") {
+        str_stream >> t;
+        t -= 1;
+        tri.push_back(t);
+      }
+      str_stream.clear();
+    }
+  }
+  return vertex.size();
+}
+
+/**
+ *  @name LegacyConnectivity
+ *  @fn size_t LegacyConnectivity(const std::vector<Mesh::Triangle>& tri,
+                                  const size_t n_vertex)
+ *  @brief  Reference connectivity, one std::vector per vertex filled with
+ *          push_back, used as baseline
+ *  @param[in]  tri       Triangulation
+ *  @param[in]  n_vertex  Number of vertex
+ *  @return Estimated memory footprint in bytes (16 bytes of allocator
+ *          overhead per row)
+ */
+size_t LegacyConnectivity(const std::vector<Mesh::Triangle>& tri,
+                          const size_t n_vertex) {
+  std::vector<std::vector<int>> con(n_vertex, std::vector<int>(0));
+  for (const auto& t : tri) {
+    const int* c = &t.x_;
+    for (int e = 0; e < 3; ++e) {
+      con[c[e]].push_back(c[(e + 1) % 3]);
+      con[c[e]].push_back(c[(e + 2) % 3]);
+    }
+  }
+  size_t bytes = con.size() * sizeof(std::vector<int>);
+  for (const auto& c : con) {
+    bytes += c.capacity() ? (c.capacity() * sizeof(int)) + 16 : 0;
+  }
+  return bytes;
+}
+
+/**
+ *  @name LegacyNormal
+ *  @fn void LegacyNormal(const Mesh& mesh, std::vector<Mesh::Normal>* normal)
+ *  @brief  Reference angle weighted normals, every face normal is computed
+ *          again at each of its corners, used as baseline
+ *  @param[in]  mesh    Mesh with connectivity
+ *  @param[out] normal  Vertex normals
+ */
+void LegacyNormal(const Mesh& mesh, std::vector<Mesh::Normal>* normal) {
+  const auto& vertex = mesh.get_vertex();
+  const auto& con = mesh.get_vertex_connectivity();
+  normal->resize(vertex.size());
+  for (size_t v = 0; v < vertex.size(); ++v) {
+    const auto conn = con[v];
+    const Mesh::Vertex& A = vertex[v];
+    Mesh::Normal weighted_n;
+    for (size_t j = 0; j < conn.size(); j += 2) {
+      Mesh::Edge AB = vertex[conn[j]] - A;
+      Mesh::Edge AC = vertex[conn[j + 1]] - A;
+      Mesh::Normal n = AB ^ AC;
+      n.Normalize();
+      AB.Normalize();
+      AC.Normalize();
+      weighted_n += n * std::acos(AB * AC);
+    }
+    weighted_n.Normalize();
+    (*normal)[v] = weighted_n;
+  }
+}
+
+/**
+ *  @name FileSize
+ *  @fn double FileSize(const std::string& path)
+ *  @brief  Size of a given file in MB
+ *  @param[in]  path  Path to the file
+ *  @return Size in MB
+ */
+double FileSize(const std::string& path) {
+  std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+  stream.seekg(0, std::ios_base::end);
+  return static_cast<double>(stream.tellg()) / (1024.0 * 1024.0);
+}
+
+int main(const int argc, const char** argv) {
+  // Define argument needed
+  OGLKit::CmdLineParser parser;
+  parser.AddArgument("-i",
+                     OGLKit::CmdLineParser::ArgState::kNeeded,
+                     "Input mesh");
+  parser.AddArgument("-n",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Number of repetition (default 5)");
+  parser.AddArgument("-o",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Output mesh, measure export throughput");
+  // Parse
+  int err = parser.ParseCmdLine(argc, argv);
+  if (!err) {
+    std::string path, rep;
+    parser.HasArgument("-i", &path);
+    int n_rep = 5;
+    // Optional arguments are reported even if not provided, check the value
+    if (parser.HasArgument("-n", &rep) && !rep.empty()) {
+      n_rep = std::max(1, std::stoi(rep));
+    }
+    std::string dir, file, ext;
+    OGLKit::StringUtil::ExtractDirectory(path, &dir, &file, &ext);
+    const double size = FileSize(path);
+    std::cout << path << " : " << size << " MB" << std::endl;
+    std::cout << "Threads : ";
+    std::cout << OGLKit::ThreadPool::Instance().size() + 1 << std::endl;
+    // Baseline
+    if (ext == "obj") {
+      double best = 1e30;
+      for (int i = 0; i < n_rep; ++i) {
+        auto start = Clock::now();
+        LegacyLoadOBJ(path);
+        std::chrono::duration<double> dt = Clock::now() - start;
+        best = std::min(best, dt.count());
+      }
+      std::cout << "stream parser         : " << best * 1e3 << " ms, ";
+      std::cout << size / best << " MB/s" << std::endl;
+    }
+    // Mesh::Load, serial then parallel parsing
+    const char* modes[] = {"Mesh::Load (serial)   : ",
+                           "Mesh::Load (parallel) : "};
+    for (int m = 0; m < 2 && !err; ++m) {
+      double best = 1e30;
+      for (int i = 0; i < n_rep && !err; ++i) {
+        Mesh mesh;
+        mesh.set_parallel_loading(m == 1);
+        auto start = Clock::now();
+        err = mesh.Load(path);
+        std::chrono::duration<double> dt = Clock::now() - start;
+        best = std::min(best, dt.count());
+      }
+      if (!err) {
+        std::cout << modes[m] << best * 1e3 << " ms, ";
+        std::cout << size / best << " MB/s (including post-processing)";
+        std::cout << std::endl;
+      } else {
+        std::cout << "Unable to load : " << path << std::endl;
+      }
+    }
+    // Connectivity, vector of vector vs compressed sparse rows
+    if (!err) {
+      Mesh mesh;
+      mesh.set_post_process(Mesh::kNoPostProcess);
+      err = mesh.Load(path);
+      const auto& tri = mesh.get_triangle();
+      const size_t n_vertex = mesh.get_vertex().size();
+      double best = 1e30;
+      size_t bytes = 0;
+      for (int i = 0; i < n_rep && !err; ++i) {
+        auto start = Clock::now();
+        bytes = LegacyConnectivity(tri, n_vertex);
+        std::chrono::duration<double> dt = Clock::now() - start;
+        best = std::min(best, dt.count());
+      }
+      std::cout << "vector<vector<int>>   : " << best * 1e3 << " ms, ";
+      std::cout << bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+      const char* con_modes[] = {"Connectivity (serial) : ",
+                                 "Connectivity (para.)  : "};
+      for (int m = 0; m < 2 && !err; ++m) {
+        OGLKit::Connectivity con;
+        best = 1e30;
+        for (int i = 0; i < n_rep && !err; ++i) {
+          auto start = Clock::now();
+          err = con.Build(tri, n_vertex, m == 1);
+          std::chrono::duration<double> dt = Clock::now() - start;
+          best = std::min(best, dt.count());
+        }
+        bytes = ((con.get_offset().capacity() + con.get_index().capacity() +
+                  con.get_corner().capacity()) * sizeof(int));
+        std::cout << con_modes[m] << best * 1e3 << " ms, ";
+        std::cout << bytes / (1024.0 * 1024.0) << " MB" << std::endl;
+      }
+    }
+    // Vertex normals, per corner recomputation vs face pass + gather
+    if (!err) {
+      Mesh mesh;
+      err = mesh.Load(path);
+      std::vector<Mesh::Normal> normal;
+      double best = 1e30;
+      for (int i = 0; i < n_rep && !err; ++i) {
+        auto start = Clock::now();
+        LegacyNormal(mesh, &normal);
+        std::chrono::duration<double> dt = Clock::now() - start;
+        best = std::min(best, dt.count());
+      }
+      std::cout << "Normal (per corner)   : " << best * 1e3 << " ms";
+      std::cout << std::endl;
+      const char* w_modes[] = {"Normal (angle)        : ",
+                               "Normal (area)         : ",
+                               "Normal (uniform)      : "};
+      const Mesh::NormalWeighting weighting[] = {Mesh::kAngleWeighting,
+                                                 Mesh::kAreaWeighting,
+                                                 Mesh::kUniformWeighting};
+      for (int m = 0; m < 3 && !err; ++m) {
+        mesh.set_normal_weighting(weighting[m]);
+        best = 1e30;
+        for (int i = 0; i < n_rep; ++i) {
+          auto start = Clock::now();
+          mesh.ComputeVertexNormal();
+          std::chrono::duration<double> dt = Clock::now() - start;
+          best = std::min(best, dt.count());
+        }
+        std::cout << w_modes[m] << best * 1e3 << " ms" << std::endl;
+      }
+    }
+    // Export
+    std::string output;
+    if (!err && parser.HasArgument("-o", &output) && !output.empty()) {
+      Mesh mesh;
+      err = mesh.Load(path);
+      double best = 1e30;
+      for (int i = 0; i < n_rep && !err; ++i) {
+        auto start = Clock::now();
+        err = mesh.Save(output);
+        std::chrono::duration<double> dt = Clock::now() - start;
+        best = std::min(best, dt.count());
+      }
+      if (!err) {
+        const double out_size = FileSize(output);
+        std::cout << "Mesh::Save            : " << best * 1e3 << " ms, ";
+        std::cout << out_size / best << " MB/s" << std::endl;
+      } else {
+        std::cout << "Unable to save : " << output << std::endl;
+      }
+    }
+  } else {
+    std::cout << "Unable to parse cmd line" << std::endl;
+  }
+  return err;
+}
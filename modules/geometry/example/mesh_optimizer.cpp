@@ -0,0 +1,105 @@
+/**
+ *  @file   mesh_optimizer.cpp
+ *  @brief  Reorder the triangles of a mesh for the vertex cache (and
+ *          overdraw), then optionally its vertices for fetch locality.
+ *          Report the cache efficiency before / after
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "oglkit/core/cmd_parser.hpp"
+#include "oglkit/geometry/mesh.hpp"
+#include "oglkit/geometry/mesh_optimizer.hpp"
+
+using Clock = std::chrono::high_resolution_clock;
+using Mesh = OGLKit::Mesh<float>;
+using MeshOptimizer = OGLKit::MeshOptimizer<float>;
+
+int main(const int argc, const char** argv) {
+  // Define argument needed
+  OGLKit::CmdLineParser parser;
+  parser.AddArgument("-i",
+                     OGLKit::CmdLineParser::ArgState::kNeeded,
+                     "Input mesh");
+  parser.AddArgument("-o",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Output mesh (any supported format)");
+  parser.AddArgument("-d",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Sort clusters to reduce overdraw, 0 or 1 (default 1)");
+  parser.AddArgument("-v",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Vertex order: first, morton or hilbert (default none)");
+  // Parse
+  int err = parser.ParseCmdLine(argc, argv);
+  if (!err) {
+    std::string path, output, overdraw, order;
+    parser.HasArgument("-i", &path);
+    // Geometry is kept as is, only the triangle order changes
+    Mesh mesh;
+    mesh.set_post_process(Mesh::kNoPostProcess);
+    err = mesh.Load(path);
+    if (!err) {
+      const bool sort = !(parser.HasArgument("-d", &overdraw) &&
+                          overdraw == "0");
+      const Mesh& source = mesh;
+      MeshOptimizer::Report report;
+      auto start = Clock::now();
+      {
+        auto edit = mesh.Edit();
+        err = MeshOptimizer::Optimize(source.get_vertex(),
+                                      sort,
+                                      &edit.triangle(),
+                                      &report);
+      }
+      std::chrono::duration<double> dt = Clock::now() - start;
+      if (!err) {
+        std::cout << "Triangles : " << source.get_triangle().size();
+        std::cout << ", cache size : " << MeshOptimizer::kCacheSize;
+        std::cout << std::endl;
+        std::cout << "Before    : ACMR " << report.before.acmr << ", ATVR ";
+        std::cout << report.before.atvr << std::endl;
+        std::cout << "After     : ACMR " << report.after.acmr << ", ATVR ";
+        std::cout << report.after.atvr << ", " << report.n_cluster;
+        std::cout << " clusters" << std::endl;
+        std::cout << "Time      : " << dt.count() * 1e3 << " ms" << std::endl;
+      } else {
+        std::cout << "Invalid triangulation : " << path << std::endl;
+      }
+    } else {
+      std::cout << "Unable to load : " << path << std::endl;
+    }
+    if (!err && parser.HasArgument("-v", &order) && !order.empty()) {
+      Mesh::VertexOrder vertex_order = Mesh::kFirstUseOrder;
+      if (order == "morton") {
+        vertex_order = Mesh::kMortonOrder;
+      } else if (order == "hilbert") {
+        vertex_order = Mesh::kHilbertOrder;
+      }
+      auto start = Clock::now();
+      err = mesh.ReorderVertex(vertex_order);
+      std::chrono::duration<double> dt = Clock::now() - start;
+      if (!err) {
+        std::cout << "Vertices  : " << order << " order, " << dt.count() * 1e3;
+        std::cout << " ms" << std::endl;
+      } else {
+        std::cout << "Invalid triangulation : " << path << std::endl;
+      }
+    }
+    if (!err && parser.HasArgument("-o", &output) && !output.empty()) {
+      err = mesh.Save(output);
+      if (err) {
+        std::cout << "Unable to save : " << output << std::endl;
+      }
+    }
+  } else {
+    std::cout << "Unable to parse cmd line" << std::endl;
+  }
+  return err;
+}
@@ -0,0 +1,116 @@
+/**
+ *  @file   mesh_simplifier.cpp
+ *  @brief  Decimate a mesh into a chain of LODs, report triangle count and
+ *          error of each level
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "oglkit/core/cmd_parser.hpp"
+#include "oglkit/geometry/mesh.hpp"
+#include "oglkit/geometry/mesh_simplifier.hpp"
+
+using Clock = std::chrono::high_resolution_clock;
+using Mesh = OGLKit::Mesh<float>;
+using MeshSimplifier = OGLKit::MeshSimplifier<float>;
+
+int main(const int argc, const char** argv) {
+  // Define argument needed
+  OGLKit::CmdLineParser parser;
+  parser.AddArgument("-i",
+                     OGLKit::CmdLineParser::ArgState::kNeeded,
+                     "Input mesh");
+  parser.AddArgument("-o",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Output coarsest level (any supported format)");
+  parser.AddArgument("-n",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Number of level (default 3)");
+  parser.AddArgument("-r",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Triangle ratio between two levels (default 0.25)");
+  parser.AddArgument("-e",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Maximum relative error (default 0.01)");
+  parser.AddArgument("-b",
+                     OGLKit::CmdLineParser::ArgState::kOptional,
+                     "Lock open borders, 0 or 1 (default 0)");
+  // Parse
+  int err = parser.ParseCmdLine(argc, argv);
+  if (!err) {
+    std::string path, output, arg;
+    parser.HasArgument("-i", &path);
+    int n_level = 3;
+    float ratio = 0.25f;
+    float max_error = 0.01f;
+    bool lock = false;
+    if (parser.HasArgument("-n", &arg) && !arg.empty()) {
+      n_level = std::max(1, std::stoi(arg));
+    }
+    if (parser.HasArgument("-r", &arg) && !arg.empty()) {
+      ratio = std::stof(arg);
+    }
+    if (parser.HasArgument("-e", &arg) && !arg.empty()) {
+      max_error = std::stof(arg);
+    }
+    if (parser.HasArgument("-b", &arg) && !arg.empty()) {
+      lock = arg == "1";
+    }
+    Mesh mesh;
+    mesh.set_post_process(Mesh::kNoPostProcess);
+    err = mesh.Load(path);
+    if (!err) {
+      const Mesh& source = mesh;
+      std::vector<MeshSimplifier::Level> level;
+      float n_tri = static_cast<float>(source.get_triangle().size());
+      for (int l = 0; l < n_level; ++l) {
+        n_tri *= ratio;
+        level.push_back(MeshSimplifier::Level(static_cast<size_t>(n_tri),
+                                              max_error));
+      }
+      std::vector<MeshSimplifier::LOD> lod;
+      auto start = Clock::now();
+      err = MeshSimplifier::BuildLOD(source.get_vertex(),
+                                     source.get_triangle(),
+                                     level,
+                                     lock,
+                                     &lod);
+      std::chrono::duration<double> dt = Clock::now() - start;
+      if (!err) {
+        std::cout << "Triangles : " << source.get_triangle().size();
+        std::cout << std::endl;
+        for (size_t l = 0; l < lod.size(); ++l) {
+          std::cout << "LOD " << l + 1 << "     : " << lod[l].tri.size();
+          std::cout << " triangles (target " << level[l].n_tri << "), error ";
+          std::cout << lod[l].error << std::endl;
+        }
+        std::cout << "Time      : " << dt.count() * 1e3 << " ms" << std::endl;
+        if (parser.HasArgument("-o", &output) && !output.empty()) {
+          // Stand-alone mesh, unused vertices removed
+          mesh.Edit().triangle().swap(lod.back().tri);
+          err = mesh.RemoveUnusedVertex();
+          if (!err) {
+            err = mesh.Save(output);
+          }
+          if (err) {
+            std::cout << "Unable to save : " << output << std::endl;
+          }
+        }
+      } else {
+        std::cout << "Invalid triangulation : " << path << std::endl;
+      }
+    } else {
+      std::cout << "Unable to load : " << path << std::endl;
+    }
+  } else {
+    std::cout << "Unable to parse cmd line" << std::endl;
+  }
+  return err;
+}
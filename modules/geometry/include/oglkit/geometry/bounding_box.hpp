@@ -0,0 +1,135 @@
+/**
+ *  @file   bounding_box.hpp
+ *  @brief  Vectorized min / max reduction computing the bounding box of a
+ *          set of vertices
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_BOUNDING_BOX__
+#define __OGLKIT_BOUNDING_BOX__
+
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+#include "oglkit/geometry/aabb.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  BoundingBox
+ *  @brief  Bounding box of vertex arrays or of subsets of them (index lists,
+ *          triangle ranges). Positions are reduced as a flat stream of
+ *          scalars with AVX, SSE2 or NEON depending on the instruction set
+ *          the library is built for, scalar otherwise. Large inputs are
+ *          split across the thread pool.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ *  @tparam T Data type
+ */
+template<typename T>
+class OGLKIT_EXPORTS BoundingBox {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Vertex */
+  using Vertex = OGLKit::Vector3<T>;
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /** Minimum number of vertex (or index) handled by a thread */
+  static const size_t kBlockSize;
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name InstructionSet
+   *  @fn static const char* InstructionSet(void)
+   *  @brief  Instruction set used by the reduction
+   *  @return "AVX", "SSE2", "NEON" or "Scalar"
+   */
+  static const char* InstructionSet(void);
+
+  /**
+   *  @name Empty
+   *  @fn static AABB<T> Empty(void)
+   *  @brief  Box containing nothing, neutral element of the union
+   *  @return Empty box
+   */
+  static AABB<T> Empty(void);
+
+  /**
+   *  @name Extend
+   *  @fn static void Extend(const Vertex* vertex, const size_t n,
+                             AABB<T>* bbox)
+   *  @brief  Extend a box with n contiguous vertices on the calling thread
+   *          (i.e. from within an already parallel loop). The center is not
+   *          updated.
+   *  @param[in]      vertex  Vertices
+   *  @param[in]      n       Number of vertex
+   *  @param[in,out]  bbox    Box to extend
+   */
+  static void Extend(const Vertex* vertex, const size_t n, AABB<T>* bbox);
+
+  /**
+   *  @name Compute
+   *  @fn static void Compute(const std::vector<Vertex>& vertex,
+                              AABB<T>* bbox)
+   *  @brief  Compute the box of every vertex, empty if there is none
+   *  @param[in]  vertex  Vertices
+   *  @param[out] bbox    Bounding box
+   */
+  static void Compute(const std::vector<Vertex>& vertex, AABB<T>* bbox);
+
+  /**
+   *  @name Compute
+   *  @fn static int Compute(const std::vector<Vertex>& vertex,
+                             const std::vector<int>& index,
+                             AABB<T>* bbox)
+   *  @brief  Compute the box of a subset of the vertices
+   *  @param[in]  vertex  Vertices
+   *  @param[in]  index   Index of the vertices to include, repetition allowed
+   *  @param[out] bbox    Bounding box
+   *  @return -1 if an index is out of range, 0 otherwise
+   */
+  static int Compute(const std::vector<Vertex>& vertex,
+                     const std::vector<int>& index,
+                     AABB<T>* bbox);
+
+  /**
+   *  @name Compute
+   *  @fn static int Compute(const std::vector<Vertex>& vertex,
+                             const std::vector<Triangle>& tri,
+                             const size_t first_tri,
+                             const size_t n_tri,
+                             AABB<T>* bbox)
+   *  @brief  Compute the box of the vertices used by a range of triangles
+   *          (i.e. a cluster)
+   *  @param[in]  vertex    Vertices
+   *  @param[in]  tri       Triangles
+   *  @param[in]  first_tri First triangle of the range
+   *  @param[in]  n_tri     Number of triangle in the range
+   *  @param[out] bbox      Bounding box
+   *  @return -1 if the range or a corner is out of range, 0 otherwise
+   */
+  static int Compute(const std::vector<Vertex>& vertex,
+                     const std::vector<Triangle>& tri,
+                     const size_t first_tri,
+                     const size_t n_tri,
+                     AABB<T>* bbox);
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_BOUNDING_BOX__ */
@@ -0,0 +1,227 @@
+/**
+ *  @file   connectivity.hpp
+ *  @brief  Vertex connectivity stored as compressed sparse rows
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_CONNECTIVITY__
+#define __OGLKIT_CONNECTIVITY__
+
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  Connectivity
+ *  @brief  Vertex connectivity in compressed sparse row layout. For each
+ *          triangle sharing a vertex, the row of that vertex holds the two
+ *          other corners (in winding order), rows are ordered by triangle.
+ *          Row i spans index[offset[i]] ... index[offset[i + 1] - 1], the
+ *          whole structure lives in a few arrays instead of one heap
+ *          allocation per vertex. The corner (3 * triangle + k) each pair
+ *          comes from is kept alongside, giving vertex / face incidence.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ */
+class OGLKIT_EXPORTS Connectivity {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /**
+   *  @struct Row
+   *  @brief  View on the neighbours of a vertex
+   */
+  struct Row {
+    /** First neighbour */
+    const int* first;
+    /** Past the last neighbour */
+    const int* last;
+    /** Corner of each pair of neighbour, pair j comes from corner[j / 2] */
+    const int* corner;
+
+    /** First neighbour */
+    const int* begin(void) const {
+      return first;
+    }
+    /** Past the last neighbour */
+    const int* end(void) const {
+      return last;
+    }
+    /** Number of neighbour, twice the number of triangle */
+    size_t size(void) const {
+      return static_cast<size_t>(last - first);
+    }
+    /** Check if the vertex is isolated */
+    bool empty(void) const {
+      return first == last;
+    }
+    /** Access a given neighbour */
+    int operator[](const size_t i) const {
+      return first[i];
+    }
+  };
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name Connectivity
+   *  @fn Connectivity(void)
+   *  @brief  Constructor
+   */
+  Connectivity(void) = default;
+
+  /**
+   *  @name Build
+   *  @fn int Build(const std::vector<Triangle>& tri, const size_t n_vertex,
+                    const bool parallel)
+   *  @brief  Build the connectivity of a triangulation: count, prefix sum
+   *          then fill. When run in parallel, each task handles a range of
+   *          triangles and rows are sorted by corner afterwards, the result
+   *          is identical to the serial one.
+   *  @param[in]  tri       Triangulation
+   *  @param[in]  n_vertex  Number of vertex
+   *  @param[in]  parallel  Use the library's thread pool
+   *  @return -1 if a triangle is out of range or the triangulation is too
+   *          large to be indexed with int, 0 otherwise
+   */
+  int Build(const std::vector<Triangle>& tri,
+            const size_t n_vertex,
+            const bool parallel);
+
+  /**
+   *  @name Clear
+   *  @fn void Clear(void)
+   *  @brief  Release the connectivity
+   */
+  void Clear(void);
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name size
+   *  @fn size_t size(void) const
+   *  @brief  Number of vertex
+   *  @return Number of row
+   */
+  size_t size(void) const {
+    return offset_.empty() ? 0 : offset_.size() - 1;
+  }
+
+  /**
+   *  @name empty
+   *  @fn bool empty(void) const
+   *  @brief  Check if the connectivity is built
+   *  @return True if there is no row
+   */
+  bool empty(void) const {
+    return offset_.size() < 2;
+  }
+
+  /**
+   *  @name operator[]
+   *  @fn Row operator[](const size_t i) const
+   *  @brief  Neighbours of a given vertex
+   *  @param[in]  i Vertex's index
+   *  @return Row
+   */
+  Row operator[](const size_t i) const {
+    const int* idx = index_.data();
+    Row row = {idx + offset_[i], idx + offset_[i + 1],
+               corner_.data() + (offset_[i] / 2)};
+    return row;
+  }
+
+  /**
+   *  @name get_offset
+   *  @fn const std::vector<int>& get_offset(void) const
+   *  @brief  Rows' offset, size + 1 entries
+   *  @return Offset array
+   */
+  const std::vector<int>& get_offset(void) const {
+    return offset_;
+  }
+
+  /**
+   *  @name get_offset
+   *  @fn std::vector<int>& get_offset(void)
+   *  @brief  Rows' offset, size + 1 entries
+   *  @return Offset array
+   */
+  std::vector<int>& get_offset(void) {
+    return offset_;
+  }
+
+  /**
+   *  @name get_index
+   *  @fn const std::vector<int>& get_index(void) const
+   *  @brief  Neighbours of every vertex, row after row
+   *  @return Index array
+   */
+  const std::vector<int>& get_index(void) const {
+    return index_;
+  }
+
+  /**
+   *  @name get_index
+   *  @fn std::vector<int>& get_index(void)
+   *  @brief  Neighbours of every vertex, row after row
+   *  @return Index array
+   */
+  std::vector<int>& get_index(void) {
+    return index_;
+  }
+
+  /**
+   *  @name get_corner
+   *  @fn const std::vector<int>& get_corner(void) const
+   *  @brief  Corner (3 * triangle + k) of each pair of neighbour, row after
+   *          row. Half the size of the index array.
+   *  @return Corner array
+   */
+  const std::vector<int>& get_corner(void) const {
+    return corner_;
+  }
+
+  /**
+   *  @name get_corner
+   *  @fn std::vector<int>& get_corner(void)
+   *  @brief  Corner (3 * triangle + k) of each pair of neighbour, row after
+   *          row. Half the size of the index array.
+   *  @return Corner array
+   */
+  std::vector<int>& get_corner(void) {
+    return corner_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+  /** Rows' offset */
+  std::vector<int> offset_;
+  /** Neighbours */
+  std::vector<int> index_;
+  /** Corner of each pair of neighbour */
+  std::vector<int> corner_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_CONNECTIVITY__ */
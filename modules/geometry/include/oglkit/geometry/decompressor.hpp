@@ -0,0 +1,243 @@
+/**
+ *  @file   decompressor.hpp
+ *  @brief  Background decompression of gzip / zstd buffers
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_DECOMPRESSOR__
+#define __OGLKIT_DECOMPRESSOR__
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  Decompressor
+ *  @brief  Inflate a compressed buffer on a dedicated thread into a
+ *          contiguous output. Consumers can start working on the data already
+ *          produced while the remaining part is being decompressed.
+ *          The output is preallocated from the size stored in the stream (gzip
+ *          trailer, zstd frame header), therefore data() stays valid while
+ *          decompressing. If the estimation is too small the output is
+ *          reallocated once everything is inflated, within Wait()/Finish(),
+ *          hence consumers must only keep offsets between two calls.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ */
+class OGLKIT_EXPORTS Decompressor {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /**
+   *  @enum Codec
+   *  @brief  Supported compression format
+   */
+  enum Codec {
+    /** Not compressed */
+    kNone,
+    /** gzip stream (possibly multiple members) */
+    kGzip,
+    /** Zstandard frame */
+    kZstd
+  };
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name Decompressor
+   *  @fn Decompressor(void)
+   *  @brief  Constructor
+   */
+  Decompressor(void);
+
+  /**
+   *  @name Decompressor
+   *  @fn Decompressor(const Decompressor& other) = delete
+   *  @brief  Copy constructor
+   */
+  Decompressor(const Decompressor& other) = delete;
+
+  /**
+   *  @name operator=
+   *  @fn Decompressor& operator=(const Decompressor& rhs) = delete
+   *  @brief  Assignment operator
+   */
+  Decompressor& operator=(const Decompressor& rhs) = delete;
+
+  /**
+   *  @name ~Decompressor
+   *  @fn ~Decompressor(void)
+   *  @brief  Destructor, stop the decompression if still running
+   */
+  ~Decompressor(void);
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name DetectCodec
+   *  @fn static Codec DetectCodec(const char* data, const size_t size)
+   *  @brief  Identify the compression format from the magic bytes
+   *  @param[in]  data  Beginning of the buffer
+   *  @param[in]  size  Buffer's size
+   *  @return Compression format, kNone if not compressed (or not supported)
+   */
+  static Codec DetectCodec(const char* data, const size_t size);
+
+  /**
+   *  @name Open
+   *  @fn int Open(const char* data, const size_t size)
+   *  @brief  Start the decompression of a given buffer. The buffer must stay
+   *          alive until Finish() or Close() returns.
+   *  @param[in]  data  Compressed data
+   *  @param[in]  size  Compressed size
+   *  @return -1 if the buffer is not compressed with a supported codec,
+   *          0 otherwise
+   */
+  int Open(const char* data, const size_t size);
+
+  /**
+   *  @name Wait
+   *  @fn size_t Wait(const size_t n)
+   *  @brief  Block until at least \p n bytes are decompressed or the end of
+   *          the stream is reached
+   *  @param[in]  n Number of byte needed
+   *  @return Number of byte available, smaller than \p n only at the end of
+   *          the stream
+   */
+  size_t Wait(const size_t n);
+
+  /**
+   *  @name Finish
+   *  @fn int Finish(void)
+   *  @brief  Wait until the whole stream is decompressed
+   *  @return -1 if the stream is corrupted or truncated, 0 otherwise
+   */
+  int Finish(void);
+
+  /**
+   *  @name Close
+   *  @fn void Close(void)
+   *  @brief  Stop decompressing and release the output
+   */
+  void Close(void);
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name data
+   *  @fn const char* data(void) const
+   *  @brief  Decompressed data, valid up to the value returned by Wait()
+   *  @return Pointer to the first decompressed byte
+   */
+  const char* data(void) const {
+    return buffer_.get();
+  }
+
+  /**
+   *  @name codec
+   *  @fn Codec codec(void) const
+   *  @brief  Compression format of the opened stream
+   *  @return Codec
+   */
+  Codec codec(void) const {
+    return codec_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+
+  /**
+   *  @name Run
+   *  @fn void Run(void)
+   *  @brief  Decompression loop, executed on the worker thread
+   */
+  void Run(void);
+
+  /**
+   *  @name InflateGzip
+   *  @fn int InflateGzip(void)
+   *  @brief  Decompress gzip members (zlib)
+   *  @return -1 if error, 0 otherwise
+   */
+  int InflateGzip(void);
+
+  /**
+   *  @name InflateZstd
+   *  @fn int InflateZstd(void)
+   *  @brief  Decompress zstd frames
+   *  @return -1 if error (or not supported), 0 otherwise
+   */
+  int InflateZstd(void);
+
+  /**
+   *  @name Output
+   *  @fn char* Output(size_t* n)
+   *  @brief  Provide where to write the next decompressed bytes
+   *  @param[out] n Space available at the returned location
+   *  @return Output location
+   */
+  char* Output(size_t* n);
+
+  /**
+   *  @name Produced
+   *  @fn bool Produced(const size_t n)
+   *  @brief  Publish freshly decompressed bytes
+   *  @param[in]  n Number of byte written at the last Output() location
+   *  @return False if the decompression has been cancelled
+   */
+  bool Produced(const size_t n);
+
+  /** Compressed data */
+  const char* input_;
+  /** Compressed size */
+  size_t input_size_;
+  /** Compression format */
+  Codec codec_;
+  /** Decompressed data */
+  std::unique_ptr<char[]> buffer_;
+  /** Preallocated size of buffer_ */
+  size_t capacity_;
+  /** Bytes written beyond the estimated size */
+  std::vector<char> overflow_;
+  /** Bytes written so far (buffer_ then overflow_) */
+  size_t written_;
+  /** Bytes published to consumers */
+  size_t available_;
+  /** Indicate the end of the stream is reached */
+  bool done_;
+  /** Decompression error */
+  int error_;
+  /** Cancellation flag */
+  std::atomic<bool> stop_;
+  /** Synchronization */
+  std::mutex mutex_;
+  /** Progress notification */
+  std::condition_variable cond_;
+  /** Worker */
+  std::thread worker_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_DECOMPRESSOR__ */
@@ -0,0 +1,281 @@
+/**
+ *  @file   gltf.hpp
+ *  @brief  glTF 2.0 asset reader (.gltf + .bin, .glb)
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_GLTF__
+#define __OGLKIT_GLTF__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/json.hpp"
+#include "oglkit/core/memory_map.hpp"
+#include "oglkit/geometry/mesh.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  GLTFAsset
+ *  @brief  glTF 2.0 asset. Binary buffers (.bin files or the .glb BIN chunk)
+ *          are memory mapped and accessors point straight into them.
+ *          Triangle primitives are listed while walking the default scene's
+ *          node hierarchy, the same way OGLModel walks an Assimp scene (node
+ *          transformations are not applied).
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ */
+class OGLKIT_EXPORTS GLTFAsset {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /**
+   *  @enum ComponentType
+   *  @brief  Accessor's component type
+   */
+  enum ComponentType {
+    /** int8 */
+    kByte = 5120,
+    /** uint8 */
+    kUByte = 5121,
+    /** int16 */
+    kShort = 5122,
+    /** uint16 */
+    kUShort = 5123,
+    /** uint32 */
+    kUInt = 5125,
+    /** float */
+    kFloat = 5126
+  };
+
+  /**
+   *  @enum Mode
+   *  @brief  Primitive topology supported
+   */
+  enum Mode {
+    /** Triangle list */
+    kTriangles = 4,
+    /** Triangle strip */
+    kTriangleStrip = 5,
+    /** Triangle fan */
+    kTriangleFan = 6
+  };
+
+  /**
+   *  @struct Accessor
+   *  @brief  Typed view on a binary buffer
+   */
+  struct Accessor {
+    /** First element */
+    const char* data;
+    /** Number of element */
+    size_t count;
+    /** Distance in bytes between two elements */
+    size_t stride;
+    /** Component type, ComponentType */
+    int component_type;
+    /** Number of component per element (i.e. 3 for VEC3) */
+    int n_component;
+    /** Integer components are mapped to [0, 1] / [-1, 1] */
+    bool normalized;
+  };
+
+  /**
+   *  @struct Primitive
+   *  @brief  Geometry to be drawn, attributes are accessor indices or -1
+   *          if not present
+   */
+  struct Primitive {
+    /** POSITION */
+    int position;
+    /** NORMAL */
+    int normal;
+    /** TEXCOORD_0 */
+    int tcoord;
+    /** TANGENT */
+    int tangent;
+    /** COLOR_0 */
+    int color;
+    /** Indices */
+    int indices;
+    /** Topology, Mode */
+    int mode;
+    /** Index of the glTF mesh holding this primitive */
+    int mesh;
+    /** Path to the base color texture, empty if none (or embedded) */
+    std::string texture;
+  };
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name GLTFAsset
+   *  @fn GLTFAsset(void)
+   *  @brief  Constructor
+   */
+  GLTFAsset(void);
+
+  /**
+   *  @name GLTFAsset
+   *  @fn GLTFAsset(const GLTFAsset& other) = delete
+   *  @brief  Copy constructor
+   */
+  GLTFAsset(const GLTFAsset& other) = delete;
+
+  /**
+   *  @name operator=
+   *  @fn GLTFAsset& operator=(const GLTFAsset& rhs) = delete
+   *  @brief  Assignment operator
+   */
+  GLTFAsset& operator=(const GLTFAsset& rhs) = delete;
+
+  /**
+   *  @name ~GLTFAsset
+   *  @fn ~GLTFAsset(void)
+   *  @brief  Destructor
+   */
+  ~GLTFAsset(void) = default;
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name Load
+   *  @fn int Load(const std::string& path)
+   *  @brief  Load a .gltf or .glb file, external buffers are resolved
+   *          relative to the file's directory
+   *  @param[in]  path  Path to the asset
+   *  @return -1 if error, 0 otherwise
+   */
+  int Load(const std::string& path);
+
+  /**
+   *  @name Load
+   *  @fn int Load(const char* data, const size_t size,
+                   const std::string& directory)
+   *  @brief  Load an asset from a buffer holding a .gltf or .glb file. The
+   *          buffer must stay alive as long as the asset is used.
+   *  @param[in]  data      Buffer
+   *  @param[in]  size      Buffer's size
+   *  @param[in]  directory Folder where external buffers are located
+   *  @return -1 if error, 0 otherwise
+   */
+  int Load(const char* data, const size_t size, const std::string& directory);
+
+  /**
+   *  @name GetAccessor
+   *  @fn int GetAccessor(const int index, Accessor* accessor) const
+   *  @brief  Resolve an accessor and check it lies within its buffer
+   *  @param[in]  index     Accessor's index
+   *  @param[out] accessor  Resolved accessor
+   *  @return -1 if invalid or not supported (i.e. sparse), 0 otherwise
+   */
+  int GetAccessor(const int index, Accessor* accessor) const;
+
+  /**
+   *  @name GetBounds
+   *  @fn int GetBounds(const int index, AABB<T>* bbox) const
+   *  @brief  Bounding box stored in an accessor (min / max), required for
+   *          POSITION
+   *  @param[in]  index Accessor's index
+   *  @param[out] bbox  Bounding box
+   *  @return -1 if not available, 0 otherwise
+   */
+  template<typename T>
+  int GetBounds(const int index, AABB<T>* bbox) const;
+
+  /**
+   *  @name Extract
+   *  @fn int Extract(const size_t i, Mesh<T>* mesh) const
+   *  @brief  Copy a primitive into a mesh. Attributes stored as tightly
+   *          packed floats matching the mesh's layout are copied in one go
+   *          from the mapped buffer, others are converted element-wise.
+   *          Strips and fans are converted to triangle lists.
+   *  @param[in]  i     Primitive's index
+   *  @param[out] mesh  Mesh where to copy (attributes are replaced)
+   *  @return -1 if error, 0 otherwise
+   */
+  template<typename T>
+  int Extract(const size_t i, Mesh<T>* mesh) const;
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name get_primitive
+   *  @fn const std::vector<Primitive>& get_primitive(void) const
+   *  @brief  Triangle primitives of the default scene
+   *  @return Primitives
+   */
+  const std::vector<Primitive>& get_primitive(void) const {
+    return primitive_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+
+  /**
+   *  @struct Buffer
+   *  @brief  Binary buffer's content
+   */
+  struct Buffer {
+    /** First byte */
+    const char* data;
+    /** Size in bytes */
+    size_t size;
+  };
+
+  /**
+   *  @name LoadBuffers
+   *  @fn int LoadBuffers(const char* bin, const size_t bin_size,
+                          const std::string& directory)
+   *  @brief  Map every buffer, either from external files, base64 data uri
+   *          or the .glb BIN chunk
+   *  @param[in]  bin       .glb BIN chunk, nullptr if none
+   *  @param[in]  bin_size  Size of the BIN chunk
+   *  @param[in]  directory Folder where external buffers are located
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadBuffers(const char* bin,
+                  const size_t bin_size,
+                  const std::string& directory);
+
+  /**
+   *  @name ListPrimitives
+   *  @fn int ListPrimitives(const std::string& directory)
+   *  @brief  Walk the default scene and gather its triangle primitives
+   *  @param[in]  directory Folder where textures are located
+   *  @return -1 if error, 0 otherwise
+   */
+  int ListPrimitives(const std::string& directory);
+
+  /** Parsed JSON document */
+  JSONValue json_;
+  /** Mapped files (.glb or external buffers) */
+  std::vector<std::unique_ptr<MemoryMap>> file_;
+  /** Decoded data uri */
+  std::vector<std::vector<char>> decoded_;
+  /** Buffers */
+  std::vector<Buffer> buffer_;
+  /** Triangle primitives */
+  std::vector<Primitive> primitive_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_GLTF__ */
@@ -0,0 +1,273 @@
+/**
+ *  @file   half_edge.hpp
+ *  @brief  Index based half-edge connectivity
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_HALF_EDGE__
+#define __OGLKIT_HALF_EDGE__
+
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  HalfEdge
+ *  @brief  Half-edge connectivity of a triangulation. Half-edges are implicit:
+ *          h = 3 * f + k goes from corner k to corner k + 1 of triangle f,
+ *          therefore face / next / previous are arithmetic. Only the twin
+ *          (opposite half-edge), the origin and one outgoing half-edge per
+ *          vertex are stored.
+ *          Edges shared by more than two triangles, or by two triangles with
+ *          inconsistent orientation, are non-manifold: they are reported and
+ *          treated as boundaries.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ */
+class OGLKIT_EXPORTS HalfEdge {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name HalfEdge
+   *  @fn HalfEdge(void)
+   *  @brief  Constructor
+   */
+  HalfEdge(void) = default;
+
+  /**
+   *  @name Build
+   *  @fn int Build(const std::vector<Triangle>& tri, const size_t n_vertex,
+                    const bool parallel)
+   *  @brief  Build the half-edges of a triangulation. Half-edges are bucketed
+   *          by their smallest end point (count, prefix sum, fill) and twins
+   *          are matched within each bucket, no global sort nor hashing
+   *          involved. The result does not depend on \p parallel.
+   *  @param[in]  tri       Triangulation
+   *  @param[in]  n_vertex  Number of vertex
+   *  @param[in]  parallel  Use the library's thread pool
+   *  @return -1 if a triangle is out of range or the triangulation is too
+   *          large to be indexed with int, 0 otherwise
+   */
+  int Build(const std::vector<Triangle>& tri,
+            const size_t n_vertex,
+            const bool parallel);
+
+  /**
+   *  @name Clear
+   *  @fn void Clear(void)
+   *  @brief  Release the structure
+   */
+  void Clear(void);
+
+#pragma mark -
+#pragma mark Navigation
+
+  /**
+   *  @name Face
+   *  @fn static int Face(const int h)
+   *  @brief  Triangle holding a half-edge
+   *  @param[in]  h Half-edge
+   *  @return Triangle's index
+   */
+  static int Face(const int h) {
+    return h / 3;
+  }
+
+  /**
+   *  @name Next
+   *  @fn static int Next(const int h)
+   *  @brief  Next half-edge within the same triangle
+   *  @param[in]  h Half-edge
+   *  @return Next half-edge
+   */
+  static int Next(const int h) {
+    return h % 3 == 2 ? h - 2 : h + 1;
+  }
+
+  /**
+   *  @name Prev
+   *  @fn static int Prev(const int h)
+   *  @brief  Previous half-edge within the same triangle
+   *  @param[in]  h Half-edge
+   *  @return Previous half-edge
+   */
+  static int Prev(const int h) {
+    return h % 3 == 0 ? h + 2 : h - 1;
+  }
+
+  /**
+   *  @name Twin
+   *  @fn int Twin(const int h) const
+   *  @brief  Opposite half-edge
+   *  @param[in]  h Half-edge
+   *  @return Opposite half-edge, -1 on boundary (or non-manifold edge)
+   */
+  int Twin(const int h) const {
+    return twin_[h];
+  }
+
+  /**
+   *  @name Origin
+   *  @fn int Origin(const int h) const
+   *  @brief  Vertex a half-edge starts from
+   *  @param[in]  h Half-edge
+   *  @return Vertex's index
+   */
+  int Origin(const int h) const {
+    return origin_[h];
+  }
+
+  /**
+   *  @name Target
+   *  @fn int Target(const int h) const
+   *  @brief  Vertex a half-edge points to
+   *  @param[in]  h Half-edge
+   *  @return Vertex's index
+   */
+  int Target(const int h) const {
+    return origin_[Next(h)];
+  }
+
+  /**
+   *  @name OppositeFace
+   *  @fn int OppositeFace(const int h) const
+   *  @brief  Triangle on the other side of a half-edge
+   *  @param[in]  h Half-edge
+   *  @return Triangle's index, -1 on boundary
+   */
+  int OppositeFace(const int h) const {
+    return twin_[h] < 0 ? -1 : Face(twin_[h]);
+  }
+
+  /**
+   *  @name Outgoing
+   *  @fn int Outgoing(const int v) const
+   *  @brief  Half-edge leaving a vertex, the boundary one for boundary
+   *          vertices so that rotating with NextOutgoing() covers the whole
+   *          fan
+   *  @param[in]  v Vertex's index
+   *  @return Half-edge, -1 for isolated vertex
+   */
+  int Outgoing(const int v) const {
+    return out_[v];
+  }
+
+  /**
+   *  @name NextOutgoing
+   *  @fn int NextOutgoing(const int h) const
+   *  @brief  Rotate around the origin of a half-edge
+   *  @param[in]  h Half-edge leaving a vertex
+   *  @return Next half-edge leaving the same vertex, -1 when reaching a
+   *          boundary
+   */
+  int NextOutgoing(const int h) const {
+    return twin_[Prev(h)];
+  }
+
+  /**
+   *  @name IsBoundaryVertex
+   *  @fn bool IsBoundaryVertex(const int v) const
+   *  @brief  Check if a vertex lies on a boundary (or is isolated)
+   *  @param[in]  v Vertex's index
+   *  @return True if on boundary
+   */
+  bool IsBoundaryVertex(const int v) const {
+    return out_[v] < 0 || twin_[out_[v]] < 0;
+  }
+
+  /**
+   *  @name OneRing
+   *  @fn void OneRing(const int v, std::vector<int>* ring) const
+   *  @brief  Neighbours of a vertex, in rotation order
+   *  @param[in]  v     Vertex's index
+   *  @param[out] ring  Neighbouring vertices
+   */
+  void OneRing(const int v, std::vector<int>* ring) const;
+
+  /**
+   *  @name BoundaryLoops
+   *  @fn void BoundaryLoops(std::vector<std::vector<int>>* loops) const
+   *  @brief  Gather the boundary loops
+   *  @param[out] loops For each loop, its half-edges in walking order
+   */
+  void BoundaryLoops(std::vector<std::vector<int>>* loops) const;
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name size
+   *  @fn size_t size(void) const
+   *  @brief  Number of half-edge
+   *  @return Three times the number of triangle
+   */
+  size_t size(void) const {
+    return twin_.size();
+  }
+
+  /**
+   *  @name empty
+   *  @fn bool empty(void) const
+   *  @brief  Check if the structure is built
+   *  @return True if there is no vertex
+   */
+  bool empty(void) const {
+    return out_.empty();
+  }
+
+  /**
+   *  @name n_vertex
+   *  @fn size_t n_vertex(void) const
+   *  @brief  Number of vertex
+   *  @return Number of vertex
+   */
+  size_t n_vertex(void) const {
+    return out_.size();
+  }
+
+  /**
+   *  @name get_non_manifold_edge
+   *  @fn const std::vector<int>& get_non_manifold_edge(void) const
+   *  @brief  Half-edges lying on non-manifold edges, sorted
+   *  @return Half-edges
+   */
+  const std::vector<int>& get_non_manifold_edge(void) const {
+    return non_manifold_;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+  /** Opposite half-edge, -1 if none */
+  std::vector<int> twin_;
+  /** Origin of each half-edge */
+  std::vector<int> origin_;
+  /** Outgoing half-edge of each vertex */
+  std::vector<int> out_;
+  /** Half-edges lying on non-manifold edges */
+  std::vector<int> non_manifold_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_HALF_EDGE__ */
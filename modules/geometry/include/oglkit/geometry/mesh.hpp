@@ -11,11 +11,17 @@
 #ifndef __OGLKIT_MESH__
 #define __OGLKIT_MESH__
 
+#include <functional>
+#include <future>
+#include <istream>
 #include <vector>
 
 #include "oglkit/core/library_export.hpp"
 #include "oglkit/core/math/vector.hpp"
 #include "oglkit/geometry/aabb.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/half_edge.hpp"
+#include "oglkit/geometry/mesh_partitioner.hpp"
 
 /**
  *  @namespace  OGLKit
@@ -23,9 +29,17 @@
  */
 namespace OGLKit {
 
+/** glTF asset forwarding */
+class GLTFAsset;
+
 /**
  *  @class  Mesh
- *  @brief  3D Mesh container
+ *  @brief  3D Mesh container. Derived data (connectivity, normals,
+ *          tangents, bounding box, clusters) are versioned against the
+ *          source arrays and rebuilt lazily by the Update*() calls. Writes
+ *          go through Edit(), which flags what changed; get_*() accessors,
+ *          const or not, never change any version, therefore data modified
+ *          through them are not seen by the Update*() calls.
  *  @author Christophe Ecabert
  *  @date   02/08/16
  *  @ingroup geometry
@@ -48,10 +62,212 @@ class OGLKIT_EXPORTS Mesh {
   using TCoord = OGLKit::Vector2<T>;
   /** Vertex color */
   using Color = OGLKit::Vector4<T>;
-  /** Tangente space */
-  using Tangent = OGLKit::Vector3<T>;
+  /** Tangente space, direction and handedness (w = +/-1) with
+   bitangent = w * (normal ^ tangent) */
+  using Tangent = OGLKit::Vector4<T>;
   /** Triangle */
   using Triangle = OGLKit::Vector3<int>;
+  /** Cluster of triangles, contiguous range of the triangulation */
+  using Cluster = typename MeshPartitioner<T>::Cluster;
+
+  /**
+   *  @enum PostProcessStage
+   *  @brief  Processing applied once a mesh file is parsed, stages can be
+   *          combined (i.e. kCenter | kBoundingBox)
+   */
+  enum PostProcessStage {
+    /** Leave the mesh as parsed */
+    kNoPostProcess = 0x00,
+    /** Move the center of gravity to the origin */
+    kCenter = 0x01,
+    /** Bounding box, if not provided by the parser */
+    kBoundingBox = 0x02,
+    /** Vertex connectivity */
+    kConnectivity = 0x04,
+    /** Vertex normals, if not provided by the file */
+    kNormal = 0x08,
+    /** Reorder triangles for the post-transform vertex cache */
+    kVertexCache = 0x10,
+    /** Reorder triangles for the vertex cache and overdraw */
+    kOverdraw = 0x20,
+    /** Reorder vertices by first use in the (optimized) triangles */
+    kVertexFetch = 0x40,
+    /** Stages applied by default */
+    kDefaultPostProcess = kCenter | kBoundingBox | kConnectivity
+  };
+
+  /**
+   *  @enum NormalWeighting
+   *  @brief  Weight of each face's normal when averaged at a vertex
+   */
+  enum NormalWeighting {
+    /** Angle of the face at the vertex */
+    kAngleWeighting = 0,
+    /** Area of the face */
+    kAreaWeighting = 1,
+    /** Same weight for every face */
+    kUniformWeighting = 2
+  };
+
+  /**
+   *  @enum VertexOrder
+   *  @brief  Vertex ordering used by ReorderVertex()
+   */
+  enum VertexOrder {
+    /** Order of first reference in the triangles, unused vertices last */
+    kFirstUseOrder = 0,
+    /** Morton code (Z-order) of the position */
+    kMortonOrder = 1,
+    /** Hilbert code of the position */
+    kHilbertOrder = 2
+  };
+
+  /**
+   *  @class  Editor
+   *  @brief  Scoped write access to the mesh's data, the only tracked way
+   *          to modify it. Source arrays (vertex, triangle, texture
+   *          coordinate) accessed through the editor are flagged as modified
+   *          when it goes out of scope, derived data depending on them are
+   *          then rebuilt by the next Update*() call. Normals and tangents
+   *          accessed through it are taken as provided by the caller and
+   *          kept by UpdateNormal() / UpdateTangent() until their sources
+   *          change. Vertex colors only bump the mesh's version.
+   */
+  class Editor {
+   public:
+    /**
+     *  @name Editor
+     *  @fn explicit Editor(Mesh<T>* mesh)
+     *  @brief  Constructor
+     *  @param[in]  mesh  Mesh to edit
+     */
+    explicit Editor(Mesh<T>* mesh) : mesh_(mesh), touched_(0),
+                                     normal_(false), tangent_(false),
+                                     color_(false) {}
+
+    /**
+     *  @name Editor
+     *  @fn Editor(Editor&& other)
+     *  @brief  Move constructor, \p other does not flag anything anymore
+     *  @param[in]  other Editor to move from
+     */
+    Editor(Editor&& other) : mesh_(other.mesh_), touched_(other.touched_),
+                             normal_(other.normal_),
+                             tangent_(other.tangent_),
+                             color_(other.color_) {
+      other.mesh_ = nullptr;
+    }
+
+    /**
+     *  @name Editor
+     *  @fn Editor(const Editor& other) = delete
+     *  @brief  Copy constructor
+     */
+    Editor(const Editor& other) = delete;
+
+    /**
+     *  @name operator=
+     *  @fn Editor& operator=(const Editor& rhs) = delete
+     *  @brief  Assignment operator
+     */
+    Editor& operator=(const Editor& rhs) = delete;
+
+    /**
+     *  @name ~Editor
+     *  @fn ~Editor(void)
+     *  @brief  Destructor, flag the accessed arrays as modified and the
+     *          provided normals / tangents as up to date
+     */
+    ~Editor(void) {
+      if (mesh_ && (touched_ || color_)) {
+        mesh_->Touch(touched_);
+      }
+      if (mesh_ && normal_) {
+        mesh_->normal_version_ = mesh_->version_;
+      }
+      if (mesh_ && tangent_) {
+        mesh_->tangent_version_ = mesh_->version_;
+      }
+    }
+
+    /**
+     *  @name vertex
+     *  @fn std::vector<Vertex>& vertex(void)
+     *  @brief  Vertex array
+     *  @return Vertex array
+     */
+    std::vector<Vertex>& vertex(void) {
+      touched_ |= kVertexData;
+      return mesh_->vertex_;
+    }
+
+    /**
+     *  @name triangle
+     *  @fn std::vector<Triangle>& triangle(void)
+     *  @brief  Triangle array
+     *  @return Triangle array
+     */
+    std::vector<Triangle>& triangle(void) {
+      touched_ |= kTriangleData;
+      return mesh_->tri_;
+    }
+
+    /**
+     *  @name tex_coord
+     *  @fn std::vector<TCoord>& tex_coord(void)
+     *  @brief  Texture coordinate array
+     *  @return Texture coordinate array
+     */
+    std::vector<TCoord>& tex_coord(void) {
+      touched_ |= kTCoordData;
+      return mesh_->tex_coord_;
+    }
+
+    /**
+     *  @name normal
+     *  @fn std::vector<Normal>& normal(void)
+     *  @brief  Normal array, provided by the caller
+     *  @return Normal array
+     */
+    std::vector<Normal>& normal(void) {
+      normal_ = true;
+      return mesh_->normal_;
+    }
+
+    /**
+     *  @name tangent
+     *  @fn std::vector<Tangent>& tangent(void)
+     *  @brief  Tangent array, provided by the caller
+     *  @return Tangent array
+     */
+    std::vector<Tangent>& tangent(void) {
+      tangent_ = true;
+      return mesh_->tangent_;
+    }
+
+    /**
+     *  @name vertex_color
+     *  @fn std::vector<Color>& vertex_color(void)
+     *  @brief  Vertex color array, nothing is derived from it
+     *  @return Vertex color array
+     */
+    std::vector<Color>& vertex_color(void) {
+      color_ = true;
+      return mesh_->vertex_color_;
+    }
+
+   private:
+    /** Mesh being edited */
+    Mesh<T>* mesh_;
+    /** Arrays accessed, DataSource */
+    int touched_;
+    /** Normals provided */
+    bool normal_;
+    /** Tangents provided */
+    bool tangent_;
+    /** Colors accessed */
+    bool color_;
+  };
 
 #pragma mark -
 #pragma mark Initialization
@@ -98,19 +314,68 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name Load
    *  @fn virtual int Load(const std::string& filename)
-   *  @brief  Load mesh from supported file : .obj, .ply
+   *  @brief  Load mesh from supported file : .obj, .ply, .stl, .gltf, .glb,
+   *          .oglmesh. The .obj, .ply and .stl files can be gzip / zstd
+   *          compressed (i.e. .ply.gz), unknown extensions are detected from
+   *          the file's content. Identical .stl corners are welded into
+   *          shared vertices, glTF primitives are merged into a single mesh.
    *  @param[in]  filename  Path to the mesh file
    *  @return -1 if error, 0 otherwise
    */
   int Load(const std::string& filename);
 
+  /**
+   *  @name Load
+   *  @fn int Load(const void* data, const size_t size)
+   *  @brief  Load mesh from a buffer holding an .obj, .ply, .stl (possibly
+   *          gzip / zstd compressed) or .glb file. The format is detected from
+   *          the content.
+   *  @param[in]  data  Buffer
+   *  @param[in]  size  Buffer's size in bytes
+   *  @return -1 if error, 0 otherwise
+   */
+  int Load(const void* data, const size_t size);
+
+  /**
+   *  @name Load
+   *  @fn int Load(std::istream& stream)
+   *  @brief  Load mesh from a binary stream holding an .obj, .ply or .stl
+   *          file (possibly gzip / zstd compressed). The stream is read until
+   *          its end, the format is detected from the content.
+   *  @param[in]  stream  Binary stream from where to load the mesh
+   *  @return -1 if error, 0 otherwise
+   */
+  int Load(std::istream& stream);
+
+  /**
+   *  @name LoadAsync
+   *  @fn std::future<int> LoadAsync(const std::string& filename,
+                                 const std::function<void(int)>& callback)
+   *  @brief  Load mesh from supported file on the library's thread pool
+   *          (parsing, centering, connectivity and bounding box). The mesh
+   *          must not be accessed until the returned future is ready.
+   *  @param[in]  filename  Path to the mesh file
+   *  @param[in]  callback  Optional function invoked on the loading thread
+   *                        with the error code, before the future is ready.
+   *                        Can be used to chain extra processing (i.e.
+   *                        normals) off the calling thread.
+   *  @return Future holding -1 if error, 0 otherwise
+   */
+  std::future<int> LoadAsync(const std::string& filename,
+                             const std::function<void(int)>& callback =
+                                 nullptr);
+
   /**
    *  @name Save
-   *  @fn virtual int Save(const std::string& filename)
-   *  @brief  Save mesh to supported file format: .ply/.obj
+   *  @fn virtual int Save(const std::string& filename,
+                           const bool binary = true)
+   *  @brief  Save mesh to supported file format: .ply/.obj/.stl/.oglmesh
+   *  @param[in]  filename  Path to the mesh file
+   *  @param[in]  binary    Use binary encoding when supported by the format
+   *                        (i.e. .ply), .stl is always binary
    *  @return -1 if error, 0 otherwise
    */
-  int Save(const std::string& filename);
+  int Save(const std::string& filename, const bool binary = true);
 
   /**
    *  @name BuildConnectivity
@@ -120,13 +385,27 @@ class OGLKIT_EXPORTS Mesh {
    */
   void BuildConnectivity(void);
 
+  /**
+   *  @name Edit
+   *  @fn Editor Edit(void)
+   *  @brief  Start editing the mesh's data, see Editor
+   *  @return Scoped editor
+   */
+  Editor Edit(void) {
+    return Editor(this);
+  }
+
 #pragma mark -
 #pragma mark Usage
 
   /**
    *  @name ComputeVertexNormal
    *  @fn void ComputeVertexNormal(void)
-   *  @brief  Compute normal for each vertex in the object
+   *  @brief  Compute normal for each vertex in the object. Face normals (and
+   *          corner angles) are computed once, then gathered per vertex
+   *          through the connectivity (built first if needed), both passes
+   *          run on the thread pool. Weighting is selected with
+   *          set_normal_weighting().
    */
   void ComputeVertexNormal(void);
 
@@ -137,6 +416,125 @@ class OGLKIT_EXPORTS Mesh {
    */
   void ComputeBoundingBox(void);
 
+  /**
+   *  @name ComputeBoundingBox
+   *  @fn int ComputeBoundingBox(const size_t first_tri, const size_t n_tri,
+                                 AABB<T>* bbox) const
+   *  @brief  Compute the bounding box of the vertices used by a range of
+   *          triangles (i.e. a cluster), the mesh's box is left untouched
+   *  @param[in]  first_tri First triangle of the range
+   *  @param[in]  n_tri     Number of triangle in the range
+   *  @param[out] bbox      Bounding box
+   *  @return -1 if the range or a triangle is invalid, 0 otherwise
+   */
+  int ComputeBoundingBox(const size_t first_tri,
+                         const size_t n_tri,
+                         AABB<T>* bbox) const;
+
+  /**
+   *  @name ComputeVertexTangent
+   *  @fn void ComputeVertexTangent(void)
+   *  @brief  Compute tangent for each vertex from the texture coordinates,
+   *          following MikkTSpace: face tangents are projected onto the
+   *          tangent plane of each corner's normal, weighted by the corner
+   *          angle and averaged, the bitangent's orientation is stored in w.
+   *          Faces are processed then gathered per vertex on the thread
+   *          pool, the result does not depend on the number of thread.
+   *          Connectivity and normals are built if missing. Cleared if there
+   *          is no texture coordinate.
+   */
+  void ComputeVertexTangent(void);
+
+  /**
+   *  @name ReorderVertex
+   *  @fn int ReorderVertex(const VertexOrder order)
+   *  @brief  Permute the vertices to improve vertex fetch locality. Every
+   *          per-vertex array (position, normal, texture coordinate,
+   *          tangent, color) is moved together and triangles are remapped.
+   *          Up to date normals, tangents, bounding box and clusters stay
+   *          valid, the connectivity is rebuilt if present.
+   *  @param[in]  order Ordering strategy
+   *  @return -1 if the triangulation is invalid, 0 otherwise
+   */
+  int ReorderVertex(const VertexOrder order);
+
+  /**
+   *  @name RemoveUnusedVertex
+   *  @fn int RemoveUnusedVertex(void)
+   *  @brief  Drop vertices no triangle refers to (i.e. once triangles are
+   *          replaced by a simplified level), remaining ones are ordered by
+   *          first use
+   *  @return -1 if the triangulation is invalid, 0 otherwise
+   */
+  int RemoveUnusedVertex(void);
+
+  /**
+   *  @name BuildCluster
+   *  @fn int BuildCluster(const size_t max_vertex, const size_t max_tri)
+   *  @brief  Split the triangulation into clusters (meshlets) for culling,
+   *          triangles are reordered so that every cluster is a contiguous
+   *          range. Normals, tangents and bounding box stay valid.
+   *  @param[in]  max_vertex  Maximum number of vertex per cluster
+   *  @param[in]  max_tri     Maximum number of triangle per cluster
+   *  @return -1 if the triangulation or the budgets are invalid, 0 otherwise
+   */
+  int BuildCluster(const size_t max_vertex, const size_t max_tri);
+
+  /**
+   *  @name UpdateConnectivity
+   *  @fn const Connectivity& UpdateConnectivity(void)
+   *  @brief  Rebuild the connectivity if the triangles (or the number of
+   *          vertex) changed since it was last built
+   *  @return Vertex connectivity
+   */
+  const Connectivity& UpdateConnectivity(void);
+
+  /**
+   *  @name UpdateHalfEdge
+   *  @fn const HalfEdge& UpdateHalfEdge(void)
+   *  @brief  Rebuild the half-edge structure if the triangles (or the number
+   *          of vertex) changed since it was last built. Not part of the
+   *          loading stages, built on first request only.
+   *  @return Half-edge connectivity
+   */
+  const HalfEdge& UpdateHalfEdge(void);
+
+  /**
+   *  @name UpdateCluster
+   *  @fn const std::vector<Cluster>& UpdateCluster(void)
+   *  @brief  Recompute the clusters' bounds if the vertices moved since they
+   *          were built. Clusters are dropped if the triangles changed.
+   *  @return Clusters
+   */
+  const std::vector<Cluster>& UpdateCluster(void);
+
+  /**
+   *  @name UpdateNormal
+   *  @fn const std::vector<Normal>& UpdateNormal(void)
+   *  @brief  Recompute the normals if the vertices or triangles changed
+   *          since they were last computed (or loaded)
+   *  @return Vertex normals
+   */
+  const std::vector<Normal>& UpdateNormal(void);
+
+  /**
+   *  @name UpdateTangent
+   *  @fn const std::vector<Tangent>& UpdateTangent(void)
+   *  @brief  Recompute the tangents if the vertices, triangles, texture
+   *          coordinates or normals changed since they were last computed
+   *  @return Vertex tangents
+   */
+  const std::vector<Tangent>& UpdateTangent(void);
+
+  /**
+   *  @name UpdateBoundingBox
+   *  @fn const AABB<T>& UpdateBoundingBox(void)
+   *  @brief  Recompute the bounding box if the vertices changed since it was
+   *          last computed
+   *  @return Bounding box
+   */
+  const AABB<T>& UpdateBoundingBox(void);
+
 #pragma mark -
 #pragma mark Accessors
 
@@ -153,7 +551,7 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_vertex
    *  @fn std::vector<Vertex>& get_vertex(void)
-   *  @brief Give reference to internal vertex storage.
+   *  @brief Give reference to internal vertex storage, untracked (see Mesh)
    *  @return Vertex array
    */
   std::vector<Vertex>& get_vertex(void) {
@@ -173,7 +571,7 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_normal
    *  @fn std::vector<Normal>& get_normal(void)
-   *  @brief Give reference to internal normal storage.
+   *  @brief Give reference to internal normal storage, untracked (see Mesh)
    *  @return Normal array
    */
   std::vector<Normal>& get_normal(void) {
@@ -205,7 +603,8 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_tangent
    *  @fn std::vector<Tangent>& get_tangent(void)
-   *  @brief  Give reference to internal tangent storage
+   *  @brief  Give reference to internal tangent storage, untracked (see
+   *          Mesh)
    *  @return Tangent array (Normal mapping)
    */
   std::vector<Tangent>& get_tangent(void) {
@@ -215,7 +614,8 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_tex_coord
    *  @fn std::vector<TCoord>& get_tex_coord(void)
-   *  @brief  Give reference to internal texture coordinate storage.
+   *  @brief  Give reference to internal texture coordinate storage,
+   *          untracked (see Mesh)
    *  @return Texture coordinate array
    */
   std::vector<TCoord>& get_tex_coord(void) {
@@ -236,7 +636,8 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_vertex_color
    *  @fn std::vector<Color>& get_vertex_color(void)
-   *  @brief  Give reference to internal vertex color storage.
+   *  @brief  Give reference to internal vertex color storage, untracked
+   *          (see Mesh)
    *  @return Vertex color array
    */
   std::vector<Color>& get_vertex_color(void) {
@@ -257,14 +658,133 @@ class OGLKIT_EXPORTS Mesh {
   /**
    *  @name get_triangle
    *  @fn std::vector<Triangle>& get_triangle(void)
-   *  @brief  Give reference to internal triangulation storage, can not be
-   *          modified.
+   *  @brief  Give reference to internal triangulation storage, untracked
+   *          (see Mesh)
    *  @return Triangle array
    */
   std::vector<Triangle>& get_triangle(void) {
     return tri_;
   }
 
+  /**
+   *  @name get_vertex_connectivity
+   *  @fn const Connectivity& get_vertex_connectivity(void) const
+   *  @brief  Give reference to the vertex connectivity (i.e. the two other
+   *          corners of each triangle sharing a vertex), empty if not built
+   *  @return Connectivity array
+   */
+  const Connectivity& get_vertex_connectivity(void) const {
+    return vertex_con_;
+  }
+
+  /**
+   *  @name get_half_edge
+   *  @fn const HalfEdge& get_half_edge(void) const
+   *  @brief  Give reference to the half-edge connectivity, empty if not
+   *          built (see UpdateHalfEdge)
+   *  @return Half-edge connectivity
+   */
+  const HalfEdge& get_half_edge(void) const {
+    return half_edge_;
+  }
+
+  /**
+   *  @name get_cluster
+   *  @fn const std::vector<Cluster>& get_cluster(void) const
+   *  @brief  Give reference to the clusters, empty if not built (see
+   *          BuildCluster / UpdateCluster)
+   *  @return Clusters
+   */
+  const std::vector<Cluster>& get_cluster(void) const {
+    return cluster_;
+  }
+
+  /**
+   *  @name set_parallel_loading
+   *  @fn void set_parallel_loading(const bool parallel)
+   *  @brief  Enable/Disable parsing of large files on the library's thread
+   *          pool (enabled by default)
+   *  @param[in]  parallel  True to parse in parallel
+   */
+  void set_parallel_loading(const bool parallel) {
+    parallel_loading_ = parallel;
+  }
+
+  /**
+   *  @name set_use_cache
+   *  @fn void set_use_cache(const bool use_cache)
+   *  @brief  Enable/Disable the sidecar cache (disabled by default). When
+   *          enabled, Load() reads "<filename>.oglmesh" if it is not older
+   *          than the source file and was written with the same
+   *          post-processing and encoding settings, otherwise the source is
+   *          parsed and the cache is (re)written.
+   *  @param[in]  use_cache True to use sidecar cache
+   */
+  void set_use_cache(const bool use_cache) {
+    use_cache_ = use_cache;
+  }
+
+  /**
+   *  @name set_compact_cache
+   *  @fn void set_compact_cache(const bool compact)
+   *  @brief  Enable/Disable compact encoding of .oglmesh cache (disabled by
+   *          default): 16 bits quantized positions, octahedral normals and
+   *          delta/varint indices (see MeshCodec)
+   *  @param[in]  compact True to write compact cache
+   */
+  void set_compact_cache(const bool compact) {
+    compact_cache_ = compact;
+  }
+
+  /**
+   *  @name set_post_process
+   *  @fn void set_post_process(const int stages)
+   *  @brief  Select the stages applied after parsing a file (default:
+   *          kDefaultPostProcess). Vertex passes are fused and run alongside
+   *          the connectivity construction.
+   *  @param[in]  stages  Combination of PostProcessStage
+   */
+  void set_post_process(const int stages) {
+    post_process_ = stages;
+  }
+
+  /**
+   *  @name post_process
+   *  @fn int post_process(void) const
+   *  @brief  Stages applied after parsing a file
+   *  @return Combination of PostProcessStage
+   */
+  int post_process(void) const {
+    return post_process_;
+  }
+
+  /**
+   *  @name set_normal_weighting
+   *  @fn void set_normal_weighting(const NormalWeighting weighting)
+   *  @brief  Select how face normals are weighted by ComputeVertexNormal()
+   *          (default: kAngleWeighting). Computed normals are refreshed on
+   *          the next UpdateNormal() call.
+   *  @param[in]  weighting Face weighting
+   */
+  void set_normal_weighting(const NormalWeighting weighting) {
+    if (weighting != normal_weighting_) {
+      // Computed normals (and tangents) become stale
+      normal_weighting_ = weighting;
+      normal_version_ = 0;
+      ++version_;
+    }
+  }
+
+  /**
+   *  @name normal_weighting
+   *  @fn NormalWeighting normal_weighting(void) const
+   *  @brief  Weighting used by ComputeVertexNormal()
+   *  @return Face weighting
+   */
+  NormalWeighting normal_weighting(void) const {
+    return normal_weighting_;
+  }
+
   /**
    *  @name bbox
    *  @fn const AABB<T>& bbox(void) const
@@ -274,6 +794,17 @@ class OGLKIT_EXPORTS Mesh {
     return bbox_;
   }
 
+  /**
+   *  @name version
+   *  @fn size_t version(void) const
+   *  @brief  Edit counter, increases each time the source data are modified
+   *          (i.e. to know when GPU buffers need to be refreshed)
+   *  @return Version
+   */
+  size_t version(void) const {
+    return version_;
+  }
+
 #pragma mark -
 #pragma mark Protected
  protected:
@@ -289,6 +820,27 @@ class OGLKIT_EXPORTS Mesh {
     kObj,
     /** .ply */
     kPly,
+    /** .stl */
+    kStl,
+    /** .gltf / .glb */
+    kGltf,
+    /** .oglmesh, native cache */
+    kCache
+  };
+
+  /**
+   *  @enum DataSource
+   *  @brief  Arrays derived data are computed from
+   */
+  enum DataSource {
+    /** vertex_ */
+    kVertexData = 0x01,
+    /** tri_ */
+    kTriangleData = 0x02,
+    /** tex_coord_ */
+    kTCoordData = 0x04,
+    /** Everything */
+    kAllData = kVertexData | kTriangleData | kTCoordData
   };
 
   /** Vertex */
@@ -304,11 +856,53 @@ class OGLKIT_EXPORTS Mesh {
   /** Triangulation */
   std::vector<Triangle> tri_;
   /** Connectivity - vertex interconnection */
-  std::vector<std::vector<int>> vertex_con_;
+  Connectivity vertex_con_;
+  /** Half-edge connectivity */
+  HalfEdge half_edge_;
+  /** Triangle clusters */
+  std::vector<Cluster> cluster_;
   /** Boundary box */
   AABB<T> bbox_;
   /** Wether or not the bounding box has been computed already or not */
   bool bbox_is_computed_;
+  /** Parse large files in parallel */
+  bool parallel_loading_;
+  /** Use sidecar cache when loading */
+  bool use_cache_;
+  /** Write compact cache */
+  bool compact_cache_;
+  /** Stages applied after parsing, PostProcessStage */
+  int post_process_;
+  /** Face weighting used for vertex normals */
+  NormalWeighting normal_weighting_;
+  /** Scratch face normals, kept across ComputeVertexNormal() calls */
+  std::vector<Normal> face_normal_;
+  /** Scratch corner angles, kept across ComputeVertexNormal() calls */
+  std::vector<T> corner_angle_;
+  /** Scratch face tangents and bitangents */
+  std::vector<Edge> face_tangent_;
+  /** Edit counter */
+  size_t version_;
+  /** Version of the last modification of vertex_ */
+  size_t vertex_version_;
+  /** Version of the last modification of tri_ */
+  size_t tri_version_;
+  /** Version of the last modification of tex_coord_ */
+  size_t tcoord_version_;
+  /** Version vertex_con_ has been built at */
+  size_t con_version_;
+  /** Version half_edge_ has been built at */
+  size_t half_edge_version_;
+  /** Version cluster_ has been built (or bounded) at */
+  size_t cluster_version_;
+  /** Version normal_ has been computed at */
+  size_t normal_version_;
+  /** Version tangent_ has been computed at */
+  size_t tangent_version_;
+  /** Version bbox_ has been computed at */
+  size_t bbox_version_;
+  /** File size (bytes) above which parallel parsing is used */
+  static constexpr size_t kParallelLoadingSize = 1 << 20;
   
 #pragma mark -
 #pragma mark Private
@@ -323,48 +917,225 @@ private:
    */
   FileExt HashExt(const std::string& ext);
 
+  /**
+   *  @name DetectFormat
+   *  @fn FileExt DetectFormat(const std::string& path)
+   *  @brief  Identify the format of a file from its first bytes (decompressed
+   *          if needed)
+   *  @param[in]  path  Path to the mesh file
+   *  @return File format, kUndef if not recognized
+   */
+  FileExt DetectFormat(const std::string& path);
+
+  /**
+   *  @name DetectFormat
+   *  @fn FileExt DetectFormat(const char* data, const size_t size)
+   *  @brief  Identify the format of a buffer from its first bytes
+   *          (decompressed if needed)
+   *  @param[in]  data  Buffer holding the mesh
+   *  @param[in]  size  Buffer's size
+   *  @return File format, kUndef if not recognized
+   */
+  FileExt DetectFormat(const char* data, const size_t size);
+
+  /**
+   *  @name Clear
+   *  @fn void Clear(void)
+   *  @brief  Empty every container before loading
+   */
+  void Clear(void);
+
+  /**
+   *  @name PostProcess
+   *  @fn void PostProcess(void)
+   *  @brief  Apply the selected post-processing stages to the freshly parsed
+   *          mesh. Centroid and bounding box are gathered in a single pass
+   *          over the vertices, the connectivity is built in the meantime.
+   */
+  void PostProcess(void);
+
+  /**
+   *  @name RemapVertex
+   *  @fn void RemapVertex(const std::vector<int>& remap)
+   *  @brief  Move every per-vertex array and update the triangles
+   *  @param[in]  remap New index of each vertex, remap[old] = new
+   */
+  void RemapVertex(const std::vector<int>& remap);
+
+  /**
+   *  @name Touch
+   *  @fn void Touch(const int source)
+   *  @brief  Flag source arrays as modified, derived data depending on them
+   *          become stale
+   *  @param[in]  source  Combination of DataSource
+   */
+  void Touch(const int source);
+
+  /**
+   *  @name MarkLoaded
+   *  @fn void MarkLoaded(void)
+   *  @brief  Flag derived data provided by a freshly loaded file (or
+   *          computed while post-processing it) as up to date
+   */
+  void MarkLoaded(void);
+
   /**
    *  @name LoadOBJ
    *  @fn int LoadOBJ(const std::string& path)
-   *  @brief  Load mesh from .obj file
+   *  @brief  Load mesh from .obj file, possibly gzip / zstd compressed
    *  @param[in]  path  Path to .obj file
    *  @return -1 if error, 0 otherwise
    */
   int LoadOBJ(const std::string& path);
 
+  /**
+   *  @name LoadOBJ
+   *  @fn int LoadOBJ(const char* data, const size_t size,
+                      const std::string& name)
+   *  @brief  Load mesh from a buffer holding an .obj file, possibly gzip /
+   *          zstd compressed
+   *  @param[in]  data  Buffer
+   *  @param[in]  size  Buffer's size
+   *  @param[in]  name  Name of the source used in error messages
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadOBJ(const char* data, const size_t size, const std::string& name);
+
   /**
    *  @name SaveOBJ
-   *  @fn int SaveOBJ(const std::string path) const
-   *  @brief SAve mesh to a .obj file
+   *  @fn int SaveOBJ(const std::string& path) const
+   *  @brief  Save mesh to a .obj file
    *  @param[in]  path  Path to .obj file
    *  @return -1 if error, 0 otherwise
    */
-  int SaveOBJ(const std::string& path);
+  int SaveOBJ(const std::string& path) const;
 
   /**
    *  @name LoadPLY
    *  @fn int LoadPLY(const std::string path)
-   *  @brief  Load mesh from .ply file
+   *  @brief  Load mesh from .ply file, possibly gzip / zstd compressed
    *  @param[in]  path  Path to .ply file
    *  @return -1 if error, 0 otherwise
    */
   int LoadPLY(const std::string& path);
 
+  /**
+   *  @name LoadPLY
+   *  @fn int LoadPLY(const char* data, const size_t size,
+                      const std::string& name)
+   *  @brief  Load mesh from a buffer holding a .ply file, possibly gzip /
+   *          zstd compressed
+   *  @param[in]  data  Buffer
+   *  @param[in]  size  Buffer's size
+   *  @param[in]  name  Name of the source used in error messages
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadPLY(const char* data, const size_t size, const std::string& name);
+
+  /**
+   *  @name LoadCache
+   *  @fn int LoadCache(const std::string& path)
+   *  @brief  Load mesh from native .oglmesh cache
+   *  @param[in]  path  Path to .oglmesh file
+   *  @return -1 if error (the mesh is left empty), 0 otherwise
+   */
+  int LoadCache(const std::string& path);
+
+  /**
+   *  @name SaveCache
+   *  @fn int SaveCache(const std::string& path) const
+   *  @brief  Save mesh to native .oglmesh cache
+   *  @param[in]  path  Path to .oglmesh file
+   *  @return -1 if error, 0 otherwise
+   */
+  int SaveCache(const std::string& path) const;
+
+  /**
+   *  @name CacheFlags
+   *  @fn uint32_t CacheFlags(void) const
+   *  @brief  Settings shaping the cached data: post-processing stages,
+   *          normal weighting and compact encoding. A sidecar cache written
+   *          with other settings is stale.
+   *  @return Flags stored in the .oglmesh header
+   */
+  uint32_t CacheFlags(void) const;
+
   /**
    *  @name SavePLY
-   *  @fn int SavePLY(const std::string path) const
-   *  @brief SAve mesh to a .ply file
-   *  @param[in]  path  Path to .ply file
+   *  @fn int SavePLY(const std::string& path, const bool binary) const
+   *  @brief  Save mesh to a .ply file
+   *  @param[in]  path    Path to .ply file
+   *  @param[in]  binary  If true use binary_little_endian format, otherwise
+   *                      ascii
    *  @return -1 if error, 0 otherwise
    */
-  int SavePLY(const std::string& path) const;
-  
+  int SavePLY(const std::string& path, const bool binary) const;
+
+  /**
+   *  @name LoadSTL
+   *  @fn int LoadSTL(const std::string& path)
+   *  @brief  Load mesh from .stl file (binary or ascii), possibly gzip / zstd
+   *          compressed
+   *  @param[in]  path  Path to .stl file
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadSTL(const std::string& path);
+
+  /**
+   *  @name LoadSTL
+   *  @fn int LoadSTL(const char* data, const size_t size,
+                      const std::string& name)
+   *  @brief  Load mesh from a buffer holding a .stl file, possibly gzip /
+   *          zstd compressed. Facets are welded into an indexed mesh.
+   *  @param[in]  data  Buffer
+   *  @param[in]  size  Buffer's size
+   *  @param[in]  name  Name of the source used in error messages
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadSTL(const char* data, const size_t size, const std::string& name);
+
+  /**
+   *  @name SaveSTL
+   *  @fn int SaveSTL(const std::string& path) const
+   *  @brief  Save mesh to a binary .stl file
+   *  @param[in]  path  Path to .stl file
+   *  @return -1 if error, 0 otherwise
+   */
+  int SaveSTL(const std::string& path) const;
+
+  /**
+   *  @name LoadGLTF
+   *  @fn int LoadGLTF(const std::string& path)
+   *  @brief  Load mesh from .gltf (+ .bin) or .glb file
+   *  @param[in]  path  Path to .gltf / .glb file
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadGLTF(const std::string& path);
+
   /**
-   *  @name   PlaceToOrigin
-   *  @fn     void PlaceToOrigin(void)
-   *  @brief  Place mest to world origin (i.e. remove center of graviaty).
+   *  @name LoadGLTF
+   *  @fn int LoadGLTF(const char* data, const size_t size,
+                       const std::string& name)
+   *  @brief  Load mesh from a buffer holding a .glb file (or a .gltf file
+   *          with embedded buffers)
+   *  @param[in]  data  Buffer
+   *  @param[in]  size  Buffer's size
+   *  @param[in]  name  Name of the source used in error messages
+   *  @return -1 if error, 0 otherwise
+   */
+  int LoadGLTF(const char* data, const size_t size, const std::string& name);
+
+  /**
+   *  @name LoadGLTF
+   *  @fn int LoadGLTF(const GLTFAsset& asset, const std::string& name)
+   *  @brief  Merge every triangle primitive of a glTF asset into this mesh.
+   *          Attributes are kept only if present in every primitive.
+   *  @param[in]  asset Loaded asset
+   *  @param[in]  name  Name of the source used in error messages
+   *  @return -1 if error, 0 otherwise
    */
-  void PlaceToOrigin(void);
+  int LoadGLTF(const GLTFAsset& asset, const std::string& name);
+
 };
 
 }  // namespace OGLKit
@@ -0,0 +1,268 @@
+/**
+ *  @file   mesh_cache.hpp
+ *  @brief  Native binary mesh container, memory mappable
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MESH_CACHE__
+#define __OGLKIT_MESH_CACHE__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/memory_map.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MeshCache
+ *  @brief  Versioned binary mesh container made of typed sections. The file
+ *          starts with a Header followed by a table of Section, each
+ *          section's data is aligned on kAlignment bytes and stored in the
+ *          host's byte order. Once mapped, data can be used in place.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ */
+class OGLKIT_EXPORTS MeshCache {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /**
+   *  @enum SectionType
+   *  @brief  Kind of data stored in a section
+   */
+  enum SectionType {
+    /** Vertex position, 3 scalars */
+    kVertex = 1,
+    /** Vertex normal, 3 scalars */
+    kNormal = 2,
+    /** Texture coordinate, 2 scalars */
+    kTCoord = 3,
+    /** Tangent, 4 scalars (direction, handedness) */
+    kTangent = 4,
+    /** Vertex color, 4 scalars */
+    kVertexColor = 5,
+    /** Triangle, 3 int32 */
+    kTriangle = 6,
+    /** Vertex connectivity, int32: N + 1 offsets followed by indices */
+    kConnectivity = 7,
+    /** Bounding box, 6 scalars: min then max */
+    kBBox = 8,
+    /** Vertex position quantized relative to kBBox, 3 uint16 */
+    kQuantizedVertex = 9,
+    /** Octahedral encoded normal, 2 int16 */
+    kOctahedralNormal = 10,
+    /** Delta + varint coded triangle, byte stream */
+    kPackedTriangle = 11
+  };
+
+  /**
+   *  @struct Header
+   *  @brief  File header
+   */
+  struct Header {
+    /** Magic number, kMagic */
+    char magic[8];
+    /** Format version */
+    uint32_t version;
+    /** Byte order mark, kByteOrder written in host order */
+    uint32_t byte_order;
+    /** Size in bytes of the scalar type (i.e. float/double) */
+    uint32_t scalar_size;
+    /** Number of section */
+    uint32_t n_section;
+    /** Settings the data were produced with, opaque to the container */
+    uint32_t flags;
+    /** Padding, keeps the section table 8 bytes aligned */
+    uint32_t reserved;
+  };
+
+  /**
+   *  @struct Section
+   *  @brief  Entry of the section table
+   */
+  struct Section {
+    /** Section type, SectionType */
+    uint32_t type;
+    /** Size in bytes of one element */
+    uint32_t element_size;
+    /** Number of element */
+    uint64_t count;
+    /** Offset of the data from the beginning of the file */
+    uint64_t offset;
+  };
+
+  /**
+   *  @struct Block
+   *  @brief  Data to write into a section
+   */
+  struct Block {
+    /** Section type */
+    SectionType type;
+    /** Size in bytes of one element */
+    uint32_t element_size;
+    /** Number of element */
+    uint64_t count;
+    /** Data */
+    const void* data;
+  };
+
+  /** Magic number */
+  static const char kMagic[8];
+  /** Current format version */
+  static const uint32_t kVersion;
+  /** Byte order mark */
+  static const uint32_t kByteOrder;
+  /** Alignment of section's data */
+  static const uint64_t kAlignment;
+
+#pragma mark -
+#pragma mark Initialization
+
+  /**
+   *  @name MeshCache
+   *  @fn MeshCache(void)
+   *  @brief  Constructor
+   */
+  MeshCache(void);
+
+  /**
+   *  @name MeshCache
+   *  @fn MeshCache(const MeshCache& other) = delete
+   *  @brief  Copy constructor
+   */
+  MeshCache(const MeshCache& other) = delete;
+
+  /**
+   *  @name operator=
+   *  @fn MeshCache& operator=(const MeshCache& rhs) = delete
+   *  @brief  Assignment operator
+   */
+  MeshCache& operator=(const MeshCache& rhs) = delete;
+
+  /**
+   *  @name ~MeshCache
+   *  @fn ~MeshCache(void)
+   *  @brief  Destructor
+   */
+  ~MeshCache(void) = default;
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name Open
+   *  @fn int Open(const std::string& path)
+   *  @brief  Map a cache file and validate its header and section table
+   *  @param[in]  path  Path to the cache file
+   *  @return -1 if error (missing, corrupted, other version or byte order),
+   *          0 otherwise
+   */
+  int Open(const std::string& path);
+
+  /**
+   *  @name Close
+   *  @fn void Close(void)
+   *  @brief  Release the mapping
+   */
+  void Close(void);
+
+  /**
+   *  @name Find
+   *  @fn const void* Find(const SectionType type,
+                           const uint32_t element_size,
+                           size_t* count) const
+   *  @brief  Look for a given section
+   *  @param[in]  type          Section type
+   *  @param[in]  element_size  Expected size of one element
+   *  @param[out] count         Number of element
+   *  @return Pointer to the section's data or nullptr if not present (or
+   *          with a different element size)
+   */
+  const void* Find(const SectionType type,
+                   const uint32_t element_size,
+                   size_t* count) const;
+
+  /**
+   *  @name Write
+   *  @fn static int Write(const std::string& path,
+                           const uint32_t scalar_size,
+                           const uint32_t flags,
+                           const std::vector<Block>& block)
+   *  @brief  Write a cache file
+   *  @param[in]  path        Path to the cache file
+   *  @param[in]  scalar_size Size of the scalar type
+   *  @param[in]  flags       Settings the data were produced with
+   *  @param[in]  block       Sections to write
+   *  @return -1 if error, 0 otherwise
+   */
+  static int Write(const std::string& path,
+                   const uint32_t scalar_size,
+                   const uint32_t flags,
+                   const std::vector<Block>& block);
+
+  /**
+   *  @name IsUpToDate
+   *  @fn static bool IsUpToDate(const std::string& cache,
+                                 const std::string& source,
+                                 const uint32_t flags)
+   *  @brief  Check if a cache file exists, is not older than its source and
+   *          was produced with the same settings
+   *  @param[in]  cache   Path to the cache file
+   *  @param[in]  source  Path to the source mesh file
+   *  @param[in]  flags   Current settings, compared to the cache's ones
+   *  @return True if the cache can be used in place of the source
+   */
+  static bool IsUpToDate(const std::string& cache,
+                         const std::string& source,
+                         const uint32_t flags);
+
+#pragma mark -
+#pragma mark Accessors
+
+  /**
+   *  @name scalar_size
+   *  @fn uint32_t scalar_size(void) const
+   *  @brief  Size of the scalar type stored in the cache
+   *  @return Scalar size in bytes, 0 if not opened
+   */
+  uint32_t scalar_size(void) const {
+    return header_ ? header_->scalar_size : 0;
+  }
+
+  /**
+   *  @name flags
+   *  @fn uint32_t flags(void) const
+   *  @brief  Settings the cached data were produced with
+   *  @return Flags given to Write(), 0 if not opened
+   */
+  uint32_t flags(void) const {
+    return header_ ? header_->flags : 0;
+  }
+
+#pragma mark -
+#pragma mark Private
+ private:
+  /** Mapped file */
+  MemoryMap file_;
+  /** Header */
+  const Header* header_;
+  /** Section table */
+  const Section* section_;
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MESH_CACHE__ */
@@ -0,0 +1,183 @@
+/**
+ *  @file   mesh_codec.hpp
+ *  @brief  Compact mesh encoding (quantized positions, octahedral normals,
+ *          delta/varint indices)
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MESH_CODEC__
+#define __OGLKIT_MESH_CODEC__
+
+#include <cstdint>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+#include "oglkit/geometry/aabb.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MeshCodec
+ *  @brief  Compact encoding of mesh attributes:
+ *            - Positions are quantized on 16 bits relative to the bounding box
+ *            - Normals are octahedral encoded on 2 x 16 bits
+ *            - Triangle indices are delta + zigzag + varint coded
+ *          Attribute's decoders are branch free loops over flat arrays
+ *          therefore they are auto-vectorized by the compiler.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ *  @tparam T Data type
+ */
+template<typename T>
+class OGLKIT_EXPORTS MeshCodec {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Vertex */
+  using Vertex = OGLKit::Vector3<T>;
+  /** Normal */
+  using Normal = OGLKit::Vector3<T>;
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /**
+   *  @struct Report
+   *  @brief  Round trip error and size of the encoded attributes
+   */
+  struct Report {
+    /** Maximum absolute position error (any axis), in mesh unit */
+    T position_error;
+    /** Theoretical position error bound, half a quantization step */
+    T position_bound;
+    /** Maximum normal angular error, in degree */
+    T normal_error;
+    /** Size in bytes before encoding (position, normal, triangle) */
+    size_t raw_size;
+    /** Size in bytes after encoding (position, normal, triangle) */
+    size_t encoded_size;
+
+    /**
+     *  @name Report
+     *  @fn Report(void)
+     *  @brief  Constructor
+     */
+    Report(void) : position_error(0),
+                   position_bound(0),
+                   normal_error(0),
+                   raw_size(0),
+                   encoded_size(0) {}
+  };
+
+#pragma mark -
+#pragma mark Position
+
+  /**
+   *  @name EncodePosition
+   *  @fn static void EncodePosition(const std::vector<Vertex>& vertex,
+                                     const AABB<T>& bbox,
+                                     std::vector<uint16_t>* code,
+                                     Report* report)
+   *  @brief  Quantize positions on 16 bits relative to a bounding box
+   *  @param[in]  vertex  Positions
+   *  @param[in]  bbox    Bounding box enclosing every position
+   *  @param[out] code    Quantized positions (3 per vertex)
+   *  @param[out] report  Round trip error (optional)
+   */
+  static void EncodePosition(const std::vector<Vertex>& vertex,
+                             const AABB<T>& bbox,
+                             std::vector<uint16_t>* code,
+                             Report* report);
+
+  /**
+   *  @name DecodePosition
+   *  @fn static void DecodePosition(const uint16_t* code, const size_t n,
+                                     const AABB<T>& bbox, Vertex* vertex)
+   *  @brief  Reconstruct quantized positions
+   *  @param[in]  code    Quantized positions (3 per vertex)
+   *  @param[in]  n       Number of vertex
+   *  @param[in]  bbox    Bounding box used for encoding
+   *  @param[out] vertex  Positions
+   */
+  static void DecodePosition(const uint16_t* code,
+                             const size_t n,
+                             const AABB<T>& bbox,
+                             Vertex* vertex);
+
+#pragma mark -
+#pragma mark Normal
+
+  /**
+   *  @name EncodeNormal
+   *  @fn static void EncodeNormal(const std::vector<Normal>& normal,
+                                   std::vector<int16_t>* code,
+                                   Report* report)
+   *  @brief  Octahedral encoding of unit vectors on 2 x 16 bits
+   *  @param[in]  normal  Normals
+   *  @param[out] code    Encoded normals (2 per normal)
+   *  @param[out] report  Round trip error (optional)
+   */
+  static void EncodeNormal(const std::vector<Normal>& normal,
+                           std::vector<int16_t>* code,
+                           Report* report);
+
+  /**
+   *  @name DecodeNormal
+   *  @fn static void DecodeNormal(const int16_t* code, const size_t n,
+                                   Normal* normal)
+   *  @brief  Reconstruct octahedral encoded normals
+   *  @param[in]  code    Encoded normals (2 per normal)
+   *  @param[in]  n       Number of normal
+   *  @param[out] normal  Unit normals
+   */
+  static void DecodeNormal(const int16_t* code,
+                           const size_t n,
+                           Normal* normal);
+
+#pragma mark -
+#pragma mark Triangle
+
+  /**
+   *  @name EncodeTriangle
+   *  @fn static void EncodeTriangle(const std::vector<Triangle>& tri,
+                                     std::vector<uint8_t>* code,
+                                     Report* report)
+   *  @brief  Lossless encoding of triangle indices. Stream starts with the
+   *          number of triangle, then each index is stored as the zigzag
+   *          varint of its difference with the previous one.
+   *  @param[in]  tri     Triangles
+   *  @param[out] code    Byte stream
+   *  @param[out] report  Encoded size (optional)
+   */
+  static void EncodeTriangle(const std::vector<Triangle>& tri,
+                             std::vector<uint8_t>* code,
+                             Report* report);
+
+  /**
+   *  @name DecodeTriangle
+   *  @fn static int DecodeTriangle(const uint8_t* code, const size_t size,
+                                    std::vector<Triangle>* tri)
+   *  @brief  Decode triangle indices
+   *  @param[in]  code  Byte stream
+   *  @param[in]  size  Stream length in bytes
+   *  @param[out] tri   Triangles
+   *  @return -1 if the stream is malformed, 0 otherwise
+   */
+  static int DecodeTriangle(const uint8_t* code,
+                            const size_t size,
+                            std::vector<Triangle>* tri);
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MESH_CODEC__ */
@@ -0,0 +1,222 @@
+/**
+ *  @file   mesh_optimizer.hpp
+ *  @brief  Index buffer reordering for the post-transform vertex cache and
+ *          overdraw
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MESH_OPTIMIZER__
+#define __OGLKIT_MESH_OPTIMIZER__
+
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MeshOptimizer
+ *  @brief  Reorder triangles to reduce vertex shading and overdraw, based on
+ *          Tipsify (Sander et al., "Fast Triangle Reordering for Vertex
+ *          Locality and Reduced Overdraw", 2007):
+ *            - Triangles are emitted as fans around vertices picked by their
+ *              age in a simulated FIFO cache, linear time.
+ *            - The resulting clusters are split where it does not hurt the
+ *              cache much, then sorted so that outer facing clusters are
+ *              drawn first.
+ *          Vertex fetch locality is improved separately by remapping the
+ *          vertices, either by first use in the index buffer or along a
+ *          space filling curve (Morton / Hilbert).
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ *  @tparam T Data type
+ */
+template<typename T>
+class OGLKIT_EXPORTS MeshOptimizer {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Vertex */
+  using Vertex = OGLKit::Vector3<T>;
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /**
+   *  @enum VertexOrder
+   *  @brief  Vertex ordering strategy
+   */
+  enum VertexOrder {
+    /** Order of first reference in the index buffer */
+    kFirstUseOrder = 0,
+    /** Morton code (Z-order) of the position */
+    kMortonOrder = 1,
+    /** Hilbert code of the position */
+    kHilbertOrder = 2
+  };
+
+  /**
+   *  @struct CacheStatistic
+   *  @brief  Efficiency of an index buffer with a FIFO vertex cache
+   */
+  struct CacheStatistic {
+    /** Average cache miss ratio, transformed vertex per triangle [0.5, 3] */
+    T acmr;
+    /** Average transformed to vertex ratio, 1 is optimal */
+    T atvr;
+    /** Number of transformed vertex */
+    size_t n_transform;
+
+    /**
+     *  @name CacheStatistic
+     *  @fn CacheStatistic(void)
+     *  @brief  Constructor
+     */
+    CacheStatistic(void) : acmr(0), atvr(0), n_transform(0) {}
+  };
+
+  /**
+   *  @struct Report
+   *  @brief  Cache efficiency before and after optimization
+   */
+  struct Report {
+    /** Input order */
+    CacheStatistic before;
+    /** Optimized order */
+    CacheStatistic after;
+    /** Number of cluster, split at cache flushes (and overdraw sorted) */
+    size_t n_cluster;
+
+    /**
+     *  @name Report
+     *  @fn Report(void)
+     *  @brief  Constructor
+     */
+    Report(void) : n_cluster(0) {}
+  };
+
+  /** Default simulated cache size */
+  static const size_t kCacheSize;
+  /** Default ACMR degradation accepted to reduce overdraw */
+  static const T kOverdrawThreshold;
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name Optimize
+   *  @fn static int Optimize(const std::vector<Vertex>& vertex,
+                              const bool overdraw,
+                              std::vector<Triangle>* tri,
+                              Report* report)
+   *  @brief  Reorder triangles for the vertex cache then, optionally, for
+   *          overdraw with the default parameters
+   *  @param[in]      vertex    Positions
+   *  @param[in]      overdraw  Sort clusters to reduce overdraw
+   *  @param[in,out]  tri       Triangles to reorder
+   *  @param[out]     report    Cache efficiency before / after (optional)
+   *  @return -1 if a triangle is out of range, 0 otherwise
+   */
+  static int Optimize(const std::vector<Vertex>& vertex,
+                      const bool overdraw,
+                      std::vector<Triangle>* tri,
+                      Report* report);
+
+  /**
+   *  @name OptimizeVertexCache
+   *  @fn static int OptimizeVertexCache(const size_t n_vertex,
+                                         const size_t cache_size,
+                                         std::vector<Triangle>* tri,
+                                         std::vector<int>* cluster)
+   *  @brief  Tipsify, emit triangle fans around the vertex most likely to
+   *          still be in cache
+   *  @param[in]      n_vertex    Number of vertex
+   *  @param[in]      cache_size  Simulated cache size
+   *  @param[in,out]  tri         Triangles to reorder
+   *  @param[out]     cluster     First triangle of each cluster, new cluster
+   *                              starts where the cache is flushed
+   *                              (optional)
+   *  @return -1 if a triangle is out of range, 0 otherwise
+   */
+  static int OptimizeVertexCache(const size_t n_vertex,
+                                 const size_t cache_size,
+                                 std::vector<Triangle>* tri,
+                                 std::vector<int>* cluster);
+
+  /**
+   *  @name OptimizeOverdraw
+   *  @fn static int OptimizeOverdraw(const std::vector<Vertex>& vertex,
+                                      const size_t cache_size,
+                                      const T threshold,
+                                      std::vector<Triangle>* tri,
+                                      std::vector<int>* cluster)
+   *  @brief  Split clusters where the cache miss ratio stays below
+   *          \p threshold times the cluster's one, then draw the clusters
+   *          facing away from the mesh's centroid first
+   *  @param[in]      vertex      Positions
+   *  @param[in]      cache_size  Simulated cache size
+   *  @param[in]      threshold   Accepted ACMR degradation (i.e. 1.05)
+   *  @param[in,out]  tri         Triangles ordered by OptimizeVertexCache
+   *  @param[in,out]  cluster     Clusters given by OptimizeVertexCache,
+   *                              updated to the drawn ones
+   *  @return -1 if the clusters or triangles are invalid, 0 otherwise
+   */
+  static int OptimizeOverdraw(const std::vector<Vertex>& vertex,
+                              const size_t cache_size,
+                              const T threshold,
+                              std::vector<Triangle>* tri,
+                              std::vector<int>* cluster);
+
+  /**
+   *  @name VertexRemap
+   *  @fn static int VertexRemap(const std::vector<Vertex>& vertex,
+                                 const std::vector<Triangle>& tri,
+                                 const VertexOrder order,
+                                 std::vector<int>* remap)
+   *  @brief  Compute the new location of every vertex. With kFirstUseOrder,
+   *          vertices never referenced are moved at the end in their
+   *          original order. Space filling curves quantize positions on 10
+   *          bits per axis within the bounding box, ties are broken by
+   *          index.
+   *  @param[in]  vertex  Positions
+   *  @param[in]  tri     Triangles
+   *  @param[in]  order   Ordering strategy
+   *  @param[out] remap   New index of each vertex, remap[old] = new
+   *  @return -1 if a triangle is out of range, 0 otherwise
+   */
+  static int VertexRemap(const std::vector<Vertex>& vertex,
+                         const std::vector<Triangle>& tri,
+                         const VertexOrder order,
+                         std::vector<int>* remap);
+
+  /**
+   *  @name AnalyzeVertexCache
+   *  @fn static void AnalyzeVertexCache(const std::vector<Triangle>& tri,
+                                         const size_t n_vertex,
+                                         const size_t cache_size,
+                                         CacheStatistic* stat)
+   *  @brief  Simulate a FIFO vertex cache
+   *  @param[in]  tri         Triangles, in drawing order
+   *  @param[in]  n_vertex    Number of vertex
+   *  @param[in]  cache_size  Simulated cache size
+   *  @param[out] stat        ACMR / ATVR
+   */
+  static void AnalyzeVertexCache(const std::vector<Triangle>& tri,
+                                 const size_t n_vertex,
+                                 const size_t cache_size,
+                                 CacheStatistic* stat);
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MESH_OPTIMIZER__ */
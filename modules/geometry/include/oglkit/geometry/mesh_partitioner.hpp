@@ -0,0 +1,172 @@
+/**
+ *  @file   mesh_partitioner.hpp
+ *  @brief  Split a triangulation into small clusters (meshlets) with their
+ *          own bounds for fine grained culling
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MESH_PARTITIONER__
+#define __OGLKIT_MESH_PARTITIONER__
+
+#include <cmath>
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+#include "oglkit/geometry/aabb.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MeshPartitioner
+ *  @brief  Greedy clustering of triangles: a cluster grows from a seed by
+ *          adding the adjacent triangle introducing the fewest new vertices,
+ *          oldest frontier first, until its vertex or triangle budget is
+ *          exhausted. The next seed is taken along the previous cluster's
+ *          frontier. Triangles are reordered so that each cluster is a
+ *          contiguous range of the index buffer.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ *  @tparam T Data type
+ */
+template<typename T>
+class OGLKIT_EXPORTS MeshPartitioner {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Vertex */
+  using Vertex = OGLKit::Vector3<T>;
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /**
+   *  @struct Cluster
+   *  @brief  Range of triangles with its bounds
+   */
+  struct Cluster {
+    /** First triangle within the index buffer */
+    size_t first_tri;
+    /** Number of triangle */
+    size_t n_tri;
+    /** Number of distinct vertex */
+    size_t n_vertex;
+    /** Bounding box */
+    AABB<T> bbox;
+    /** Bounding sphere's center */
+    Vertex center;
+    /** Bounding sphere's radius */
+    T radius;
+    /** Normal cone's apex */
+    Vertex cone_apex;
+    /** Normal cone's axis, unit length */
+    Vertex cone_axis;
+    /** Sine of the cone's half angle, 1 if the cone is too wide to cull */
+    T cone_cutoff;
+
+    /**
+     *  @name Cluster
+     *  @fn Cluster(void)
+     *  @brief  Constructor
+     */
+    Cluster(void) : first_tri(0), n_tri(0), n_vertex(0), radius(0),
+                    cone_cutoff(1) {}
+
+    /**
+     *  @name IsBackfacing
+     *  @fn bool IsBackfacing(const Vertex& eye) const
+     *  @brief  Check if every triangle of the cluster faces away from a
+     *          viewpoint (perspective projection)
+     *  @param[in]  eye Camera position, same space as the vertices
+     *  @return True if the cluster can be culled
+     */
+    bool IsBackfacing(const Vertex& eye) const {
+      const Vertex d = cone_apex - eye;
+      const T len = d.Norm();
+      return cone_cutoff < T(1.0) && len > T(0.0) &&
+             d * cone_axis >= cone_cutoff * len;
+    }
+
+    /**
+     *  @name IsOutside
+     *  @fn bool IsOutside(const Vector4<T>* plane, const size_t n_plane) const
+     *  @brief  Check if the bounding sphere lies entirely behind one of the
+     *          planes (i.e. frustum planes extracted from the view-projection
+     *          matrix, inside being a*x + b*y + c*z + d >= 0)
+     *  @param[in]  plane   Planes (a, b, c, d), not necessarily normalized
+     *  @param[in]  n_plane Number of plane
+     *  @return True if the cluster can be culled
+     */
+    bool IsOutside(const Vector4<T>* plane, const size_t n_plane) const {
+      for (size_t i = 0; i < n_plane; ++i) {
+        const Vector4<T>& p = plane[i];
+        const T n = std::sqrt(p.x_ * p.x_ + p.y_ * p.y_ + p.z_ * p.z_);
+        const T dist = (p.x_ * center.x_ + p.y_ * center.y_ +
+                        p.z_ * center.z_ + p.w_);
+        if (dist < -radius * n) {
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  /** Default maximum number of vertex per cluster */
+  static const size_t kMaxVertex;
+  /** Default maximum number of triangle per cluster */
+  static const size_t kMaxTriangle;
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name Partition
+   *  @fn static int Partition(const std::vector<Vertex>& vertex,
+                               const size_t max_vertex,
+                               const size_t max_tri,
+                               std::vector<Triangle>* tri,
+                               std::vector<Cluster>* cluster)
+   *  @brief  Split triangles into clusters, triangles are reordered cluster
+   *          after cluster. Bounds are computed on the thread pool.
+   *  @param[in]      vertex      Positions
+   *  @param[in]      max_vertex  Maximum number of vertex per cluster (>= 3)
+   *  @param[in]      max_tri     Maximum number of triangle per cluster
+   *  @param[in,out]  tri         Triangles to partition
+   *  @param[out]     cluster     Clusters
+   *  @return -1 if a triangle is out of range or the budgets are invalid,
+   *          0 otherwise
+   */
+  static int Partition(const std::vector<Vertex>& vertex,
+                       const size_t max_vertex,
+                       const size_t max_tri,
+                       std::vector<Triangle>* tri,
+                       std::vector<Cluster>* cluster);
+
+  /**
+   *  @name ComputeBounds
+   *  @fn static void ComputeBounds(const std::vector<Vertex>& vertex,
+                                    const std::vector<Triangle>& tri,
+                                    Cluster* cluster)
+   *  @brief  Compute box, sphere and normal cone of a cluster's range (i.e.
+   *          after the vertices moved)
+   *  @param[in]      vertex  Positions
+   *  @param[in]      tri     Triangles
+   *  @param[in,out]  cluster Cluster, range given
+   */
+  static void ComputeBounds(const std::vector<Vertex>& vertex,
+                            const std::vector<Triangle>& tri,
+                            Cluster* cluster);
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MESH_PARTITIONER__ */
@@ -0,0 +1,148 @@
+/**
+ *  @file   mesh_simplifier.hpp
+ *  @brief  Quadric error metric decimation producing a chain of LODs
+ *  @ingroup geometry
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#ifndef __OGLKIT_MESH_SIMPLIFIER__
+#define __OGLKIT_MESH_SIMPLIFIER__
+
+#include <vector>
+
+#include "oglkit/core/library_export.hpp"
+#include "oglkit/core/math/vector.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @class  MeshSimplifier
+ *  @brief  Edge collapse decimation driven by quadric error metrics
+ *          (Garland & Heckbert, "Surface Simplification Using Quadric Error
+ *          Metrics", 1997):
+ *            - Vertices are collapsed onto one of their neighbours, LODs
+ *              therefore index the original vertex buffer and keep every
+ *              attribute as is.
+ *            - Vertices sharing a position are wedges of an attribute seam
+ *              (UV, normal, ...). Seam and border vertices only slide along
+ *              their seam / border, wedges move together.
+ *            - Collapses are processed in passes: costs are evaluated on the
+ *              thread pool, sorted, then the cheapest independent ones are
+ *              applied.
+ *          Errors are distances relative to the largest extent of the mesh.
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  @ingroup geometry
+ *  @tparam T Data type
+ */
+template<typename T>
+class OGLKIT_EXPORTS MeshSimplifier {
+ public:
+
+#pragma mark -
+#pragma mark Type definition
+
+  /** Vertex */
+  using Vertex = OGLKit::Vector3<T>;
+  /** Triangle */
+  using Triangle = OGLKit::Vector3<int>;
+
+  /**
+   *  @struct Level
+   *  @brief  Stopping criteria of one level of detail, whichever is reached
+   *          first
+   */
+  struct Level {
+    /** Target number of triangle */
+    size_t n_tri;
+    /** Maximum error, relative to the mesh's extent */
+    T max_error;
+
+    /**
+     *  @name Level
+     *  @fn Level(const size_t n_tri, const T max_error)
+     *  @brief  Constructor
+     *  @param[in]  n_tri     Target number of triangle
+     *  @param[in]  max_error Maximum relative error
+     */
+    Level(const size_t n_tri, const T max_error) : n_tri(n_tri),
+                                                   max_error(max_error) {}
+  };
+
+  /**
+   *  @struct LOD
+   *  @brief  Simplified triangulation, indexing the original vertices
+   */
+  struct LOD {
+    /** Triangles */
+    std::vector<Triangle> tri;
+    /** Largest error introduced so far, relative to the mesh's extent */
+    T error;
+
+    /**
+     *  @name LOD
+     *  @fn LOD(void)
+     *  @brief  Constructor
+     */
+    LOD(void) : error(0) {}
+  };
+
+#pragma mark -
+#pragma mark Usage
+
+  /**
+   *  @name BuildLOD
+   *  @fn static int BuildLOD(const std::vector<Vertex>& vertex,
+                              const std::vector<Triangle>& tri,
+                              const std::vector<Level>& level,
+                              const bool lock_boundary,
+                              std::vector<LOD>* lod)
+   *  @brief  Simplify a triangulation into a chain of LODs, each level
+   *          continues from the previous one
+   *  @param[in]  vertex        Positions
+   *  @param[in]  tri           Triangles
+   *  @param[in]  level         Criteria of each level, coarser and coarser
+   *  @param[in]  lock_boundary Keep open borders untouched
+   *  @param[out] lod           One triangulation per level
+   *  @return -1 if a triangle is out of range, 0 otherwise
+   */
+  static int BuildLOD(const std::vector<Vertex>& vertex,
+                      const std::vector<Triangle>& tri,
+                      const std::vector<Level>& level,
+                      const bool lock_boundary,
+                      std::vector<LOD>* lod);
+
+  /**
+   *  @name Simplify
+   *  @fn static int Simplify(const std::vector<Vertex>& vertex,
+                              const size_t n_tri,
+                              const T max_error,
+                              const bool lock_boundary,
+                              std::vector<Triangle>* tri,
+                              T* error)
+   *  @brief  Simplify a triangulation in place, single level
+   *  @param[in]      vertex        Positions
+   *  @param[in]      n_tri         Target number of triangle
+   *  @param[in]      max_error     Maximum relative error
+   *  @param[in]      lock_boundary Keep open borders untouched
+   *  @param[in,out]  tri           Triangles to simplify
+   *  @param[out]     error         Error introduced (optional)
+   *  @return -1 if a triangle is out of range, 0 otherwise
+   */
+  static int Simplify(const std::vector<Vertex>& vertex,
+                      const size_t n_tri,
+                      const T max_error,
+                      const bool lock_boundary,
+                      std::vector<Triangle>* tri,
+                      T* error);
+};
+
+}  // namespace OGLKit
+#endif /* __OGLKIT_MESH_SIMPLIFIER__ */
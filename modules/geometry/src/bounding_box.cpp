@@ -0,0 +1,430 @@
+/**
+ *  @file   bounding_box.cpp
+ *  @brief  Vectorized min / max reduction computing the bounding box of a
+ *          set of vertices
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OGLKIT_BBOX_AVX
+#elif (defined(__SSE2__) || defined(_M_X64) || \
+       (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define OGLKIT_BBOX_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define OGLKIT_BBOX_NEON
+#endif
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/bounding_box.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Number of vertex gathered before being reduced */
+static const size_t kGatherSize = 256;
+
+/** Minimum number of vertex (or index) handled by a thread */
+template<typename T>
+const size_t BoundingBox<T>::kBlockSize = 1 << 16;
+
+#pragma mark -
+#pragma mark Type definition
+
+/**
+ *  @struct BoxLane
+ *  @brief  Register holding kWidth consecutive scalars, scalar fallback
+ *  @tparam T Data type
+ */
+template<typename T>
+struct BoxLane {
+  /** Register */
+  using Reg = T;
+  /** Number of scalar per register */
+  static const size_t kWidth = 1;
+  /** Unaligned load */
+  static Reg Load(const T* p) { return *p; }
+  /** Element-wise minimum */
+  static Reg Min(const Reg a, const Reg b) { return a < b ? a : b; }
+  /** Element-wise maximum */
+  static Reg Max(const Reg a, const Reg b) { return a > b ? a : b; }
+  /** Unaligned store */
+  static void Store(const Reg a, T* p) { *p = a; }
+};
+
+#if defined(OGLKIT_BBOX_AVX)
+/** AVX, 8 floats */
+template<>
+struct BoxLane<float> {
+  using Reg = __m256;
+  static const size_t kWidth = 8;
+  static Reg Load(const float* p) { return _mm256_loadu_ps(p); }
+  static Reg Min(const Reg a, const Reg b) { return _mm256_min_ps(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return _mm256_max_ps(a, b); }
+  static void Store(const Reg a, float* p) { _mm256_storeu_ps(p, a); }
+};
+/** AVX, 4 doubles */
+template<>
+struct BoxLane<double> {
+  using Reg = __m256d;
+  static const size_t kWidth = 4;
+  static Reg Load(const double* p) { return _mm256_loadu_pd(p); }
+  static Reg Min(const Reg a, const Reg b) { return _mm256_min_pd(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return _mm256_max_pd(a, b); }
+  static void Store(const Reg a, double* p) { _mm256_storeu_pd(p, a); }
+};
+#elif defined(OGLKIT_BBOX_SSE2)
+/** SSE, 4 floats */
+template<>
+struct BoxLane<float> {
+  using Reg = __m128;
+  static const size_t kWidth = 4;
+  static Reg Load(const float* p) { return _mm_loadu_ps(p); }
+  static Reg Min(const Reg a, const Reg b) { return _mm_min_ps(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return _mm_max_ps(a, b); }
+  static void Store(const Reg a, float* p) { _mm_storeu_ps(p, a); }
+};
+/** SSE2, 2 doubles */
+template<>
+struct BoxLane<double> {
+  using Reg = __m128d;
+  static const size_t kWidth = 2;
+  static Reg Load(const double* p) { return _mm_loadu_pd(p); }
+  static Reg Min(const Reg a, const Reg b) { return _mm_min_pd(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return _mm_max_pd(a, b); }
+  static void Store(const Reg a, double* p) { _mm_storeu_pd(p, a); }
+};
+#elif defined(OGLKIT_BBOX_NEON)
+/** NEON, 4 floats */
+template<>
+struct BoxLane<float> {
+  using Reg = float32x4_t;
+  static const size_t kWidth = 4;
+  static Reg Load(const float* p) { return vld1q_f32(p); }
+  static Reg Min(const Reg a, const Reg b) { return vminq_f32(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return vmaxq_f32(a, b); }
+  static void Store(const Reg a, float* p) { vst1q_f32(p, a); }
+};
+#if defined(__aarch64__)
+/** NEON (AArch64), 2 doubles */
+template<>
+struct BoxLane<double> {
+  using Reg = float64x2_t;
+  static const size_t kWidth = 2;
+  static Reg Load(const double* p) { return vld1q_f64(p); }
+  static Reg Min(const Reg a, const Reg b) { return vminq_f64(a, b); }
+  static Reg Max(const Reg a, const Reg b) { return vmaxq_f64(a, b); }
+  static void Store(const Reg a, double* p) { vst1q_f64(p, a); }
+};
+#endif
+#endif
+
+/**
+ *  @name ExtendBox
+ *  @fn static void ExtendBox(const T* p, const size_t n, T* lo, T* hi)
+ *  @brief  Reduce n packed xyz triplets into lo / hi. The input is read as a
+ *          flat stream by blocks of 3 registers (kWidth vertices), scalar j
+ *          of a block always being component j % 3. Lanes are folded once at
+ *          the end, the remaining vertices are handled one by one.
+ *  @param[in]      p   Packed positions
+ *  @param[in]      n   Number of vertex
+ *  @param[in,out]  lo  Minimum, 3 components
+ *  @param[in,out]  hi  Maximum, 3 components
+ */
+template<typename T>
+static void ExtendBox(const T* p, const size_t n, T* lo, T* hi) {
+  using Lane = BoxLane<T>;
+  const size_t w = Lane::kWidth;
+  const size_t n_block = n / w;
+  size_t i = 0;
+  if (n_block > 0) {
+    // Two blocks per iteration, independent accumulators hide the latency
+    typename Lane::Reg mn[6], mx[6];
+    for (size_t k = 0; k < 6; ++k) {
+      mn[k] = mx[k] = Lane::Load(p + (k % 3) * w);
+    }
+    size_t b = 1;
+    for (; b + 1 < n_block; b += 2) {
+      const T* q = p + 3 * w * b;
+      for (size_t k = 0; k < 6; ++k) {
+        const typename Lane::Reg r = Lane::Load(q + k * w);
+        mn[k] = Lane::Min(mn[k], r);
+        mx[k] = Lane::Max(mx[k], r);
+      }
+    }
+    if (b < n_block) {
+      const T* q = p + 3 * w * b;
+      for (size_t k = 0; k < 3; ++k) {
+        const typename Lane::Reg r = Lane::Load(q + k * w);
+        mn[k] = Lane::Min(mn[k], r);
+        mx[k] = Lane::Max(mx[k], r);
+      }
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      mn[k] = Lane::Min(mn[k], mn[k + 3]);
+      mx[k] = Lane::Max(mx[k], mx[k + 3]);
+    }
+    T s_lo[3 * Lane::kWidth];
+    T s_hi[3 * Lane::kWidth];
+    for (size_t k = 0; k < 3; ++k) {
+      Lane::Store(mn[k], s_lo + k * w);
+      Lane::Store(mx[k], s_hi + k * w);
+    }
+    for (size_t j = 0; j < 3 * w; ++j) {
+      const size_t c = j % 3;
+      lo[c] = lo[c] < s_lo[j] ? lo[c] : s_lo[j];
+      hi[c] = hi[c] > s_hi[j] ? hi[c] : s_hi[j];
+    }
+    i = n_block * w;
+  }
+  for (; i < n; ++i) {
+    const T* v = p + 3 * i;
+    for (size_t c = 0; c < 3; ++c) {
+      lo[c] = lo[c] < v[c] ? lo[c] : v[c];
+      hi[c] = hi[c] > v[c] ? hi[c] : v[c];
+    }
+  }
+}
+
+/**
+ *  @name GatherBox
+ *  @fn static int GatherBox(const Vector3<T>* vertex, const size_t n_vertex,
+                             const int* index, const size_t n,
+                             AABB<T>* bbox)
+ *  @brief  Extend a box with indexed vertices, copied into small packed
+ *          batches reduced by ExtendBox
+ *  @param[in]      vertex    Vertices
+ *  @param[in]      n_vertex  Number of vertex
+ *  @param[in]      index     Indices
+ *  @param[in]      n         Number of index
+ *  @param[in,out]  bbox      Box to extend
+ *  @return -1 if an index is out of range, 0 otherwise
+ */
+template<typename T>
+static int GatherBox(const Vector3<T>* vertex,
+                     const size_t n_vertex,
+                     const int* index,
+                     const size_t n,
+                     AABB<T>* bbox) {
+  T buffer[3 * kGatherSize];
+  for (size_t i = 0; i < n; i += kGatherSize) {
+    const size_t m = std::min(kGatherSize, n - i);
+    for (size_t j = 0; j < m; ++j) {
+      // Negative indices wrap around to large values
+      const size_t v = static_cast<size_t>(index[i + j]);
+      if (v >= n_vertex) {
+        return -1;
+      }
+      buffer[3 * j] = vertex[v].x_;
+      buffer[3 * j + 1] = vertex[v].y_;
+      buffer[3 * j + 2] = vertex[v].z_;
+    }
+    ExtendBox(buffer, m, &bbox->min_.x_, &bbox->max_.x_);
+  }
+  return 0;
+}
+
+/**
+ *  @name ReduceBox
+ *  @fn static int ReduceBox(const size_t n, const size_t grain,
+                             const F& fcn, AABB<T>* bbox)
+ *  @brief  Run fcn(begin, end, box) over [0, n[, split on the thread pool
+ *          when large enough, and merge the partial boxes
+ *  @param[in]  n     Number of element
+ *  @param[in]  grain Minimum number of element per thread
+ *  @param[in]  fcn   Partial reduction, returns -1 on error
+ *  @param[out] bbox  Bounding box
+ *  @return -1 if any partial reduction failed, 0 otherwise
+ */
+template<typename T, typename F>
+static int ReduceBox(const size_t n,
+                     const size_t grain,
+                     const F& fcn,
+                     AABB<T>* bbox) {
+  *bbox = BoundingBox<T>::Empty();
+  int err = 0;
+  if (n >= 2 * grain) {
+    auto& pool = ThreadPool::Instance();
+    // At most one block per worker + calling thread
+    std::vector<AABB<T>> partial(pool.size() + 1, BoundingBox<T>::Empty());
+    std::vector<int> error(partial.size(), 0);
+    std::atomic<size_t> slot(0);
+    pool.ParallelFor(0, n, grain, [&](const size_t begin, const size_t end) {
+      const size_t s = slot++;
+      error[s] = fcn(begin, end, &partial[s]);
+    });
+    for (size_t s = 0; s < partial.size(); ++s) {
+      err |= error[s];
+      *bbox += partial[s];
+    }
+  } else {
+    err = fcn(0, n, bbox);
+  }
+  bbox->center_ = (bbox->min_ + bbox->max_) * T(0.5);
+  return err ? -1 : 0;
+}
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name InstructionSet
+ *  @fn static const char* InstructionSet(void)
+ *  @brief  Instruction set used by the reduction
+ *  @return "AVX", "SSE2", "NEON" or "Scalar"
+ */
+template<typename T>
+const char* BoundingBox<T>::InstructionSet(void) {
+  if (BoxLane<T>::kWidth == 1) {
+    return "Scalar";
+  }
+#if defined(OGLKIT_BBOX_AVX)
+  return "AVX";
+#elif defined(OGLKIT_BBOX_SSE2)
+  return "SSE2";
+#else
+  return "NEON";
+#endif
+}
+
+/*
+ *  @name Empty
+ *  @fn static AABB<T> Empty(void)
+ *  @brief  Box containing nothing, neutral element of the union
+ *  @return Empty box
+ */
+template<typename T>
+AABB<T> BoundingBox<T>::Empty(void) {
+  const T lo = std::numeric_limits<T>::lowest();
+  const T hi = std::numeric_limits<T>::max();
+  return AABB<T>(hi, lo, hi, lo, hi, lo);
+}
+
+/*
+ *  @name Extend
+ *  @fn static void Extend(const Vertex* vertex, const size_t n,
+                           AABB<T>* bbox)
+ *  @brief  Extend a box with n contiguous vertices on the calling thread
+ *          (i.e. from within an already parallel loop). The center is not
+ *          updated.
+ *  @param[in]      vertex  Vertices
+ *  @param[in]      n       Number of vertex
+ *  @param[in,out]  bbox    Box to extend
+ */
+template<typename T>
+void BoundingBox<T>::Extend(const Vertex* vertex,
+                            const size_t n,
+                            AABB<T>* bbox) {
+  if (n != 0) {
+    ExtendBox(&vertex->x_, n, &bbox->min_.x_, &bbox->max_.x_);
+  }
+}
+
+/*
+ *  @name Compute
+ *  @fn static void Compute(const std::vector<Vertex>& vertex,
+                            AABB<T>* bbox)
+ *  @brief  Compute the box of every vertex, empty if there is none
+ *  @param[in]  vertex  Vertices
+ *  @param[out] bbox    Bounding box
+ */
+template<typename T>
+void BoundingBox<T>::Compute(const std::vector<Vertex>& vertex,
+                             AABB<T>* bbox) {
+  ReduceBox(vertex.size(),
+            kBlockSize,
+            [&](const size_t begin, const size_t end, AABB<T>* box) {
+              Extend(vertex.data() + begin, end - begin, box);
+              return 0;
+            },
+            bbox);
+}
+
+/*
+ *  @name Compute
+ *  @fn static int Compute(const std::vector<Vertex>& vertex,
+                           const std::vector<int>& index,
+                           AABB<T>* bbox)
+ *  @brief  Compute the box of a subset of the vertices
+ *  @param[in]  vertex  Vertices
+ *  @param[in]  index   Index of the vertices to include, repetition allowed
+ *  @param[out] bbox    Bounding box
+ *  @return -1 if an index is out of range, 0 otherwise
+ */
+template<typename T>
+int BoundingBox<T>::Compute(const std::vector<Vertex>& vertex,
+                            const std::vector<int>& index,
+                            AABB<T>* bbox) {
+  return ReduceBox(index.size(),
+                   kBlockSize,
+                   [&](const size_t begin, const size_t end, AABB<T>* box) {
+                     return GatherBox(vertex.data(),
+                                      vertex.size(),
+                                      index.data() + begin,
+                                      end - begin,
+                                      box);
+                   },
+                   bbox);
+}
+
+/*
+ *  @name Compute
+ *  @fn static int Compute(const std::vector<Vertex>& vertex,
+                           const std::vector<Triangle>& tri,
+                           const size_t first_tri,
+                           const size_t n_tri,
+                           AABB<T>* bbox)
+ *  @brief  Compute the box of the vertices used by a range of triangles
+ *          (i.e. a cluster)
+ *  @param[in]  vertex    Vertices
+ *  @param[in]  tri       Triangles
+ *  @param[in]  first_tri First triangle of the range
+ *  @param[in]  n_tri     Number of triangle in the range
+ *  @param[out] bbox      Bounding box
+ *  @return -1 if the range or a corner is out of range, 0 otherwise
+ */
+template<typename T>
+int BoundingBox<T>::Compute(const std::vector<Vertex>& vertex,
+                            const std::vector<Triangle>& tri,
+                            const size_t first_tri,
+                            const size_t n_tri,
+                            AABB<T>* bbox) {
+  if (first_tri > tri.size() || n_tri > tri.size() - first_tri) {
+    *bbox = Empty();
+    return -1;
+  }
+  // Corners of the range seen as a flat index list
+  const int* index = n_tri ? &tri[first_tri].x_ : nullptr;
+  return ReduceBox(3 * n_tri,
+                   kBlockSize,
+                   [&](const size_t begin, const size_t end, AABB<T>* box) {
+                     return GatherBox(vertex.data(),
+                                      vertex.size(),
+                                      index + begin,
+                                      end - begin,
+                                      box);
+                   },
+                   bbox);
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float bounding box */
+template class BoundingBox<float>;
+/** Double bounding box */
+template class BoundingBox<double>;
+
+}  // namespace OGLKit
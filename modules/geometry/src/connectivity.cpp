@@ -0,0 +1,174 @@
+/**
+ *  @file   connectivity.cpp
+ *  @brief  Vertex connectivity stored as compressed sparse rows
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Number of triangle below which the connectivity is built serially */
+static const size_t kGrainSize = 1 << 16;
+
+/**
+ *  @struct RowEntry
+ *  @brief  Corner and its two neighbours, used to sort a row
+ */
+struct RowEntry {
+  /** Corner, 3 * triangle + position */
+  int corner;
+  /** Next vertex in winding order */
+  int first;
+  /** Previous vertex in winding order */
+  int second;
+};
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name Build
+ *  @fn int Build(const std::vector<Triangle>& tri, const size_t n_vertex,
+                  const bool parallel)
+ *  @brief  Build the connectivity of a triangulation: count, prefix sum
+ *          then fill. When run in parallel, each task handles a range of
+ *          triangles and rows are sorted by corner afterwards, the result
+ *          is identical to the serial one.
+ *  @param[in]  tri       Triangulation
+ *  @param[in]  n_vertex  Number of vertex
+ *  @param[in]  parallel  Use the library's thread pool
+ *  @return -1 if a triangle is out of range or the triangulation is too
+ *          large to be indexed with int, 0 otherwise
+ */
+int Connectivity::Build(const std::vector<Triangle>& tri,
+                        const size_t n_vertex,
+                        const bool parallel) {
+  const size_t n_tri = tri.size();
+  const size_t max_size = static_cast<size_t>(std::numeric_limits<int>::max());
+  if (n_tri > max_size / 6 || n_vertex >= max_size) {
+    this->Clear();
+    return -1;
+  }
+  const int n = static_cast<int>(n_vertex);
+  offset_.assign(n_vertex + 1, 0);
+  index_.resize(6 * n_tri);
+  corner_.resize(3 * n_tri);
+  if (!parallel || n_tri <= kGrainSize) {
+    // Count, two neighbours per corner
+    for (const auto& t : tri) {
+      const int* c = &t.x_;
+      for (int e = 0; e < 3; ++e) {
+        if (c[e] < 0 || c[e] >= n) {
+          this->Clear();
+          return -1;
+        }
+        offset_[c[e] + 1] += 2;
+      }
+    }
+    for (size_t i = 0; i < n_vertex; ++i) {
+      offset_[i + 1] += offset_[i];
+    }
+    // Fill, in triangle order
+    std::vector<int> cursor(offset_.begin(), offset_.end() - 1);
+    for (size_t f = 0; f < n_tri; ++f) {
+      const int* c = &tri[f].x_;
+      for (int e = 0; e < 3; ++e) {
+        int& p = cursor[c[e]];
+        index_[p] = c[(e + 1) % 3];
+        index_[p + 1] = c[(e + 2) % 3];
+        corner_[p / 2] = static_cast<int>(3 * f) + e;
+        p += 2;
+      }
+    }
+    return 0;
+  }
+  // Every task handles a contiguous range of triangles, rows are shared
+  // therefore counts and cursors are atomic.
+  auto& pool = ThreadPool::Instance();
+  std::vector<std::atomic<int>> cursor(n_vertex);
+  std::atomic<bool> valid(true);
+  pool.ParallelFor(0, n_tri, kGrainSize, [&](const size_t begin,
+                                             const size_t end) {
+    for (size_t f = begin; f < end; ++f) {
+      const int* c = &tri[f].x_;
+      for (int e = 0; e < 3; ++e) {
+        if (c[e] < 0 || c[e] >= n) {
+          valid.store(false, std::memory_order_relaxed);
+          return;
+        }
+        cursor[c[e]].fetch_add(2, std::memory_order_relaxed);
+      }
+    }
+  });
+  if (!valid.load()) {
+    this->Clear();
+    return -1;
+  }
+  for (size_t i = 0; i < n_vertex; ++i) {
+    offset_[i + 1] = offset_[i] + cursor[i].load(std::memory_order_relaxed);
+    cursor[i].store(offset_[i], std::memory_order_relaxed);
+  }
+  // Fill, rows end up in arbitrary order
+  pool.ParallelFor(0, n_tri, kGrainSize, [&](const size_t begin,
+                                             const size_t end) {
+    for (size_t f = begin; f < end; ++f) {
+      const int* c = &tri[f].x_;
+      for (int e = 0; e < 3; ++e) {
+        const int p = cursor[c[e]].fetch_add(2, std::memory_order_relaxed);
+        index_[p] = c[(e + 1) % 3];
+        index_[p + 1] = c[(e + 2) % 3];
+        corner_[p / 2] = static_cast<int>(3 * f) + e;
+      }
+    }
+  });
+  // Sort each row by corner, i.e. triangle order as in the serial case
+  pool.ParallelFor(0, n_vertex, kGrainSize, [&](const size_t begin,
+                                                const size_t end) {
+    std::vector<RowEntry> row;
+    for (size_t v = begin; v < end; ++v) {
+      const int lo = offset_[v] / 2;
+      const int hi = offset_[v + 1] / 2;
+      row.clear();
+      for (int k = lo; k < hi; ++k) {
+        row.push_back({corner_[k], index_[2 * k], index_[2 * k + 1]});
+      }
+      std::sort(row.begin(), row.end(),
+                [](const RowEntry& a, const RowEntry& b) {
+                  return a.corner < b.corner;
+                });
+      for (int k = lo; k < hi; ++k) {
+        const RowEntry& r = row[k - lo];
+        corner_[k] = r.corner;
+        index_[2 * k] = r.first;
+        index_[2 * k + 1] = r.second;
+      }
+    }
+  });
+  return 0;
+}
+
+/*
+ *  @name Clear
+ *  @fn void Clear(void)
+ *  @brief  Release the connectivity
+ */
+void Connectivity::Clear(void) {
+  std::vector<int>().swap(offset_);
+  std::vector<int>().swap(index_);
+  std::vector<int>().swap(corner_);
+}
+
+}  // namespace OGLKit
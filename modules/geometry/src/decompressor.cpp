@@ -0,0 +1,335 @@
+/**
+ *  @file   decompressor.cpp
+ *  @brief  Background decompression of gzip / zstd buffers
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include <zlib.h>
+#ifdef OGLKIT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "oglkit/geometry/decompressor.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Granularity of the decompression, consumers are notified at this rate */
+static const size_t kChunkSize = 1 << 20;
+/** Largest input handed to zlib at once (counters are 32 bits) */
+static const size_t kMaxZlibInput = 1 << 30;
+/** Deflate can not compress more than ~1032:1 */
+static const size_t kMaxDeflateRatio = 1032;
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name Decompressor
+ *  @fn Decompressor(void)
+ *  @brief  Constructor
+ */
+Decompressor::Decompressor(void) : input_(nullptr),
+                                   input_size_(0),
+                                   codec_(kNone),
+                                   capacity_(0),
+                                   written_(0),
+                                   available_(0),
+                                   done_(false),
+                                   error_(0),
+                                   stop_(false) {
+}
+
+/*
+ *  @name ~Decompressor
+ *  @fn ~Decompressor(void)
+ *  @brief  Destructor, stop the decompression if still running
+ */
+Decompressor::~Decompressor(void) {
+  this->Close();
+}
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name DetectCodec
+ *  @fn static Codec DetectCodec(const char* data, const size_t size)
+ *  @brief  Identify the compression format from the magic bytes
+ *  @param[in]  data  Beginning of the buffer
+ *  @param[in]  size  Buffer's size
+ *  @return Compression format, kNone if not compressed (or not supported)
+ */
+Decompressor::Codec Decompressor::DetectCodec(const char* data,
+                                              const size_t size) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+  if (size >= 2 && p[0] == 0x1F && p[1] == 0x8B) {
+    return kGzip;
+  }
+  if (size >= 4 && p[0] == 0x28 && p[1] == 0xB5 && p[2] == 0x2F &&
+      p[3] == 0xFD) {
+    return kZstd;
+  }
+  return kNone;
+}
+
+/*
+ *  @name Open
+ *  @fn int Open(const char* data, const size_t size)
+ *  @brief  Start the decompression of a given buffer. The buffer must stay
+ *          alive until Finish() or Close() returns.
+ *  @param[in]  data  Compressed data
+ *  @param[in]  size  Compressed size
+ *  @return -1 if the buffer is not compressed with a supported codec,
+ *          0 otherwise
+ */
+int Decompressor::Open(const char* data, const size_t size) {
+  this->Close();
+  codec_ = DetectCodec(data, size);
+  // Estimate the decompressed size
+  size_t hint = 0;
+  if (codec_ == kGzip) {
+    // ISIZE, size modulo 2^32 of the last member, little endian
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    if (size >= 18) {
+      p += size - 4;
+      hint = (static_cast<size_t>(p[0]) |
+              (static_cast<size_t>(p[1]) << 8) |
+              (static_cast<size_t>(p[2]) << 16) |
+              (static_cast<size_t>(p[3]) << 24));
+    }
+    hint = std::min(hint, size * kMaxDeflateRatio);
+  } else if (codec_ == kZstd) {
+#ifdef OGLKIT_WITH_ZSTD
+    const unsigned long long n = ZSTD_getFrameContentSize(data, size);
+    hint = (n != ZSTD_CONTENTSIZE_UNKNOWN && n != ZSTD_CONTENTSIZE_ERROR ?
+            static_cast<size_t>(n) :
+            4 * size);
+#else
+    std::cout << "Error, zstd support not available" << std::endl;
+    codec_ = kNone;
+#endif
+  }
+  if (codec_ == kNone) {
+    return -1;
+  }
+  input_ = data;
+  input_size_ = size;
+  capacity_ = std::max(hint, size_t(1));
+  buffer_.reset(new char[capacity_]);
+  worker_ = std::thread(&Decompressor::Run, this);
+  return 0;
+}
+
+/*
+ *  @name Wait
+ *  @fn size_t Wait(const size_t n)
+ *  @brief  Block until at least \p n bytes are decompressed or the end of
+ *          the stream is reached
+ *  @param[in]  n Number of byte needed
+ *  @return Number of byte available, smaller than \p n only at the end of
+ *          the stream
+ */
+size_t Decompressor::Wait(const size_t n) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [&] { return available_ >= n || done_; });
+  if (done_ && !overflow_.empty()) {
+    // Estimation was too small, make the output contiguous. The worker is
+    // done and the caller is not reading, it is safe to move the data.
+    std::unique_ptr<char[]> buffer(new char[written_]);
+    std::memcpy(buffer.get(), buffer_.get(), capacity_);
+    std::memcpy(buffer.get() + capacity_,
+                overflow_.data(),
+                written_ - capacity_);
+    buffer_.swap(buffer);
+    capacity_ = written_;
+    available_ = written_;
+    std::vector<char>().swap(overflow_);
+  }
+  return available_;
+}
+
+/*
+ *  @name Finish
+ *  @fn int Finish(void)
+ *  @brief  Wait until the whole stream is decompressed
+ *  @return -1 if the stream is corrupted or truncated, 0 otherwise
+ */
+int Decompressor::Finish(void) {
+  this->Wait(std::numeric_limits<size_t>::max());
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  return error_;
+}
+
+/*
+ *  @name Close
+ *  @fn void Close(void)
+ *  @brief  Stop decompressing and release the output
+ */
+void Decompressor::Close(void) {
+  stop_ = true;
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  input_ = nullptr;
+  input_size_ = 0;
+  codec_ = kNone;
+  buffer_.reset();
+  capacity_ = 0;
+  std::vector<char>().swap(overflow_);
+  written_ = 0;
+  available_ = 0;
+  done_ = false;
+  error_ = 0;
+  stop_ = false;
+}
+
+#pragma mark -
+#pragma mark Private
+
+/*
+ *  @name Run
+ *  @fn void Run(void)
+ *  @brief  Decompression loop, executed on the worker thread
+ */
+void Decompressor::Run(void) {
+  const int err = codec_ == kGzip ? this->InflateGzip() : this->InflateZstd();
+  std::lock_guard<std::mutex> lock(mutex_);
+  overflow_.resize(written_ > capacity_ ? written_ - capacity_ : 0);
+  available_ = std::min(written_, capacity_);
+  error_ = err;
+  done_ = true;
+  cond_.notify_all();
+}
+
+/*
+ *  @name InflateGzip
+ *  @fn int InflateGzip(void)
+ *  @brief  Decompress gzip members (zlib)
+ *  @return -1 if error, 0 otherwise
+ */
+int Decompressor::InflateGzip(void) {
+  z_stream strm;
+  std::memset(&strm, 0, sizeof(strm));
+  // 16 + MAX_WBITS : gzip wrapper
+  if (inflateInit2(&strm, 16 + MAX_WBITS) != Z_OK) {
+    return -1;
+  }
+  const char* in = input_;
+  size_t remaining = input_size_;
+  int error = 0;
+  while (!error) {
+    if (strm.avail_in == 0 && remaining != 0) {
+      const size_t n = std::min(remaining, kMaxZlibInput);
+      strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+      strm.avail_in = static_cast<uInt>(n);
+      in += n;
+      remaining -= n;
+    }
+    size_t n_out = 0;
+    char* out = this->Output(&n_out);
+    strm.next_out = reinterpret_cast<Bytef*>(out);
+    strm.avail_out = static_cast<uInt>(n_out);
+    const int ret = inflate(&strm, Z_NO_FLUSH);
+    if (!this->Produced(n_out - strm.avail_out)) {
+      error = -1;
+    } else if (ret == Z_STREAM_END) {
+      // Concatenated members, anything else is trailing garbage
+      if (strm.avail_in >= 2 && strm.next_in[0] == 0x1F &&
+          strm.next_in[1] == 0x8B) {
+        inflateReset(&strm);
+      } else {
+        break;
+      }
+    } else if (ret != Z_OK) {
+      // Corrupted, or truncated when input is exhausted (Z_BUF_ERROR)
+      error = -1;
+    }
+  }
+  inflateEnd(&strm);
+  return error;
+}
+
+/*
+ *  @name InflateZstd
+ *  @fn int InflateZstd(void)
+ *  @brief  Decompress zstd frames
+ *  @return -1 if error (or not supported), 0 otherwise
+ */
+int Decompressor::InflateZstd(void) {
+#ifdef OGLKIT_WITH_ZSTD
+  ZSTD_DStream* stream = ZSTD_createDStream();
+  if (!stream || ZSTD_isError(ZSTD_initDStream(stream))) {
+    ZSTD_freeDStream(stream);
+    return -1;
+  }
+  ZSTD_inBuffer in = {input_, input_size_, 0};
+  size_t ret = 0;
+  bool full = false;
+  int error = 0;
+  while (!error && (in.pos < in.size || full)) {
+    size_t n_out = 0;
+    ZSTD_outBuffer out = {this->Output(&n_out), 0, 0};
+    out.size = n_out;
+    ret = ZSTD_decompressStream(stream, &out, &in);
+    full = out.pos == out.size;
+    if (ZSTD_isError(ret) || !this->Produced(out.pos)) {
+      error = -1;
+    }
+  }
+  ZSTD_freeDStream(stream);
+  // Non zero hint means the last frame is incomplete
+  return error || ret != 0 ? -1 : 0;
+#else
+  return -1;
+#endif
+}
+
+/*
+ *  @name Output
+ *  @fn char* Output(size_t* n)
+ *  @brief  Provide where to write the next decompressed bytes
+ *  @param[out] n Space available at the returned location
+ *  @return Output location
+ */
+char* Decompressor::Output(size_t* n) {
+  if (written_ < capacity_) {
+    *n = std::min(capacity_ - written_, kChunkSize);
+    return buffer_.get() + written_;
+  }
+  // Only touched by the worker until done_ is raised
+  const size_t offset = written_ - capacity_;
+  overflow_.resize(offset + kChunkSize);
+  *n = kChunkSize;
+  return overflow_.data() + offset;
+}
+
+/*
+ *  @name Produced
+ *  @fn bool Produced(const size_t n)
+ *  @brief  Publish freshly decompressed bytes
+ *  @param[in]  n Number of byte written at the last Output() location
+ *  @return False if the decompression has been cancelled
+ */
+bool Decompressor::Produced(const size_t n) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  written_ += n;
+  available_ = std::min(written_, capacity_);
+  cond_.notify_all();
+  return !stop_;
+}
+
+}  // namespace OGLKit
@@ -0,0 +1,737 @@
+/**
+ *  @file   gltf.cpp
+ *  @brief  glTF 2.0 asset reader (.gltf + .bin, .glb)
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stack>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "oglkit/geometry/gltf.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** .glb magic number, "glTF" */
+static const uint32_t kGLBMagic = 0x46546C67;
+/** .glb JSON chunk type, "JSON" */
+static const uint32_t kGLBChunkJSON = 0x4E4F534A;
+/** .glb BIN chunk type, "BIN\0" */
+static const uint32_t kGLBChunkBIN = 0x004E4942;
+
+/**
+ *  @name IsBigEndian
+ *  @fn bool IsBigEndian(void)
+ *  @brief  Check host byte order, glTF data are little endian
+ *  @return True if host is big endian
+ */
+static bool IsBigEndian(void) {
+  const uint16_t one = 1;
+  return *reinterpret_cast<const uint8_t*>(&one) != 1;
+}
+
+/**
+ *  @name LoadLE
+ *  @fn V LoadLE(const char* p, const bool swap)
+ *  @brief  Read a little endian value from an unaligned location
+ *  @param[in]  p     Where to read
+ *  @param[in]  swap  Reverse byte order (big endian host)
+ *  @return Value
+ */
+template<typename V>
+static inline V LoadLE(const char* p, const bool swap) {
+  char bytes[sizeof(V)];
+  std::memcpy(bytes, p, sizeof(V));
+  if (swap) {
+    std::reverse(bytes, bytes + sizeof(V));
+  }
+  V value;
+  std::memcpy(&value, bytes, sizeof(V));
+  return value;
+}
+
+/**
+ *  @name ComponentSize
+ *  @fn size_t ComponentSize(const int type)
+ *  @brief  Size in bytes of an accessor's component
+ *  @param[in]  type  Component type
+ *  @return Size, 0 if unknown
+ */
+static size_t ComponentSize(const int type) {
+  switch (type) {
+    case GLTFAsset::kByte:
+    case GLTFAsset::kUByte: return 1;
+    case GLTFAsset::kShort:
+    case GLTFAsset::kUShort: return 2;
+    case GLTFAsset::kUInt:
+    case GLTFAsset::kFloat: return 4;
+    default: return 0;
+  }
+}
+
+/**
+ *  @name ReadComponent
+ *  @fn S ReadComponent(const char* p, const int type, const bool normalized,
+                        const bool swap)
+ *  @brief  Read an accessor's component and convert it to a scalar
+ *  @param[in]  p           Where to read
+ *  @param[in]  type        Component type
+ *  @param[in]  normalized  Map integers to [0, 1] / [-1, 1]
+ *  @param[in]  swap        Reverse byte order (big endian host)
+ *  @return Value
+ */
+template<typename S>
+static inline S ReadComponent(const char* p,
+                              const int type,
+                              const bool normalized,
+                              const bool swap) {
+  switch (type) {
+    case GLTFAsset::kFloat: return static_cast<S>(LoadLE<float>(p, swap));
+    case GLTFAsset::kUInt: return static_cast<S>(LoadLE<uint32_t>(p, swap));
+    case GLTFAsset::kUByte: {
+      const S v = static_cast<S>(static_cast<uint8_t>(*p));
+      return normalized ? v / S(255) : v;
+    }
+    case GLTFAsset::kByte: {
+      const S v = static_cast<S>(static_cast<int8_t>(*p));
+      return normalized ? std::max(v / S(127), S(-1)) : v;
+    }
+    case GLTFAsset::kUShort: {
+      const S v = static_cast<S>(LoadLE<uint16_t>(p, swap));
+      return normalized ? v / S(65535) : v;
+    }
+    case GLTFAsset::kShort: {
+      const S v = static_cast<S>(LoadLE<int16_t>(p, swap));
+      return normalized ? std::max(v / S(32767), S(-1)) : v;
+    }
+    default: return S(0);
+  }
+}
+
+/**
+ *  @name CopyAttribute
+ *  @fn void CopyAttribute(const GLTFAsset::Accessor& accessor,
+                           const int n_component, const S fill,
+                           std::vector<V>* attribute)
+ *  @brief  Copy an accessor into a vertex attribute. Tightly packed floats
+ *          matching the attribute's layout are copied in one go, others are
+ *          converted element-wise.
+ *  @param[in]  accessor    Source
+ *  @param[in]  n_component Number of component of the attribute
+ *  @param[in]  fill        Value of the components missing in the accessor
+ *                          (i.e. alpha of a RGB color)
+ *  @param[out] attribute   Destination
+ */
+template<typename V, typename S>
+static void CopyAttribute(const GLTFAsset::Accessor& accessor,
+                          const int n_component,
+                          const S fill,
+                          std::vector<V>* attribute) {
+  const bool swap = IsBigEndian();
+  attribute->resize(accessor.count);
+  if (std::is_same<S, float>::value && !swap &&
+      accessor.component_type == GLTFAsset::kFloat &&
+      accessor.n_component == n_component &&
+      sizeof(V) == n_component * sizeof(S) &&
+      accessor.stride == sizeof(V)) {
+    std::memcpy(static_cast<void*>(attribute->data()),
+                accessor.data,
+                accessor.count * sizeof(V));
+    return;
+  }
+  const size_t c_size = ComponentSize(accessor.component_type);
+  const int n = std::min(n_component, accessor.n_component);
+  const char* p = accessor.data;
+  for (size_t i = 0; i < accessor.count; ++i, p += accessor.stride) {
+    S* dst = &((*attribute)[i].x_);
+    for (int k = 0; k < n; ++k) {
+      dst[k] = ReadComponent<S>(p + (k * c_size),
+                                accessor.component_type,
+                                accessor.normalized,
+                                swap);
+    }
+    for (int k = n; k < n_component; ++k) {
+      dst[k] = fill;
+    }
+  }
+}
+
+/**
+ *  @name ToIndex
+ *  @fn int ToIndex(const JSONValue& value)
+ *  @brief  Read an index (non negative integer)
+ *  @param[in]  value Value holding the index
+ *  @return Index, -1 if missing or invalid
+ */
+static int ToIndex(const JSONValue& value) {
+  const double v = value.AsNumber(-1.0);
+  if (v < 0.0 || v > static_cast<double>(std::numeric_limits<int>::max()) ||
+      v != static_cast<double>(static_cast<int>(v))) {
+    return -1;
+  }
+  return static_cast<int>(v);
+}
+
+/**
+ *  @name ToSize
+ *  @fn bool ToSize(const JSONValue& value, const size_t def, size_t* size)
+ *  @brief  Read a size / offset (non negative integer)
+ *  @param[in]  value Value holding the size
+ *  @param[in]  def   Default value if missing
+ *  @param[out] size  Size
+ *  @return False if invalid
+ */
+static bool ToSize(const JSONValue& value, const size_t def, size_t* size) {
+  if (value.type() == JSONValue::kNull) {
+    *size = def;
+    return true;
+  }
+  const double v = value.AsNumber(-1.0);
+  if (v < 0.0 || v > 9007199254740992.0 || v != std::floor(v)) {
+    return false;
+  }
+  *size = static_cast<size_t>(v);
+  return true;
+}
+
+/**
+ *  @name DecodeURI
+ *  @fn std::string DecodeURI(const std::string& uri)
+ *  @brief  Resolve percent-encoded characters of a relative uri
+ *  @param[in]  uri Uri
+ *  @return Decoded path
+ */
+static std::string DecodeURI(const std::string& uri) {
+  std::string path;
+  for (size_t i = 0; i < uri.size(); ++i) {
+    if (uri[i] == '%' && i + 2 < uri.size() &&
+        std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+        std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+      path.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2),
+                                                 nullptr,
+                                                 16)));
+      i += 2;
+    } else {
+      path.push_back(uri[i]);
+    }
+  }
+  return path;
+}
+
+/**
+ *  @name DecodeBase64
+ *  @fn int DecodeBase64(const std::string& str, const size_t first,
+                         std::vector<char>* data)
+ *  @brief  Decode the base64 payload of a data uri
+ *  @param[in]  str   Data uri
+ *  @param[in]  first Beginning of the payload
+ *  @param[out] data  Decoded data
+ *  @return -1 if malformed, 0 otherwise
+ */
+static int DecodeBase64(const std::string& str,
+                        const size_t first,
+                        std::vector<char>* data) {
+  data->clear();
+  data->reserve(((str.size() - first) / 4) * 3);
+  uint32_t acc = 0;
+  int n_bit = 0;
+  for (size_t i = first; i < str.size() && str[i] != '='; ++i) {
+    const char c = str[i];
+    int v;
+    if (c >= 'A' && c <= 'Z') {
+      v = c - 'A';
+    } else if (c >= 'a' && c <= 'z') {
+      v = c - 'a' + 26;
+    } else if (c >= '0' && c <= '9') {
+      v = c - '0' + 52;
+    } else if (c == '+') {
+      v = 62;
+    } else if (c == '/') {
+      v = 63;
+    } else {
+      return -1;
+    }
+    acc = (acc << 6) | static_cast<uint32_t>(v);
+    n_bit += 6;
+    if (n_bit >= 8) {
+      n_bit -= 8;
+      data->push_back(static_cast<char>((acc >> n_bit) & 0xFF));
+    }
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name GLTFAsset
+ *  @fn GLTFAsset(void)
+ *  @brief  Constructor
+ */
+GLTFAsset::GLTFAsset(void) {
+}
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name Load
+ *  @fn int Load(const std::string& path)
+ *  @brief  Load a .gltf or .glb file, external buffers are resolved
+ *          relative to the file's directory
+ *  @param[in]  path  Path to the asset
+ *  @return -1 if error, 0 otherwise
+ */
+int GLTFAsset::Load(const std::string& path) {
+  std::unique_ptr<MemoryMap> file(new MemoryMap());
+  if (file->Open(path)) {
+    return -1;
+  }
+  const size_t pos = path.rfind('/');
+  const std::string dir = pos != std::string::npos ? path.substr(0, pos + 1) :
+                                                     "";
+  const int err = this->Load(file->data(), file->size(), dir);
+  if (!err) {
+    // Accessors might point into the .glb mapping
+    file_.push_back(std::move(file));
+  }
+  return err;
+}
+
+/*
+ *  @name Load
+ *  @fn int Load(const char* data, const size_t size,
+                 const std::string& directory)
+ *  @brief  Load an asset from a buffer holding a .gltf or .glb file. The
+ *          buffer must stay alive as long as the asset is used.
+ *  @param[in]  data      Buffer
+ *  @param[in]  size      Buffer's size
+ *  @param[in]  directory Folder where external buffers are located
+ *  @return -1 if error, 0 otherwise
+ */
+int GLTFAsset::Load(const char* data,
+                    const size_t size,
+                    const std::string& directory) {
+  json_ = JSONValue();
+  file_.clear();
+  decoded_.clear();
+  buffer_.clear();
+  primitive_.clear();
+  const char* json = data;
+  size_t json_size = size;
+  const char* bin = nullptr;
+  size_t bin_size = 0;
+  const bool swap = IsBigEndian();
+  if (size >= 12 && LoadLE<uint32_t>(data, swap) == kGLBMagic) {
+    // Binary container: header, JSON chunk, optional BIN chunk
+    const size_t length = LoadLE<uint32_t>(data + 8, swap);
+    if (LoadLE<uint32_t>(data + 4, swap) != 2 || length > size ||
+        length < 20 || LoadLE<uint32_t>(data + 16, swap) != kGLBChunkJSON) {
+      return -1;
+    }
+    json = data + 20;
+    json_size = LoadLE<uint32_t>(data + 12, swap);
+    if (json_size > length - 20) {
+      return -1;
+    }
+    const size_t next = 20 + json_size;
+    if (next + 8 <= length &&
+        LoadLE<uint32_t>(data + next + 4, swap) == kGLBChunkBIN) {
+      bin = data + next + 8;
+      bin_size = LoadLE<uint32_t>(data + next, swap);
+      if (bin_size > length - next - 8) {
+        return -1;
+      }
+    }
+  }
+  if (json_.Parse(json, json + json_size) ||
+      json_["asset"]["version"].AsString().compare(0, 2, "2.") != 0) {
+    std::cout << "Error, not a glTF 2.0 asset" << std::endl;
+    return -1;
+  }
+  if (this->LoadBuffers(bin, bin_size, directory) ||
+      this->ListPrimitives(directory)) {
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ *  @name GetAccessor
+ *  @fn int GetAccessor(const int index, Accessor* accessor) const
+ *  @brief  Resolve an accessor and check it lies within its buffer
+ *  @param[in]  index     Accessor's index
+ *  @param[out] accessor  Resolved accessor
+ *  @return -1 if invalid or not supported (i.e. sparse), 0 otherwise
+ */
+int GLTFAsset::GetAccessor(const int index, Accessor* accessor) const {
+  const JSONValue& acc = json_["accessors"][static_cast<size_t>(index)];
+  const JSONValue& view = json_["bufferViews"][static_cast<size_t>(
+                                  ToIndex(acc["bufferView"]))];
+  const int buffer = ToIndex(view["buffer"]);
+  if (index < 0 || acc.type() != JSONValue::kObject || acc.Has("sparse") ||
+      view.type() != JSONValue::kObject || buffer < 0 ||
+      static_cast<size_t>(buffer) >= buffer_.size()) {
+    return -1;
+  }
+  const std::string& type = acc["type"].AsString();
+  static const char* kTypes[] = {"SCALAR", "VEC2", "VEC3", "VEC4"};
+  accessor->n_component = 0;
+  for (int k = 0; k < 4; ++k) {
+    if (type == kTypes[k]) {
+      accessor->n_component = k + 1;
+    }
+  }
+  accessor->component_type = ToIndex(acc["componentType"]);
+  accessor->normalized = acc["normalized"].AsBool(false);
+  const size_t c_size = ComponentSize(accessor->component_type);
+  const size_t e_size = c_size * accessor->n_component;
+  size_t acc_offset, view_offset, view_length;
+  if (e_size == 0 ||
+      !ToSize(acc["count"], 0, &accessor->count) ||
+      !ToSize(acc["byteOffset"], 0, &acc_offset) ||
+      !ToSize(view["byteOffset"], 0, &view_offset) ||
+      !ToSize(view["byteLength"], std::numeric_limits<size_t>::max(),
+              &view_length) ||
+      !ToSize(view["byteStride"], e_size, &accessor->stride) ||
+      accessor->stride < e_size || accessor->count == 0) {
+    return -1;
+  }
+  // Range covered by the accessor must fit in the view, itself in the buffer
+  const Buffer& buf = buffer_[buffer];
+  const size_t extent = (accessor->count - 1) * accessor->stride + e_size;
+  if ((accessor->count - 1) > std::numeric_limits<size_t>::max() /
+                              accessor->stride ||
+      view_offset > buf.size || view_length > buf.size - view_offset ||
+      acc_offset > view_length || extent > view_length - acc_offset) {
+    return -1;
+  }
+  accessor->data = buf.data + view_offset + acc_offset;
+  return 0;
+}
+
+/*
+ *  @name GetBounds
+ *  @fn int GetBounds(const int index, AABB<T>* bbox) const
+ *  @brief  Bounding box stored in an accessor (min / max), required for
+ *          POSITION
+ *  @param[in]  index Accessor's index
+ *  @param[out] bbox  Bounding box
+ *  @return -1 if not available, 0 otherwise
+ */
+template<typename T>
+int GLTFAsset::GetBounds(const int index, AABB<T>* bbox) const {
+  const JSONValue& acc = json_["accessors"][static_cast<size_t>(index)];
+  const JSONValue& min = acc["min"];
+  const JSONValue& max = acc["max"];
+  if (index < 0 || min.size() < 3 || max.size() < 3) {
+    return -1;
+  }
+  T* b_min = &bbox->min_.x_;
+  T* b_max = &bbox->max_.x_;
+  for (size_t k = 0; k < 3; ++k) {
+    if (min[k].type() != JSONValue::kNumber ||
+        max[k].type() != JSONValue::kNumber) {
+      return -1;
+    }
+    b_min[k] = static_cast<T>(min[k].AsNumber(0.0));
+    b_max[k] = static_cast<T>(max[k].AsNumber(0.0));
+  }
+  bbox->center_ = (bbox->min_ + bbox->max_) * T(0.5);
+  return 0;
+}
+
+/*
+ *  @name Extract
+ *  @fn int Extract(const size_t i, Mesh<T>* mesh) const
+ *  @brief  Copy a primitive into a mesh. Attributes stored as tightly
+ *          packed floats matching the mesh's layout are copied in one go
+ *          from the mapped buffer, others are converted element-wise.
+ *          Strips and fans are converted to triangle lists.
+ *  @param[in]  i     Primitive's index
+ *  @param[out] mesh  Mesh where to copy (attributes are replaced)
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int GLTFAsset::Extract(const size_t i, Mesh<T>* mesh) const {
+  using Triangle = typename Mesh<T>::Triangle;
+  if (i >= primitive_.size()) {
+    return -1;
+  }
+  const Primitive& prim = primitive_[i];
+  // Position
+  Accessor acc;
+  if (this->GetAccessor(prim.position, &acc) || acc.n_component != 3) {
+    return -1;
+  }
+  const size_t n_vertex = acc.count;
+  auto edit = mesh->Edit();
+  CopyAttribute(acc, 3, T(0), &edit.vertex());
+  // Optional attributes, must have one element per vertex
+  const int optional[] = {prim.normal, prim.tcoord, prim.tangent, prim.color};
+  edit.normal().clear();
+  edit.tex_coord().clear();
+  edit.tangent().clear();
+  edit.vertex_color().clear();
+  for (int k = 0; k < 4; ++k) {
+    if (optional[k] < 0) {
+      continue;
+    }
+    if (this->GetAccessor(optional[k], &acc) || acc.count != n_vertex) {
+      return -1;
+    }
+    switch (k) {
+      case 0: CopyAttribute(acc, 3, T(0), &edit.normal());
+        break;
+      case 1: CopyAttribute(acc, 2, T(0), &edit.tex_coord());
+        break;
+      // xyz and handedness (w)
+      case 2: CopyAttribute(acc, 4, T(1), &edit.tangent());
+        break;
+      default: CopyAttribute(acc, 4, T(1), &edit.vertex_color());
+        break;
+    }
+  }
+  // Indices, implicit when not provided
+  std::vector<uint32_t> index;
+  auto& tri = edit.triangle();
+  tri.clear();
+  const bool swap = IsBigEndian();
+  if (prim.indices >= 0) {
+    if (this->GetAccessor(prim.indices, &acc) || acc.n_component != 1 ||
+        acc.normalized || acc.component_type == kFloat ||
+        acc.component_type == kByte || acc.component_type == kShort) {
+      return -1;
+    }
+    if (prim.mode == kTriangles && acc.component_type == kUInt && !swap &&
+        acc.stride == 4 && acc.count % 3 == 0) {
+      // Same layout as Triangle, range is checked below
+      tri.resize(acc.count / 3);
+      std::memcpy(static_cast<void*>(tri.data()), acc.data, acc.count * 4);
+    } else {
+      index.resize(acc.count);
+      const char* p = acc.data;
+      for (size_t k = 0; k < acc.count; ++k, p += acc.stride) {
+        index[k] = ReadComponent<uint32_t>(p, acc.component_type, false, swap);
+      }
+    }
+  } else {
+    index.resize(n_vertex);
+    for (size_t k = 0; k < n_vertex; ++k) {
+      index[k] = static_cast<uint32_t>(k);
+    }
+  }
+  if (!index.empty() || tri.empty()) {
+    const size_t n = index.size();
+    if (prim.mode == kTriangles) {
+      if (n % 3 != 0) {
+        return -1;
+      }
+      tri.resize(n / 3);
+      for (size_t k = 0; k < n / 3; ++k) {
+        tri[k] = Triangle(static_cast<int>(index[3 * k]),
+                          static_cast<int>(index[(3 * k) + 1]),
+                          static_cast<int>(index[(3 * k) + 2]));
+      }
+    } else {
+      // Strip alternates winding, fan shares its first vertex
+      const size_t n_tri = n >= 3 ? n - 2 : 0;
+      tri.resize(n_tri);
+      for (size_t k = 0; k < n_tri; ++k) {
+        const uint32_t a = prim.mode == kTriangleFan ? index[0] : index[k];
+        const uint32_t b = index[k + 1];
+        const uint32_t c = index[k + 2];
+        tri[k] = (prim.mode == kTriangleStrip && (k & 1) ?
+                  Triangle(static_cast<int>(b), static_cast<int>(a),
+                           static_cast<int>(c)) :
+                  Triangle(static_cast<int>(a), static_cast<int>(b),
+                           static_cast<int>(c)));
+      }
+    }
+  }
+  for (const auto& t : tri) {
+    if (t.x_ < 0 || t.y_ < 0 || t.z_ < 0 ||
+        static_cast<size_t>(t.x_) >= n_vertex ||
+        static_cast<size_t>(t.y_) >= n_vertex ||
+        static_cast<size_t>(t.z_) >= n_vertex) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Private
+
+/*
+ *  @name LoadBuffers
+ *  @fn int LoadBuffers(const char* bin, const size_t bin_size,
+                        const std::string& directory)
+ *  @brief  Map every buffer, either from external files, base64 data uri
+ *          or the .glb BIN chunk
+ *  @param[in]  bin       .glb BIN chunk, nullptr if none
+ *  @param[in]  bin_size  Size of the BIN chunk
+ *  @param[in]  directory Folder where external buffers are located
+ *  @return -1 if error, 0 otherwise
+ */
+int GLTFAsset::LoadBuffers(const char* bin,
+                           const size_t bin_size,
+                           const std::string& directory) {
+  const JSONValue& buffers = json_["buffers"];
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const JSONValue& buffer = buffers[i];
+    const std::string& uri = buffer["uri"].AsString();
+    size_t length = 0;
+    if (!ToSize(buffer["byteLength"], 0, &length)) {
+      return -1;
+    }
+    Buffer buf = {nullptr, 0};
+    if (!buffer.Has("uri")) {
+      // .glb embedded buffer, can be padded
+      if (i != 0 || !bin || bin_size < length) {
+        std::cout << "Error, missing glb binary chunk" << std::endl;
+        return -1;
+      }
+      buf.data = bin;
+      buf.size = length;
+    } else if (uri.compare(0, 5, "data:") == 0) {
+      const size_t pos = uri.find(";base64,");
+      decoded_.push_back(std::vector<char>());
+      if (pos == std::string::npos ||
+          DecodeBase64(uri, pos + 8, &decoded_.back()) ||
+          decoded_.back().size() < length) {
+        std::cout << "Error, malformed glTF data uri" << std::endl;
+        return -1;
+      }
+      buf.data = decoded_.back().data();
+      buf.size = length;
+    } else {
+      const std::string path = directory + DecodeURI(uri);
+      std::unique_ptr<MemoryMap> file(new MemoryMap());
+      if (file->Open(path) || file->size() < length) {
+        std::cout << "Error, unable to load glTF buffer : " << path;
+        std::cout << std::endl;
+        return -1;
+      }
+      buf.data = file->data();
+      buf.size = length;
+      file_.push_back(std::move(file));
+    }
+    buffer_.push_back(buf);
+  }
+  return 0;
+}
+
+/*
+ *  @name ListPrimitives
+ *  @fn int ListPrimitives(const std::string& directory)
+ *  @brief  Walk the default scene and gather its triangle primitives
+ *  @param[in]  directory Folder where textures are located
+ *  @return -1 if error, 0 otherwise
+ */
+int GLTFAsset::ListPrimitives(const std::string& directory) {
+  const JSONValue& meshes = json_["meshes"];
+  const JSONValue& nodes = json_["nodes"];
+  // Meshes to process, from the scene's nodes or every mesh if no scene
+  std::vector<int> mesh_list;
+  const JSONValue& scenes = json_["scenes"];
+  if (scenes.size() > 0) {
+    const int s = json_.Has("scene") ? ToIndex(json_["scene"]) : 0;
+    const JSONValue& scene = scenes[static_cast<size_t>(s)];
+    if (s < 0 || scene.type() != JSONValue::kObject) {
+      return -1;
+    }
+    // Avoid recursion by using stack
+    std::vector<bool> visited(nodes.size(), false);
+    std::stack<int> queue;
+    for (size_t k = 0; k < scene["nodes"].size(); ++k) {
+      queue.push(ToIndex(scene["nodes"][k]));
+    }
+    while (!queue.empty()) {
+      const int n = queue.top();
+      queue.pop();
+      if (n < 0 || static_cast<size_t>(n) >= nodes.size() || visited[n]) {
+        return -1;
+      }
+      visited[n] = true;
+      const JSONValue& node = nodes[static_cast<size_t>(n)];
+      if (node.Has("mesh")) {
+        mesh_list.push_back(ToIndex(node["mesh"]));
+      }
+      for (size_t k = 0; k < node["children"].size(); ++k) {
+        queue.push(ToIndex(node["children"][k]));
+      }
+    }
+  } else {
+    for (size_t m = 0; m < meshes.size(); ++m) {
+      mesh_list.push_back(static_cast<int>(m));
+    }
+  }
+  // Triangle primitives, others (points, lines) are skipped
+  for (const int m : mesh_list) {
+    const JSONValue& mesh = meshes[static_cast<size_t>(m)];
+    if (m < 0 || mesh.type() != JSONValue::kObject) {
+      return -1;
+    }
+    const JSONValue& primitives = mesh["primitives"];
+    for (size_t k = 0; k < primitives.size(); ++k) {
+      const JSONValue& p = primitives[k];
+      const JSONValue& attr = p["attributes"];
+      Primitive prim;
+      prim.mode = p.Has("mode") ? ToIndex(p["mode"]) : kTriangles;
+      prim.position = ToIndex(attr["POSITION"]);
+      if (prim.position < 0 || (prim.mode != kTriangles &&
+                                prim.mode != kTriangleStrip &&
+                                prim.mode != kTriangleFan)) {
+        continue;
+      }
+      prim.normal = ToIndex(attr["NORMAL"]);
+      prim.tcoord = ToIndex(attr["TEXCOORD_0"]);
+      prim.tangent = ToIndex(attr["TANGENT"]);
+      prim.color = ToIndex(attr["COLOR_0"]);
+      prim.indices = ToIndex(p["indices"]);
+      prim.mesh = m;
+      // Base color texture, external images only
+      const JSONValue& material = json_["materials"][static_cast<size_t>(
+                                         ToIndex(p["material"]))];
+      const JSONValue& texture = json_["textures"][static_cast<size_t>(
+              ToIndex(material["pbrMetallicRoughness"]["baseColorTexture"]
+                      ["index"]))];
+      const std::string& uri = json_["images"][static_cast<size_t>(
+                                 ToIndex(texture["source"]))]["uri"].AsString();
+      if (!uri.empty() && uri.compare(0, 5, "data:") != 0) {
+        prim.texture = directory + DecodeURI(uri);
+      }
+      primitive_.push_back(prim);
+    }
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float */
+template int GLTFAsset::GetBounds<float>(const int, AABB<float>*) const;
+template int GLTFAsset::Extract<float>(const size_t, Mesh<float>*) const;
+/** Double */
+template int GLTFAsset::GetBounds<double>(const int, AABB<double>*) const;
+template int GLTFAsset::Extract<double>(const size_t, Mesh<double>*) const;
+
+}  // namespace OGLKit
@@ -0,0 +1,251 @@
+/**
+ *  @file   half_edge.cpp
+ *  @brief  Index based half-edge connectivity
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/half_edge.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Number of half-edge below which the structure is built serially */
+static const size_t kGrainSize = 1 << 16;
+/** Placeholder while looking for the smallest half-edge of a vertex */
+static const int kNoHalfEdge = std::numeric_limits<int>::max();
+
+/**
+ *  @name AtomicMin
+ *  @fn static void AtomicMin(const int value, std::atomic<int>* target)
+ *  @brief  Lower an atomic value to \p value if it is smaller
+ *  @param[in]      value   Candidate
+ *  @param[in,out]  target  Value to lower
+ */
+static void AtomicMin(const int value, std::atomic<int>* target) {
+  int current = target->load(std::memory_order_relaxed);
+  while (value < current &&
+         !target->compare_exchange_weak(current,
+                                        value,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name Build
+ *  @fn int Build(const std::vector<Triangle>& tri, const size_t n_vertex,
+                  const bool parallel)
+ *  @brief  Build the half-edges of a triangulation. Half-edges are bucketed
+ *          by their smallest end point (count, prefix sum, fill) and twins
+ *          are matched within each bucket, no global sort nor hashing
+ *          involved. The result does not depend on \p parallel.
+ *  @param[in]  tri       Triangulation
+ *  @param[in]  n_vertex  Number of vertex
+ *  @param[in]  parallel  Use the library's thread pool
+ *  @return -1 if a triangle is out of range or the triangulation is too
+ *          large to be indexed with int, 0 otherwise
+ */
+int HalfEdge::Build(const std::vector<Triangle>& tri,
+                    const size_t n_vertex,
+                    const bool parallel) {
+  const size_t n_he = 3 * tri.size();
+  const size_t max_size = static_cast<size_t>(std::numeric_limits<int>::max());
+  if (tri.size() > max_size / 3 || n_vertex >= max_size) {
+    this->Clear();
+    return -1;
+  }
+  const int n = static_cast<int>(n_vertex);
+  // Small problems are processed inline (single block)
+  auto& pool = ThreadPool::Instance();
+  const bool large = parallel && n_he > kGrainSize;
+  const size_t grain = large ? kGrainSize : std::numeric_limits<size_t>::max();
+  // Origins
+  std::atomic<bool> valid(true);
+  origin_.resize(n_he);
+  pool.ParallelFor(0, n_he, grain, [&](const size_t begin, const size_t end) {
+    for (size_t h = begin; h < end; ++h) {
+      const int v = (&tri[h / 3].x_)[h % 3];
+      if (v < 0 || v >= n) {
+        valid = false;
+      }
+      origin_[h] = v;
+    }
+  });
+  if (!valid) {
+    this->Clear();
+    return -1;
+  }
+  // Bucket half-edges by their smallest end point. Every task handles a
+  // range of half-edges, counts and cursors are therefore atomic. Buckets
+  // are filled in arbitrary order, they are sorted when matching twins.
+  std::vector<int> offset(n_vertex + 1, 0);
+  std::vector<int> bucket(n_he);
+  std::vector<std::atomic<int>> cursor(n_vertex);
+  auto key = [&](const size_t h) {
+    return std::min(origin_[h], origin_[Next(static_cast<int>(h))]);
+  };
+  pool.ParallelFor(0, n_he, grain, [&](const size_t begin, const size_t end) {
+    for (size_t h = begin; h < end; ++h) {
+      cursor[key(h)].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  for (size_t v = 0; v < n_vertex; ++v) {
+    offset[v + 1] = offset[v] + cursor[v].load(std::memory_order_relaxed);
+    cursor[v].store(offset[v], std::memory_order_relaxed);
+  }
+  pool.ParallelFor(0, n_he, grain, [&](const size_t begin, const size_t end) {
+    for (size_t h = begin; h < end; ++h) {
+      const int p = cursor[key(h)].fetch_add(1, std::memory_order_relaxed);
+      bucket[p] = static_cast<int>(h);
+    }
+  });
+  // Match twins within each bucket, grouped by their other end point.
+  // Non-manifold half-edges are tagged with -2.
+  twin_.resize(n_he);
+  pool.ParallelFor(0, n_vertex, grain / 8, [&](const size_t begin,
+                                               const size_t end) {
+    auto other = [&](const int h) {
+      return std::max(origin_[h], origin_[Next(h)]);
+    };
+    for (size_t v = begin; v < end; ++v) {
+      int* first = bucket.data() + offset[v];
+      int* last = bucket.data() + offset[v + 1];
+      std::sort(first, last, [&](const int a, const int b) {
+        const int oa = other(a);
+        const int ob = other(b);
+        return oa < ob || (oa == ob && a < b);
+      });
+      while (first != last) {
+        int* group = first + 1;
+        while (group != last && other(*group) == other(*first)) {
+          ++group;
+        }
+        const long n_group = group - first;
+        if (n_group == 1) {
+          twin_[first[0]] = -1;
+        } else if (n_group == 2 && origin_[first[0]] != origin_[first[1]]) {
+          twin_[first[0]] = first[1];
+          twin_[first[1]] = first[0];
+        } else {
+          for (int* h = first; h != group; ++h) {
+            twin_[*h] = -2;
+          }
+        }
+        first = group;
+      }
+    }
+  });
+  non_manifold_.clear();
+  for (size_t h = 0; h < n_he; ++h) {
+    if (twin_[h] == -2) {
+      twin_[h] = -1;
+      non_manifold_.push_back(static_cast<int>(h));
+    }
+  }
+  // Outgoing half-edge, the first boundary one if any, the first one
+  // otherwise. Smallest index are gathered atomically per vertex.
+  std::vector<std::atomic<int>> first_any(n_vertex);
+  std::vector<std::atomic<int>> first_boundary(n_vertex);
+  for (size_t v = 0; v < n_vertex; ++v) {
+    first_any[v].store(kNoHalfEdge, std::memory_order_relaxed);
+    first_boundary[v].store(kNoHalfEdge, std::memory_order_relaxed);
+  }
+  pool.ParallelFor(0, n_he, grain, [&](const size_t begin, const size_t end) {
+    for (size_t h = begin; h < end; ++h) {
+      const int v = origin_[h];
+      AtomicMin(static_cast<int>(h), &first_any[v]);
+      if (twin_[h] < 0) {
+        AtomicMin(static_cast<int>(h), &first_boundary[v]);
+      }
+    }
+  });
+  out_.resize(n_vertex);
+  for (size_t v = 0; v < n_vertex; ++v) {
+    const int b = first_boundary[v].load(std::memory_order_relaxed);
+    const int a = first_any[v].load(std::memory_order_relaxed);
+    out_[v] = b != kNoHalfEdge ? b : (a != kNoHalfEdge ? a : -1);
+  }
+  return 0;
+}
+
+/*
+ *  @name Clear
+ *  @fn void Clear(void)
+ *  @brief  Release the structure
+ */
+void HalfEdge::Clear(void) {
+  std::vector<int>().swap(twin_);
+  std::vector<int>().swap(origin_);
+  std::vector<int>().swap(out_);
+  std::vector<int>().swap(non_manifold_);
+}
+
+#pragma mark -
+#pragma mark Navigation
+
+/*
+ *  @name OneRing
+ *  @fn void OneRing(const int v, std::vector<int>* ring) const
+ *  @brief  Neighbours of a vertex, in rotation order
+ *  @param[in]  v     Vertex's index
+ *  @param[out] ring  Neighbouring vertices
+ */
+void HalfEdge::OneRing(const int v, std::vector<int>* ring) const {
+  ring->clear();
+  const int start = out_[v];
+  int h = start;
+  while (h >= 0) {
+    ring->push_back(this->Target(h));
+    const int next = this->NextOutgoing(h);
+    if (next < 0) {
+      // Boundary, last neighbour is across the incoming boundary edge
+      ring->push_back(origin_[Prev(h)]);
+    }
+    h = next != start ? next : -1;
+  }
+}
+
+/*
+ *  @name BoundaryLoops
+ *  @fn void BoundaryLoops(std::vector<std::vector<int>>* loops) const
+ *  @brief  Gather the boundary loops
+ *  @param[out] loops For each loop, its half-edges in walking order
+ */
+void HalfEdge::BoundaryLoops(std::vector<std::vector<int>>* loops) const {
+  loops->clear();
+  std::vector<bool> visited(twin_.size(), false);
+  for (size_t i = 0; i < twin_.size(); ++i) {
+    const int h = static_cast<int>(i);
+    if (twin_[h] >= 0 || visited[h]) {
+      continue;
+    }
+    loops->push_back(std::vector<int>());
+    auto& loop = loops->back();
+    int g = h;
+    do {
+      visited[g] = true;
+      loop.push_back(g);
+      // Rotate around the target until the boundary half-edge leaving it
+      int c = Next(g);
+      while (twin_[c] >= 0) {
+        c = Next(twin_[c]);
+      }
+      g = c;
+    } while (g != h && !visited[g]);
+  }
+}
+
+}  // namespace OGLKit
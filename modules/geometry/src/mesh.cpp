@@ -8,15 +8,25 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <sstream>
-#ifdef __APPLE__
-#include <dispatch/dispatch.h>
-#endif
-
-#include "ply/ply.h"
+#include <limits>
+#include <type_traits>
 
+#include "oglkit/core/char_conv.hpp"
+#include "oglkit/core/memory_map.hpp"
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/bounding_box.hpp"
+#include "oglkit/geometry/decompressor.hpp"
+#include "oglkit/geometry/gltf.hpp"
 #include "oglkit/geometry/mesh.hpp"
+#include "oglkit/geometry/mesh_cache.hpp"
+#include "oglkit/geometry/mesh_codec.hpp"
+#include "oglkit/geometry/mesh_optimizer.hpp"
 
 /**
  *  @namespace  OGLKit
@@ -27,617 +37,4397 @@ namespace OGLKit {
 #pragma mark -
 #pragma mark Type definition
   
+/** Amount of decompressed data parsed at once when streaming */
+const size_t kStreamChunkSize = 4 << 20;
+/** Number of vertex reduced at once while post-processing, fixed to keep
+ the result independent of the number of thread */
+const size_t kPostProcessBlockSize = 1 << 16;
+/** Number of face / vertex processed at once while computing normals */
+const size_t kNormalBlockSize = 1 << 14;
+
+/**
+ *  @struct OBJCorner
+ *  @brief  Face corner of an .obj file, index of position, texture coordinate
+ *          and normal (-1 if not provided)
+ */
+struct OBJCorner {
+  /** Position index */
+  int v;
+  /** Texture coordinate index */
+  int t;
+  /** Normal index */
+  int n;
+};
+
 /**
- *  @struct PLYVertex
- *  @brief  Data object to read ply file
+ *  @struct OBJContent
+ *  @brief  Data parsed from an .obj buffer
  */
 template<typename T>
-struct PLYVertex {
-  /** Vertex typedef */
-  using Vertex = typename Mesh<T>::Vertex;
-  /** Normal typedef */
-  using Normal = typename Mesh<T>::Normal;
-  
-  /** Position */
-  Vertex vertex;
+struct OBJContent {
+  /** Vertex */
+  std::vector<typename Mesh<T>::Vertex> vertex;
   /** Normal */
-  Normal normal;
-  
+  std::vector<typename Mesh<T>::Normal> normal;
+  /** Texture coordinate */
+  std::vector<typename Mesh<T>::TCoord> tcoord;
+  /** Triangle corners, three per triangle */
+  std::vector<OBJCorner> corner;
+  /** Position in corner (as int array) of indices given relative to the
+   chunk's attributes */
+  std::vector<size_t> relative;
+  /** Bounding box of the vertex */
+  AABB<T> bbox;
+
   /**
-   *  @name PLYVertex
-   *  @fn PLYVertex(void)
+   *  @name OBJContent
+   *  @fn OBJContent(void)
    *  @brief  Constructor
    */
-  PLYVertex(void) : vertex(-1.0, -1.0, -1.0),
-                    normal(-1.0, -1.0, -1.0) {}
+  OBJContent(void) {
+    bbox.min_.x_ = std::numeric_limits<T>::max();
+    bbox.max_.x_ = std::numeric_limits<T>::lowest();
+    bbox.min_.y_ = std::numeric_limits<T>::max();
+    bbox.max_.y_ = std::numeric_limits<T>::lowest();
+    bbox.min_.z_ = std::numeric_limits<T>::max();
+    bbox.max_.z_ = std::numeric_limits<T>::lowest();
+  }
 };
-  
+
 /**
- *  @struct PLYFace
- *  @brief  Data object to read ply file
+ *  @class  OBJCornerMap
+ *  @brief  Open addressing hash map (linear probing) from face corner to
+ *          welded vertex index
  */
-template<typename T>
-struct PLYFace {
-  /** Triangle typedef */
-  using Triangle = typename Mesh<T>::Triangle;
-  /** Texture coordinate typedef */
-  using TCoord = typename Mesh<T>::TCoord;
-  
-  /** number of vertex in the face */
-  int n_vertex;
-  /** List of vertex indices */
-  Triangle* list_idx;
-  /** number of tcoord */
-  int n_tcoord;
-  /** List of texture coordinate */
-  TCoord* list_tcoord;
-  
+class OBJCornerMap {
+ public:
   /**
-   *  @name PLYFace(void)
-   *  @fn PLYFace(void)
+   *  @name OBJCornerMap
+   *  @fn explicit OBJCornerMap(const size_t n)
    *  @brief  Constructor
+   *  @param[in]  n Expected number of element
    */
-  PLYFace(void) : list_idx(nullptr),
-                  list_tcoord(nullptr) {}
-  
-  ~PLYFace(void) {
-    if (list_idx) {
-      free(list_idx);
-      list_idx = nullptr;
+  explicit OBJCornerMap(const size_t n) : size_(0) {
+    this->Allocate(n);
+  }
+
+  /**
+   *  @name Insert
+   *  @fn int Insert(const OBJCorner& key, const int value)
+   *  @brief  Add a corner if not already present
+   *  @param[in]  key   Corner to insert
+   *  @param[in]  value Value associated to the corner if not already present
+   *  @return Value associated to the corner
+   */
+  int Insert(const OBJCorner& key, const int value) {
+    size_t pos = Hash(key) & mask_;
+    while (value_[pos] != -1) {
+      const OBJCorner& k = key_[pos];
+      if (k.v == key.v && k.t == key.t && k.n == key.n) {
+        return value_[pos];
+      }
+      pos = (pos + 1) & mask_;
     }
-    if (list_tcoord) {
-      free(list_tcoord);
-      list_tcoord = nullptr;
+    key_[pos] = key;
+    value_[pos] = value;
+    if (++size_ * 2 > value_.size()) {
+      this->Rehash();
     }
+    return value;
   }
-};
 
-#pragma mark -
-#pragma mark Initialization
+ private:
+  /**
+   *  @name Hash
+   *  @fn static size_t Hash(const OBJCorner& key)
+   *  @brief  Hash function
+   *  @param[in]  key Corner to hash
+   *  @return Hash value
+   */
+  static size_t Hash(const OBJCorner& key) {
+    uint64_t h = static_cast<uint32_t>(key.v) * 0x9E3779B97F4A7C15ull;
+    h ^= static_cast<uint32_t>(key.t) * 0xC2B2AE3D27D4EB4Full;
+    h ^= static_cast<uint32_t>(key.n) * 0x165667B19E3779F9ull;
+    return static_cast<size_t>(h ^ (h >> 29));
+  }
 
-/*
- *  @name
- *  @fn
- *  @brief  Constructor
- */
-template<typename T>
-Mesh<T>::Mesh(void) : bbox_is_computed_(false) {
-}
+  /**
+   *  @name Allocate
+   *  @fn void Allocate(const size_t n)
+   *  @brief  Allocate table for n element (load factor below 0.5)
+   *  @param[in]  n Number of element
+   */
+  void Allocate(const size_t n) {
+    size_t capacity = 16;
+    while (capacity < 2 * n) {
+      capacity <<= 1;
+    }
+    key_.resize(capacity);
+    value_.assign(capacity, -1);
+    mask_ = capacity - 1;
+    size_ = 0;
+  }
 
-/*
- *  @name Mesh
- *  @fn Mesh(const std::string& filename)
- *  @brief  Load mesh from supported file :
- *            .obj, .ply, .tri
- */
-template<typename T>
-Mesh<T>::Mesh(const std::string& filename) : bbox_is_computed_(false){
-  if (this->Load(filename)) {
-    std::cout << "Error while loading mesh from file : " + filename << std::endl;
+  /**
+   *  @name Rehash
+   *  @fn void Rehash(void)
+   *  @brief  Double table's capacity
+   */
+  void Rehash(void) {
+    std::vector<OBJCorner> key;
+    std::vector<int> value;
+    key.swap(key_);
+    value.swap(value_);
+    this->Allocate(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+      if (value[i] != -1) {
+        this->Insert(key[i], value[i]);
+      }
+    }
   }
-}
 
-/*
- *  @name Mesh  @fn Meshid)
- *  @brief  Destructor
+  /** Keys */
+  std::vector<OBJCorner> key_;
+  /** Values, -1 for empty slot */
+  std::vector<int> value_;
+  /** Capacity - 1 */
+  size_t mask_;
+  /** Number of element */
+  size_t size_;
+};
+
+/**
+ *  @name ParseReals
+ *  @fn const char* ParseReals(const char* first, const char* last,
+                               const int n, T* values)
+ *  @brief  Parse \p n blank separated real numbers
+ *  @param[in]  first   Beginning of the range
+ *  @param[in]  last    End of the range
+ *  @param[in]  n       Number of value to parse
+ *  @param[out] values  Parsed values
+ *  @return Position after the last value or nullptr if malformed
  */
 template<typename T>
-Mesh<T>::~Mesh(void) {
+const char* ParseReals(const char* first,
+                       const char* last,
+                       const int n,
+                       T* values) {
+  for (int i = 0; i < n; ++i) {
+    first = CharConv::SkipSpace(first, last);
+    const char* p = CharConv::FromChars(first, last, &values[i]);
+    if (p == first) {
+      return nullptr;
+    }
+    first = p;
+  }
+  return first;
 }
 
-/*
- *  @name Load
- *  @fn int Load(const std::string& filename)
- *  @brief  Load mesh from supported file :
- *            .obj, .ply, .tri
- *  @return -1 if error, 0 otherwise
+/**
+ *  @name ParseOBJCorner
+ *  @fn const char* ParseOBJCorner(const char* first, const char* last,
+                                   const OBJContent<T>& content,
+                                   OBJCorner* corner, int* relative)
+ *  @brief  Parse a face corner (v, v/vt, v//vn or v/vt/vn). Indices are
+ *          converted to 0-based, relative (negative) ones are resolved against
+ *          the attributes seen so far in this chunk.
+ *  @param[in]  first     Beginning of the range
+ *  @param[in]  last      End of the range
+ *  @param[in]  content   Data parsed so far
+ *  @param[out] corner    Parsed corner
+ *  @param[out] relative  Bitmask of the relative indices (v:1, t:2, n:4)
+ *  @return Position after the corner, \p first if malformed
  */
 template<typename T>
-int Mesh<T>::Load(const std::string& filename) {
-  // Load data
-  int err = -1;
-  size_t pos = filename.rfind(".");
-  if (pos != std::string::npos) {
-    // Ensure empty containter
-    vertex_.clear();
-    normal_.clear();
-    tex_coord_.clear();
-    tri_.clear();
-    vertex_con_.clear();
-    //memset(bbox_, 0, sizeof(bbox_));
-    std::string ext = filename.substr(pos + 1, filename.length());
-    FileExt file_ext = this->HashExt(ext);
-    switch (file_ext) {
-      // OBJ
-      case kObj: {
-        err = this->LoadOBJ(filename);
-      }
+const char* ParseOBJCorner(const char* first,
+                           const char* last,
+                           const OBJContent<T>& content,
+                           OBJCorner* corner,
+                           int* relative) {
+  const int count[] = {static_cast<int>(content.vertex.size()),
+                       static_cast<int>(content.tcoord.size()),
+                       static_cast<int>(content.normal.size())};
+  int* idx = &corner->v;
+  idx[1] = -1;
+  idx[2] = -1;
+  *relative = 0;
+  const char* p = first;
+  for (int k = 0; k < 3; ++k) {
+    if (k > 0) {
+      // Components are separated by '/', texture coordinate can be empty
+      if (p == last || *p != '/') {
         break;
-      // PLY
-      case kPly: {
-        err = this->LoadPLY(filename);
       }
-        break;
-      // Not supported yet
-      case kUndef:
-      default:  std::cout << "Error, unsported extension type : " << ext;
-        std::cout << std::endl;
-        err = -1;
-        break;
+      ++p;
+      if (k == 1 && p != last && *p == '/') {
+        continue;
+      }
     }
-    if (!err) {
-      this->PlaceToOrigin();
-      this->BuildConnectivity();
+    const char* q = CharConv::FromChars(p, last, &idx[k]);
+    if (q == p || idx[k] == 0) {
+      return first;
+    }
+    if (idx[k] < 0) {
+      idx[k] += count[k];
+      *relative |= 1 << k;
+    } else {
+      idx[k] -= 1;
     }
+    p = q;
   }
-  if (!err && !bbox_is_computed_) {
-    this->ComputeBoundingBox();
+  return p;
+}
+
+/**
+ *  @name PushOBJCorner
+ *  @fn void PushOBJCorner(const OBJCorner& corner, const int relative,
+                           OBJContent<T>* content)
+ *  @brief  Add a triangle corner
+ *  @param[in]  corner    Corner to add
+ *  @param[in]  relative  Bitmask of the relative indices
+ *  @param[out] content   Where to add the corner
+ */
+template<typename T>
+void PushOBJCorner(const OBJCorner& corner,
+                   const int relative,
+                   OBJContent<T>* content) {
+  const size_t pos = content->corner.size() * 3;
+  for (int k = 0; k < 3; ++k) {
+    if (relative & (1 << k)) {
+      content->relative.push_back(pos + k);
+    }
   }
-  return err;
+  content->corner.push_back(corner);
 }
 
-/*
- *  @name Save
- *  @fn int Save(const std::string& filename)
- *  @brief  Save mesh to supported file format:
- *            .ply
+/**
+ *  @name ParseOBJ
+ *  @fn int ParseOBJ(const char* first, const char* last,
+                     OBJContent<T>* content)
+ *  @brief  Parse the content of an .obj file stored in [first, last[. The
+ *          buffer is tokenized in place, nothing is allocated per line.
+ *          Polygons are triangulated as fan.
+ *  @param[in]  first   Beginning of the buffer
+ *  @param[in]  last    End of the buffer
+ *  @param[out] content Parsed data
  *  @return -1 if error, 0 otherwise
  */
 template<typename T>
-int Mesh<T>::Save(const std::string& filename) {
-  // Load data
-  int err = -1;
-  size_t pos = filename.rfind(".");
-  if (pos != std::string::npos) {
-    std::string ext = filename.substr(pos + 1, filename.length());
-    FileExt file_ext = this->HashExt(ext);
-    switch (file_ext) {
-        // PLY
-      case kPly: {
-        err = this->SavePLY(filename);
+int ParseOBJ(const char* first, const char* last, OBJContent<T>* content) {
+  using Vertex = typename Mesh<T>::Vertex;
+  using Normal = typename Mesh<T>::Normal;
+  using TCoord = typename Mesh<T>::TCoord;
+  const char* p = first;
+  while (p != last) {
+    p = CharConv::SkipSpace(p, last);
+    if (p == last) {
+      break;
+    }
+    const char* key_end = CharConv::SkipToken(p, last);
+    const size_t key_len = static_cast<size_t>(key_end - p);
+    if (key_len == 1 && p[0] == 'v') {
+      // Vertex
+      Vertex v;
+      p = ParseReals(key_end, last, 3, &v.x_);
+      if (!p) {
+        return -1;
       }
-        break;
-        // OBJ
-      case kObj: {
-        err = this->SaveOBJ(filename);
+      content->vertex.push_back(v);
+    } else if (key_len == 2 && p[0] == 'v' && p[1] == 'n') {
+      // Normal
+      Normal n;
+      p = ParseReals(key_end, last, 3, &n.x_);
+      if (!p) {
+        return -1;
+      }
+      content->normal.push_back(n);
+    } else if (key_len == 2 && p[0] == 'v' && p[1] == 't') {
+      // Texture coordinate
+      TCoord tc;
+      p = ParseReals(key_end, last, 2, &tc.x_);
+      if (!p) {
+        return -1;
+      }
+      content->tcoord.push_back(tc);
+    } else if (key_len == 1 && p[0] == 'f') {
+      // Faces, triangulated as fan around the first corner
+      OBJCorner c0, prev, curr;
+      int rel0 = 0, rel_prev = 0, rel_curr = 0;
+      int n_corner = 0;
+      p = CharConv::SkipSpace(key_end, last);
+      while (p != last && *p != '\n' && *p != '#') {
+        const char* q = ParseOBJCorner(p, last, *content, &curr, &rel_curr);
+        if (q == p) {
+          return -1;
+        }
+        if (n_corner == 0) {
+          c0 = curr;
+          rel0 = rel_curr;
+        } else if (n_corner >= 2) {
+          PushOBJCorner(c0, rel0, content);
+          PushOBJCorner(prev, rel_prev, content);
+          PushOBJCorner(curr, rel_curr, content);
+        }
+        prev = curr;
+        rel_prev = rel_curr;
+        ++n_corner;
+        p = CharConv::SkipSpace(q, last);
+      }
+      if (n_corner < 3) {
+        return -1;
       }
-        break;
-
-        break;
-        // Undef
-        case kUndef:
-      default:  std::cout << "Error, unsported extension type : " << ext;
-        std::cout << std::endl;
-        err = -1;
-        break;
     }
+    // Next line
+    p = CharConv::SkipLine(p, last);
   }
-  return err;
+  // Boundary box, reduced once every position is parsed
+  BoundingBox<T>::Extend(content->vertex.data(),
+                         content->vertex.size(),
+                         &content->bbox);
+  return 0;
 }
 
-/*
- *  @name BuildConnectivity
- *  @fn void BuildConnectivity(void)
- *  @brief  Construct vertex connectivity (vertex connection) used later
- *          in normal computation
+/**
+ *  @name SplitLines
+ *  @fn std::vector<const char*> SplitLines(const char* first,
+                                           const char* last,
+                                           const size_t n_chunk)
+ *  @brief  Split a buffer into chunks of similar size ending on line breaks
+ *  @param[in]  first   Beginning of the buffer
+ *  @param[in]  last    End of the buffer
+ *  @param[in]  n_chunk Number of chunk wanted
+ *  @return Chunk boundaries, chunk i is [bound[i], bound[i+1][
  */
-template<typename T>
-void Mesh<T>::BuildConnectivity(void) {
-  // Init outter containter
-  assert(vertex_.size() != 0 && tri_.size() != 0);
-  vertex_con_.clear();
-  vertex_con_ = std::vector<std::vector<int>>(vertex_.size(),
-                                              std::vector<int>(0));
-  // Loop over all triangle
-  const int n_tri = static_cast<int>(tri_.size());
-  for (int i = 0; i < n_tri; ++i) {
-    int* tri_idx_ptr = &(tri_[i].x_);
-    for (int e = 0; e < 3; ++e) {
-      int idx_in = tri_idx_ptr[e];
-      int idx_out_1 = tri_idx_ptr[(e + 1) % 3];
-      int idx_out_2 = tri_idx_ptr[(e + 2) % 3];
-      // Add to connectivity list
-      vertex_con_[idx_in].push_back(idx_out_1);
-      vertex_con_[idx_in].push_back(idx_out_2);
+std::vector<const char*> SplitLines(const char* first,
+                                    const char* last,
+                                    const size_t n_chunk) {
+  std::vector<const char*> bound(1, first);
+  const size_t size = static_cast<size_t>(last - first);
+  for (size_t k = 1; k < n_chunk; ++k) {
+    const char* p = std::max(first + (k * size) / n_chunk, bound.back());
+    p = CharConv::SkipLine(p, last);
+    if (p != last && p != bound.back()) {
+      bound.push_back(p);
     }
   }
+  bound.push_back(last);
+  return bound;
 }
 
-/*
- *  @name HashExt
- *  @fn FileExt HashExt(const std::string& ext)
- *  @brief  Provide the type of extension
- *  @param[in]  ext Name of the extension
- *  @return Hash of the given extension if know by the object
+/**
+ *  @name MergeOBJChunks
+ *  @fn void MergeOBJChunks(const std::vector<OBJContent<T>>& chunks,
+                            OBJContent<T>* content)
+ *  @brief  Concatenate chunks parsed independently, in file order
+ *  @param[in]  chunks  Parsed chunks
+ *  @param[out] content Merged data
  */
 template<typename T>
-typename Mesh<T>::FileExt Mesh<T>::HashExt(const std::string& ext) {
-  FileExt fext = kUndef;
-  if (ext == "obj") {
-    fext = kObj;
-  } else if (ext == "ply") {
-    fext = kPly;
+void MergeOBJChunks(const std::vector<OBJContent<T>>& chunks,
+                    OBJContent<T>* content) {
+  auto& pool = ThreadPool::Instance();
+  const size_t n_chunk = chunks.size();
+  // Offset of each chunk in the final arrays
+  std::vector<size_t> off_v(n_chunk + 1, 0), off_n(n_chunk + 1, 0);
+  std::vector<size_t> off_t(n_chunk + 1, 0), off_c(n_chunk + 1, 0);
+  for (size_t c = 0; c < n_chunk; ++c) {
+    off_v[c + 1] = off_v[c] + chunks[c].vertex.size();
+    off_n[c + 1] = off_n[c] + chunks[c].normal.size();
+    off_t[c + 1] = off_t[c] + chunks[c].tcoord.size();
+    off_c[c + 1] = off_c[c] + chunks[c].corner.size();
+    content->bbox += chunks[c].bbox;
   }
-  return fext;
+  content->vertex.resize(off_v[n_chunk]);
+  content->normal.resize(off_n[n_chunk]);
+  content->tcoord.resize(off_t[n_chunk]);
+  content->corner.resize(off_c[n_chunk]);
+  pool.ParallelFor(0, n_chunk, 1, [&](const size_t begin, const size_t end) {
+    for (size_t c = begin; c < end; ++c) {
+      const auto& chunk = chunks[c];
+      std::copy(chunk.vertex.begin(),
+                chunk.vertex.end(),
+                content->vertex.begin() + off_v[c]);
+      std::copy(chunk.normal.begin(),
+                chunk.normal.end(),
+                content->normal.begin() + off_n[c]);
+      std::copy(chunk.tcoord.begin(),
+                chunk.tcoord.end(),
+                content->tcoord.begin() + off_t[c]);
+      std::copy(chunk.corner.begin(),
+                chunk.corner.end(),
+                content->corner.begin() + off_c[c]);
+      // Shift relative indices by the number of element in previous chunks
+      const int offset[] = {static_cast<int>(off_v[c]),
+                            static_cast<int>(off_t[c]),
+                            static_cast<int>(off_n[c])};
+      int* idx = &(content->corner[off_c[c]].v);
+      for (const size_t r : chunk.relative) {
+        idx[r] += offset[r % 3];
+      }
+    }
+  });
 }
 
-/*
- *  @name LoadOBJ
- *  @fn int LoadOBJ(const std::string& path)
- *  @brief  Load mesh from .obj file
- *  @param[in]  path  Path to obj file
+/**
+ *  @name ParseOBJParallel
+ *  @fn int ParseOBJParallel(const char* first, const char* last,
+                             OBJContent<T>* content)
+ *  @brief  Parse an .obj buffer split into chunks on the library's thread
+ *          pool. Chunks are merged back in file order.
+ *  @param[in]  first   Beginning of the buffer
+ *  @param[in]  last    End of the buffer
+ *  @param[out] content Parsed data
  *  @return -1 if error, 0 otherwise
  */
 template<typename T>
-int Mesh<T>::LoadOBJ(const std::string& path) {
-  int error = -1;
-  std::ifstream stream(path, std::ios_base::in);
-  if (stream.is_open()) {
-    // Init bbox
-    bbox_.min_.x_ = std::numeric_limits<T>::max();
-    bbox_.max_.x_ = std::numeric_limits<T>::lowest();
-    bbox_.min_.y_ = std::numeric_limits<T>::max();
-    bbox_.max_.y_ = std::numeric_limits<T>::lowest();
-    bbox_.min_.z_ = std::numeric_limits<T>::max();
-    bbox_.max_.z_ = std::numeric_limits<T>::lowest();
-    // Start to read
-    std::string line, key;
-    std::stringstream str_stream;
-    Vertex vertex;
-    Normal normal;
-    TCoord tcoord;
-    Triangle tri;
-    while (!stream.eof()) {
-      // Scan line
-      std::getline(stream, line);
-      if (!line.empty()) {
-        str_stream.str(line);
-        str_stream >> key;
-        if (key == "v") {
-          // Vertex
-          str_stream >> vertex;
-          vertex_.push_back(vertex);
-          // Compute boundary box
-          bbox_.min_.x_ = bbox_.min_.x_ < vertex.x_ ? bbox_.min_.x_ : vertex.x_;
-          bbox_.max_.x_ = bbox_.max_.x_ > vertex.x_ ? bbox_.max_.x_ : vertex.x_;
-          bbox_.min_.y_ = bbox_.min_.y_ < vertex.y_ ? bbox_.min_.y_ : vertex.y_;
-          bbox_.max_.y_ = bbox_.max_.y_ > vertex.y_ ? bbox_.max_.y_ : vertex.y_;
-          bbox_.min_.z_ = bbox_.min_.z_ < vertex.z_ ? bbox_.min_.z_ : vertex.z_;
-          bbox_.max_.z_ = bbox_.max_.z_ > vertex.z_ ? bbox_.max_.z_ : vertex.z_;
-        } else if (key == "vn") {
-          // Normal
-          str_stream >> normal;
-          normal_.push_back(normal);
-        } else if (key == "vt") {
-          // Texture coordinate
-          str_stream >> tcoord;
-          tex_coord_.push_back(tcoord);
-        } else if (key == "f") {
-          // Faces
-          str_stream >> tri;
-          tri -= 1;
-          tri_.push_back(tri);
-        }
-        str_stream.clear();
-      }
+int ParseOBJParallel(const char* first,
+                     const char* last,
+                     OBJContent<T>* content) {
+  auto& pool = ThreadPool::Instance();
+  const auto bound = SplitLines(first, last, 2 * (pool.size() + 1));
+  const size_t n_chunk = bound.size() - 1;
+  std::vector<OBJContent<T>> chunks(n_chunk);
+  std::vector<int> errors(n_chunk, 0);
+  pool.ParallelFor(0, n_chunk, 1, [&](const size_t begin, const size_t end) {
+    for (size_t c = begin; c < end; ++c) {
+      errors[c] = ParseOBJ(bound[c], bound[c + 1], &chunks[c]);
+    }
+  });
+  for (const int e : errors) {
+    if (e) {
+      return -1;
     }
-    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
-    bbox_is_computed_ = true;
-    error = 0;
   }
-  return error;
+  MergeOBJChunks(chunks, content);
+  return 0;
 }
 
-/*
- *  @name LoadPLY
- *  @fn int LoadPLY(const std::string& path)
- *  @brief  Load mesh from .obj file
- *  @param[in]  path  Path to ply file
+/**
+ *  @name ParseOBJStream
+ *  @fn int ParseOBJStream(Decompressor* stream, OBJContent<T>* content)
+ *  @brief  Parse an .obj file while it is being decompressed. Complete lines
+ *          are parsed chunk by chunk as soon as they are available, chunks
+ *          are merged back in file order at the end.
+ *  @param[in]  stream  Opened decompressor
+ *  @param[out] content Parsed data
  *  @return -1 if error, 0 otherwise
  */
 template<typename T>
-int Mesh<T>::LoadPLY(const std::string& path) {
-  int error = -1;
-  // Read ply file
-  PlyFile* ply_file;
-  int n_elem;
-  char ** elem_list;
-  int file_type;
-  float version;
-  /* open a PLY file for reading */
-  ply_file = ply_open_for_reading(const_cast<char*>(path.c_str()),
-                                  &n_elem,
-                                  &elem_list,
-                                  &file_type, &version);
-  if (ply_file) {
-    // list of property information for a vertex
-    int type = sizeof(T) == 4 ? PLY_FLOAT : PLY_DOUBLE;
-    PlyProperty vertex_prop[]  = {
-      {"x", PLY_FLOAT, type, offsetof(PLYVertex<T>,vertex.x_), 0, 0, 0, 0},
-      {"y", PLY_FLOAT, type, offsetof(PLYVertex<T>,vertex.y_), 0, 0, 0, 0},
-      {"z", PLY_FLOAT, type, offsetof(PLYVertex<T>,vertex.z_), 0, 0, 0, 0},
-      {"nx", PLY_FLOAT, type, offsetof(PLYVertex<T>,normal.x_), 0, 0, 0, 0},
-      {"ny", PLY_FLOAT, type, offsetof(PLYVertex<T>,normal.y_), 0, 0, 0, 0},
-      {"nz", PLY_FLOAT, type, offsetof(PLYVertex<T>,normal.z_), 0, 0, 0, 0}
-    };
-    PlyProperty face_prop[] = {
-      {"vertex_indices", PLY_INT, PLY_INT, offsetof(PLYFace<T>, list_idx),
-        1, PLY_INT, PLY_INT, offsetof(PLYFace<T>, n_vertex)},
-      {"texcoord", PLY_FLOAT, type, offsetof(PLYFace<T>, list_tcoord),
-        1, PLY_INT, PLY_INT, offsetof(PLYFace<T>, n_tcoord)}
-    };
-    
-    // go through each kind of element that we learned is in the file
-    // and read them
-    for (int i = 0; i < n_elem; ++i) {
-      // get the description of the first element
-      int num_elems;
-      int n_props;
-      char* elem_name = elem_list[i];
-      ply_get_element_description(ply_file,
-                                  elem_name,
-                                  &num_elems,
-                                  &n_props);
-      // if we're on vertex elements, read them in
-      if (equal_strings ("vertex", elem_name)) {
-        // Get position
-        ply_get_property(ply_file, elem_name, &vertex_prop[0]);
-        ply_get_property(ply_file, elem_name, &vertex_prop[1]);
-        ply_get_property(ply_file, elem_name, &vertex_prop[2]);
-        // Get normal
-        ply_get_property(ply_file, elem_name, &vertex_prop[3]);
-        ply_get_property(ply_file, elem_name, &vertex_prop[4]);
-        ply_get_property(ply_file, elem_name, &vertex_prop[5]);
-        
-        // Init bbox
-        bbox_.min_.x_ = std::numeric_limits<T>::max();
-        bbox_.max_.x_ = std::numeric_limits<T>::lowest();
-        bbox_.min_.y_ = std::numeric_limits<T>::max();
-        bbox_.max_.y_ = std::numeric_limits<T>::lowest();
-        bbox_.min_.z_ = std::numeric_limits<T>::max();
-        bbox_.max_.z_ = std::numeric_limits<T>::lowest();
-        
-        /* grab all the vertex elements */
-        for (int j = 0; j < num_elems; ++j) {
-          PLYVertex<T> vert;
-          ply_get_element(ply_file, reinterpret_cast<void*>(&vert));
-          // Push data into structure
-          vertex_.push_back(vert.vertex);
-          // Compute boundary box
-          bbox_.min_.x_ = (bbox_.min_.x_ < vert.vertex.x_ ?
-                           bbox_.min_.x_ :
-                           vert.vertex.x_);
-          bbox_.max_.x_ = (bbox_.max_.x_ > vert.vertex.x_ ?
-                           bbox_.max_.x_ :
-                           vert.vertex.x_);
-          bbox_.min_.y_ = (bbox_.min_.y_ < vert.vertex.y_ ?
-                           bbox_.min_.y_ :
-                           vert.vertex.y_);
-          bbox_.max_.y_ = (bbox_.max_.y_ > vert.vertex.y_ ?
-                           bbox_.max_.y_ :
-                           vert.vertex.y_);
-          bbox_.min_.z_ = (bbox_.min_.z_ < vert.vertex.z_ ?
-                           bbox_.min_.z_ :
-                           vert.vertex.z_);
-          bbox_.max_.z_ = (bbox_.max_.z_ > vert.vertex.z_ ?
-                           bbox_.max_.z_ :
-                           vert.vertex.z_);
-          // Normal if present
-          if ((vert.normal.x_ != -1.0f) &&
-              (vert.normal.y_ != -1.0f) &&
-              (vert.normal.z_ != -1.0f)) {
-            normal_.push_back(vert.normal);
-          }
-        }
-        bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
-        bbox_is_computed_ = true;
-      }
-      // if we're on face elements, read them in
-      if (equal_strings ("face", elem_name)) {
-        // set up for getting face elements
-        ply_get_property (ply_file, elem_name, &face_prop[0]);
-        ply_get_property (ply_file, elem_name, &face_prop[1]);
-        // grab all the face elements
-        for (int j = 0; j < num_elems; j++) {
-          PLYFace<T> face;
-          ply_get_element(ply_file, reinterpret_cast<void*>(&face));
-          if (face.n_vertex != 3) {
-            std::cout << "Support only triangle mesh !" << std::endl;
-            return error;
-          }
-          if (face.list_idx != nullptr) {
-            tri_.push_back(face.list_idx[0]);
-          }
-          if (face.list_tcoord != nullptr) {
-            assert(face.n_tcoord == 6);
-            tex_coord_.push_back(face.list_tcoord[0]);
-            tex_coord_.push_back(face.list_tcoord[1]);
-            tex_coord_.push_back(face.list_tcoord[2]);
-          }
-        }
+int ParseOBJStream(Decompressor* stream, OBJContent<T>* content) {
+  std::vector<OBJContent<T>> chunks;
+  size_t pos = 0;
+  size_t avail = 0;
+  bool done = false;
+  while (!done) {
+    // Ask for more than already seen, a single line can span several chunks
+    const size_t want = std::max(pos + kStreamChunkSize, avail + 1);
+    avail = stream->Wait(want);
+    done = avail < want;
+    // Only offsets are kept across Wait(), the buffer can move at the end
+    const char* first = stream->data() + pos;
+    const char* last = stream->data() + avail;
+    if (!done) {
+      // Stop after the last complete line
+      while (last != first && last[-1] != '\n') {
+        --last;
+      }
+    }
+    if (last != first) {
+      chunks.emplace_back();
+      if (ParseOBJ(first, last, &chunks.back())) {
+        return -1;
       }
+      pos += static_cast<size_t>(last - first);
     }
-    // close the PLY file
-    ply_close (ply_file);
-    // Shall we free elem_list ?
-    free(elem_list);
-    // Done
-    error = 0;
   }
-  return error;
+  if (stream->Finish()) {
+    return -1;
+  }
+  MergeOBJChunks(chunks, content);
+  return 0;
 }
 
-/*
- *  @name SaveOBJ
- *  @fn int SaveOBJ(const std::string path) const
- *  @brief SAve mesh to a .obj file
- *  @param[in]  path  Path to .obj file
- *  @return -1 if error, 0 otherwise
+/**
+ *  @name BuildOBJMesh
+ *  @fn int BuildOBJMesh(OBJContent<T>* content,
+                         std::vector<typename Mesh<T>::Triangle>* tri,
+                         bool* welded)
+ *  @brief  Convert parsed corners into a single index buffer. When corners
+ *          reference texture coordinates or normals with indices differing
+ *          from the position's one, each unique (v, vt, vn) tuple is welded
+ *          into a single vertex and the attributes arrays of \p content are
+ *          rebuilt accordingly (i.e. ready for GPU upload).
+ *  @param[in,out]  content Parsed data
+ *  @param[out]     tri     Triangulation
+ *  @param[out]     welded  Indicate if attributes have been rebuilt
+ *  @return -1 if an index is out of range, 0 otherwise
  */
 template<typename T>
-int Mesh<T>::SaveOBJ(const std::string& path) {
-  int err = -1;
-  std::ofstream out_stream(path, std::ios_base::out);
-  if (out_stream.is_open()) {
-    // Header
-    out_stream << "# wavefront file written by OGLKit c++ library" << std::endl;
-
-    // Vertex
-    if (vertex_.size() > 0) {
-      size_t n_vert = vertex_.size();
-      for (size_t i = 0; i < n_vert; ++i) {
-        const Vertex& v = vertex_[i];
-        out_stream << "f " << v.x_ << " " << v.y_ << " " << v.z_ << std::endl;
-      }
+int BuildOBJMesh(OBJContent<T>* content,
+                 std::vector<typename Mesh<T>::Triangle>* tri,
+                 bool* welded) {
+  const int n_vertex = static_cast<int>(content->vertex.size());
+  const int n_tcoord = static_cast<int>(content->tcoord.size());
+  const int n_normal = static_cast<int>(content->normal.size());
+  const auto& corner = content->corner;
+  // Check indices and whether the arrays are already aligned
+  bool has_tcoord = false;
+  bool has_normal = false;
+  bool aligned = true;
+  for (const auto& c : corner) {
+    if (c.v < 0 || c.v >= n_vertex || c.t >= n_tcoord || c.n >= n_normal ||
+        c.t < -1 || c.n < -1) {
+      return -1;
     }
-    // Normal
-    if (normal_.size() > 0) {
-      size_t n_norm = normal_.size();
-      for (size_t i = 0; i < n_norm; ++i) {
-        const Normal& n = normal_[i];
-        out_stream << "vn " << n.x_ << " " << n.y_ << " " << n.z_ << std::endl;
-      }
+    has_tcoord |= c.t != -1;
+    has_normal |= c.n != -1;
+    aligned &= (c.t == -1 || c.t == c.v) && (c.n == -1 || c.n == c.v);
+  }
+  aligned &= !has_tcoord || n_tcoord == n_vertex;
+  aligned &= !has_normal || n_normal == n_vertex;
+  tri->resize(corner.size() / 3);
+  *welded = !aligned;
+  if (corner.empty()) {
+    return 0;
+  }
+  int* idx = &((*tri)[0].x_);
+  if (aligned) {
+    // Positions index all attributes
+    for (size_t i = 0; i < corner.size(); ++i) {
+      idx[i] = corner[i].v;
     }
-    // Texture coordinate
-    if (tex_coord_.size() > 0) {
-      size_t n_tcoord = tex_coord_.size();
-      for (size_t i = 0; i < n_tcoord; ++i) {
-        const TCoord& tc = tex_coord_[i];
-        out_stream << "vt " << tc.x_ << " " << tc.y_ << std::endl;
+    return 0;
+  }
+  // Weld unique (v, vt, vn)
+  using Vertex = typename Mesh<T>::Vertex;
+  using Normal = typename Mesh<T>::Normal;
+  using TCoord = typename Mesh<T>::TCoord;
+  std::vector<Vertex> vertex;
+  std::vector<Normal> normal;
+  std::vector<TCoord> tcoord;
+  const size_t n_expected = static_cast<size_t>(std::max(n_vertex,
+                                                         std::max(n_tcoord,
+                                                                  n_normal)));
+  vertex.reserve(n_expected);
+  if (has_normal) {
+    normal.reserve(n_expected);
+  }
+  if (has_tcoord) {
+    tcoord.reserve(n_expected);
+  }
+  OBJCornerMap map(n_expected);
+  for (size_t i = 0; i < corner.size(); ++i) {
+    const auto& c = corner[i];
+    const int n_weld = static_cast<int>(vertex.size());
+    idx[i] = map.Insert(c, n_weld);
+    if (idx[i] == n_weld) {
+      // New vertex
+      vertex.push_back(content->vertex[c.v]);
+      if (has_normal) {
+        normal.push_back(c.n != -1 ? content->normal[c.n] : Normal());
       }
-    }
-    // Tri
-    if (tri_.size() > 0) {
-      size_t n_tri = tri_.size();
-      for (size_t i = 0; i < n_tri; ++i) {
-        const Triangle & tri = tri_[i];
-        out_stream << "f " << tri.x_ << " " << tri.y_ << " " << tri.z_;
-        out_stream << std::endl;
+      if (has_tcoord) {
+        tcoord.push_back(c.t != -1 ? content->tcoord[c.t] : TCoord());
       }
     }
-    // Done
-    err = out_stream.good() ? 0 : -1;
-    out_stream.close();
   }
-  return err;
+  content->vertex.swap(vertex);
+  content->normal.swap(normal);
+  content->tcoord.swap(tcoord);
+  return 0;
 }
 
-/*
- *  @name SavePLY
- *  @fn int SavePLY(const std::string& path) const
- *  @brief SAve mesh to a .ply file
- *  @param[in]  path  Path to .ply file
- *  @return -1 if error, 0 otherwise
+/**
+ *  @enum PLYType
+ *  @brief  Scalar type of a ply property
  */
-template<typename T>
-int Mesh<T>::SavePLY(const std::string& path) const {
-  int error = -1;
-  // TODO: Need to be implemented !
-  return error;
-}
+enum PLYType {
+  /** Unknown */
+  kPLYInvalid,
+  /** char/int8 */
+  kPLYInt8,
+  /** uchar/uint8 */
+  kPLYUInt8,
+  /** short/int16 */
+  kPLYInt16,
+  /** ushort/uint16 */
+  kPLYUInt16,
+  /** int/int32 */
+  kPLYInt32,
+  /** uint/uint32 */
+  kPLYUInt32,
+  /** float/float32 */
+  kPLYFloat32,
+  /** double/float64 */
+  kPLYFloat64
+};
 
-#pragma mark -
-#pragma mark Usage
+/**
+ *  @enum PLYFormat
+ *  @brief  Encoding of a ply file
+ */
+enum PLYFormat {
+  /** Text */
+  kPLYAscii,
+  /** Binary, little endian */
+  kPLYBinaryLE,
+  /** Binary, big endian */
+  kPLYBinaryBE
+};
+
+/**
+ *  @struct PLYPropertyDesc
+ *  @brief  Description of a ply property
+ */
+struct PLYPropertyDesc {
+  /** Name */
+  std::string name;
+  /** Type of the value (item's type for list) */
+  PLYType type;
+  /** Type of the list's length, kPLYInvalid if not a list */
+  PLYType count_type;
+  /** Offset within the record (valid only for fixed stride element) */
+  size_t offset;
+};
+
+/**
+ *  @struct PLYElementDesc
+ *  @brief  Description of a ply element
+ */
+struct PLYElementDesc {
+  /** Name */
+  std::string name;
+  /** Number of element */
+  size_t count;
+  /** Properties */
+  std::vector<PLYPropertyDesc> property;
+  /** Size in bytes of a record, 0 if it contains list */
+  size_t stride;
 
-  /*
-   *  @name ComputeVertexNormal
-   *  @fn void ComputeVertexNormal(void)
-   *  @brief  Compute normal for each vertex in the object
+  /**
+   *  @name Find
+   *  @fn int Find(const char* name) const
+   *  @brief  Look for a property
+   *  @param[in]  name  Property's name
+   *  @return Index of the property or -1 if not found
    */
-template<typename T>
-void Mesh<T>::ComputeVertexNormal(void) {
-  // Loop over all vertex
-  assert(vertex_con_.size() > 0);
-  const int n_vert = static_cast<int>(vertex_.size());
-  normal_.resize(n_vert, Mesh::Normal());
-#if defined(__APPLE__)
-  dispatch_apply(n_vert,
-                 dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT,
-                                           (unsigned long)NULL), ^(size_t v) {
-#else
-  #pragma omp parallel for
-  for (int v = 0; v < n_vert; ++v) {
-#endif
-   // Loop over all connect vertex
-   std::vector<int>& conn = vertex_con_[v];
-   const Vertex& A = vertex_[v];
-   const int n_conn = static_cast<int>(conn.size());
-   Normal weighted_n;
-   for (int j = 0; j < n_conn; j += 2) {
-     const Vertex& B = vertex_[conn[j]];
-     const Vertex& C = vertex_[conn[j+1]];
-     // Define edges AB, AC
-     Edge AB = B - A;
-     Edge AC = C - A;
-     // Compute surface's normal (triangle ABC)
-     Normal n = AB ^ AC;
-     n.Normalize();
-     // Stack each face contribution and weight with angle
-     AB.Normalize();
-     AC.Normalize();
-     const T angle = std::acos(AB * AC);
-     weighted_n += (n * angle);
-   }
-   // normalize and set
-   weighted_n.Normalize();
-   normal_[v] = weighted_n;
- }
-#if defined(__APPLE__)
-  );
-#endif
-}
+  int Find(const char* name) const {
+    for (size_t i = 0; i < property.size(); ++i) {
+      if (property[i].name == name) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+};
 
-/*
- *  @name ComputeBoundingBox
- *  @fn void ComputeBoundingBox(void)
- *  @brief  Compute the bounding box of the mesh
+/**
+ *  @struct PLYHeader
+ *  @brief  Header of a ply file
  */
-template<typename T>
-void Mesh<T>::ComputeBoundingBox(void) {
- // Init bbox
- bbox_.min_.x_ = std::numeric_limits<T>::max();
- bbox_.max_.x_ = std::numeric_limits<T>::lowest();
- bbox_.min_.y_ = std::numeric_limits<T>::max();
- bbox_.max_.y_ = std::numeric_limits<T>::lowest();
- bbox_.min_.z_ = std::numeric_limits<T>::max();
- bbox_.max_.z_ = std::numeric_limits<T>::lowest();
-
- for (auto v_it = this->vertex_.begin(); v_it != this->vertex_.end(); ++v_it) {
-   // Compute boundary box
-   bbox_.min_.x_ = bbox_.min_.x_ < v_it->x_ ? bbox_.min_.x_ : v_it->x_;
-   bbox_.max_.x_ = bbox_.max_.x_ > v_it->x_ ? bbox_.max_.x_ : v_it->x_;
-   bbox_.min_.y_ = bbox_.min_.y_ < v_it->y_ ? bbox_.min_.y_ : v_it->y_;
-   bbox_.max_.y_ = bbox_.max_.y_ > v_it->y_ ? bbox_.max_.y_ : v_it->y_;
-   bbox_.min_.z_ = bbox_.min_.z_ < v_it->z_ ? bbox_.min_.z_ : v_it->z_;
-   bbox_.max_.z_ = bbox_.max_.z_ > v_it->z_ ? bbox_.max_.z_ : v_it->z_;
- }
- bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
- bbox_is_computed_ = true;
-}
-                 
-/*
- *  @name   PlaceToOrigin
- *  @fn     void PlaceToOrigin(void)
- *  @brief  Place mest to world origin (i.e. remove center of graviaty).
- */
-template<typename T>
-void Mesh<T>::PlaceToOrigin(void) {
-  // Get center of gravity
-  Vertex cog;
-  for (const auto& v : this->vertex_) {
-    cog += v;
-  }
-  cog /= static_cast<T>(this->vertex_.size());
-  // Center all vertex
-  for (auto& v : this->vertex_) {
-    v -= cog;
-  }
-  // Update bbox as well
-  if (bbox_is_computed_) {
-    bbox_.min_ -= cog;
-    bbox_.max_ -= cog;
-    bbox_.center_ -= cog;
+struct PLYHeader {
+  /** Encoding */
+  PLYFormat format;
+  /** Elements in file order */
+  std::vector<PLYElementDesc> element;
+  /** Header size in bytes, i.e. where data start */
+  size_t size;
+};
+
+/**
+ *  @name PLYTypeSize
+ *  @fn size_t PLYTypeSize(const PLYType type)
+ *  @brief  Size in bytes of a given type
+ *  @param[in]  type  Property type
+ *  @return Size in bytes
+ */
+size_t PLYTypeSize(const PLYType type) {
+  switch (type) {
+    case kPLYInt8:
+    case kPLYUInt8: return 1;
+    case kPLYInt16:
+    case kPLYUInt16: return 2;
+    case kPLYInt32:
+    case kPLYUInt32:
+    case kPLYFloat32: return 4;
+    case kPLYFloat64: return 8;
+    case kPLYInvalid:
+    default: return 0;
+  }
+}
+
+/**
+ *  @name PLYTypeFromString
+ *  @fn PLYType PLYTypeFromString(const std::string& name)
+ *  @brief  Convert a type name into its enum
+ *  @param[in]  name  Type name
+ *  @return Property type
+ */
+PLYType PLYTypeFromString(const std::string& name) {
+  if (name == "char" || name == "int8") {
+    return kPLYInt8;
+  } else if (name == "uchar" || name == "uint8") {
+    return kPLYUInt8;
+  } else if (name == "short" || name == "int16") {
+    return kPLYInt16;
+  } else if (name == "ushort" || name == "uint16") {
+    return kPLYUInt16;
+  } else if (name == "int" || name == "int32") {
+    return kPLYInt32;
+  } else if (name == "uint" || name == "uint32") {
+    return kPLYUInt32;
+  } else if (name == "float" || name == "float32") {
+    return kPLYFloat32;
+  } else if (name == "double" || name == "float64") {
+    return kPLYFloat64;
+  }
+  return kPLYInvalid;
+}
+
+/**
+ *  @name ParsePLYHeader
+ *  @fn int ParsePLYHeader(const char* first, const char* last,
+                           PLYHeader* header)
+ *  @brief  Parse the header of a ply file
+ *  @param[in]  first   Beginning of the buffer
+ *  @param[in]  last    End of the buffer
+ *  @param[out] header  Parsed header
+ *  @return -1 if error, 0 otherwise
+ */
+int ParsePLYHeader(const char* first, const char* last, PLYHeader* header) {
+  // Read header line by line, split into words
+  std::vector<std::string> words;
+  const char* p = first;
+  bool has_magic = false;
+  bool has_format = false;
+  header->element.clear();
+  while (p != last) {
+    const char* eol = p;
+    while (eol != last && *eol != '\n') {
+      ++eol;
+    }
+    words.clear();
+    const char* w = CharConv::SkipSpace(p, eol);
+    while (w != eol) {
+      const char* w_end = CharConv::SkipToken(w, eol);
+      words.emplace_back(w, w_end);
+      w = CharConv::SkipSpace(w_end, eol);
+    }
+    p = eol != last ? eol + 1 : last;
+    if (words.empty()) {
+      continue;
+    }
+    const std::string& key = words[0];
+    if (!has_magic) {
+      // Magic number
+      if (key != "ply") {
+        return -1;
+      }
+      has_magic = true;
+    } else if (key == "format" && words.size() >= 2) {
+      has_format = true;
+      if (words[1] == "ascii") {
+        header->format = kPLYAscii;
+      } else if (words[1] == "binary_little_endian") {
+        header->format = kPLYBinaryLE;
+      } else if (words[1] == "binary_big_endian") {
+        header->format = kPLYBinaryBE;
+      } else {
+        return -1;
+      }
+    } else if (key == "element" && words.size() >= 3) {
+      PLYElementDesc elem;
+      elem.name = words[1];
+      elem.count = static_cast<size_t>(std::strtoull(words[2].c_str(),
+                                                     nullptr,
+                                                     10));
+      elem.stride = 0;
+      header->element.push_back(elem);
+    } else if (key == "property" && !header->element.empty()) {
+      PLYPropertyDesc prop;
+      if (words.size() >= 5 && words[1] == "list") {
+        prop.count_type = PLYTypeFromString(words[2]);
+        prop.type = PLYTypeFromString(words[3]);
+        prop.name = words[4];
+        if (prop.count_type == kPLYInvalid) {
+          return -1;
+        }
+      } else if (words.size() >= 3) {
+        prop.count_type = kPLYInvalid;
+        prop.type = PLYTypeFromString(words[1]);
+        prop.name = words[2];
+      } else {
+        return -1;
+      }
+      if (prop.type == kPLYInvalid) {
+        return -1;
+      }
+      prop.offset = 0;
+      header->element.back().property.push_back(prop);
+    } else if (key == "end_header") {
+      header->size = static_cast<size_t>(p - first);
+      // Compute stride of element without list
+      for (auto& elem : header->element) {
+        size_t offset = 0;
+        for (auto& prop : elem.property) {
+          if (prop.count_type != kPLYInvalid) {
+            offset = 0;
+            break;
+          }
+          prop.offset = offset;
+          offset += PLYTypeSize(prop.type);
+        }
+        elem.stride = offset;
+      }
+      return has_format ? 0 : -1;
+    }
+  }
+  return -1;
+}
+
+/**
+ *  @name LoadRaw
+ *  @fn V LoadRaw(const char* p, const bool swap)
+ *  @brief  Read an unaligned value from a buffer
+ *  @param[in]  p     Where to read
+ *  @param[in]  swap  If true, swap bytes order
+ *  @return Value
+ */
+template<typename V>
+inline V LoadRaw(const char* p, const bool swap) {
+  V value;
+  if (!swap) {
+    std::memcpy(&value, p, sizeof(V));
+  } else {
+    char buffer[sizeof(V)];
+    for (size_t i = 0; i < sizeof(V); ++i) {
+      buffer[i] = p[sizeof(V) - 1 - i];
+    }
+    std::memcpy(&value, buffer, sizeof(V));
+  }
+  return value;
+}
+
+/**
+ *  @name ReadPLYScalar
+ *  @fn S ReadPLYScalar(const char* p, const PLYType type, const bool swap)
+ *  @brief  Read a binary ply scalar and convert it to \p S
+ *  @param[in]  p     Where to read
+ *  @param[in]  type  Type stored in the file
+ *  @param[in]  swap  If true, swap bytes order
+ *  @return Converted value
+ */
+template<typename S>
+inline S ReadPLYScalar(const char* p, const PLYType type, const bool swap) {
+  switch (type) {
+    case kPLYInt8: return static_cast<S>(LoadRaw<int8_t>(p, swap));
+    case kPLYUInt8: return static_cast<S>(LoadRaw<uint8_t>(p, swap));
+    case kPLYInt16: return static_cast<S>(LoadRaw<int16_t>(p, swap));
+    case kPLYUInt16: return static_cast<S>(LoadRaw<uint16_t>(p, swap));
+    case kPLYInt32: return static_cast<S>(LoadRaw<int32_t>(p, swap));
+    case kPLYUInt32: return static_cast<S>(LoadRaw<uint32_t>(p, swap));
+    case kPLYFloat32: return static_cast<S>(LoadRaw<float>(p, swap));
+    case kPLYFloat64: return static_cast<S>(LoadRaw<double>(p, swap));
+    case kPLYInvalid:
+    default: return S(0);
+  }
+}
+
+/**
+ *  @name PLYColorScale
+ *  @fn T PLYColorScale(const PLYType type)
+ *  @brief  Scaling factor bringing a color channel into [0, 1]
+ *  @param[in]  type  Channel type
+ *  @return Scaling factor
+ */
+template<typename T>
+T PLYColorScale(const PLYType type) {
+  switch (type) {
+    case kPLYUInt8: return T(1.0 / 255.0);
+    case kPLYUInt16: return T(1.0 / 65535.0);
+    default: return T(1.0);
+  }
+}
+
+/**
+ *  @struct PLYVertexLayout
+ *  @brief  Location of the vertex attributes in a ply vertex element, -1 if
+ *          not present
+ */
+struct PLYVertexLayout {
+  /** Position x, y, z */
+  int position[3];
+  /** Normal nx, ny, nz */
+  int normal[3];
+  /** Texture coordinate u, v */
+  int tcoord[2];
+  /** Color red, green, blue, alpha */
+  int color[4];
+
+  /**
+   *  @name PLYVertexLayout
+   *  @fn explicit PLYVertexLayout(const PLYElementDesc& elem)
+   *  @brief  Constructor
+   *  @param[in]  elem  Vertex element description
+   */
+  explicit PLYVertexLayout(const PLYElementDesc& elem) {
+    position[0] = elem.Find("x");
+    position[1] = elem.Find("y");
+    position[2] = elem.Find("z");
+    normal[0] = elem.Find("nx");
+    normal[1] = elem.Find("ny");
+    normal[2] = elem.Find("nz");
+    const char* u_names[] = {"u", "s", "texture_u"};
+    const char* v_names[] = {"v", "t", "texture_v"};
+    tcoord[0] = -1;
+    tcoord[1] = -1;
+    for (int k = 0; k < 3 && (tcoord[0] == -1 || tcoord[1] == -1); ++k) {
+      tcoord[0] = elem.Find(u_names[k]);
+      tcoord[1] = elem.Find(v_names[k]);
+    }
+    color[0] = elem.Find("red");
+    color[1] = elem.Find("green");
+    color[2] = elem.Find("blue");
+    color[3] = elem.Find("alpha");
+  }
+
+  /**
+   *  @name has_position
+   *  @fn bool has_position(void) const
+   *  @return True if x, y, z are present
+   */
+  bool has_position(void) const {
+    return position[0] != -1 && position[1] != -1 && position[2] != -1;
+  }
+
+  /**
+   *  @name has_normal
+   *  @fn bool has_normal(void) const
+   *  @return True if nx, ny, nz are present
+   */
+  bool has_normal(void) const {
+    return normal[0] != -1 && normal[1] != -1 && normal[2] != -1;
+  }
+
+  /**
+   *  @name has_tcoord
+   *  @fn bool has_tcoord(void) const
+   *  @return True if texture coordinates are present
+   */
+  bool has_tcoord(void) const {
+    return tcoord[0] != -1 && tcoord[1] != -1;
+  }
+
+  /**
+   *  @name has_color
+   *  @fn bool has_color(void) const
+   *  @return True if red, green, blue are present
+   */
+  bool has_color(void) const {
+    return color[0] != -1 && color[1] != -1 && color[2] != -1;
+  }
+};
+
+/**
+ *  @struct PLYContent
+ *  @brief  Data parsed from a .ply buffer
+ */
+template<typename T>
+struct PLYContent {
+  /** Vertex */
+  std::vector<typename Mesh<T>::Vertex> vertex;
+  /** Normal */
+  std::vector<typename Mesh<T>::Normal> normal;
+  /** Texture coordinate */
+  std::vector<typename Mesh<T>::TCoord> tcoord;
+  /** Vertex color */
+  std::vector<typename Mesh<T>::Color> color;
+  /** Triangle */
+  std::vector<typename Mesh<T>::Triangle> tri;
+  /** Bounding box of the vertex */
+  AABB<T> bbox;
+
+  /**
+   *  @name PLYContent
+   *  @fn PLYContent(void)
+   *  @brief  Constructor
+   */
+  PLYContent(void) {
+    bbox.min_.x_ = std::numeric_limits<T>::max();
+    bbox.max_.x_ = std::numeric_limits<T>::lowest();
+    bbox.min_.y_ = std::numeric_limits<T>::max();
+    bbox.max_.y_ = std::numeric_limits<T>::lowest();
+    bbox.min_.z_ = std::numeric_limits<T>::max();
+    bbox.max_.z_ = std::numeric_limits<T>::lowest();
+  }
+};
+
+/**
+ *  @name ReadPLYBinaryRecord
+ *  @fn const char* ReadPLYBinaryRecord(const char* p, const char* last,
+                                        const PLYElementDesc& elem,
+                                        const bool swap, double* value)
+ *  @brief  Move past one binary record of an element containing lists
+ *  @param[in]  p     Beginning of the record
+ *  @param[in]  last  End of the buffer
+ *  @param[in]  elem  Element description
+ *  @param[in]  swap  If true, swap bytes order
+ *  @param[out] value If not nullptr, value of each property (number of item
+ *                    for lists)
+ *  @return Position of the next record, nullptr if truncated
+ */
+const char* ReadPLYBinaryRecord(const char* p,
+                                const char* last,
+                                const PLYElementDesc& elem,
+                                const bool swap,
+                                double* value) {
+  for (size_t k = 0; k < elem.property.size(); ++k) {
+    const auto& prop = elem.property[k];
+    size_t n = 1;
+    if (prop.count_type != kPLYInvalid) {
+      const size_t sz = PLYTypeSize(prop.count_type);
+      if (static_cast<size_t>(last - p) < sz) {
+        return nullptr;
+      }
+      n = ReadPLYScalar<size_t>(p, prop.count_type, swap);
+      p += sz;
+    }
+    const size_t sz = PLYTypeSize(prop.type);
+    if (static_cast<size_t>(last - p) / sz < n) {
+      return nullptr;
+    }
+    if (value) {
+      value[k] = (prop.count_type != kPLYInvalid ?
+                  static_cast<double>(n) :
+                  ReadPLYScalar<double>(p, prop.type, swap));
+    }
+    p += n * sz;
+  }
+  return p;
+}
+
+/**
+ *  @name StorePLYVertex
+ *  @fn void StorePLYVertex(const double* val, const PLYVertexLayout& layout,
+                            const T* c_scale, const size_t i,
+                            PLYContent<T>* content)
+ *  @brief  Store the attributes of one vertex record
+ *  @param[in]  val       Value of each property of the record
+ *  @param[in]  layout    Vertex layout
+ *  @param[in]  c_scale   Scaling of each color channel
+ *  @param[in]  i         Vertex index
+ *  @param[out] content   Where to store the vertex (already allocated)
+ */
+template<typename T>
+void StorePLYVertex(const double* val,
+                    const PLYVertexLayout& layout,
+                    const T* c_scale,
+                    const size_t i,
+                    PLYContent<T>* content) {
+  const int* slot = &layout.position[0];
+  auto& v = content->vertex[i];
+  v.x_ = static_cast<T>(val[slot[0]]);
+  v.y_ = static_cast<T>(val[slot[1]]);
+  v.z_ = static_cast<T>(val[slot[2]]);
+  if (!content->normal.empty()) {
+    auto& nrm = content->normal[i];
+    nrm.x_ = static_cast<T>(val[slot[3]]);
+    nrm.y_ = static_cast<T>(val[slot[4]]);
+    nrm.z_ = static_cast<T>(val[slot[5]]);
+  }
+  if (!content->tcoord.empty()) {
+    auto& tc = content->tcoord[i];
+    tc.x_ = static_cast<T>(val[slot[6]]);
+    tc.y_ = static_cast<T>(val[slot[7]]);
+  }
+  if (!content->color.empty()) {
+    T* c = &content->color[i].x_;
+    for (int k = 0; k < 3; ++k) {
+      c[k] = static_cast<T>(val[slot[8 + k]]) * c_scale[k];
+    }
+    c[3] = (slot[11] != -1 ?
+            static_cast<T>(val[slot[11]]) * c_scale[3] :
+            T(1.0));
+  }
+}
+
+/**
+ *  @name ParsePLYBinaryVertex
+ *  @fn int ParsePLYBinaryVertex(const char* first, const char* last,
+                                 const PLYElementDesc& elem, const bool swap,
+                                 const bool parallel, PLYContent<T>* content)
+ *  @brief  Read a binary vertex block and scatter it into the attribute
+ *          arrays. Fixed stride blocks are scattered in parallel, blocks
+ *          holding lists are walked record by record.
+ *  @param[in]  first     Beginning of the vertex block
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  elem      Vertex element description
+ *  @param[in]  swap      If true, swap bytes order
+ *  @param[in]  parallel  Scatter on the library's thread pool
+ *  @param[out] content   Where to store the vertex
+ *  @return Position after the block or nullptr if error
+ */
+template<typename T>
+const char* ParsePLYBinaryVertex(const char* first,
+                                 const char* last,
+                                 const PLYElementDesc& elem,
+                                 const bool swap,
+                                 const bool parallel,
+                                 PLYContent<T>* content) {
+  const PLYVertexLayout layout(elem);
+  const size_t n = elem.count;
+  const size_t stride = elem.stride;
+  if (!layout.has_position() ||
+      (stride != 0 && static_cast<size_t>(last - first) / stride < n)) {
+    return nullptr;
+  }
+  // Offset and type of each attribute
+  size_t off[12];
+  PLYType type[12];
+  const int* slot = &layout.position[0];
+  for (int k = 0; k < 12; ++k) {
+    off[k] = slot[k] != -1 ? elem.property[slot[k]].offset : 0;
+    type[k] = slot[k] != -1 ? elem.property[slot[k]].type : kPLYInvalid;
+  }
+  content->vertex.resize(n);
+  if (layout.has_normal()) {
+    content->normal.resize(n);
+  }
+  if (layout.has_tcoord()) {
+    content->tcoord.resize(n);
+  }
+  const T c_scale[] = {PLYColorScale<T>(type[8]), PLYColorScale<T>(type[9]),
+                       PLYColorScale<T>(type[10]), PLYColorScale<T>(type[11])};
+  if (layout.has_color()) {
+    content->color.resize(n);
+  }
+  if (stride == 0) {
+    // Records holding lists, walked one after the other
+    std::vector<double> value(elem.property.size());
+    const char* p = first;
+    for (size_t i = 0; i < n && p; ++i) {
+      p = ReadPLYBinaryRecord(p, last, elem, swap, value.data());
+      if (p) {
+        StorePLYVertex(value.data(), layout, c_scale, i, content);
+      }
+    }
+    if (p) {
+      BoundingBox<T>::Extend(content->vertex.data(), n, &content->bbox);
+    }
+    return p;
+  }
+  auto scatter = [&](const size_t begin, const size_t end, AABB<T>* bbox) {
+    for (size_t i = begin; i < end; ++i) {
+      const char* rec = first + (i * stride);
+      auto& v = content->vertex[i];
+      v.x_ = ReadPLYScalar<T>(rec + off[0], type[0], swap);
+      v.y_ = ReadPLYScalar<T>(rec + off[1], type[1], swap);
+      v.z_ = ReadPLYScalar<T>(rec + off[2], type[2], swap);
+      if (!content->normal.empty()) {
+        auto& nrm = content->normal[i];
+        nrm.x_ = ReadPLYScalar<T>(rec + off[3], type[3], swap);
+        nrm.y_ = ReadPLYScalar<T>(rec + off[4], type[4], swap);
+        nrm.z_ = ReadPLYScalar<T>(rec + off[5], type[5], swap);
+      }
+      if (!content->tcoord.empty()) {
+        auto& tc = content->tcoord[i];
+        tc.x_ = ReadPLYScalar<T>(rec + off[6], type[6], swap);
+        tc.y_ = ReadPLYScalar<T>(rec + off[7], type[7], swap);
+      }
+      if (!content->color.empty()) {
+        T* c = &content->color[i].x_;
+        for (int k = 0; k < 3; ++k) {
+          c[k] = ReadPLYScalar<T>(rec + off[8 + k], type[8 + k], swap) *
+                 c_scale[k];
+        }
+        c[3] = (type[11] != kPLYInvalid ?
+                ReadPLYScalar<T>(rec + off[11], type[11], swap) * c_scale[3] :
+                T(1.0));
+      }
+    }
+    BoundingBox<T>::Extend(content->vertex.data() + begin, end - begin, bbox);
+  };
+  if (parallel) {
+    auto& pool = ThreadPool::Instance();
+    std::vector<PLYContent<T>> partial(pool.size() + 1);
+    std::atomic<size_t> block(0);
+    pool.ParallelFor(0, n, 1 << 16, [&](const size_t begin, const size_t end) {
+      // Each block reduces its own bounding box
+      AABB<T>& bbox = partial[block++].bbox;
+      scatter(begin, end, &bbox);
+    });
+    for (const auto& p : partial) {
+      content->bbox += p.bbox;
+    }
+  } else {
+    scatter(0, n, &content->bbox);
+  }
+  return first + (n * stride);
+}
+
+/**
+ *  @name AddPLYPolygon
+ *  @fn void AddPLYPolygon(const int* idx, const size_t n,
+                           std::vector<Triangle>* tri)
+ *  @brief  Triangulate a polygon as fan
+ *  @param[in]  idx   Polygon's vertex indices
+ *  @param[in]  n     Number of vertex in the polygon
+ *  @param[out] tri   Where to add triangles
+ */
+template<typename T>
+void AddPLYPolygon(const int* idx,
+                   const size_t n,
+                   std::vector<typename Mesh<T>::Triangle>* tri) {
+  for (size_t k = 2; k < n; ++k) {
+    tri->emplace_back(idx[0], idx[k - 1], idx[k]);
+  }
+}
+
+/**
+ *  @name ParsePLYBinaryFace
+ *  @fn const char* ParsePLYBinaryFace(const char* first, const char* last,
+                                       const PLYElementDesc& elem,
+                                       const bool swap, const bool parallel,
+                                       PLYContent<T>* content)
+ *  @brief  Read a binary face block. When the block contains only triangles
+ *          described by a single list it is read with a fixed stride,
+ *          otherwise record are walked one after the other and polygons are
+ *          triangulated as fan.
+ *  @param[in]  first     Beginning of the face block
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  elem      Face element description
+ *  @param[in]  swap      If true, swap bytes order
+ *  @param[in]  parallel  Scatter on the library's thread pool
+ *  @param[out] content   Where to store the faces
+ *  @return Position after the block or nullptr if error
+ */
+template<typename T>
+const char* ParsePLYBinaryFace(const char* first,
+                               const char* last,
+                               const PLYElementDesc& elem,
+                               const bool swap,
+                               const bool parallel,
+                               PLYContent<T>* content) {
+  using TCoord = typename Mesh<T>::TCoord;
+  int idx_prop = elem.Find("vertex_indices");
+  if (idx_prop == -1) {
+    idx_prop = elem.Find("vertex_index");
+  }
+  if (idx_prop == -1 || elem.property[idx_prop].count_type == kPLYInvalid) {
+    return nullptr;
+  }
+  const size_t n = elem.count;
+  const PLYPropertyDesc& list = elem.property[idx_prop];
+  const size_t c_size = PLYTypeSize(list.count_type);
+  const size_t i_size = PLYTypeSize(list.type);
+  // Fixed stride, triangles only
+  if (elem.property.size() == 1) {
+    const size_t stride = c_size + (3 * i_size);
+    if (static_cast<size_t>(last - first) / stride >= n) {
+      content->tri.resize(n);
+      std::atomic<bool> is_tri(true);
+      auto scatter = [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end && is_tri; ++i) {
+          const char* rec = first + (i * stride);
+          if (ReadPLYScalar<int>(rec, list.count_type, swap) != 3) {
+            is_tri = false;
+            break;
+          }
+          int* idx = &content->tri[i].x_;
+          idx[0] = ReadPLYScalar<int>(rec + c_size, list.type, swap);
+          idx[1] = ReadPLYScalar<int>(rec + c_size + i_size, list.type, swap);
+          idx[2] = ReadPLYScalar<int>(rec + c_size + (2 * i_size),
+                                      list.type,
+                                      swap);
+        }
+      };
+      if (parallel) {
+        ThreadPool::Instance().ParallelFor(0, n, 1 << 16, scatter);
+      } else {
+        scatter(0, n);
+      }
+      if (is_tri) {
+        return first + (n * stride);
+      }
+      content->tri.clear();
+    }
+  }
+  // Generic walk
+  const int tc_prop = elem.Find("texcoord");
+  std::vector<int> idx;
+  content->tri.reserve(n);
+  const char* p = first;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < elem.property.size(); ++k) {
+      const auto& prop = elem.property[k];
+      size_t n_item = 1;
+      if (prop.count_type != kPLYInvalid) {
+        const size_t sz = PLYTypeSize(prop.count_type);
+        if (static_cast<size_t>(last - p) < sz) {
+          return nullptr;
+        }
+        n_item = ReadPLYScalar<size_t>(p, prop.count_type, swap);
+        p += sz;
+      }
+      const size_t sz = PLYTypeSize(prop.type);
+      if (static_cast<size_t>(last - p) / sz < n_item) {
+        return nullptr;
+      }
+      if (static_cast<int>(k) == idx_prop) {
+        idx.resize(n_item);
+        for (size_t j = 0; j < n_item; ++j) {
+          idx[j] = ReadPLYScalar<int>(p + (j * sz), prop.type, swap);
+        }
+        AddPLYPolygon<T>(idx.data(), n_item, &content->tri);
+      } else if (static_cast<int>(k) == tc_prop) {
+        // Per corner texture coordinates
+        for (size_t j = 0; j + 1 < n_item; j += 2) {
+          content->tcoord.push_back(TCoord(
+                  ReadPLYScalar<T>(p + (j * sz), prop.type, swap),
+                  ReadPLYScalar<T>(p + ((j + 1) * sz), prop.type, swap)));
+        }
+      }
+      p += n_item * sz;
+    }
+  }
+  return p;
+}
+
+/**
+ *  @name ParsePLYBinary
+ *  @fn int ParsePLYBinary(const char* first, const char* last,
+                           const PLYHeader& header, const bool parallel,
+                           PLYContent<T>* content)
+ *  @brief  Read the data of a binary ply file directly from a buffer
+ *  @param[in]  first     Beginning of the data (i.e. after the header)
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  header    File's header
+ *  @param[in]  parallel  Scatter on the library's thread pool
+ *  @param[out] content   Parsed data
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int ParsePLYBinary(const char* first,
+                   const char* last,
+                   const PLYHeader& header,
+                   const bool parallel,
+                   PLYContent<T>* content) {
+  const uint16_t one = 1;
+  const bool host_le = *reinterpret_cast<const uint8_t*>(&one) == 1;
+  const bool swap = (header.format == kPLYBinaryLE) != host_le;
+  const char* p = first;
+  for (const auto& elem : header.element) {
+    if (elem.name == "vertex") {
+      p = ParsePLYBinaryVertex(p, last, elem, swap, parallel, content);
+    } else if (elem.name == "face") {
+      p = ParsePLYBinaryFace(p, last, elem, swap, parallel, content);
+    } else if (elem.stride != 0) {
+      // Skip unused element
+      if (static_cast<size_t>(last - p) / elem.stride < elem.count) {
+        return -1;
+      }
+      p += elem.count * elem.stride;
+    } else {
+      for (size_t i = 0; i < elem.count && p; ++i) {
+        p = ReadPLYBinaryRecord(p, last, elem, swap, nullptr);
+      }
+    }
+    if (!p) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+ *  @class  PLYLineIndex
+ *  @brief  Coarse index of the line breaks of a buffer, allowing to jump to
+ *          a given line without scanning everything before it.
+ */
+class PLYLineIndex {
+ public:
+  /**
+   *  @name Build
+   *  @fn void Build(const char* first, const char* last, const size_t n_chunk,
+                     const bool parallel)
+   *  @brief  Count line breaks of each chunk of the buffer
+   *  @param[in]  first     Beginning of the buffer
+   *  @param[in]  last      End of the buffer
+   *  @param[in]  n_chunk   Number of chunk
+   *  @param[in]  parallel  Count on the library's thread pool
+   */
+  void Build(const char* first,
+             const char* last,
+             const size_t n_chunk,
+             const bool parallel) {
+    const size_t size = static_cast<size_t>(last - first);
+    const size_t n = std::max(std::min(n_chunk, size), size_t(1));
+    last_ = last;
+    chunk_.resize(n + 1);
+    line_.assign(n + 1, 0);
+    for (size_t c = 0; c <= n; ++c) {
+      chunk_[c] = first + (c * size) / n;
+    }
+    auto count = [&](const size_t begin, const size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        line_[c + 1] = static_cast<size_t>(std::count(chunk_[c],
+                                                      chunk_[c + 1],
+                                                      '\n'));
+      }
+    };
+    if (parallel) {
+      ThreadPool::Instance().ParallelFor(0, n, 1, count);
+    } else {
+      count(0, n);
+    }
+    for (size_t c = 0; c < n; ++c) {
+      line_[c + 1] += line_[c];
+    }
+  }
+
+  /**
+   *  @name Seek
+   *  @fn const char* Seek(const size_t line) const
+   *  @brief  Find where a given line starts
+   *  @param[in]  line  Line number (starting at 0)
+   *  @return Beginning of the line or nullptr if the buffer is shorter
+   */
+  const char* Seek(const size_t line) const {
+    if (line == 0) {
+      return chunk_[0];
+    }
+    if (line > line_.back()) {
+      return nullptr;
+    }
+    // Chunk holding the line break ending line - 1
+    const size_t c = static_cast<size_t>(std::lower_bound(line_.begin(),
+                                                          line_.end(),
+                                                          line) -
+                                         line_.begin()) - 1;
+    const char* p = chunk_[c];
+    for (size_t k = line_[c]; k < line; ++k) {
+      p = static_cast<const char*>(std::memchr(p, '\n', last_ - p)) + 1;
+    }
+    return p;
+  }
+
+ private:
+  /** Chunk boundaries */
+  std::vector<const char*> chunk_;
+  /** Number of line break before each chunk */
+  std::vector<size_t> line_;
+  /** End of the buffer */
+  const char* last_;
+};
+
+/**
+ *  @name SkipPLYSpace
+ *  @fn const char* SkipPLYSpace(const char* p, const char* last,
+                                 const bool by_line)
+ *  @brief  Move to the next token of an ascii record
+ *  @param[in]  p         Current position
+ *  @param[in]  last      End of the range
+ *  @param[in]  by_line   If true, line breaks are not skipped
+ *  @return Position of the next token
+ */
+const char* SkipPLYSpace(const char* p, const char* last, const bool by_line) {
+  while (p != last && (CharConv::IsSpace(*p) || (!by_line && *p == '\n'))) {
+    ++p;
+  }
+  return p;
+}
+
+/**
+ *  @name FindPLYRecordEnd
+ *  @fn const char* FindPLYRecordEnd(const char* p, const char* last,
+                                     const bool by_line)
+ *  @brief  Find the bound of an ascii record, its line break when records
+ *          fill one line each, the end of the buffer otherwise
+ *  @param[in]  p         Beginning of the record
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  by_line   If true, one record per line
+ *  @return Bound of the record
+ */
+const char* FindPLYRecordEnd(const char* p,
+                             const char* last,
+                             const bool by_line) {
+  if (!by_line) {
+    return last;
+  }
+  const char* eol = static_cast<const char*>(std::memchr(p, '\n', last - p));
+  return eol ? eol : last;
+}
+
+/**
+ *  @name NextPLYRecord
+ *  @fn const char* NextPLYRecord(const char* p, const char* eol,
+                                  const char* last, const bool by_line)
+ *  @brief  Move past a parsed ascii record. When records fill one line each,
+ *          nothing but blanks may follow it on its line.
+ *  @param[in]  p         Position after the record's last token
+ *  @param[in]  eol       Bound of the record
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  by_line   If true, one record per line
+ *  @return Beginning of the next record, nullptr if the line holds more
+ */
+const char* NextPLYRecord(const char* p,
+                          const char* eol,
+                          const char* last,
+                          const bool by_line) {
+  if (!by_line) {
+    return p;
+  }
+  if (CharConv::SkipSpace(p, eol) != eol) {
+    return nullptr;
+  }
+  return eol != last ? eol + 1 : last;
+}
+
+/**
+ *  @name SkipPLYAsciiRecord
+ *  @fn const char* SkipPLYAsciiRecord(const char* first, const char* last,
+                                       const PLYElementDesc& elem,
+                                       const size_t n, const bool by_line)
+ *  @brief  Move past \p n consecutive ascii records of an unused element
+ *  @param[in]  first     Beginning of the first record
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  elem      Element description
+ *  @param[in]  n         Number of record to skip
+ *  @param[in]  by_line   If true, one record per line
+ *  @return Position after the last record or nullptr if error
+ */
+const char* SkipPLYAsciiRecord(const char* first,
+                               const char* last,
+                               const PLYElementDesc& elem,
+                               const size_t n,
+                               const bool by_line) {
+  const char* p = first;
+  for (size_t i = 0; i < n && p; ++i) {
+    const char* eol = FindPLYRecordEnd(p, last, by_line);
+    for (const auto& prop : elem.property) {
+      int n_item = 1;
+      if (prop.count_type != kPLYInvalid) {
+        const char* q = SkipPLYSpace(p, eol, by_line);
+        p = CharConv::FromChars(q, eol, &n_item);
+        if (p == q || n_item < 0) {
+          return nullptr;
+        }
+      }
+      for (int j = 0; j < n_item; ++j) {
+        const char* q = SkipPLYSpace(p, eol, by_line);
+        p = CharConv::SkipToken(q, eol);
+        if (p == q) {
+          return nullptr;
+        }
+      }
+    }
+    p = NextPLYRecord(p, eol, last, by_line);
+  }
+  return p;
+}
+
+/**
+ *  @name ParsePLYAsciiVertex
+ *  @fn const char* ParsePLYAsciiVertex(const char* first, const char* last,
+                                        const PLYElementDesc& elem,
+                                        const PLYVertexLayout& layout,
+                                        const size_t n,
+                                        std::vector<double>* value,
+                                        const size_t idx, const bool by_line,
+                                        PLYContent<T>* content)
+ *  @brief  Parse \p n consecutive ascii vertex records
+ *  @param[in]  first   Beginning of the first record
+ *  @param[in]  last    End of the buffer
+ *  @param[in]  elem    Vertex element description
+ *  @param[in]  layout  Vertex layout
+ *  @param[in]  n       Number of record to parse
+ *  @param[in]  value   Buffer holding the record's values
+ *  @param[in]  idx     Index of the first vertex
+ *  @param[in]  by_line If true, one record per line
+ *  @param[out] content Where to store the vertex (already allocated)
+ *  @return Position after the last record or nullptr if error
+ */
+template<typename T>
+const char* ParsePLYAsciiVertex(const char* first,
+                                const char* last,
+                                const PLYElementDesc& elem,
+                                const PLYVertexLayout& layout,
+                                const size_t n,
+                                std::vector<double>* value,
+                                const size_t idx,
+                                const bool by_line,
+                                PLYContent<T>* content) {
+  T c_scale[4];
+  for (int k = 0; k < 4; ++k) {
+    c_scale[k] = (layout.color[k] != -1 ?
+                  PLYColorScale<T>(elem.property[layout.color[k]].type) :
+                  T(1.0));
+  }
+  double* val = value->data();
+  const char* p = first;
+  for (size_t i = idx; i < idx + n && p; ++i) {
+    const char* eol = FindPLYRecordEnd(p, last, by_line);
+    for (size_t k = 0; k < elem.property.size(); ++k) {
+      const char* q = SkipPLYSpace(p, eol, by_line);
+      p = CharConv::FromChars(q, eol, &val[k]);
+      if (p == q) {
+        return nullptr;
+      }
+      if (elem.property[k].count_type != kPLYInvalid) {
+        // List are not used for vertex, skip items
+        for (int j = 0; j < static_cast<int>(val[k]); ++j) {
+          q = SkipPLYSpace(p, eol, by_line);
+          p = CharConv::SkipToken(q, eol);
+          if (p == q) {
+            return nullptr;
+          }
+        }
+      }
+    }
+    StorePLYVertex(val, layout, c_scale, i, content);
+    p = NextPLYRecord(p, eol, last, by_line);
+  }
+  return p;
+}
+
+/**
+ *  @name ParsePLYAsciiFace
+ *  @fn const char* ParsePLYAsciiFace(const char* first, const char* last,
+                                      const PLYElementDesc& elem,
+                                      const size_t n, const bool by_line,
+                                      PLYContent<T>* content)
+ *  @brief  Parse \p n consecutive ascii face records, polygons are
+ *          triangulated as fan
+ *  @param[in]  first   Beginning of the first record
+ *  @param[in]  last    End of the buffer
+ *  @param[in]  elem    Face element description
+ *  @param[in]  n       Number of record to parse
+ *  @param[in]  by_line If true, one record per line
+ *  @param[out] content Where to add the triangles
+ *  @return Position after the last record or nullptr if error
+ */
+template<typename T>
+const char* ParsePLYAsciiFace(const char* first,
+                              const char* last,
+                              const PLYElementDesc& elem,
+                              const size_t n,
+                              const bool by_line,
+                              PLYContent<T>* content) {
+  using TCoord = typename Mesh<T>::TCoord;
+  int idx_prop = elem.Find("vertex_indices");
+  if (idx_prop == -1) {
+    idx_prop = elem.Find("vertex_index");
+  }
+  const int tc_prop = elem.Find("texcoord");
+  std::vector<int> idx;
+  std::vector<T> tc;
+  content->tri.reserve(content->tri.size() + n);
+  const char* p = first;
+  for (size_t i = 0; i < n && p; ++i) {
+    const char* eol = FindPLYRecordEnd(p, last, by_line);
+    for (size_t k = 0; k < elem.property.size(); ++k) {
+      int n_item = 1;
+      if (elem.property[k].count_type != kPLYInvalid) {
+        const char* q = SkipPLYSpace(p, eol, by_line);
+        p = CharConv::FromChars(q, eol, &n_item);
+        if (p == q || n_item < 0) {
+          return nullptr;
+        }
+      }
+      if (static_cast<int>(k) == idx_prop) {
+        idx.resize(n_item);
+        for (int j = 0; j < n_item; ++j) {
+          const char* q = SkipPLYSpace(p, eol, by_line);
+          p = CharConv::FromChars(q, eol, &idx[j]);
+          if (p == q) {
+            return nullptr;
+          }
+        }
+        AddPLYPolygon<T>(idx.data(), idx.size(), &content->tri);
+      } else if (static_cast<int>(k) == tc_prop) {
+        tc.resize(n_item);
+        for (int j = 0; j < n_item; ++j) {
+          const char* q = SkipPLYSpace(p, eol, by_line);
+          p = CharConv::FromChars(q, eol, &tc[j]);
+          if (p == q) {
+            return nullptr;
+          }
+        }
+        for (int j = 0; j + 1 < n_item; j += 2) {
+          content->tcoord.push_back(TCoord(tc[j], tc[j + 1]));
+        }
+      } else {
+        for (int j = 0; j < n_item; ++j) {
+          const char* q = SkipPLYSpace(p, eol, by_line);
+          p = CharConv::SkipToken(q, eol);
+          if (p == q) {
+            return nullptr;
+          }
+        }
+      }
+    }
+    p = NextPLYRecord(p, eol, last, by_line);
+  }
+  return p;
+}
+
+/**
+ *  @name ParsePLYAscii
+ *  @fn int ParsePLYAscii(const char* first, const char* last,
+                          const PLYHeader& header, const bool parallel,
+                          PLYContent<T>* content)
+ *  @brief  Read the data of an ascii ply file. Records are first expected to
+ *          fill one line each, each element's section is then located from a
+ *          line index and parsed in chunks, on the library's thread pool if
+ *          requested. Once a record spans or shares lines, the remaining data
+ *          are walked token by token.
+ *  @param[in]  first     Beginning of the data (i.e. after the header)
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  header    File's header
+ *  @param[in]  parallel  Parse on the library's thread pool
+ *  @param[out] content   Parsed data
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int ParsePLYAscii(const char* first,
+                  const char* last,
+                  const PLYHeader& header,
+                  const bool parallel,
+                  PLYContent<T>* content) {
+  auto& pool = ThreadPool::Instance();
+  const size_t n_chunk = parallel ? 2 * (pool.size() + 1) : 1;
+  PLYLineIndex index;
+  index.Build(first, last, n_chunk, parallel);
+  bool by_line = true;
+  size_t line = 0;
+  const char* p = nullptr;
+  for (const auto& elem : header.element) {
+    const bool is_vertex = elem.name == "vertex";
+    const bool is_face = elem.name == "face";
+    const PLYVertexLayout layout(elem);
+    if (is_vertex) {
+      if (elem.count > 0 && !layout.has_position()) {
+        return -1;
+      }
+      content->vertex.resize(elem.count);
+      content->normal.resize(layout.has_normal() ? elem.count : 0);
+      content->tcoord.resize(layout.has_tcoord() ? elem.count : 0);
+      content->color.resize(layout.has_color() ? elem.count : 0);
+    }
+    if (by_line && (is_vertex || is_face)) {
+      // Parse each chunk of record independently
+      const size_t n_block = std::min(n_chunk, elem.count);
+      std::vector<PLYContent<T>> partial(n_block);
+      std::vector<int> errors(n_block, 0);
+      auto parse = [&](const size_t begin, const size_t end) {
+        std::vector<double> value(elem.property.size());
+        for (size_t b = begin; b < end; ++b) {
+          const size_t r_first = (b * elem.count) / n_block;
+          const size_t r_last = ((b + 1) * elem.count) / n_block;
+          const char* q = index.Seek(line + r_first);
+          if (q && is_vertex) {
+            q = ParsePLYAsciiVertex(q, last, elem, layout, r_last - r_first,
+                                    &value, r_first, true, content);
+            if (q) {
+              BoundingBox<T>::Extend(content->vertex.data() + r_first,
+                                     r_last - r_first,
+                                     &partial[b].bbox);
+            }
+          } else if (q) {
+            q = ParsePLYAsciiFace(q, last, elem, r_last - r_first, true,
+                                  &partial[b]);
+          }
+          errors[b] = q ? 0 : -1;
+        }
+      };
+      if (parallel) {
+        pool.ParallelFor(0, n_block, 1, parse);
+      } else {
+        parse(0, n_block);
+      }
+      by_line = std::find(errors.begin(), errors.end(), -1) == errors.end();
+      if (by_line) {
+        // Merge in file order
+        for (const auto& part : partial) {
+          content->bbox += part.bbox;
+          content->tri.insert(content->tri.end(),
+                              part.tri.begin(),
+                              part.tri.end());
+          content->tcoord.insert(content->tcoord.end(),
+                                 part.tcoord.begin(),
+                                 part.tcoord.end());
+        }
+      }
+    } else if (by_line) {
+      const char* q = index.Seek(line);
+      by_line = q && SkipPLYAsciiRecord(q, last, elem, elem.count, true);
+    }
+    if (by_line) {
+      line += elem.count;
+      continue;
+    }
+    // Records span or share lines, walk tokens from this element on
+    if (!p) {
+      p = index.Seek(line);
+      if (!p) {
+        return -1;
+      }
+    }
+    if (is_vertex) {
+      std::vector<double> value(elem.property.size());
+      p = ParsePLYAsciiVertex(p, last, elem, layout, elem.count, &value, 0,
+                              false, content);
+      if (p) {
+        BoundingBox<T>::Extend(content->vertex.data(), elem.count,
+                               &content->bbox);
+      }
+    } else if (is_face) {
+      p = ParsePLYAsciiFace(p, last, elem, elem.count, false, content);
+    } else {
+      p = SkipPLYAsciiRecord(p, last, elem, elem.count, false);
+    }
+    if (!p) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+ *  @name ParsePLYStream
+ *  @fn int ParsePLYStream(Decompressor* stream, const bool parallel,
+                           PLYContent<T>* content)
+ *  @brief  Parse a .ply file while it is being decompressed. Binary elements
+ *          with fixed size records are read as soon as they are complete,
+ *          the remaining elements (and ascii content) once everything is
+ *          decompressed.
+ *  @param[in]  stream    Opened decompressor
+ *  @param[in]  parallel  Parse on the library's thread pool
+ *  @param[out] content   Parsed data
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int ParsePLYStream(Decompressor* stream,
+                   const bool parallel,
+                   PLYContent<T>* content) {
+  // Header, wait until end_header is reached
+  PLYHeader header;
+  size_t want = 1 << 12;
+  size_t avail = stream->Wait(want);
+  while (ParsePLYHeader(stream->data(), stream->data() + avail, &header)) {
+    if (avail < want) {
+      return -1;
+    }
+    want *= 2;
+    avail = stream->Wait(want);
+  }
+  // Leading fixed size elements
+  PLYHeader part = header;
+  size_t offset = header.size;
+  size_t k = 0;
+  if (header.format != kPLYAscii) {
+    for (; k < header.element.size() && header.element[k].stride != 0; ++k) {
+      const PLYElementDesc& elem = header.element[k];
+      const size_t size = elem.count * elem.stride;
+      if (stream->Wait(offset + size) < offset + size) {
+        return -1;
+      }
+      part.element.assign(1, elem);
+      const char* first = stream->data() + offset;
+      if (ParsePLYBinary(first, first + size, part, parallel, content)) {
+        return -1;
+      }
+      offset += size;
+    }
+  }
+  // Remaining elements
+  if (stream->Finish()) {
+    return -1;
+  }
+  avail = stream->Wait(0);
+  part.element.assign(header.element.begin() + k, header.element.end());
+  const char* first = stream->data() + offset;
+  const char* last = stream->data() + avail;
+  return (header.format == kPLYAscii ?
+          ParsePLYAscii(first, last, part, parallel, content) :
+          ParsePLYBinary(first, last, part, parallel, content));
+}
+
+/** Binary STL header (80 bytes comment + triangle count) */
+const size_t kSTLHeaderSize = 84;
+/** Binary STL facet record (normal, 3 vertex, attribute) */
+const size_t kSTLRecordSize = 50;
+
+/**
+ *  @struct STLContent
+ *  @brief  Data parsed from a .stl buffer, triangle soup
+ */
+template<typename T>
+struct STLContent {
+  /** Triangle corners, three per facet */
+  std::vector<typename Mesh<T>::Vertex> corner;
+  /** Bounding box of the corners */
+  AABB<T> bbox;
+
+  /**
+   *  @name STLContent
+   *  @fn STLContent(void)
+   *  @brief  Constructor
+   */
+  STLContent(void) {
+    bbox.min_.x_ = std::numeric_limits<T>::max();
+    bbox.max_.x_ = std::numeric_limits<T>::lowest();
+    bbox.min_.y_ = std::numeric_limits<T>::max();
+    bbox.max_.y_ = std::numeric_limits<T>::lowest();
+    bbox.min_.z_ = std::numeric_limits<T>::max();
+    bbox.max_.z_ = std::numeric_limits<T>::lowest();
+  }
+};
+
+/**
+ *  @name IsBinarySTL
+ *  @fn bool IsBinarySTL(const char* data, const size_t size)
+ *  @brief  Check if a buffer holds a binary .stl file, the size must match
+ *          the triangle count given in the header (ascii files start with
+ *          "solid", which is also allowed in binary's comment)
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size
+ *  @return True if binary
+ */
+bool IsBinarySTL(const char* data, const size_t size) {
+  if (size < kSTLHeaderSize) {
+    return false;
+  }
+  const uint16_t one = 1;
+  const bool swap = *reinterpret_cast<const uint8_t*>(&one) != 1;
+  const size_t n = LoadRaw<uint32_t>(data + 80, swap);
+  return (size - kSTLHeaderSize) / kSTLRecordSize == n &&
+         (size - kSTLHeaderSize) % kSTLRecordSize == 0;
+}
+
+/**
+ *  @name ParseSTLBinary
+ *  @fn int ParseSTLBinary(const char* first, const char* last,
+                           const bool parallel, STLContent<T>* content)
+ *  @brief  Read the facets of a binary .stl buffer (little endian), facet's
+ *          normals are ignored.
+ *  @param[in]  first     Beginning of the buffer (i.e. header)
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  parallel  Read on the library's thread pool
+ *  @param[out] content   Parsed data
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int ParseSTLBinary(const char* first,
+                   const char* last,
+                   const bool parallel,
+                   STLContent<T>* content) {
+  using Vertex = typename Mesh<T>::Vertex;
+  const size_t size = static_cast<size_t>(last - first);
+  if (!IsBinarySTL(first, size)) {
+    return -1;
+  }
+  const uint16_t one = 1;
+  const bool swap = *reinterpret_cast<const uint8_t*>(&one) != 1;
+  const size_t n = (size - kSTLHeaderSize) / kSTLRecordSize;
+  content->corner.resize(3 * n);
+  auto& pool = ThreadPool::Instance();
+  const size_t n_block = parallel ? pool.size() + 1 : 1;
+  std::vector<STLContent<T>> partial(n_block);
+  auto read = [&](const size_t begin, const size_t end) {
+    for (size_t b = begin; b < end; ++b) {
+      const size_t f_first = (b * n) / n_block;
+      const size_t f_last = ((b + 1) * n) / n_block;
+      const char* p = first + kSTLHeaderSize + (f_first * kSTLRecordSize);
+      Vertex* v = &content->corner[3 * f_first];
+      for (size_t f = f_first; f < f_last; ++f, p += kSTLRecordSize) {
+        for (size_t k = 0; k < 3; ++k, ++v) {
+          // + 0 folds -0 into +0, equal positions have equal bits
+          const char* q = p + 12 + (12 * k);
+          v->x_ = static_cast<T>(LoadRaw<float>(q, swap)) + T(0);
+          v->y_ = static_cast<T>(LoadRaw<float>(q + 4, swap)) + T(0);
+          v->z_ = static_cast<T>(LoadRaw<float>(q + 8, swap)) + T(0);
+        }
+      }
+      BoundingBox<T>::Extend(content->corner.data() + 3 * f_first,
+                             3 * (f_last - f_first),
+                             &partial[b].bbox);
+    }
+  };
+  if (n_block > 1) {
+    pool.ParallelFor(0, n_block, 1, read);
+  } else {
+    read(0, n_block);
+  }
+  for (const auto& part : partial) {
+    content->bbox += part.bbox;
+  }
+  return 0;
+}
+
+/**
+ *  @name ParseSTLAscii
+ *  @fn int ParseSTLAscii(const char* first, const char* last,
+                          const bool parallel, STLContent<T>* content)
+ *  @brief  Read the facets of an ascii .stl buffer. Only "vertex" lines
+ *          carry data, three consecutive ones form a facet, therefore the
+ *          buffer is split into line chunks parsed independently.
+ *  @param[in]  first     Beginning of the buffer
+ *  @param[in]  last      End of the buffer
+ *  @param[in]  parallel  Parse on the library's thread pool
+ *  @param[out] content   Parsed data
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int ParseSTLAscii(const char* first,
+                  const char* last,
+                  const bool parallel,
+                  STLContent<T>* content) {
+  using Vertex = typename Mesh<T>::Vertex;
+  auto& pool = ThreadPool::Instance();
+  const auto bound = SplitLines(first,
+                                last,
+                                parallel ? 2 * (pool.size() + 1) : 1);
+  const size_t n_chunk = bound.size() - 1;
+  std::vector<STLContent<T>> chunks(n_chunk);
+  std::vector<int> errors(n_chunk, 0);
+  auto parse = [&](const size_t begin, const size_t end) {
+    for (size_t c = begin; c < end; ++c) {
+      STLContent<T>& chunk = chunks[c];
+      const char* p = bound[c];
+      const char* p_last = bound[c + 1];
+      while (p != p_last && !errors[c]) {
+        p = CharConv::SkipSpace(p, p_last);
+        const char* key_end = CharConv::SkipToken(p, p_last);
+        if (key_end - p == 6 && std::strncmp(p, "vertex", 6) == 0) {
+          Vertex v;
+          p = ParseReals(key_end, p_last, 3, &v.x_);
+          if (!p) {
+            errors[c] = -1;
+            break;
+          }
+          v.x_ += T(0);
+          v.y_ += T(0);
+          v.z_ += T(0);
+          chunk.corner.push_back(v);
+        }
+        p = CharConv::SkipLine(p, p_last);
+      }
+      BoundingBox<T>::Extend(chunk.corner.data(),
+                             chunk.corner.size(),
+                             &chunk.bbox);
+    }
+  };
+  if (n_chunk > 1) {
+    pool.ParallelFor(0, n_chunk, 1, parse);
+  } else {
+    parse(0, n_chunk);
+  }
+  size_t n = 0;
+  for (size_t c = 0; c < n_chunk; ++c) {
+    if (errors[c]) {
+      return -1;
+    }
+    n += chunks[c].corner.size();
+  }
+  if (n % 3 != 0) {
+    return -1;
+  }
+  content->corner.reserve(n);
+  for (const auto& chunk : chunks) {
+    content->corner.insert(content->corner.end(),
+                           chunk.corner.begin(),
+                           chunk.corner.end());
+    content->bbox += chunk.bbox;
+  }
+  return 0;
+}
+
+/**
+ *  @name HashPosition
+ *  @fn uint64_t HashPosition(const V& v)
+ *  @brief  Hash the bit pattern of a position
+ *  @param[in]  v Position
+ *  @return Hash value
+ */
+template<typename V>
+inline uint64_t HashPosition(const V& v) {
+  using S = typename std::conditional<sizeof(v.x_) == 4,
+                                      uint32_t,
+                                      uint64_t>::type;
+  const auto* c = &v.x_;
+  uint64_t h = 0x9E3779B97F4A7C15ULL;
+  for (int k = 0; k < 3; ++k) {
+    S bits;
+    std::memcpy(&bits, &c[k], sizeof(S));
+    h = (h ^ static_cast<uint64_t>(bits)) * 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 32;
+  }
+  return h;
+}
+
+/**
+ *  @name WeldCorners
+ *  @fn void WeldCorners(const std::vector<Vertex>& corner, const bool parallel,
+                         std::vector<Vertex>* vertex,
+                         std::vector<Triangle>* tri)
+ *  @brief  Merge identical corners of a triangle soup into shared vertices.
+ *          Corners are hashed by position and scattered into buckets (count,
+ *          prefix sum, fill), each bucket is then welded independently with
+ *          its own hash table. Vertices are numbered by first occurrence, the
+ *          result does not depend on the number of thread.
+ *  @param[in]  corner    Triangle corners, three per triangle
+ *  @param[in]  parallel  Weld on the library's thread pool
+ *  @param[out] vertex    Unique positions
+ *  @param[out] tri       Triangles indexing \p vertex
+ */
+template<typename T>
+void WeldCorners(const std::vector<typename Mesh<T>::Vertex>& corner,
+                 const bool parallel,
+                 std::vector<typename Mesh<T>::Vertex>* vertex,
+                 std::vector<typename Mesh<T>::Triangle>* tri) {
+  auto& pool = ThreadPool::Instance();
+  const size_t n = corner.size();
+  const size_t n_block = parallel ? pool.size() + 1 : 1;
+  // Buckets picked from hash's high bits, slots from the low ones
+  const int bucket_bits = parallel ? 8 : 0;
+  const size_t n_bucket = size_t(1) << bucket_bits;
+  auto bucket_of = [&](const uint64_t h) -> size_t {
+    return bucket_bits ? static_cast<size_t>(h >> (64 - bucket_bits)) : 0;
+  };
+  auto run = [&](const size_t count, const std::function<void(size_t,
+                                                             size_t)>& fcn) {
+    if (parallel) {
+      pool.ParallelFor(0, count, 1, fcn);
+    } else {
+      fcn(0, count);
+    }
+  };
+  // Count
+  std::vector<uint64_t> hash(n);
+  std::vector<size_t> offset(n_block * n_bucket, 0);
+  run(n_block, [&](const size_t begin, const size_t end) {
+    for (size_t b = begin; b < end; ++b) {
+      size_t* count = &offset[b * n_bucket];
+      for (size_t i = (b * n) / n_block; i < ((b + 1) * n) / n_block; ++i) {
+        hash[i] = HashPosition(corner[i]);
+        ++count[bucket_of(hash[i])];
+      }
+    }
+  });
+  // Prefix sum, bucket major so that each bucket lists corners in order
+  std::vector<size_t> bucket_start(n_bucket + 1, 0);
+  size_t sum = 0;
+  for (size_t k = 0; k < n_bucket; ++k) {
+    bucket_start[k] = sum;
+    for (size_t b = 0; b < n_block; ++b) {
+      const size_t c = offset[(b * n_bucket) + k];
+      offset[(b * n_bucket) + k] = sum;
+      sum += c;
+    }
+  }
+  bucket_start[n_bucket] = sum;
+  // Fill
+  std::vector<int> order(n);
+  run(n_block, [&](const size_t begin, const size_t end) {
+    for (size_t b = begin; b < end; ++b) {
+      size_t* pos = &offset[b * n_bucket];
+      for (size_t i = (b * n) / n_block; i < ((b + 1) * n) / n_block; ++i) {
+        order[pos[bucket_of(hash[i])]++] = static_cast<int>(i);
+      }
+    }
+  });
+  // Weld each bucket, representative is the first corner at a position
+  std::vector<int> rep(n);
+  run(n_bucket, [&](const size_t begin, const size_t end) {
+    std::vector<int> slot;
+    for (size_t k = begin; k < end; ++k) {
+      const size_t b_first = bucket_start[k];
+      const size_t b_size = bucket_start[k + 1] - b_first;
+      size_t capacity = 16;
+      while (capacity < 2 * b_size) {
+        capacity *= 2;
+      }
+      const size_t mask = capacity - 1;
+      slot.assign(capacity, -1);
+      for (size_t j = b_first; j < b_first + b_size; ++j) {
+        const int i = order[j];
+        size_t s = static_cast<size_t>(hash[i]) & mask;
+        while (slot[s] != -1 &&
+               std::memcmp(&corner[slot[s]], &corner[i], sizeof(corner[i]))) {
+          s = (s + 1) & mask;
+        }
+        if (slot[s] == -1) {
+          slot[s] = i;
+        }
+        rep[i] = slot[s];
+      }
+    }
+  });
+  // Number unique vertex by first occurrence
+  std::vector<int> id(n);
+  int n_vertex = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (rep[i] == static_cast<int>(i)) {
+      id[i] = n_vertex++;
+    }
+  }
+  vertex->resize(static_cast<size_t>(n_vertex));
+  tri->resize(n / 3);
+  run(n_block, [&](const size_t begin, const size_t end) {
+    for (size_t b = begin; b < end; ++b) {
+      const size_t f_first = (b * (n / 3)) / n_block;
+      const size_t f_last = ((b + 1) * (n / 3)) / n_block;
+      for (size_t f = f_first; f < f_last; ++f) {
+        int* t = &((*tri)[f].x_);
+        for (size_t k = 0; k < 3; ++k) {
+          const size_t i = (3 * f) + k;
+          t[k] = id[rep[i]];
+          if (rep[i] == static_cast<int>(i)) {
+            (*vertex)[id[i]] = corner[i];
+          }
+        }
+      }
+    }
+  });
+}
+
+/**
+ *  @struct PLYWriteLayout
+ *  @brief  Attributes written into a ply file
+ */
+struct PLYWriteLayout {
+  /** Write per vertex normal */
+  bool normal;
+  /** Write per vertex texture coordinate */
+  bool tcoord;
+  /** Write per vertex color */
+  bool color;
+  /** Write per corner texture coordinate (face's texcoord list) */
+  bool face_tcoord;
+  /** Binary output */
+  bool binary;
+  /** Swap bytes order (big endian host) */
+  bool swap;
+};
+
+/** Number of record packed before flushing to disk */
+const size_t kBlockRecord = 1 << 14;
+/** Upper bound of the size of an ascii ply record (12 numbers) */
+const size_t kPLYMaxAsciiRecord = 12 * 32;
+
+/**
+ *  @name StoreRaw
+ *  @fn char* StoreRaw(const V value, const bool swap, char* p)
+ *  @brief  Write a value into an unaligned buffer
+ *  @param[in]  value Value to write
+ *  @param[in]  swap  If true, swap bytes order
+ *  @param[in]  p     Where to write
+ *  @return Position following the value
+ */
+template<typename V>
+inline char* StoreRaw(const V value, const bool swap, char* p) {
+  std::memcpy(p, &value, sizeof(V));
+  if (swap) {
+    std::reverse(p, p + sizeof(V));
+  }
+  return p + sizeof(V);
+}
+
+/**
+ *  @name StorePLYValue
+ *  @fn char* StorePLYValue(const V value, const PLYWriteLayout& layout,
+                            char* p)
+ *  @brief  Write a value into a ply record, ascii values are followed by a
+ *          space
+ *  @param[in]  value   Value to write
+ *  @param[in]  layout  Output configuration
+ *  @param[in]  p       Where to write
+ *  @return Position following the value
+ */
+template<typename V>
+inline char* StorePLYValue(const V value, const PLYWriteLayout& layout, char* p) {
+  if (layout.binary) {
+    return StoreRaw(value, layout.swap, p);
+  }
+  // Shortest representation that round trips
+  typedef typename std::conditional<std::is_integral<V>::value,
+                                    int,
+                                    V>::type Text;
+  p = CharConv::ToChars(p, p + 32, static_cast<Text>(value));
+  *p++ = ' ';
+  return p;
+}
+
+/**
+ *  @name EndPLYRecord
+ *  @fn char* EndPLYRecord(const PLYWriteLayout& layout, char* p)
+ *  @brief  Terminate a ply record (i.e. line break for ascii)
+ *  @param[in]  layout  Output configuration
+ *  @param[in]  p       End of the record
+ *  @return Position following the record
+ */
+inline char* EndPLYRecord(const PLYWriteLayout& layout, char* p) {
+  if (!layout.binary) {
+    p[-1] = '\n';
+  }
+  return p;
+}
+
+/**
+ *  @name PackPLYVertex
+ *  @fn char* PackPLYVertex(const Mesh<T>& mesh, const PLYWriteLayout& layout,
+                            const size_t i, char* p)
+ *  @brief  Write one vertex record
+ *  @param[in]  mesh    Mesh to save
+ *  @param[in]  layout  Output configuration
+ *  @param[in]  i       Vertex index
+ *  @param[in]  p       Where to write
+ *  @return Position following the record
+ */
+template<typename T>
+char* PackPLYVertex(const Mesh<T>& mesh,
+                    const PLYWriteLayout& layout,
+                    const size_t i,
+                    char* p) {
+  const auto& v = mesh.get_vertex()[i];
+  p = StorePLYValue(v.x_, layout, p);
+  p = StorePLYValue(v.y_, layout, p);
+  p = StorePLYValue(v.z_, layout, p);
+  if (layout.normal) {
+    const auto& n = mesh.get_normal()[i];
+    p = StorePLYValue(n.x_, layout, p);
+    p = StorePLYValue(n.y_, layout, p);
+    p = StorePLYValue(n.z_, layout, p);
+  }
+  if (layout.tcoord) {
+    const auto& tc = mesh.get_tex_coord()[i];
+    p = StorePLYValue(tc.x_, layout, p);
+    p = StorePLYValue(tc.y_, layout, p);
+  }
+  if (layout.color) {
+    const T* c = &mesh.get_vertex_color()[i].x_;
+    for (int k = 0; k < 4; ++k) {
+      const T value = std::min(std::max(c[k], T(0.0)), T(1.0));
+      p = StorePLYValue(static_cast<uint8_t>((value * T(255.0)) + T(0.5)),
+                        layout,
+                        p);
+    }
+  }
+  return EndPLYRecord(layout, p);
+}
+
+/**
+ *  @name PackPLYFace
+ *  @fn char* PackPLYFace(const Mesh<T>& mesh, const PLYWriteLayout& layout,
+                          const size_t i, char* p)
+ *  @brief  Write one face record
+ *  @param[in]  mesh    Mesh to save
+ *  @param[in]  layout  Output configuration
+ *  @param[in]  i       Triangle index
+ *  @param[in]  p       Where to write
+ *  @return Position following the record
+ */
+template<typename T>
+char* PackPLYFace(const Mesh<T>& mesh,
+                  const PLYWriteLayout& layout,
+                  const size_t i,
+                  char* p) {
+  const auto& t = mesh.get_triangle()[i];
+  p = StorePLYValue(uint8_t(3), layout, p);
+  p = StorePLYValue(static_cast<int32_t>(t.x_), layout, p);
+  p = StorePLYValue(static_cast<int32_t>(t.y_), layout, p);
+  p = StorePLYValue(static_cast<int32_t>(t.z_), layout, p);
+  if (layout.face_tcoord) {
+    p = StorePLYValue(uint8_t(6), layout, p);
+    for (size_t k = 0; k < 3; ++k) {
+      const auto& tc = mesh.get_tex_coord()[(3 * i) + k];
+      p = StorePLYValue(tc.x_, layout, p);
+      p = StorePLYValue(tc.y_, layout, p);
+    }
+  }
+  return EndPLYRecord(layout, p);
+}
+
+/**
+ *  @name WriteSection
+ *  @fn bool WriteSection(const size_t n, const size_t record_size,
+                          const F& pack, std::ostream* stream)
+ *  @brief  Pack records into large blocks and write them to a stream. Large
+ *          sections are packed on the library's thread pool, one block per
+ *          thread, and written in order.
+ *  @param[in]  n           Number of record
+ *  @param[in]  record_size Upper bound of a record's size in bytes
+ *  @param[in]  pack        Function packing record i at a given location and
+ *                          returning the position following it
+ *  @param[in]  stream      Output stream
+ *  @return True if everything has been written
+ */
+template<typename F>
+bool WriteSection(const size_t n,
+                  const size_t record_size,
+                  const F& pack,
+                  std::ostream* stream) {
+  auto& pool = ThreadPool::Instance();
+  const size_t n_buffer = n > kBlockRecord ? pool.size() + 1 : 1;
+  std::vector<std::vector<char>> buffer(n_buffer);
+  std::vector<size_t> used(n_buffer, 0);
+  for (auto& b : buffer) {
+    b.resize(std::min(n, kBlockRecord) * record_size);
+  }
+  for (size_t first = 0; first < n && stream->good();
+       first += n_buffer * kBlockRecord) {
+    const size_t n_block = std::min(n_buffer,
+                                    (n - first + kBlockRecord - 1) /
+                                    kBlockRecord);
+    auto fill = [&](const size_t begin, const size_t end) {
+      for (size_t b = begin; b < end; ++b) {
+        const size_t r_first = first + (b * kBlockRecord);
+        const size_t r_last = std::min(r_first + kBlockRecord, n);
+        char* p = buffer[b].data();
+        for (size_t i = r_first; i < r_last; ++i) {
+          p = pack(i, p);
+        }
+        used[b] = static_cast<size_t>(p - buffer[b].data());
+      }
+    };
+    if (n_block > 1) {
+      pool.ParallelFor(0, n_block, 1, fill);
+    } else {
+      fill(0, n_block);
+    }
+    for (size_t b = 0; b < n_block; ++b) {
+      stream->write(buffer[b].data(), used[b]);
+    }
+  }
+  return stream->good();
+}
+
+/**
+ *  @name PackOBJVector
+ *  @fn char* PackOBJVector(const char* key, const T* value, const int n,
+                            char* p)
+ *  @brief  Write an .obj attribute line (i.e. v, vn, vt)
+ *  @param[in]  key   Line's key, followed by a space
+ *  @param[in]  value Values
+ *  @param[in]  n     Number of value
+ *  @param[in]  p     Where to write
+ *  @return Position following the line
+ */
+template<typename T>
+char* PackOBJVector(const char* key, const T* value, const int n, char* p) {
+  while (*key) {
+    *p++ = *key++;
+  }
+  for (int k = 0; k < n; ++k) {
+    p = CharConv::ToChars(p, p + 32, value[k]);
+    *p++ = k + 1 < n ? ' ' : '\n';
+  }
+  return p;
+}
+
+/**
+ *  @name PackOBJFace
+ *  @fn char* PackOBJFace(const int* idx, const bool tcoord, const bool normal,
+                          char* p)
+ *  @brief  Write an .obj triangle, indices are 1-based and shared by every
+ *          attributes (i.e. v, v/vt, v//vn or v/vt/vn)
+ *  @param[in]  idx     Triangle's vertex indices (0-based)
+ *  @param[in]  tcoord  Reference texture coordinates
+ *  @param[in]  normal  Reference normals
+ *  @param[in]  p       Where to write
+ *  @return Position following the line
+ */
+inline char* PackOBJFace(const int* idx,
+                         const bool tcoord,
+                         const bool normal,
+                         char* p) {
+  *p++ = 'f';
+  for (int k = 0; k < 3; ++k) {
+    *p++ = ' ';
+    char* q = p;
+    p = CharConv::ToChars(p, p + 16, idx[k] + 1);
+    const size_t len = static_cast<size_t>(p - q);
+    if (tcoord || normal) {
+      *p++ = '/';
+      if (tcoord) {
+        std::memcpy(p, q, len);
+        p += len;
+      }
+      if (normal) {
+        *p++ = '/';
+        std::memcpy(p, q, len);
+        p += len;
+      }
+    }
+  }
+  *p++ = '\n';
+  return p;
+}
+
+/**
+ *  @name PackSTLFacet
+ *  @fn char* PackSTLFacet(const std::vector<Vertex>& vertex,
+                           const Triangle& tri, const bool swap, char* p)
+ *  @brief  Write a binary .stl facet (normal, vertices, attribute)
+ *  @param[in]  vertex  Mesh's vertices
+ *  @param[in]  tri     Triangle to write
+ *  @param[in]  swap    Convert to little endian
+ *  @param[in]  p       Where to write
+ *  @return Position following the record
+ */
+template<typename T>
+inline char* PackSTLFacet(const std::vector<typename Mesh<T>::Vertex>& vertex,
+                          const typename Mesh<T>::Triangle& tri,
+                          const bool swap,
+                          char* p) {
+  using Vertex = typename Mesh<T>::Vertex;
+  const Vertex& a = vertex[tri.x_];
+  const Vertex& b = vertex[tri.y_];
+  const Vertex& c = vertex[tri.z_];
+  Vertex n = (b - a) ^ (c - a);
+  const T norm = n.Norm();
+  n = norm > T(0) ? n / norm : Vertex();
+  const Vertex* v[4] = {&n, &a, &b, &c};
+  for (int k = 0; k < 4; ++k) {
+    p = StoreRaw(static_cast<float>(v[k]->x_), swap, p);
+    p = StoreRaw(static_cast<float>(v[k]->y_), swap, p);
+    p = StoreRaw(static_cast<float>(v[k]->z_), swap, p);
+  }
+  return StoreRaw(uint16_t(0), swap, p);
+}
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name
+ *  @fn
+ *  @brief  Constructor
+ */
+template<typename T>
+Mesh<T>::Mesh(void) : bbox_is_computed_(false),
+                      parallel_loading_(true),
+                      use_cache_(false),
+                      compact_cache_(false),
+                      post_process_(kDefaultPostProcess),
+                      normal_weighting_(kAngleWeighting),
+                      version_(0),
+                      vertex_version_(0),
+                      tri_version_(0),
+                      tcoord_version_(0),
+                      con_version_(0),
+                      half_edge_version_(0),
+                      cluster_version_(0),
+                      normal_version_(0),
+                      tangent_version_(0),
+                      bbox_version_(0) {
+}
+
+/*
+ *  @name Mesh
+ *  @fn Mesh(const std::string& filename)
+ *  @brief  Load mesh from supported file :
+ *            .obj, .ply, .tri
+ */
+template<typename T>
+Mesh<T>::Mesh(const std::string& filename) :
+    bbox_is_computed_(false),
+    parallel_loading_(true),
+    use_cache_(false),
+    compact_cache_(false),
+    post_process_(kDefaultPostProcess),
+    normal_weighting_(kAngleWeighting),
+    version_(0),
+    vertex_version_(0),
+    tri_version_(0),
+    tcoord_version_(0),
+    con_version_(0),
+    half_edge_version_(0),
+    cluster_version_(0),
+    normal_version_(0),
+    tangent_version_(0),
+    bbox_version_(0) {
+  if (this->Load(filename)) {
+    std::cout << "Error while loading mesh from file : " + filename << std::endl;
+  }
+}
+
+/*
+ *  @name Mesh  @fn Meshid)
+ *  @brief  Destructor
+ */
+template<typename T>
+Mesh<T>::~Mesh(void) {
+}
+
+/*
+ *  @name Load
+ *  @fn int Load(const std::string& filename)
+ *  @brief  Load mesh from supported file :
+ *            .obj, .ply, .stl, .gltf, .glb, .oglmesh
+ *          The .obj, .ply and .stl files can be gzip / zstd compressed (i.e.
+ *          .ply.gz), unknown extensions are detected from the file's content.
+ *          Identical .stl corners are welded into shared vertices, glTF
+ *          primitives are merged into a single mesh.
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::Load(const std::string& filename) {
+  // Load data
+  int err = -1;
+  size_t pos = filename.rfind(".");
+  if (pos != std::string::npos) {
+    // Ensure empty containter
+    this->Clear();
+    std::string ext = filename.substr(pos + 1, filename.length());
+    if ((ext == "gz" || ext == "zst") && pos > 0) {
+      // Compressed, format given by the inner extension
+      const size_t inner = filename.rfind(".", pos - 1);
+      ext = (inner != std::string::npos ?
+             filename.substr(inner + 1, pos - inner - 1) :
+             "");
+    }
+    FileExt file_ext = this->HashExt(ext);
+    if (file_ext == kUndef) {
+      file_ext = this->DetectFormat(filename);
+    }
+    // Sidecar cache, already post-processed
+    const std::string cache = filename + ".oglmesh";
+    const bool use_cache = use_cache_ && file_ext != kCache;
+    if (use_cache &&
+        MeshCache::IsUpToDate(cache, filename, this->CacheFlags()) &&
+        !this->LoadCache(cache)) {
+      return 0;
+    }
+    switch (file_ext) {
+      // OBJ
+      case kObj: {
+        err = this->LoadOBJ(filename);
+      }
+        break;
+      // PLY
+      case kPly: {
+        err = this->LoadPLY(filename);
+      }
+        break;
+      // STL
+      case kStl: {
+        err = this->LoadSTL(filename);
+      }
+        break;
+      // glTF
+      case kGltf: {
+        err = this->LoadGLTF(filename);
+      }
+        break;
+      // Native cache
+      case kCache: {
+        err = this->LoadCache(filename);
+      }
+        break;
+      // Not supported yet
+      case kUndef:
+      default:  std::cout << "Error, unsported extension type : " << ext;
+        std::cout << std::endl;
+        err = -1;
+        break;
+    }
+    if (!err && file_ext != kCache) {
+      this->PostProcess();
+    }
+    if (!err && use_cache && this->SaveCache(cache)) {
+      std::cout << "Warning, unable to write cache : " << cache << std::endl;
+    }
+  }
+  return err;
+}
+
+/*
+ *  @name Load
+ *  @fn int Load(const void* data, const size_t size)
+ *  @brief  Load mesh from a buffer holding an .obj, .ply, .stl (possibly
+ *          gzip / zstd compressed) or .glb file. The format is detected from
+ *          the content.
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size in bytes
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::Load(const void* data, const size_t size) {
+  this->Clear();
+  const char* buffer = static_cast<const char*>(data);
+  int err = -1;
+  switch (this->DetectFormat(buffer, size)) {
+    // OBJ
+    case kObj: {
+      err = this->LoadOBJ(buffer, size, "<memory>");
+    }
+      break;
+    // PLY
+    case kPly: {
+      err = this->LoadPLY(buffer, size, "<memory>");
+    }
+      break;
+    // STL
+    case kStl: {
+      err = this->LoadSTL(buffer, size, "<memory>");
+    }
+      break;
+    // glTF
+    case kGltf: {
+      err = this->LoadGLTF(buffer, size, "<memory>");
+    }
+      break;
+    // Native cache needs a file to be mapped
+    case kCache:
+    case kUndef:
+    default:  std::cout << "Error, unsupported mesh format in buffer";
+      std::cout << std::endl;
+      err = -1;
+      break;
+  }
+  if (!err) {
+    this->PostProcess();
+  }
+  return err;
+}
+
+/*
+ *  @name Load
+ *  @fn int Load(std::istream& stream)
+ *  @brief  Load mesh from a binary stream holding an .obj, .ply or .stl
+ *          file (possibly gzip / zstd compressed). The stream is read until
+ *          its end, the format is detected from the content.
+ *  @param[in]  stream  Binary stream from where to load the mesh
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::Load(std::istream& stream) {
+  if (!stream.good()) {
+    return -1;
+  }
+  std::vector<char> buffer;
+  // Read in one go when the stream's length is known
+  const std::streampos start = stream.tellg();
+  if (start != std::streampos(-1) && stream.seekg(0, std::ios_base::end)) {
+    const std::streamoff size = stream.tellg() - start;
+    stream.seekg(start);
+    buffer.resize(static_cast<size_t>(size));
+    stream.read(buffer.data(), size);
+    buffer.resize(static_cast<size_t>(stream.gcount()));
+  } else {
+    // Not seekable (i.e. pipe), read by block
+    stream.clear();
+    const size_t block = 1 << 20;
+    size_t n = 0;
+    do {
+      buffer.resize(n + block);
+      stream.read(buffer.data() + n, block);
+      n += static_cast<size_t>(stream.gcount());
+    } while (stream.good());
+    buffer.resize(n);
+  }
+  if (stream.bad()) {
+    return -1;
+  }
+  return this->Load(buffer.data(), buffer.size());
+}
+
+/*
+ *  @name LoadAsync
+ *  @fn std::future<int> LoadAsync(const std::string& filename,
+                               const std::function<void(int)>& callback)
+ *  @brief  Load mesh from supported file on the library's thread pool
+ *          (parsing, centering, connectivity and bounding box). The mesh
+ *          must not be accessed until the returned future is ready.
+ *  @param[in]  filename  Path to the mesh file
+ *  @param[in]  callback  Optional function invoked on the loading thread
+ *                        with the error code, before the future is ready.
+ *  @return Future holding -1 if error, 0 otherwise
+ */
+template<typename T>
+std::future<int> Mesh<T>::LoadAsync(const std::string& filename,
+                                    const std::function<void(int)>& callback) {
+  return ThreadPool::Instance().Enqueue([this, filename, callback](void) {
+    const int err = this->Load(filename);
+    if (callback) {
+      callback(err);
+    }
+    return err;
+  });
+}
+
+/*
+ *  @name Save
+ *  @fn int Save(const std::string& filename, const bool binary = true)
+ *  @brief  Save mesh to supported file format:
+ *            .ply, .obj, .stl, .oglmesh
+ *  @param[in]  filename  Path to the mesh file
+ *  @param[in]  binary    Use binary encoding when supported by the format,
+ *                        .stl is always binary
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::Save(const std::string& filename, const bool binary) {
+  // Load data
+  int err = -1;
+  size_t pos = filename.rfind(".");
+  if (pos != std::string::npos) {
+    std::string ext = filename.substr(pos + 1, filename.length());
+    FileExt file_ext = this->HashExt(ext);
+    switch (file_ext) {
+        // PLY
+      case kPly: {
+        err = this->SavePLY(filename, binary);
+      }
+        break;
+        // OBJ
+      case kObj: {
+        err = this->SaveOBJ(filename);
+      }
+        break;
+        // STL
+      case kStl: {
+        err = this->SaveSTL(filename);
+      }
+        break;
+        // Native cache
+      case kCache: {
+        err = this->SaveCache(filename);
+      }
+        break;
+        // Undef
+        case kUndef:
+      default:  std::cout << "Error, unsported extension type : " << ext;
+        std::cout << std::endl;
+        err = -1;
+        break;
+    }
+  }
+  return err;
+}
+
+/*
+ *  @name BuildConnectivity
+ *  @fn void BuildConnectivity(void)
+ *  @brief  Construct vertex connectivity (vertex connection) used later
+ *          in normal computation
+ */
+template<typename T>
+void Mesh<T>::BuildConnectivity(void) {
+  assert(vertex_.size() != 0 && tri_.size() != 0);
+  if (vertex_con_.Build(tri_, vertex_.size(), parallel_loading_)) {
+    std::cout << "Error, invalid triangulation, can not build connectivity";
+    std::cout << std::endl;
+  }
+  con_version_ = version_;
+}
+
+/*
+ *  @name HashExt
+ *  @fn FileExt HashExt(const std::string& ext)
+ *  @brief  Provide the type of extension
+ *  @param[in]  ext Name of the extension
+ *  @return Hash of the given extension if know by the object
+ */
+template<typename T>
+typename Mesh<T>::FileExt Mesh<T>::HashExt(const std::string& ext) {
+  FileExt fext = kUndef;
+  if (ext == "obj") {
+    fext = kObj;
+  } else if (ext == "ply") {
+    fext = kPly;
+  } else if (ext == "stl") {
+    fext = kStl;
+  } else if (ext == "gltf" || ext == "glb") {
+    fext = kGltf;
+  } else if (ext == "oglmesh") {
+    fext = kCache;
+  }
+  return fext;
+}
+
+/*
+ *  @name Clear
+ *  @fn void Clear(void)
+ *  @brief  Empty every container before loading
+ */
+template<typename T>
+void Mesh<T>::Clear(void) {
+  vertex_.clear();
+  normal_.clear();
+  tex_coord_.clear();
+  tangent_.clear();
+  vertex_color_.clear();
+  tri_.clear();
+  vertex_con_.Clear();
+  half_edge_.Clear();
+  cluster_.clear();
+  bbox_is_computed_ = false;
+  this->Touch(kAllData);
+}
+
+/*
+ *  @name PostProcess
+ *  @fn void PostProcess(void)
+ *  @brief  Apply the selected post-processing stages to the freshly parsed
+ *          mesh. Centroid and bounding box are gathered in a single pass
+ *          over the vertices, the connectivity is built in the meantime.
+ */
+template<typename T>
+void Mesh<T>::PostProcess(void) {
+  // Triangle order first, connectivity is built from it
+  if ((post_process_ & (kVertexCache | kOverdraw)) && !tri_.empty() &&
+      MeshOptimizer<T>::Optimize(vertex_,
+                                 (post_process_ & kOverdraw) != 0,
+                                 &tri_,
+                                 nullptr)) {
+    std::cout << "Error, invalid triangulation, can not reorder triangles";
+    std::cout << std::endl;
+  }
+  if ((post_process_ & kVertexFetch) && !tri_.empty()) {
+    std::vector<int> remap;
+    if (MeshOptimizer<T>::VertexRemap(vertex_,
+                                      tri_,
+                                      MeshOptimizer<T>::kFirstUseOrder,
+                                      &remap)) {
+      std::cout << "Error, invalid triangulation, can not reorder vertices";
+      std::cout << std::endl;
+    } else {
+      this->RemapVertex(remap);
+    }
+  }
+  const bool center = (post_process_ & kCenter) != 0;
+  const bool bbox = (post_process_ & kBoundingBox) && !bbox_is_computed_;
+  const bool normal = ((post_process_ & kNormal) &&
+                       normal_.size() != vertex_.size());
+  // Normals are derived from the connectivity
+  const bool con = ((post_process_ & kConnectivity) || normal) && !tri_.empty();
+  const size_t n = vertex_.size();
+  const size_t n_block = ((n + kPostProcessBlockSize - 1) /
+                          kPostProcessBlockSize);
+  const bool parallel = parallel_loading_ && n_block > 1;
+  auto& pool = ThreadPool::Instance();
+  auto process_vertex = [&](void) {
+    if (n == 0 || (!center && !bbox)) {
+      return;
+    }
+    // Partial sum and / or bbox per block, merged in order afterwards
+    std::vector<Vertex> sum(n_block);
+    std::vector<AABB<T>> box(n_block, BoundingBox<T>::Empty());
+    auto reduce = [&](const size_t begin, const size_t end) {
+      for (size_t b = begin; b < end; ++b) {
+        const Vertex* v = vertex_.data() + b * kPostProcessBlockSize;
+        const Vertex* v_end = vertex_.data() + std::min(n, (b + 1) *
+                                                        kPostProcessBlockSize);
+        if (bbox) {
+          BoundingBox<T>::Extend(v, static_cast<size_t>(v_end - v), &box[b]);
+        }
+        if (center) {
+          Vertex s;
+          for (; v != v_end; ++v) {
+            s += *v;
+          }
+          sum[b] = s;
+        }
+      }
+    };
+    if (parallel) {
+      pool.ParallelFor(0, n_block, 1, reduce);
+    } else {
+      reduce(0, n_block);
+    }
+    Vertex cog = sum[0];
+    for (size_t b = 1; b < n_block; ++b) {
+      cog += sum[b];
+      box[0] += box[b];
+    }
+    if (bbox) {
+      bbox_.min_ = box[0].min_;
+      bbox_.max_ = box[0].max_;
+      bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+      bbox_is_computed_ = true;
+    }
+    if (center) {
+      // Center all vertex, bbox is shifted as well
+      cog /= static_cast<T>(n);
+      auto shift = [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          vertex_[i] -= cog;
+        }
+      };
+      if (parallel) {
+        pool.ParallelFor(0, n, kPostProcessBlockSize, shift);
+      } else {
+        shift(0, n);
+      }
+      if (bbox_is_computed_) {
+        bbox_.min_ -= cog;
+        bbox_.max_ -= cog;
+        bbox_.center_ -= cog;
+      }
+    }
+  };
+  if (con && parallel) {
+    // Connectivity only reads the triangles, build it alongside. The calling
+    // thread takes part, therefore it is safe from within a pool's worker.
+    pool.ParallelFor(0, 2, 1, [&](const size_t begin, const size_t end) {
+      for (size_t k = begin; k < end; ++k) {
+        if (k == 0) {
+          this->BuildConnectivity();
+        } else {
+          process_vertex();
+        }
+      }
+    });
+  } else {
+    process_vertex();
+    if (con) {
+      this->BuildConnectivity();
+    }
+  }
+  if (normal) {
+    this->ComputeVertexNormal();
+  }
+  if (con && !(post_process_ & kConnectivity)) {
+    vertex_con_.Clear();
+  }
+  this->MarkLoaded();
+}
+
+/**
+ *  @name PermuteArray
+ *  @fn static void PermuteArray(const std::vector<int>& remap,
+                                 std::vector<V>* data)
+ *  @brief  Move the elements of a per-vertex array, left untouched if its
+ *          size does not match the number of vertex
+ *  @param[in]      remap New index of each element, remap[old] = new
+ *  @param[in,out]  data  Array to permute
+ *  @tparam V Element type
+ */
+template<typename V>
+static void PermuteArray(const std::vector<int>& remap, std::vector<V>* data) {
+  if (data->size() != remap.size()) {
+    return;
+  }
+  std::vector<V> permuted(data->size());
+  for (size_t i = 0; i < remap.size(); ++i) {
+    permuted[remap[i]] = (*data)[i];
+  }
+  data->swap(permuted);
+}
+
+/*
+ *  @name RemapVertex
+ *  @fn void RemapVertex(const std::vector<int>& remap)
+ *  @brief  Move every per-vertex array and update the triangles
+ *  @param[in]  remap New index of each vertex, remap[old] = new
+ */
+template<typename T>
+void Mesh<T>::RemapVertex(const std::vector<int>& remap) {
+  PermuteArray(remap, &vertex_);
+  PermuteArray(remap, &normal_);
+  PermuteArray(remap, &tex_coord_);
+  PermuteArray(remap, &tangent_);
+  PermuteArray(remap, &vertex_color_);
+  auto remap_tri = [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Triangle& t = tri_[i];
+      t.x_ = remap[t.x_];
+      t.y_ = remap[t.y_];
+      t.z_ = remap[t.z_];
+    }
+  };
+  if (parallel_loading_) {
+    ThreadPool::Instance().ParallelFor(0, tri_.size(), kPostProcessBlockSize,
+                                       remap_tri);
+  } else {
+    remap_tri(0, tri_.size());
+  }
+  this->Touch(kAllData);
+}
+
+/*
+ *  @name Touch
+ *  @fn void Touch(const int source)
+ *  @brief  Flag source arrays as modified, derived data depending on them
+ *          become stale
+ *  @param[in]  source  Combination of DataSource
+ */
+template<typename T>
+void Mesh<T>::Touch(const int source) {
+  ++version_;
+  if (source & kVertexData) {
+    vertex_version_ = version_;
+  }
+  if (source & kTriangleData) {
+    tri_version_ = version_;
+  }
+  if (source & kTCoordData) {
+    tcoord_version_ = version_;
+  }
+}
+
+/*
+ *  @name MarkLoaded
+ *  @fn void MarkLoaded(void)
+ *  @brief  Flag derived data provided by a freshly loaded file (or
+ *          computed while post-processing it) as up to date
+ */
+template<typename T>
+void Mesh<T>::MarkLoaded(void) {
+  const size_t n = vertex_.size();
+  if (!vertex_con_.empty() && vertex_con_.size() == n) {
+    con_version_ = version_;
+  }
+  if (!normal_.empty() && normal_.size() == n) {
+    normal_version_ = version_;
+  }
+  if (!tangent_.empty() && tangent_.size() == n) {
+    tangent_version_ = version_;
+  }
+  if (bbox_is_computed_) {
+    bbox_version_ = version_;
+  }
+}
+
+/*
+ *  @name DetectFormat
+ *  @fn FileExt DetectFormat(const std::string& path)
+ *  @brief  Identify the format of a file from its first bytes (decompressed
+ *          if needed)
+ *  @param[in]  path  Path to the mesh file
+ *  @return File format, kUndef if not recognized
+ */
+template<typename T>
+typename Mesh<T>::FileExt Mesh<T>::DetectFormat(const std::string& path) {
+  MemoryMap file;
+  if (file.Open(path)) {
+    return kUndef;
+  }
+  return this->DetectFormat(file.data(), file.size());
+}
+
+/*
+ *  @name DetectFormat
+ *  @fn FileExt DetectFormat(const char* data, const size_t size)
+ *  @brief  Identify the format of a buffer from its first bytes (decompressed
+ *          if needed)
+ *  @param[in]  data  Buffer holding the mesh
+ *  @param[in]  size  Buffer's size
+ *  @return File format, kUndef if not recognized
+ */
+template<typename T>
+typename Mesh<T>::FileExt Mesh<T>::DetectFormat(const char* data,
+                                                const size_t size) {
+  const char* first = data;
+  const char* last = first + size;
+  Decompressor stream;
+  if (!stream.Open(data, size)) {
+    first = stream.data();
+    last = first + stream.Wait(64);
+  }
+  const char* p = CharConv::SkipSpace(first, last);
+  const size_t n = static_cast<size_t>(last - p);
+  FileExt fext = kUndef;
+  if (n >= 3 && std::strncmp(p, "ply", 3) == 0) {
+    fext = kPly;
+  } else if (p == first && n >= 4 && std::strncmp(p, "glTF", 4) == 0) {
+    fext = kGltf;
+  } else if (p == first && n >= sizeof(MeshCache::kMagic) &&
+             std::memcmp(p,
+                         MeshCache::kMagic,
+                         sizeof(MeshCache::kMagic)) == 0) {
+    fext = kCache;
+  } else if (stream.codec() == Decompressor::kNone &&
+             IsBinarySTL(data, size)) {
+    // Size given by the header, compressed ones are recognized by extension
+    fext = kStl;
+  } else if (n >= 5 && std::strncmp(p, "solid", 5) == 0) {
+    fext = kStl;
+  } else if (n > 0 && *p == '{') {
+    // JSON document
+    fext = kGltf;
+  } else if (n > 0 && std::strchr("#vfgosmu", *p) != nullptr) {
+    // Statements starting an .obj file (comment, v/vn/vt, f, g, o, s, mtllib,
+    // usemtl)
+    fext = kObj;
+  }
+  return fext;
+}
+
+/*
+ *  @name LoadOBJ
+ *  @fn int LoadOBJ(const std::string& path)
+ *  @brief  Load mesh from .obj file, possibly gzip / zstd compressed
+ *  @param[in]  path  Path to obj file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadOBJ(const std::string& path) {
+  MemoryMap file;
+  if (file.Open(path)) {
+    return -1;
+  }
+  return this->LoadOBJ(file.data(), file.size(), path);
+}
+
+/*
+ *  @name LoadOBJ
+ *  @fn int LoadOBJ(const char* data, const size_t size,
+                    const std::string& name)
+ *  @brief  Load mesh from a buffer holding an .obj file, possibly gzip /
+ *          zstd compressed
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size
+ *  @param[in]  name  Name of the source used in error messages
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadOBJ(const char* data,
+                     const size_t size,
+                     const std::string& name) {
+  int error = -1;
+  OBJContent<T> content;
+  const char* first = data;
+  const char* last = first + size;
+  Decompressor stream;
+  if (Decompressor::DetectCodec(first, size) != Decompressor::kNone) {
+    error = stream.Open(first, size);
+    error = error ? error : ParseOBJStream(&stream, &content);
+  } else if (parallel_loading_ && size > kParallelLoadingSize) {
+    error = ParseOBJParallel(first, last, &content);
+  } else {
+    error = ParseOBJ(first, last, &content);
+  }
+  bool welded = false;
+  if (!error) {
+    error = BuildOBJMesh(&content, &tri_, &welded);
+  }
+  if (!error) {
+    vertex_.swap(content.vertex);
+    normal_.swap(content.normal);
+    tex_coord_.swap(content.tcoord);
+    // Welding drops unreferenced vertex, bbox is recomputed later on
+    bbox_ = content.bbox;
+    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+    bbox_is_computed_ = !welded;
+  } else {
+    std::cout << "Error, malformed obj file : " << name << std::endl;
+  }
+  return error;
+}
+
+/*
+ *  @name LoadPLY
+ *  @fn int LoadPLY(const std::string& path)
+ *  @brief  Load mesh from .ply file. Binary content is read in bulk from a
+ *          memory mapped view of the file, ascii content is parsed in
+ *          parallel chunks. Compressed files (gzip / zstd) are parsed while
+ *          being decompressed.
+ *  @param[in]  path  Path to ply file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadPLY(const std::string& path) {
+  MemoryMap file;
+  if (file.Open(path)) {
+    return -1;
+  }
+  return this->LoadPLY(file.data(), file.size(), path);
+}
+
+/*
+ *  @name LoadPLY
+ *  @fn int LoadPLY(const char* data, const size_t size,
+                    const std::string& name)
+ *  @brief  Load mesh from a buffer holding a .ply file, possibly gzip / zstd
+ *          compressed
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size
+ *  @param[in]  name  Name of the source used in error messages
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadPLY(const char* data,
+                     const size_t size,
+                     const std::string& name) {
+  const char* first = data;
+  const char* last = first + size;
+  PLYContent<T> content;
+  const bool parallel = parallel_loading_ && size > kParallelLoadingSize;
+  int error = -1;
+  if (Decompressor::DetectCodec(first, size) != Decompressor::kNone) {
+    // Parsed while decompressing
+    Decompressor stream;
+    error = stream.Open(first, size);
+    error = error ? error : ParsePLYStream(&stream, parallel, &content);
+  } else {
+    PLYHeader header;
+    if (ParsePLYHeader(first, last, &header)) {
+      std::cout << "Error, malformed ply header : " << name << std::endl;
+      return -1;
+    }
+    // Data are read straight from the buffer
+    error = (header.format == kPLYAscii ?
+             ParsePLYAscii(first + header.size, last, header, parallel,
+                           &content) :
+             ParsePLYBinary(first + header.size, last, header, parallel,
+                            &content));
+  }
+  if (error) {
+    std::cout << "Error, malformed ply file : " << name << std::endl;
+    return -1;
+  }
+  const size_t n_vertex = content.vertex.size();
+  for (const auto& t : content.tri) {
+    if (t.x_ < 0 || t.y_ < 0 || t.z_ < 0 ||
+        static_cast<size_t>(t.x_) >= n_vertex ||
+        static_cast<size_t>(t.y_) >= n_vertex ||
+        static_cast<size_t>(t.z_) >= n_vertex) {
+      std::cout << "Error, face index out of range : " << name << std::endl;
+      return -1;
+    }
+  }
+  vertex_.swap(content.vertex);
+  normal_.swap(content.normal);
+  tex_coord_.swap(content.tcoord);
+  vertex_color_.swap(content.color);
+  tri_.swap(content.tri);
+  if (!vertex_.empty()) {
+    bbox_ = content.bbox;
+    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+    bbox_is_computed_ = true;
+  }
+  return 0;
+}
+
+/*
+ *  @name LoadCache
+ *  @fn int LoadCache(const std::string& path)
+ *  @brief  Load mesh from native .oglmesh cache
+ *  @param[in]  path  Path to .oglmesh file
+ *  @return -1 if error (the mesh is left empty), 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadCache(const std::string& path) {
+  MeshCache cache;
+  if (cache.Open(path) || cache.scalar_size() != sizeof(T)) {
+    return -1;
+  }
+  // Sections map directly onto the attribute's layout
+  size_t n = 0;
+  auto fetch = [&](const MeshCache::SectionType type,
+                   const uint32_t size) -> const char* {
+    return reinterpret_cast<const char*>(cache.Find(type, size, &n));
+  };
+  // Bounding box, min then max
+  const T* box = reinterpret_cast<const T*>(fetch(MeshCache::kBBox,
+                                                  sizeof(T)));
+  bbox_is_computed_ = box && n == 6;
+  if (bbox_is_computed_) {
+    bbox_.min_ = Vertex(box[0], box[1], box[2]);
+    bbox_.max_ = Vertex(box[3], box[4], box[5]);
+    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+  }
+  const char* data = fetch(MeshCache::kVertex, sizeof(Vertex));
+  vertex_.assign(reinterpret_cast<const Vertex*>(data),
+                 reinterpret_cast<const Vertex*>(data) + n);
+  data = fetch(MeshCache::kQuantizedVertex, 3 * sizeof(uint16_t));
+  if (data && bbox_is_computed_) {
+    vertex_.resize(n);
+    MeshCodec<T>::DecodePosition(reinterpret_cast<const uint16_t*>(data),
+                                 n,
+                                 bbox_,
+                                 vertex_.data());
+  }
+  data = fetch(MeshCache::kNormal, sizeof(Normal));
+  normal_.assign(reinterpret_cast<const Normal*>(data),
+                 reinterpret_cast<const Normal*>(data) + n);
+  data = fetch(MeshCache::kOctahedralNormal, 2 * sizeof(int16_t));
+  if (data) {
+    normal_.resize(n);
+    MeshCodec<T>::DecodeNormal(reinterpret_cast<const int16_t*>(data),
+                               n,
+                               normal_.data());
+  }
+  data = fetch(MeshCache::kTCoord, sizeof(TCoord));
+  tex_coord_.assign(reinterpret_cast<const TCoord*>(data),
+                    reinterpret_cast<const TCoord*>(data) + n);
+  data = fetch(MeshCache::kTangent, sizeof(Tangent));
+  tangent_.assign(reinterpret_cast<const Tangent*>(data),
+                  reinterpret_cast<const Tangent*>(data) + n);
+  data = fetch(MeshCache::kVertexColor, sizeof(Color));
+  vertex_color_.assign(reinterpret_cast<const Color*>(data),
+                       reinterpret_cast<const Color*>(data) + n);
+  data = fetch(MeshCache::kTriangle, sizeof(Triangle));
+  tri_.assign(reinterpret_cast<const Triangle*>(data),
+              reinterpret_cast<const Triangle*>(data) + n);
+  data = fetch(MeshCache::kPackedTriangle, sizeof(uint8_t));
+  if (data && MeshCodec<T>::DecodeTriangle(
+          reinterpret_cast<const uint8_t*>(data), n, &tri_)) {
+    // Do not leave partially loaded attributes behind
+    this->Clear();
+    return -1;
+  }
+  const size_t n_vertex = vertex_.size();
+  for (const auto& t : tri_) {
+    if (t.x_ < 0 || t.y_ < 0 || t.z_ < 0 ||
+        static_cast<size_t>(t.x_) >= n_vertex ||
+        static_cast<size_t>(t.y_) >= n_vertex ||
+        static_cast<size_t>(t.z_) >= n_vertex) {
+      this->Clear();
+      return -1;
+    }
+  }
+  // Connectivity, offsets followed by indices and corners
+  const int32_t* con = reinterpret_cast<const int32_t*>(
+          fetch(MeshCache::kConnectivity, sizeof(int32_t)));
+  vertex_con_.Clear();
+  const size_t n_index = (con && n > n_vertex ?
+                          static_cast<size_t>(con[n_vertex]) : 0);
+  const size_t n_corner = 3 * tri_.size();
+  bool valid = (con && n > n_vertex && con[0] == 0 &&
+                n_index == 2 * n_corner &&
+                n == n_vertex + 1 + n_index + n_corner);
+  for (size_t i = 0; valid && i < n_vertex; ++i) {
+    valid = con[i] <= con[i + 1];
+  }
+  const int32_t* corner = valid ? con + n_vertex + 1 + n_index : nullptr;
+  for (size_t i = 0; valid && i < n_corner; ++i) {
+    valid = corner[i] >= 0 && static_cast<size_t>(corner[i]) < n_corner;
+  }
+  if (valid) {
+    vertex_con_.get_offset().assign(con, con + n_vertex + 1);
+    vertex_con_.get_index().assign(con + n_vertex + 1, corner);
+    vertex_con_.get_corner().assign(corner, con + n);
+  } else if (!tri_.empty() && (post_process_ & kConnectivity)) {
+    this->BuildConnectivity();
+  }
+  if (!bbox_is_computed_ && !vertex_.empty() &&
+      (post_process_ & kBoundingBox)) {
+    this->ComputeBoundingBox();
+  }
+  this->MarkLoaded();
+  return 0;
+}
+
+/*
+ *  @name SaveCache
+ *  @fn int SaveCache(const std::string& path) const
+ *  @brief  Save mesh to native .oglmesh cache
+ *  @param[in]  path  Path to .oglmesh file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::SaveCache(const std::string& path) const {
+  // Compact attributes, quantization is done relative to the bbox
+  AABB<T> bbox = bbox_;
+  bool has_bbox = bbox_is_computed_;
+  if (compact_cache_ && !has_bbox && !vertex_.empty()) {
+    BoundingBox<T>::Compute(vertex_, &bbox);
+    has_bbox = true;
+  }
+  std::vector<uint16_t> q_vertex;
+  std::vector<int16_t> q_normal;
+  std::vector<uint8_t> q_tri;
+  if (compact_cache_) {
+    MeshCodec<T>::EncodePosition(vertex_, bbox, &q_vertex, nullptr);
+    MeshCodec<T>::EncodeNormal(normal_, &q_normal, nullptr);
+    MeshCodec<T>::EncodeTriangle(tri_, &q_tri, nullptr);
+  }
+  // Flatten connectivity: offsets followed by indices and corners. Not
+  // stored in compact cache, cheaper to rebuild than to load.
+  std::vector<int32_t> con;
+  if (!vertex_con_.empty() && !compact_cache_) {
+    const auto& offset = vertex_con_.get_offset();
+    const auto& index = vertex_con_.get_index();
+    const auto& corner = vertex_con_.get_corner();
+    con.reserve(offset.size() + index.size() + corner.size());
+    con.insert(con.end(), offset.begin(), offset.end());
+    con.insert(con.end(), index.begin(), index.end());
+    con.insert(con.end(), corner.begin(), corner.end());
+  }
+  const T box[] = {bbox.min_.x_, bbox.min_.y_, bbox.min_.z_,
+                   bbox.max_.x_, bbox.max_.y_, bbox.max_.z_};
+  std::vector<MeshCache::Block> block;
+  auto add = [&](const MeshCache::SectionType type,
+                 const uint32_t size,
+                 const size_t count,
+                 const void* data) {
+    if (count > 0) {
+      MeshCache::Block b = {type, size, count, data};
+      block.push_back(b);
+    }
+  };
+  if (compact_cache_) {
+    add(MeshCache::kQuantizedVertex, 3 * sizeof(uint16_t), vertex_.size(),
+        q_vertex.data());
+    add(MeshCache::kOctahedralNormal, 2 * sizeof(int16_t), normal_.size(),
+        q_normal.data());
+    add(MeshCache::kPackedTriangle, sizeof(uint8_t), q_tri.size(),
+        q_tri.data());
+  } else {
+    add(MeshCache::kVertex, sizeof(Vertex), vertex_.size(), vertex_.data());
+    add(MeshCache::kNormal, sizeof(Normal), normal_.size(), normal_.data());
+  }
+  add(MeshCache::kTCoord, sizeof(TCoord), tex_coord_.size(),
+      tex_coord_.data());
+  add(MeshCache::kTangent, sizeof(Tangent), tangent_.size(),
+      tangent_.data());
+  add(MeshCache::kVertexColor, sizeof(Color), vertex_color_.size(),
+      vertex_color_.data());
+  if (!compact_cache_) {
+    add(MeshCache::kTriangle, sizeof(Triangle), tri_.size(), tri_.data());
+  }
+  add(MeshCache::kConnectivity, sizeof(int32_t), con.size(), con.data());
+  add(MeshCache::kBBox, sizeof(T), has_bbox ? 6 : 0, box);
+  return MeshCache::Write(path, sizeof(T), this->CacheFlags(), block);
+}
+
+/*
+ *  @name CacheFlags
+ *  @fn uint32_t CacheFlags(void) const
+ *  @brief  Settings shaping the cached data: post-processing stages,
+ *          normal weighting and compact encoding. A sidecar cache written
+ *          with other settings is stale.
+ *  @return Flags stored in the .oglmesh header
+ */
+template<typename T>
+uint32_t Mesh<T>::CacheFlags(void) const {
+  // Stages in the low bits, then weighting and encoding
+  return ((static_cast<uint32_t>(post_process_) & 0xFFFF) |
+          (static_cast<uint32_t>(normal_weighting_) << 16) |
+          (compact_cache_ ? 0x100000u : 0u));
+}
+
+/*
+ *  @name SaveOBJ
+ *  @fn int SaveOBJ(const std::string& path) const
+ *  @brief  Save mesh to a .obj file. Lines are formatted into large blocks
+ *          before being written. Normals and texture coordinates are
+ *          exported when there is one per vertex.
+ *  @param[in]  path  Path to .obj file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::SaveOBJ(const std::string& path) const {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary);
+  if (!stream.is_open()) {
+    return -1;
+  }
+  const size_t n_vertex = vertex_.size();
+  const bool has_normal = n_vertex > 0 && normal_.size() == n_vertex;
+  const bool has_tcoord = n_vertex > 0 && tex_coord_.size() == n_vertex;
+  // Header
+  stream << "# wavefront file written by OGLKit c++ library\n";
+  const size_t record = 4 + (3 * 32);
+  bool ok = WriteSection(n_vertex, record, [&](const size_t i, char* p) {
+    return PackOBJVector("v ", &vertex_[i].x_, 3, p);
+  }, &stream);
+  if (ok && has_tcoord) {
+    ok = WriteSection(n_vertex, record, [&](const size_t i, char* p) {
+      return PackOBJVector("vt ", &tex_coord_[i].x_, 2, p);
+    }, &stream);
+  }
+  if (ok && has_normal) {
+    ok = WriteSection(n_vertex, record, [&](const size_t i, char* p) {
+      return PackOBJVector("vn ", &normal_[i].x_, 3, p);
+    }, &stream);
+  }
+  if (ok) {
+    ok = WriteSection(tri_.size(), 2 + (3 * 36), [&](const size_t i, char* p) {
+      return PackOBJFace(&tri_[i].x_, has_tcoord, has_normal, p);
+    }, &stream);
+  }
+  stream.close();
+  return ok && !stream.fail() ? 0 : -1;
+}
+
+/*
+ *  @name SavePLY
+ *  @fn int SavePLY(const std::string& path, const bool binary) const
+ *  @brief  Save mesh to a .ply file. Records are packed into large blocks
+ *          before being written.
+ *  @param[in]  path    Path to .ply file
+ *  @param[in]  binary  If true use binary_little_endian format, otherwise
+ *                      ascii
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::SavePLY(const std::string& path, const bool binary) const {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary);
+  if (!stream.is_open()) {
+    return -1;
+  }
+  const size_t n_vertex = vertex_.size();
+  const size_t n_tri = tri_.size();
+  const uint16_t one = 1;
+  PLYWriteLayout layout;
+  layout.normal = n_vertex > 0 && normal_.size() == n_vertex;
+  layout.tcoord = n_vertex > 0 && tex_coord_.size() == n_vertex;
+  layout.color = n_vertex > 0 && vertex_color_.size() == n_vertex;
+  layout.face_tcoord = (!layout.tcoord && n_tri > 0 &&
+                        tex_coord_.size() == 3 * n_tri);
+  layout.binary = binary;
+  layout.swap = *reinterpret_cast<const uint8_t*>(&one) != 1;
+  // Header
+  const char* type = sizeof(T) == 4 ? "float" : "double";
+  std::ostringstream header;
+  header << "ply\n";
+  header << (binary ? "format binary_little_endian 1.0\n" :
+                      "format ascii 1.0\n");
+  header << "comment written by OGLKit c++ library\n";
+  header << "element vertex " << n_vertex << "\n";
+  header << "property " << type << " x\nproperty " << type << " y\n";
+  header << "property " << type << " z\n";
+  if (layout.normal) {
+    header << "property " << type << " nx\nproperty " << type << " ny\n";
+    header << "property " << type << " nz\n";
+  }
+  if (layout.tcoord) {
+    header << "property " << type << " u\nproperty " << type << " v\n";
+  }
+  if (layout.color) {
+    header << "property uchar red\nproperty uchar green\n";
+    header << "property uchar blue\nproperty uchar alpha\n";
+  }
+  header << "element face " << n_tri << "\n";
+  header << "property list uchar int vertex_indices\n";
+  if (layout.face_tcoord) {
+    header << "property list uchar " << type << " texcoord\n";
+  }
+  header << "end_header\n";
+  stream << header.str();
+  // Vertex, positions only can be written straight from memory
+  bool ok = stream.good();
+  if (binary && !layout.swap && !layout.normal && !layout.tcoord &&
+      !layout.color && sizeof(Vertex) == 3 * sizeof(T)) {
+    stream.write(reinterpret_cast<const char*>(vertex_.data()),
+                 n_vertex * sizeof(Vertex));
+    ok = stream.good();
+  } else if (ok) {
+    const size_t record = binary ? 12 * sizeof(T) : kPLYMaxAsciiRecord;
+    ok = WriteSection(n_vertex, record, [&](const size_t i, char* p) {
+      return PackPLYVertex(*this, layout, i, p);
+    }, &stream);
+  }
+  // Faces
+  if (ok) {
+    const size_t record = (binary ? 2 + (3 * 4) + (6 * sizeof(T)) :
+                           kPLYMaxAsciiRecord);
+    ok = WriteSection(n_tri, record, [&](const size_t i, char* p) {
+      return PackPLYFace(*this, layout, i, p);
+    }, &stream);
+  }
+  stream.close();
+  return ok && !stream.fail() ? 0 : -1;
+}
+
+/*
+ *  @name LoadSTL
+ *  @fn int LoadSTL(const std::string& path)
+ *  @brief  Load mesh from .stl file (binary or ascii), possibly gzip / zstd
+ *          compressed
+ *  @param[in]  path  Path to .stl file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadSTL(const std::string& path) {
+  MemoryMap file;
+  if (file.Open(path)) {
+    return -1;
+  }
+  return this->LoadSTL(file.data(), file.size(), path);
+}
+
+/*
+ *  @name LoadSTL
+ *  @fn int LoadSTL(const char* data, const size_t size,
+                    const std::string& name)
+ *  @brief  Load mesh from a buffer holding a .stl file, possibly gzip /
+ *          zstd compressed. Facets are welded into an indexed mesh.
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size
+ *  @param[in]  name  Name of the source used in error messages
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadSTL(const char* data,
+                     const size_t size,
+                     const std::string& name) {
+  const char* first = data;
+  const char* last = first + size;
+  Decompressor stream;
+  if (Decompressor::DetectCodec(first, size) != Decompressor::kNone) {
+    // Binary records are identified by the total size, needs everything
+    if (stream.Open(first, size) || stream.Finish()) {
+      std::cout << "Error, malformed stl file : " << name << std::endl;
+      return -1;
+    }
+    first = stream.data();
+    last = first + stream.Wait(0);
+  }
+  const size_t n = static_cast<size_t>(last - first);
+  const bool parallel = parallel_loading_ && n > kParallelLoadingSize;
+  STLContent<T> content;
+  int error = -1;
+  if (IsBinarySTL(first, n)) {
+    error = ParseSTLBinary(first, last, parallel, &content);
+  } else {
+    const char* p = CharConv::SkipSpace(first, last);
+    if (last - p >= 5 && std::strncmp(p, "solid", 5) == 0) {
+      error = ParseSTLAscii(first, last, parallel, &content);
+    }
+  }
+  if (error || content.corner.size() / 3 >
+               static_cast<size_t>(std::numeric_limits<int>::max())) {
+    std::cout << "Error, malformed stl file : " << name << std::endl;
+    return -1;
+  }
+  WeldCorners<T>(content.corner, parallel, &vertex_, &tri_);
+  if (!vertex_.empty()) {
+    bbox_ = content.bbox;
+    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+    bbox_is_computed_ = true;
+  }
+  return 0;
+}
+
+/*
+ *  @name SaveSTL
+ *  @fn int SaveSTL(const std::string& path) const
+ *  @brief  Save mesh to a binary .stl file. Facet's normals are recomputed
+ *          from the positions, records are packed into large blocks before
+ *          being written.
+ *  @param[in]  path  Path to .stl file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::SaveSTL(const std::string& path) const {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary);
+  const size_t n_tri = tri_.size();
+  if (!stream.is_open() ||
+      n_tri > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
+    return -1;
+  }
+  const uint16_t one = 1;
+  const bool swap = *reinterpret_cast<const uint8_t*>(&one) != 1;
+  // Header, must not start with "solid" to avoid confusion with ascii
+  char header[kSTLHeaderSize] = "binary stl written by OGLKit c++ library";
+  StoreRaw(static_cast<uint32_t>(n_tri), swap, header + 80);
+  stream.write(header, kSTLHeaderSize);
+  bool ok = stream.good();
+  if (ok) {
+    ok = WriteSection(n_tri, kSTLRecordSize, [&](const size_t i, char* p) {
+      return PackSTLFacet<T>(vertex_, tri_[i], swap, p);
+    }, &stream);
+  }
+  stream.close();
+  return ok && !stream.fail() ? 0 : -1;
+}
+
+/*
+ *  @name LoadGLTF
+ *  @fn int LoadGLTF(const std::string& path)
+ *  @brief  Load mesh from .gltf (+ .bin) or .glb file
+ *  @param[in]  path  Path to .gltf / .glb file
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadGLTF(const std::string& path) {
+  GLTFAsset asset;
+  if (asset.Load(path)) {
+    std::cout << "Error, malformed gltf file : " << path << std::endl;
+    return -1;
+  }
+  return this->LoadGLTF(asset, path);
+}
+
+/*
+ *  @name LoadGLTF
+ *  @fn int LoadGLTF(const char* data, const size_t size,
+                     const std::string& name)
+ *  @brief  Load mesh from a buffer holding a .glb file (or a .gltf file
+ *          with embedded buffers)
+ *  @param[in]  data  Buffer
+ *  @param[in]  size  Buffer's size
+ *  @param[in]  name  Name of the source used in error messages
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadGLTF(const char* data,
+                      const size_t size,
+                      const std::string& name) {
+  GLTFAsset asset;
+  if (asset.Load(data, size, "")) {
+    std::cout << "Error, malformed gltf file : " << name << std::endl;
+    return -1;
+  }
+  return this->LoadGLTF(asset, name);
+}
+
+/*
+ *  @name LoadGLTF
+ *  @fn int LoadGLTF(const GLTFAsset& asset, const std::string& name)
+ *  @brief  Merge every triangle primitive of a glTF asset into this mesh.
+ *          Attributes are kept only if present in every primitive.
+ *  @param[in]  asset Loaded asset
+ *  @param[in]  name  Name of the source used in error messages
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::LoadGLTF(const GLTFAsset& asset, const std::string& name) {
+  const auto& primitive = asset.get_primitive();
+  if (primitive.empty()) {
+    std::cout << "Error, no triangle primitive in gltf file : " << name;
+    std::cout << std::endl;
+    return -1;
+  }
+  // Bounds are mandatory for positions, saves a pass over the vertices
+  AABB<T> bbox;
+  bool has_bbox = true;
+  std::vector<Mesh<T>> part(primitive.size());
+  for (size_t i = 0; i < primitive.size(); ++i) {
+    AABB<T> b;
+    if (asset.Extract(i, &part[i])) {
+      std::cout << "Error, malformed gltf primitive : " << name << std::endl;
+      return -1;
+    }
+    if (asset.GetBounds(primitive[i].position, &b)) {
+      has_bbox = false;
+    } else if (i == 0) {
+      bbox = b;
+    } else {
+      bbox += b;
+    }
+  }
+  if (part.size() == 1) {
+    vertex_.swap(part[0].vertex_);
+    normal_.swap(part[0].normal_);
+    tex_coord_.swap(part[0].tex_coord_);
+    tangent_.swap(part[0].tangent_);
+    vertex_color_.swap(part[0].vertex_color_);
+    tri_.swap(part[0].tri_);
+  } else {
+    bool normal = true, tcoord = true, tangent = true, color = true;
+    size_t n_vertex = 0, n_tri = 0;
+    for (const auto& p : part) {
+      normal &= !p.normal_.empty();
+      tcoord &= !p.tex_coord_.empty();
+      tangent &= !p.tangent_.empty();
+      color &= !p.vertex_color_.empty();
+      n_vertex += p.vertex_.size();
+      n_tri += p.tri_.size();
+    }
+    if (n_vertex > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      return -1;
+    }
+    vertex_.reserve(n_vertex);
+    tri_.reserve(n_tri);
+    for (const auto& p : part) {
+      const int offset = static_cast<int>(vertex_.size());
+      vertex_.insert(vertex_.end(), p.vertex_.begin(), p.vertex_.end());
+      if (normal) {
+        normal_.insert(normal_.end(), p.normal_.begin(), p.normal_.end());
+      }
+      if (tcoord) {
+        tex_coord_.insert(tex_coord_.end(),
+                          p.tex_coord_.begin(),
+                          p.tex_coord_.end());
+      }
+      if (tangent) {
+        tangent_.insert(tangent_.end(), p.tangent_.begin(), p.tangent_.end());
+      }
+      if (color) {
+        vertex_color_.insert(vertex_color_.end(),
+                             p.vertex_color_.begin(),
+                             p.vertex_color_.end());
+      }
+      for (const auto& t : p.tri_) {
+        tri_.push_back(Triangle(t.x_ + offset, t.y_ + offset, t.z_ + offset));
+      }
+    }
+  }
+  if (has_bbox) {
+    bbox_ = bbox;
+    bbox_.center_ = (bbox_.min_ + bbox_.max_) * T(0.5);
+    bbox_is_computed_ = true;
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name ComputeVertexNormal
+ *  @fn void ComputeVertexNormal(void)
+ *  @brief  Compute normal for each vertex in the object. Face normals (and
+ *          corner angles) are computed once, then gathered per vertex
+ *          through the connectivity (built first if needed), both passes
+ *          run on the thread pool. Weighting is selected with
+ *          set_normal_weighting().
+ */
+template<typename T>
+void Mesh<T>::ComputeVertexNormal(void) {
+  this->UpdateConnectivity();
+  if (vertex_con_.size() != vertex_.size() || vertex_.empty()) {
+    // No (valid) triangulation
+    normal_.clear();
+    normal_version_ = version_;
+    return;
+  }
+  auto& pool = ThreadPool::Instance();
+  const size_t n_tri = tri_.size();
+  const NormalWeighting weighting = normal_weighting_;
+  face_normal_.resize(n_tri);
+  corner_angle_.resize(weighting == kAngleWeighting ? 3 * n_tri : 0);
+  // Face pass, a single cross product per triangle. Its norm is twice the
+  // area, and the sine part of each corner angle.
+  pool.ParallelFor(0, n_tri, kNormalBlockSize, [&](const size_t begin,
+                                                   const size_t end) {
+    for (size_t f = begin; f < end; ++f) {
+      const Triangle& t = tri_[f];
+      const Vertex& A = vertex_[t.x_];
+      const Vertex& B = vertex_[t.y_];
+      const Vertex& C = vertex_[t.z_];
+      const Edge AB = B - A;
+      const Edge BC = C - B;
+      const Edge CA = A - C;
+      Normal n = CA ^ AB;
+      if (weighting != kAreaWeighting) {
+        const T sine = n.Norm();
+        if (sine > T(0.0)) {
+          n /= sine;
+        }
+        if (weighting == kAngleWeighting) {
+          T* angle = &corner_angle_[3 * f];
+          // Angles of a triangle sum to pi
+          angle[0] = std::atan2(sine, -(CA * AB));
+          angle[1] = std::atan2(sine, -(AB * BC));
+          angle[2] = T(M_PI) - angle[0] - angle[1];
+        }
+      }
+      face_normal_[f] = n;
+    }
+  });
+  // Gather pass, every vertex sums its own faces: no write conflict and the
+  // result does not depend on the number of thread
+  const size_t n_vert = vertex_.size();
+  normal_.resize(n_vert);
+  pool.ParallelFor(0, n_vert, kNormalBlockSize, [&](const size_t begin,
+                                                    const size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      const auto conn = vertex_con_[v];
+      const size_t n_face = conn.size() / 2;
+      Normal weighted_n;
+      if (weighting == kAngleWeighting) {
+        for (size_t j = 0; j < n_face; ++j) {
+          const int c = conn.corner[j];
+          weighted_n += face_normal_[c / 3] * corner_angle_[c];
+        }
+      } else {
+        for (size_t j = 0; j < n_face; ++j) {
+          weighted_n += face_normal_[conn.corner[j] / 3];
+        }
+      }
+      // normalize and set
+      weighted_n.Normalize();
+      normal_[v] = weighted_n;
+    }
+  });
+  normal_version_ = version_;
+}
+
+/*
+ *  @name ComputeBoundingBox
+ *  @fn void ComputeBoundingBox(void)
+ *  @brief  Compute the bounding box of the mesh
+ */
+template<typename T>
+void Mesh<T>::ComputeBoundingBox(void) {
+  // Vectorized, split on the thread pool for large meshes
+  BoundingBox<T>::Compute(vertex_, &bbox_);
+  bbox_is_computed_ = true;
+  bbox_version_ = version_;
+}
+
+/*
+ *  @name ComputeBoundingBox
+ *  @fn int ComputeBoundingBox(const size_t first_tri, const size_t n_tri,
+                               AABB<T>* bbox) const
+ *  @brief  Compute the bounding box of the vertices used by a range of
+ *          triangles (i.e. a cluster), the mesh's box is left untouched
+ *  @param[in]  first_tri First triangle of the range
+ *  @param[in]  n_tri     Number of triangle in the range
+ *  @param[out] bbox      Bounding box
+ *  @return -1 if the range or a triangle is invalid, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::ComputeBoundingBox(const size_t first_tri,
+                                const size_t n_tri,
+                                AABB<T>* bbox) const {
+  return BoundingBox<T>::Compute(vertex_, tri_, first_tri, n_tri, bbox);
+}
+
+/*
+ *  @name ComputeVertexTangent
+ *  @fn void ComputeVertexTangent(void)
+ *  @brief  Compute tangent for each vertex from the texture coordinates,
+ *          following MikkTSpace: face tangents are projected onto the
+ *          tangent plane of each corner's normal, weighted by the corner
+ *          angle and averaged, the bitangent's orientation is stored in w.
+ *          Faces are processed then gathered per vertex on the thread
+ *          pool, the result does not depend on the number of thread.
+ *          Connectivity and normals are built if missing. Cleared if there
+ *          is no texture coordinate.
+ */
+template<typename T>
+void Mesh<T>::ComputeVertexTangent(void) {
+  const size_t n = vertex_.size();
+  if (tex_coord_.size() != n || n == 0 || tri_.empty()) {
+    tangent_.clear();
+    tangent_version_ = version_;
+    return;
+  }
+  // Tangent space is built around the vertex normals
+  this->UpdateConnectivity();
+  if (normal_.size() != n) {
+    this->ComputeVertexNormal();
+  }
+  auto& pool = ThreadPool::Instance();
+  const size_t n_tri = tri_.size();
+  face_tangent_.resize(2 * n_tri);
+  corner_angle_.resize(3 * n_tri);
+  // Face pass, unit tangent / bitangent of each triangle (null if its
+  // texture coordinates are degenerated) and corner angles
+  pool.ParallelFor(0, n_tri, kNormalBlockSize, [&](const size_t begin,
+                                                   const size_t end) {
+    for (size_t f = begin; f < end; ++f) {
+      const Triangle& tri = tri_[f];
+      const Edge AB = vertex_[tri.y_] - vertex_[tri.x_];
+      const Edge BC = vertex_[tri.z_] - vertex_[tri.y_];
+      const Edge CA = vertex_[tri.x_] - vertex_[tri.z_];
+      const TCoord d1 = tex_coord_[tri.y_] - tex_coord_[tri.x_];
+      const TCoord d2 = tex_coord_[tri.z_] - tex_coord_[tri.x_];
+      const T det = d1.x_ * d2.y_ - d2.x_ * d1.y_;
+      Edge t, b;
+      if (det != T(0.0)) {
+        // AC = -CA
+        t = (AB * d2.y_ + CA * d1.y_) / det;
+        b = (CA * -d1.x_ - AB * d2.x_) / det;
+        const T t_norm = t.Norm();
+        const T b_norm = b.Norm();
+        t = t_norm > T(0.0) ? t / t_norm : Edge();
+        b = b_norm > T(0.0) ? b / b_norm : Edge();
+      }
+      face_tangent_[2 * f] = t;
+      face_tangent_[(2 * f) + 1] = b;
+      const T sine = (CA ^ AB).Norm();
+      T* angle = &corner_angle_[3 * f];
+      angle[0] = std::atan2(sine, -(CA * AB));
+      angle[1] = std::atan2(sine, -(AB * BC));
+      angle[2] = T(M_PI) - angle[0] - angle[1];
+    }
+  });
+  // Gather pass, each vertex sums its own corners in connectivity order
+  tangent_.resize(n);
+  pool.ParallelFor(0, n, kNormalBlockSize, [&](const size_t begin,
+                                               const size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      const auto conn = vertex_con_[v];
+      const size_t n_face = conn.size() / 2;
+      const Normal& nv = normal_[v];
+      Edge t, b;
+      for (size_t j = 0; j < n_face; ++j) {
+        const int c = conn.corner[j];
+        const Edge& ft = face_tangent_[2 * (c / 3)];
+        // Project onto the tangent plane
+        Edge pt = ft - nv * (nv * ft);
+        const T norm = pt.Norm();
+        if (norm > T(0.0)) {
+          t += pt * (corner_angle_[c] / norm);
+          b += face_tangent_[(2 * (c / 3)) + 1] * corner_angle_[c];
+        }
+      }
+      if (!(t.Norm() > T(0.0))) {
+        // No usable texture coordinates, any direction in the plane
+        const Edge axis = (std::abs(nv.x_) < T(0.9) ?
+                           Edge(T(1.0), T(0.0), T(0.0)) :
+                           Edge(T(0.0), T(1.0), T(0.0)));
+        t = axis - nv * (nv * axis);
+      }
+      t.Normalize();
+      const T w = ((nv ^ t) * b) < T(0.0) ? T(-1.0) : T(1.0);
+      tangent_[v] = Tangent(t.x_, t.y_, t.z_, w);
+    }
+  });
+  tangent_version_ = version_;
+}
+
+/*
+ *  @name ReorderVertex
+ *  @fn int ReorderVertex(const VertexOrder order)
+ *  @brief  Permute the vertices to improve vertex fetch locality. Every
+ *          per-vertex array (position, normal, texture coordinate,
+ *          tangent, color) is moved together and triangles are remapped.
+ *          Up to date normals, tangents, bounding box and clusters stay
+ *          valid, the connectivity is rebuilt if present.
+ *  @param[in]  order Ordering strategy
+ *  @return -1 if the triangulation is invalid, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::ReorderVertex(const VertexOrder order) {
+  using Optimizer = MeshOptimizer<T>;
+  std::vector<int> remap;
+  if (Optimizer::VertexRemap(vertex_,
+                             tri_,
+                             static_cast<typename Optimizer::VertexOrder>(order),
+                             &remap)) {
+    std::cout << "Error, invalid triangulation, can not reorder vertices";
+    std::cout << std::endl;
+    return -1;
+  }
+  // Derived data, up to date before the permutation, are moved along
+  const size_t n = vertex_.size();
+  const size_t source = std::max(vertex_version_, tri_version_);
+  const bool normal = normal_version_ >= source && normal_.size() == n;
+  const bool tangent = (tangent_version_ >= std::max(source, tcoord_version_) &&
+                        tangent_version_ >= normal_version_ &&
+                        tangent_.size() == n);
+  const bool bbox = bbox_is_computed_ && bbox_version_ >= vertex_version_;
+  const bool cluster = cluster_version_ >= source;
+  const bool con = !vertex_con_.empty();
+  this->RemapVertex(remap);
+  if (normal) {
+    normal_version_ = version_;
+  }
+  if (tangent) {
+    tangent_version_ = version_;
+  }
+  if (bbox) {
+    bbox_version_ = version_;
+  }
+  if (cluster) {
+    // Triangle order is kept, ranges and bounds are unchanged
+    cluster_version_ = version_;
+  }
+  half_edge_.Clear();
+  if (con && n != 0 && !tri_.empty()) {
+    this->BuildConnectivity();
+  }
+  return 0;
+}
+
+/*
+ *  @name RemoveUnusedVertex
+ *  @fn int RemoveUnusedVertex(void)
+ *  @brief  Drop vertices no triangle refers to (i.e. once triangles are
+ *          replaced by a simplified level), remaining ones are ordered by
+ *          first use
+ *  @return -1 if the triangulation is invalid, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::RemoveUnusedVertex(void) {
+  std::vector<int> remap;
+  if (MeshOptimizer<T>::VertexRemap(vertex_,
+                                    tri_,
+                                    MeshOptimizer<T>::kFirstUseOrder,
+                                    &remap)) {
+    std::cout << "Error, invalid triangulation, can not remove vertices";
+    std::cout << std::endl;
+    return -1;
+  }
+  std::vector<bool> used(vertex_.size(), false);
+  for (const auto& t : tri_) {
+    used[t.x_] = used[t.y_] = used[t.z_] = true;
+  }
+  const size_t n = vertex_.size();
+  const size_t n_used = std::count(used.begin(), used.end(), true);
+  this->RemapVertex(remap);
+  // Unused vertices are at the end
+  if (normal_.size() == n) {
+    normal_.resize(n_used);
+  }
+  if (tex_coord_.size() == n) {
+    tex_coord_.resize(n_used);
+  }
+  if (tangent_.size() == n) {
+    tangent_.resize(n_used);
+  }
+  if (vertex_color_.size() == n) {
+    vertex_color_.resize(n_used);
+  }
+  vertex_.resize(n_used);
+  vertex_con_.Clear();
+  half_edge_.Clear();
+  return 0;
+}
+
+/*
+ *  @name BuildCluster
+ *  @fn int BuildCluster(const size_t max_vertex, const size_t max_tri)
+ *  @brief  Split the triangulation into clusters (meshlets) for culling,
+ *          triangles are reordered so that every cluster is a contiguous
+ *          range. Normals, tangents and bounding box stay valid.
+ *  @param[in]  max_vertex  Maximum number of vertex per cluster
+ *  @param[in]  max_tri     Maximum number of triangle per cluster
+ *  @return -1 if the triangulation or the budgets are invalid, 0 otherwise
+ */
+template<typename T>
+int Mesh<T>::BuildCluster(const size_t max_vertex, const size_t max_tri) {
+  // Derived data, up to date before reordering, remain so after
+  const size_t n = vertex_.size();
+  const size_t source = std::max(vertex_version_, tri_version_);
+  const bool normal = normal_version_ >= source && normal_.size() == n;
+  const bool tangent = (tangent_version_ >= std::max(source, tcoord_version_) &&
+                        tangent_version_ >= normal_version_ &&
+                        tangent_.size() == n);
+  const bool bbox = bbox_is_computed_ && bbox_version_ >= vertex_version_;
+  const bool con = !vertex_con_.empty();
+  if (MeshPartitioner<T>::Partition(vertex_,
+                                    max_vertex,
+                                    max_tri,
+                                    &tri_,
+                                    &cluster_)) {
+    std::cout << "Error, invalid triangulation or cluster size, can not ";
+    std::cout << "build clusters" << std::endl;
+    return -1;
+  }
+  this->Touch(kTriangleData);
+  if (normal) {
+    normal_version_ = version_;
+  }
+  if (tangent) {
+    tangent_version_ = version_;
+  }
+  if (bbox) {
+    bbox_version_ = version_;
+  }
+  half_edge_.Clear();
+  if (con && n != 0 && !tri_.empty()) {
+    this->BuildConnectivity();
+  }
+  cluster_version_ = version_;
+  return 0;
+}
+
+/*
+ *  @name UpdateConnectivity
+ *  @fn const Connectivity& UpdateConnectivity(void)
+ *  @brief  Rebuild the connectivity if the triangles (or the number of
+ *          vertex) changed since it was last built
+ *  @return Vertex connectivity
+ */
+template<typename T>
+const Connectivity& Mesh<T>::UpdateConnectivity(void) {
+  // Vertex positions do not matter, only their number
+  if ((con_version_ < tri_version_ || vertex_con_.size() != vertex_.size()) &&
+      !vertex_.empty() && !tri_.empty()) {
+    this->BuildConnectivity();
+  }
+  return vertex_con_;
+}
+
+/*
+ *  @name UpdateHalfEdge
+ *  @fn const HalfEdge& UpdateHalfEdge(void)
+ *  @brief  Rebuild the half-edge structure if the triangles (or the number
+ *          of vertex) changed since it was last built. Not part of the
+ *          loading stages, built on first request only.
+ *  @return Half-edge connectivity
+ */
+template<typename T>
+const HalfEdge& Mesh<T>::UpdateHalfEdge(void) {
+  if ((half_edge_version_ < tri_version_ ||
+       half_edge_.n_vertex() != vertex_.size()) &&
+      !vertex_.empty() && !tri_.empty()) {
+    if (half_edge_.Build(tri_, vertex_.size(), parallel_loading_)) {
+      std::cout << "Error, invalid triangulation, can not build half-edges";
+      std::cout << std::endl;
+    }
+    half_edge_version_ = version_;
+  }
+  return half_edge_;
+}
+
+/*
+ *  @name UpdateCluster
+ *  @fn const std::vector<Cluster>& UpdateCluster(void)
+ *  @brief  Recompute the clusters' bounds if the vertices moved since they
+ *          were built. Clusters are dropped if the triangles changed.
+ *  @return Clusters
+ */
+template<typename T>
+const std::vector<typename Mesh<T>::Cluster>& Mesh<T>::UpdateCluster(void) {
+  if (cluster_version_ < tri_version_) {
+    cluster_.clear();
+  } else if (cluster_version_ < vertex_version_) {
+    ThreadPool::Instance().ParallelFor(0, cluster_.size(), 64,
+                                       [&](const size_t begin,
+                                           const size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        MeshPartitioner<T>::ComputeBounds(vertex_, tri_, &cluster_[i]);
+      }
+    });
+  }
+  cluster_version_ = version_;
+  return cluster_;
+}
+
+/*
+ *  @name UpdateNormal
+ *  @fn const std::vector<Normal>& UpdateNormal(void)
+ *  @brief  Recompute the normals if the vertices or triangles changed
+ *          since they were last computed (or loaded)
+ *  @return Vertex normals
+ */
+template<typename T>
+const std::vector<typename Mesh<T>::Normal>& Mesh<T>::UpdateNormal(void) {
+  if ((normal_version_ < std::max(vertex_version_, tri_version_) ||
+       normal_.size() != vertex_.size()) &&
+      !vertex_.empty() && !tri_.empty()) {
+    this->UpdateConnectivity();
+    this->ComputeVertexNormal();
+  }
+  return normal_;
+}
+
+/*
+ *  @name UpdateTangent
+ *  @fn const std::vector<Tangent>& UpdateTangent(void)
+ *  @brief  Recompute the tangents if the vertices, triangles, texture
+ *          coordinates or normals changed since they were last computed
+ *  @return Vertex tangents
+ */
+template<typename T>
+const std::vector<typename Mesh<T>::Tangent>&
+Mesh<T>::UpdateTangent(void) {
+  this->UpdateNormal();
+  const size_t source = std::max(std::max(vertex_version_, tri_version_),
+                                 std::max(tcoord_version_, normal_version_));
+  if (tangent_version_ < source ||
+      (tangent_.size() != vertex_.size() && !tex_coord_.empty())) {
+    this->ComputeVertexTangent();
+  }
+  return tangent_;
+}
+
+/*
+ *  @name UpdateBoundingBox
+ *  @fn const AABB<T>& UpdateBoundingBox(void)
+ *  @brief  Recompute the bounding box if the vertices changed since it was
+ *          last computed
+ *  @return Bounding box
+ */
+template<typename T>
+const AABB<T>& Mesh<T>::UpdateBoundingBox(void) {
+  if (bbox_version_ < vertex_version_ || !bbox_is_computed_) {
+    this->ComputeBoundingBox();
   }
+  return bbox_;
 }
 
 #pragma mark -
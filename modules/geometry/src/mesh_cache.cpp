@@ -0,0 +1,212 @@
+/**
+ *  @file   mesh_cache.cpp
+ *  @brief  Native binary mesh container, memory mappable
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "oglkit/geometry/mesh_cache.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Magic number */
+const char MeshCache::kMagic[8] = {'O', 'G', 'L', 'K', 'M', 'S', 'H', '\0'};
+/** Current format version */
+const uint32_t MeshCache::kVersion = 2;
+/** Byte order mark */
+const uint32_t MeshCache::kByteOrder = 0x01020304;
+/** Alignment of section's data */
+const uint64_t MeshCache::kAlignment = 64;
+
+#pragma mark -
+#pragma mark Initialization
+
+/*
+ *  @name MeshCache
+ *  @fn MeshCache(void)
+ *  @brief  Constructor
+ */
+MeshCache::MeshCache(void) : header_(nullptr), section_(nullptr) {
+}
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name Open
+ *  @fn int Open(const std::string& path)
+ *  @brief  Map a cache file and validate its header and section table
+ *  @param[in]  path  Path to the cache file
+ *  @return -1 if error (missing, corrupted, other version or byte order),
+ *          0 otherwise
+ */
+int MeshCache::Open(const std::string& path) {
+  this->Close();
+  if (file_.Open(path)) {
+    return -1;
+  }
+  const uint64_t size = file_.size();
+  const Header* header = reinterpret_cast<const Header*>(file_.data());
+  if (size < sizeof(Header) ||
+      std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion ||
+      header->byte_order != kByteOrder ||
+      (size - sizeof(Header)) / sizeof(Section) < header->n_section) {
+    this->Close();
+    return -1;
+  }
+  // Every section must lie within the file
+  const Section* section = reinterpret_cast<const Section*>(header + 1);
+  for (uint32_t i = 0; i < header->n_section; ++i) {
+    const Section& s = section[i];
+    if (s.offset > size || s.offset % kAlignment != 0 ||
+        (s.element_size != 0 &&
+         (size - s.offset) / s.element_size < s.count)) {
+      this->Close();
+      return -1;
+    }
+  }
+  header_ = header;
+  section_ = section;
+  return 0;
+}
+
+/*
+ *  @name Close
+ *  @fn void Close(void)
+ *  @brief  Release the mapping
+ */
+void MeshCache::Close(void) {
+  file_.Close();
+  header_ = nullptr;
+  section_ = nullptr;
+}
+
+/*
+ *  @name Find
+ *  @fn const void* Find(const SectionType type,
+                         const uint32_t element_size,
+                         size_t* count) const
+ *  @brief  Look for a given section
+ *  @param[in]  type          Section type
+ *  @param[in]  element_size  Expected size of one element
+ *  @param[out] count         Number of element
+ *  @return Pointer to the section's data or nullptr if not present (or
+ *          with a different element size)
+ */
+const void* MeshCache::Find(const SectionType type,
+                            const uint32_t element_size,
+                            size_t* count) const {
+  *count = 0;
+  if (!header_) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < header_->n_section; ++i) {
+    const Section& s = section_[i];
+    if (s.type == static_cast<uint32_t>(type)) {
+      if (s.element_size != element_size) {
+        return nullptr;
+      }
+      *count = static_cast<size_t>(s.count);
+      return file_.data() + s.offset;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ *  @name Write
+ *  @fn static int Write(const std::string& path,
+                         const uint32_t scalar_size,
+                         const uint32_t flags,
+                         const std::vector<Block>& block)
+ *  @brief  Write a cache file
+ *  @param[in]  path        Path to the cache file
+ *  @param[in]  scalar_size Size of the scalar type
+ *  @param[in]  flags       Settings the data were produced with
+ *  @param[in]  block       Sections to write
+ *  @return -1 if error, 0 otherwise
+ */
+int MeshCache::Write(const std::string& path,
+                     const uint32_t scalar_size,
+                     const uint32_t flags,
+                     const std::vector<Block>& block) {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary);
+  if (!stream.is_open()) {
+    return -1;
+  }
+  // Header + table
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.scalar_size = scalar_size;
+  header.n_section = static_cast<uint32_t>(block.size());
+  header.flags = flags;
+  header.reserved = 0;
+  std::vector<Section> section(block.size());
+  uint64_t offset = sizeof(Header) + (block.size() * sizeof(Section));
+  for (size_t i = 0; i < block.size(); ++i) {
+    offset = (offset + kAlignment - 1) & ~(kAlignment - 1);
+    section[i].type = static_cast<uint32_t>(block[i].type);
+    section[i].element_size = block[i].element_size;
+    section[i].count = block[i].count;
+    section[i].offset = offset;
+    offset += block[i].count * block[i].element_size;
+  }
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  stream.write(reinterpret_cast<const char*>(section.data()),
+               section.size() * sizeof(Section));
+  // Data, padded to the alignment
+  const char padding[64] = {0};
+  uint64_t pos = sizeof(Header) + (block.size() * sizeof(Section));
+  for (size_t i = 0; i < block.size() && stream.good(); ++i) {
+    stream.write(padding, static_cast<std::streamsize>(section[i].offset - pos));
+    const uint64_t size = block[i].count * block[i].element_size;
+    stream.write(reinterpret_cast<const char*>(block[i].data),
+                 static_cast<std::streamsize>(size));
+    pos = section[i].offset + size;
+  }
+  stream.close();
+  return stream.fail() ? -1 : 0;
+}
+
+/*
+ *  @name IsUpToDate
+ *  @fn static bool IsUpToDate(const std::string& cache,
+                               const std::string& source,
+                               const uint32_t flags)
+ *  @brief  Check if a cache file exists, is not older than its source and
+ *          was produced with the same settings
+ *  @param[in]  cache   Path to the cache file
+ *  @param[in]  source  Path to the source mesh file
+ *  @param[in]  flags   Current settings, compared to the cache's ones
+ *  @return True if the cache can be used in place of the source
+ */
+bool MeshCache::IsUpToDate(const std::string& cache,
+                           const std::string& source,
+                           const uint32_t flags) {
+  struct stat cache_info;
+  struct stat source_info;
+  if (stat(cache.c_str(), &cache_info) != 0 ||
+      stat(source.c_str(), &source_info) != 0 ||
+      cache_info.st_mtime < source_info.st_mtime) {
+    return false;
+  }
+  MeshCache file;
+  return !file.Open(cache) && file.flags() == flags;
+}
+
+}  // namespace OGLKit
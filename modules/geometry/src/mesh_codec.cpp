@@ -0,0 +1,332 @@
+/**
+ *  @file   mesh_codec.cpp
+ *  @brief  Compact mesh encoding (quantized positions, octahedral normals,
+ *          delta/varint indices)
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "oglkit/geometry/mesh_codec.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Largest quantized position */
+static const double kPositionMax = 65535.0;
+/** Largest quantized octahedral coordinate */
+static const double kNormalMax = 32767.0;
+
+/**
+ *  @name PutVarint
+ *  @fn void PutVarint(uint64_t value, std::vector<uint8_t>* code)
+ *  @brief  Append an unsigned LEB128 number
+ *  @param[in]  value Value to write
+ *  @param[out] code  Byte stream
+ */
+static void PutVarint(uint64_t value, std::vector<uint8_t>* code) {
+  while (value >= 0x80) {
+    code->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  code->push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ *  @name GetVarint
+ *  @fn const uint8_t* GetVarint(const uint8_t* p, const uint8_t* last,
+                                 uint64_t* value)
+ *  @brief  Read an unsigned LEB128 number
+ *  @param[in]  p     Where to read
+ *  @param[in]  last  End of the stream
+ *  @param[out] value Value read
+ *  @return Position following the number or nullptr if truncated
+ */
+static const uint8_t* GetVarint(const uint8_t* p,
+                                const uint8_t* last,
+                                uint64_t* value) {
+  uint64_t v = 0;
+  for (int shift = 0; p != last && shift < 64; shift += 7) {
+    const uint8_t byte = *p++;
+    v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = v;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+#pragma mark -
+#pragma mark Position
+
+/*
+ *  @name EncodePosition
+ *  @fn static void EncodePosition(const std::vector<Vertex>& vertex,
+                                   const AABB<T>& bbox,
+                                   std::vector<uint16_t>* code,
+                                   Report* report)
+ *  @brief  Quantize positions on 16 bits relative to a bounding box
+ *  @param[in]  vertex  Positions
+ *  @param[in]  bbox    Bounding box enclosing every position
+ *  @param[out] code    Quantized positions (3 per vertex)
+ *  @param[out] report  Round trip error (optional)
+ */
+template<typename T>
+void MeshCodec<T>::EncodePosition(const std::vector<Vertex>& vertex,
+                                  const AABB<T>& bbox,
+                                  std::vector<uint16_t>* code,
+                                  Report* report) {
+  const T* min = &bbox.min_.x_;
+  const T* max = &bbox.max_.x_;
+  T scale[3];
+  for (int k = 0; k < 3; ++k) {
+    const T extent = max[k] - min[k];
+    scale[k] = extent > T(0) ? T(kPositionMax) / extent : T(0);
+  }
+  const size_t n = vertex.size();
+  code->resize(3 * n);
+  for (size_t i = 0; i < n; ++i) {
+    const T* v = &vertex[i].x_;
+    for (int k = 0; k < 3; ++k) {
+      const T q = std::min(std::max((v[k] - min[k]) * scale[k], T(0)),
+                           T(kPositionMax));
+      (*code)[(3 * i) + k] = static_cast<uint16_t>(q + T(0.5));
+    }
+  }
+  if (report) {
+    std::vector<Vertex> decoded(n);
+    DecodePosition(code->data(), n, bbox, decoded.data());
+    report->position_error = T(0);
+    report->position_bound = T(0);
+    for (int k = 0; k < 3; ++k) {
+      const T step = (max[k] - min[k]) / T(kPositionMax);
+      report->position_bound = std::max(report->position_bound,
+                                        step * T(0.5));
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const T* v = &vertex[i].x_;
+      const T* d = &decoded[i].x_;
+      for (int k = 0; k < 3; ++k) {
+        report->position_error = std::max(report->position_error,
+                                          std::abs(v[k] - d[k]));
+      }
+    }
+    report->raw_size += n * sizeof(Vertex);
+    report->encoded_size += code->size() * sizeof(uint16_t);
+  }
+}
+
+/*
+ *  @name DecodePosition
+ *  @fn static void DecodePosition(const uint16_t* code, const size_t n,
+                                   const AABB<T>& bbox, Vertex* vertex)
+ *  @brief  Reconstruct quantized positions
+ *  @param[in]  code    Quantized positions (3 per vertex)
+ *  @param[in]  n       Number of vertex
+ *  @param[in]  bbox    Bounding box used for encoding
+ *  @param[out] vertex  Positions
+ */
+template<typename T>
+void MeshCodec<T>::DecodePosition(const uint16_t* code,
+                                  const size_t n,
+                                  const AABB<T>& bbox,
+                                  Vertex* vertex) {
+  static_assert(sizeof(Vertex) == 3 * sizeof(T), "Vertex must be packed");
+  const T ox = bbox.min_.x_;
+  const T oy = bbox.min_.y_;
+  const T oz = bbox.min_.z_;
+  const T sx = (bbox.max_.x_ - ox) / T(kPositionMax);
+  const T sy = (bbox.max_.y_ - oy) / T(kPositionMax);
+  const T sz = (bbox.max_.z_ - oz) / T(kPositionMax);
+  T* out = &vertex[0].x_;
+  for (size_t i = 0; i < 3 * n; i += 3) {
+    out[i] = ox + (sx * static_cast<T>(code[i]));
+    out[i + 1] = oy + (sy * static_cast<T>(code[i + 1]));
+    out[i + 2] = oz + (sz * static_cast<T>(code[i + 2]));
+  }
+}
+
+#pragma mark -
+#pragma mark Normal
+
+/*
+ *  @name EncodeNormal
+ *  @fn static void EncodeNormal(const std::vector<Normal>& normal,
+                                 std::vector<int16_t>* code,
+                                 Report* report)
+ *  @brief  Octahedral encoding of unit vectors on 2 x 16 bits
+ *  @param[in]  normal  Normals
+ *  @param[out] code    Encoded normals (2 per normal)
+ *  @param[out] report  Round trip error (optional)
+ */
+template<typename T>
+void MeshCodec<T>::EncodeNormal(const std::vector<Normal>& normal,
+                                std::vector<int16_t>* code,
+                                Report* report) {
+  const size_t n = normal.size();
+  code->resize(2 * n);
+  for (size_t i = 0; i < n; ++i) {
+    const Normal& nrm = normal[i];
+    const T l1 = std::abs(nrm.x_) + std::abs(nrm.y_) + std::abs(nrm.z_);
+    T x = l1 > T(0) ? nrm.x_ / l1 : T(0);
+    T y = l1 > T(0) ? nrm.y_ / l1 : T(0);
+    if (nrm.z_ < T(0)) {
+      // Fold lower hemisphere
+      const T fx = (T(1) - std::abs(y)) * (x >= T(0) ? T(1) : T(-1));
+      const T fy = (T(1) - std::abs(x)) * (y >= T(0) ? T(1) : T(-1));
+      x = fx;
+      y = fy;
+    }
+    x = std::min(std::max(x, T(-1)), T(1)) * T(kNormalMax);
+    y = std::min(std::max(y, T(-1)), T(1)) * T(kNormalMax);
+    (*code)[2 * i] = static_cast<int16_t>(std::round(x));
+    (*code)[(2 * i) + 1] = static_cast<int16_t>(std::round(y));
+  }
+  if (report) {
+    std::vector<Normal> decoded(n);
+    DecodeNormal(code->data(), n, decoded.data());
+    // Angle through atan2, acos is not accurate for small angles
+    double max_angle = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      const double a[] = {normal[i].x_, normal[i].y_, normal[i].z_};
+      const double b[] = {decoded[i].x_, decoded[i].y_, decoded[i].z_};
+      const double cx = (a[1] * b[2]) - (a[2] * b[1]);
+      const double cy = (a[2] * b[0]) - (a[0] * b[2]);
+      const double cz = (a[0] * b[1]) - (a[1] * b[0]);
+      const double dot = (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]);
+      if (a[0] != 0.0 || a[1] != 0.0 || a[2] != 0.0) {
+        const double cross = std::sqrt((cx * cx) + (cy * cy) + (cz * cz));
+        max_angle = std::max(max_angle, std::atan2(cross, dot));
+      }
+    }
+    report->normal_error = static_cast<T>(max_angle * 180.0 / M_PI);
+    report->raw_size += n * sizeof(Normal);
+    report->encoded_size += code->size() * sizeof(int16_t);
+  }
+}
+
+/*
+ *  @name DecodeNormal
+ *  @fn static void DecodeNormal(const int16_t* code, const size_t n,
+                                 Normal* normal)
+ *  @brief  Reconstruct octahedral encoded normals
+ *  @param[in]  code    Encoded normals (2 per normal)
+ *  @param[in]  n       Number of normal
+ *  @param[out] normal  Unit normals
+ */
+template<typename T>
+void MeshCodec<T>::DecodeNormal(const int16_t* code,
+                                const size_t n,
+                                Normal* normal) {
+  static_assert(sizeof(Normal) == 3 * sizeof(T), "Normal must be packed");
+  const T inv = T(1.0 / kNormalMax);
+  T* out = &normal[0].x_;
+  for (size_t i = 0; i < n; ++i) {
+    T x = static_cast<T>(code[2 * i]) * inv;
+    T y = static_cast<T>(code[(2 * i) + 1]) * inv;
+    const T z = T(1) - std::abs(x) - std::abs(y);
+    // Unfold lower hemisphere without branching
+    const T t = std::max(-z, T(0));
+    x -= std::copysign(t, x);
+    y -= std::copysign(t, y);
+    const T s = T(1) / std::sqrt((x * x) + (y * y) + (z * z));
+    out[3 * i] = x * s;
+    out[(3 * i) + 1] = y * s;
+    out[(3 * i) + 2] = z * s;
+  }
+}
+
+#pragma mark -
+#pragma mark Triangle
+
+/*
+ *  @name EncodeTriangle
+ *  @fn static void EncodeTriangle(const std::vector<Triangle>& tri,
+                                   std::vector<uint8_t>* code,
+                                   Report* report)
+ *  @brief  Lossless encoding of triangle indices. Stream starts with the
+ *          number of triangle, then each index is stored as the zigzag
+ *          varint of its difference with the previous one.
+ *  @param[in]  tri     Triangles
+ *  @param[out] code    Byte stream
+ *  @param[out] report  Encoded size (optional)
+ */
+template<typename T>
+void MeshCodec<T>::EncodeTriangle(const std::vector<Triangle>& tri,
+                                  std::vector<uint8_t>* code,
+                                  Report* report) {
+  code->clear();
+  code->reserve(tri.size() * 4);
+  PutVarint(tri.size(), code);
+  int64_t prev = 0;
+  for (const auto& t : tri) {
+    const int* idx = &t.x_;
+    for (int k = 0; k < 3; ++k) {
+      const int64_t delta = static_cast<int64_t>(idx[k]) - prev;
+      // Shift as unsigned, left shifting a negative value is undefined
+      PutVarint((static_cast<uint64_t>(delta) << 1) ^
+                static_cast<uint64_t>(delta >> 63), code);
+      prev = idx[k];
+    }
+  }
+  if (report) {
+    report->raw_size += tri.size() * sizeof(Triangle);
+    report->encoded_size += code->size();
+  }
+}
+
+/*
+ *  @name DecodeTriangle
+ *  @fn static int DecodeTriangle(const uint8_t* code, const size_t size,
+                                  std::vector<Triangle>* tri)
+ *  @brief  Decode triangle indices
+ *  @param[in]  code  Byte stream
+ *  @param[in]  size  Stream length in bytes
+ *  @param[out] tri   Triangles
+ *  @return -1 if the stream is malformed, 0 otherwise
+ */
+template<typename T>
+int MeshCodec<T>::DecodeTriangle(const uint8_t* code,
+                                 const size_t size,
+                                 std::vector<Triangle>* tri) {
+  static_assert(sizeof(Triangle) == 3 * sizeof(int), "Triangle must be packed");
+  const uint8_t* last = code + size;
+  uint64_t n = 0;
+  const uint8_t* p = GetVarint(code, last, &n);
+  // Each index takes at least one byte
+  if (!p || n > static_cast<uint64_t>(last - p) / 3) {
+    return -1;
+  }
+  tri->resize(static_cast<size_t>(n));
+  int64_t prev = 0;
+  int* idx = n > 0 ? &(*tri)[0].x_ : nullptr;
+  for (size_t i = 0; i < 3 * n; ++i) {
+    uint64_t zz = 0;
+    p = GetVarint(p, last, &zz);
+    if (!p) {
+      tri->clear();
+      return -1;
+    }
+    prev += static_cast<int64_t>(zz >> 1) ^ -static_cast<int64_t>(zz & 1);
+    idx[i] = static_cast<int>(prev);
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float codec */
+template class MeshCodec<float>;
+/** Double codec */
+template class MeshCodec<double>;
+
+}  // namespace OGLKit
@@ -0,0 +1,544 @@
+/**
+ *  @file   mesh_optimizer.cpp
+ *  @brief  Index buffer reordering for the post-transform vertex cache and
+ *          overdraw
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/mesh_optimizer.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/**
+ *  @struct FifoCache
+ *  @brief  Simulated FIFO vertex cache. A vertex is cached if it has been
+ *          pushed less than \p size misses ago, no actual queue needed.
+ */
+struct FifoCache {
+  /** Time each vertex has been pushed at */
+  std::vector<size_t> stamp;
+  /** Number of push so far, offset by the cache size */
+  size_t time;
+  /** Cache size */
+  size_t size;
+
+  /**
+   *  @name FifoCache
+   *  @fn FifoCache(const size_t n_vertex, const size_t cache_size)
+   *  @brief  Constructor, empty cache
+   *  @param[in]  n_vertex    Number of vertex
+   *  @param[in]  cache_size  Cache size
+   */
+  FifoCache(const size_t n_vertex, const size_t cache_size) :
+    stamp(n_vertex, 0),
+    time(cache_size + 1),
+    size(cache_size) {}
+
+  /**
+   *  @name Access
+   *  @fn int Access(const int v)
+   *  @brief  Reference a vertex, pushed if missing
+   *  @param[in]  v Vertex's index
+   *  @return 1 on cache miss, 0 otherwise
+   */
+  int Access(const int v) {
+    if (time - stamp[v] > size) {
+      stamp[v] = time++;
+      return 1;
+    }
+    return 0;
+  }
+
+  /**
+   *  @name Flush
+   *  @fn void Flush(void)
+   *  @brief  Empty the cache
+   */
+  void Flush(void) {
+    time += size + 1;
+  }
+};
+
+/** Bits per axis used for space filling curves */
+static const int kCurveBits = 10;
+
+/**
+ *  @name HilbertTranspose
+ *  @fn static void HilbertTranspose(uint32_t* x)
+ *  @brief  Convert 3D coordinates into the transposed Hilbert index
+ *          (J. Skilling, "Programming the Hilbert curve", 2004), bits are
+ *          then interleaved as for Morton codes
+ *  @param[in,out]  x Coordinates, kCurveBits each
+ */
+static void HilbertTranspose(uint32_t* x) {
+  const uint32_t m = 1u << (kCurveBits - 1);
+  // Inverse undo
+  for (uint32_t q = m; q > 1; q >>= 1) {
+    const uint32_t p = q - 1;
+    for (int i = 0; i < 3; ++i) {
+      if (x[i] & q) {
+        x[0] ^= p;
+      } else {
+        const uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  // Gray encode
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  uint32_t t = 0;
+  for (uint32_t q = m; q > 1; q >>= 1) {
+    if (x[2] & q) {
+      t ^= q - 1;
+    }
+  }
+  x[0] ^= t;
+  x[1] ^= t;
+  x[2] ^= t;
+}
+
+/**
+ *  @name Interleave
+ *  @fn static uint32_t Interleave(const uint32_t* x)
+ *  @brief  Interleave the bits of three coordinates, x[0] being the most
+ *          significant
+ *  @param[in]  x Coordinates, kCurveBits each
+ *  @return Curve index
+ */
+static uint32_t Interleave(const uint32_t* x) {
+  uint32_t key = 0;
+  for (int b = kCurveBits - 1; b >= 0; --b) {
+    key = (key << 3) | (((x[0] >> b) & 1u) << 2) | (((x[1] >> b) & 1u) << 1) |
+          ((x[2] >> b) & 1u);
+  }
+  return key;
+}
+
+/** Default simulated cache size */
+template<typename T>
+const size_t MeshOptimizer<T>::kCacheSize = 16;
+/** Default ACMR degradation accepted to reduce overdraw */
+template<typename T>
+const T MeshOptimizer<T>::kOverdrawThreshold = T(1.05);
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name Optimize
+ *  @fn static int Optimize(const std::vector<Vertex>& vertex,
+                            const bool overdraw,
+                            std::vector<Triangle>* tri,
+                            Report* report)
+ *  @brief  Reorder triangles for the vertex cache then, optionally, for
+ *          overdraw with the default parameters
+ *  @param[in]      vertex    Positions
+ *  @param[in]      overdraw  Sort clusters to reduce overdraw
+ *  @param[in,out]  tri       Triangles to reorder
+ *  @param[out]     report    Cache efficiency before / after (optional)
+ *  @return -1 if a triangle is out of range, 0 otherwise
+ */
+template<typename T>
+int MeshOptimizer<T>::Optimize(const std::vector<Vertex>& vertex,
+                               const bool overdraw,
+                               std::vector<Triangle>* tri,
+                               Report* report) {
+  const size_t n_vertex = vertex.size();
+  std::vector<int> cluster;
+  if (report) {
+    AnalyzeVertexCache(*tri, n_vertex, kCacheSize, &report->before);
+  }
+  if (OptimizeVertexCache(n_vertex, kCacheSize, tri, &cluster)) {
+    return -1;
+  }
+  if (overdraw &&
+      OptimizeOverdraw(vertex, kCacheSize, kOverdrawThreshold, tri,
+                       &cluster)) {
+    return -1;
+  }
+  if (report) {
+    AnalyzeVertexCache(*tri, n_vertex, kCacheSize, &report->after);
+    report->n_cluster = cluster.size();
+  }
+  return 0;
+}
+
+/*
+ *  @name OptimizeVertexCache
+ *  @fn static int OptimizeVertexCache(const size_t n_vertex,
+                                       const size_t cache_size,
+                                       std::vector<Triangle>* tri,
+                                       std::vector<int>* cluster)
+ *  @brief  Tipsify, emit triangle fans around the vertex most likely to
+ *          still be in cache
+ *  @param[in]      n_vertex    Number of vertex
+ *  @param[in]      cache_size  Simulated cache size
+ *  @param[in,out]  tri         Triangles to reorder
+ *  @param[out]     cluster     First triangle of each cluster, new cluster
+ *                              starts where the cache is flushed
+ *                              (optional)
+ *  @return -1 if a triangle is out of range, 0 otherwise
+ */
+template<typename T>
+int MeshOptimizer<T>::OptimizeVertexCache(const size_t n_vertex,
+                                          const size_t cache_size,
+                                          std::vector<Triangle>* tri,
+                                          std::vector<int>* cluster) {
+  // Vertex / triangle adjacency, triangle of corner c is c / 3
+  Connectivity adjacency;
+  if (adjacency.Build(*tri, n_vertex, true)) {
+    return -1;
+  }
+  const size_t n_tri = tri->size();
+  const size_t k = cache_size;
+  // Number of corner not emitted yet, for each vertex
+  std::vector<int> live(n_vertex);
+  for (size_t v = 0; v < n_vertex; ++v) {
+    live[v] = static_cast<int>(adjacency[v].size() / 2);
+  }
+  FifoCache cache(n_vertex, k);
+  std::vector<bool> emitted(n_tri, false);
+  std::vector<int> dead_end;
+  std::vector<int> candidate;
+  std::vector<Triangle> order;
+  order.reserve(n_tri);
+  std::vector<int> start(1, 0);
+  size_t cursor = 0;
+  int f = n_vertex > 0 ? 0 : -1;
+  while (f >= 0) {
+    // Emit the remaining fan around f
+    candidate.clear();
+    const auto row = adjacency[f];
+    const size_t n_face = row.size() / 2;
+    for (size_t j = 0; j < n_face; ++j) {
+      const int t = row.corner[j] / 3;
+      if (emitted[t]) {
+        continue;
+      }
+      const Triangle& triangle = (*tri)[t];
+      const int* c = &triangle.x_;
+      for (int e = 0; e < 3; ++e) {
+        dead_end.push_back(c[e]);
+        candidate.push_back(c[e]);
+        --live[c[e]];
+        cache.Access(c[e]);
+      }
+      order.push_back(triangle);
+      emitted[t] = true;
+    }
+    // Next fanning vertex, the oldest candidate that will still be in
+    // cache once its own fan is emitted
+    int next = -1;
+    size_t best = 0;
+    for (const int v : candidate) {
+      if (live[v] > 0) {
+        const size_t age = cache.time - cache.stamp[v];
+        const size_t priority = (age + (2 * live[v]) <= k) ? age + 1 : 1;
+        if (priority > best) {
+          best = priority;
+          next = v;
+        }
+      }
+    }
+    if (next < 0) {
+      // Dead end, recently referenced vertex first then input order
+      while (!dead_end.empty() && next < 0) {
+        const int v = dead_end.back();
+        dead_end.pop_back();
+        next = live[v] > 0 ? v : -1;
+      }
+      while (next < 0 && cursor < n_vertex) {
+        next = live[cursor] > 0 ? static_cast<int>(cursor) : -1;
+        cursor += next < 0 ? 1 : 0;
+      }
+      if (next >= 0 && order.size() > static_cast<size_t>(start.back())) {
+        start.push_back(static_cast<int>(order.size()));
+      }
+    }
+    f = next;
+  }
+  tri->swap(order);
+  if (cluster) {
+    cluster->swap(start);
+  }
+  return 0;
+}
+
+/*
+ *  @name OptimizeOverdraw
+ *  @fn static int OptimizeOverdraw(const std::vector<Vertex>& vertex,
+                                    const size_t cache_size,
+                                    const T threshold,
+                                    std::vector<Triangle>* tri,
+                                    std::vector<int>* cluster)
+ *  @brief  Split clusters where the cache miss ratio stays below
+ *          \p threshold times the cluster's one, then draw the clusters
+ *          facing away from the mesh's centroid first
+ *  @param[in]      vertex      Positions
+ *  @param[in]      cache_size  Simulated cache size
+ *  @param[in]      threshold   Accepted ACMR degradation (i.e. 1.05)
+ *  @param[in,out]  tri         Triangles ordered by OptimizeVertexCache
+ *  @param[in,out]  cluster     Clusters given by OptimizeVertexCache,
+ *                              updated to the drawn ones
+ *  @return -1 if the clusters or triangles are invalid, 0 otherwise
+ */
+template<typename T>
+int MeshOptimizer<T>::OptimizeOverdraw(const std::vector<Vertex>& vertex,
+                                       const size_t cache_size,
+                                       const T threshold,
+                                       std::vector<Triangle>* tri,
+                                       std::vector<int>* cluster) {
+  const size_t n_tri = tri->size();
+  const int n_vertex = static_cast<int>(vertex.size());
+  bool valid = (!cluster->empty() || n_tri == 0) &&
+               (cluster->empty() || cluster->front() == 0);
+  for (size_t i = 0; valid && i < cluster->size(); ++i) {
+    const int next = (i + 1 < cluster->size() ?
+                      (*cluster)[i + 1] : static_cast<int>(n_tri));
+    valid = (*cluster)[i] < next;
+  }
+  for (size_t i = 0; valid && i < n_tri; ++i) {
+    const int* c = &(*tri)[i].x_;
+    valid = (c[0] >= 0 && c[0] < n_vertex && c[1] >= 0 && c[1] < n_vertex &&
+             c[2] >= 0 && c[2] < n_vertex);
+  }
+  if (!valid) {
+    return -1;
+  }
+  // Soft boundaries, split as soon as the running ACMR is low enough: the
+  // cache flush it introduces costs less than the threshold
+  FifoCache cache(vertex.size(), cache_size);
+  std::vector<int> soft;
+  for (size_t i = 0; i < cluster->size(); ++i) {
+    const size_t begin = static_cast<size_t>((*cluster)[i]);
+    const size_t end = (i + 1 < cluster->size() ?
+                        static_cast<size_t>((*cluster)[i + 1]) : n_tri);
+    size_t miss = 0;
+    cache.Flush();
+    for (size_t t = begin; t < end; ++t) {
+      const int* c = &(*tri)[t].x_;
+      miss += cache.Access(c[0]) + cache.Access(c[1]) + cache.Access(c[2]);
+    }
+    const T limit = threshold * T(miss) / T(end - begin);
+    size_t first = begin;
+    miss = 0;
+    cache.Flush();
+    soft.push_back(static_cast<int>(begin));
+    for (size_t t = begin; t < end; ++t) {
+      const int* c = &(*tri)[t].x_;
+      miss += cache.Access(c[0]) + cache.Access(c[1]) + cache.Access(c[2]);
+      if (t + 1 < end && T(miss) <= limit * T(t + 1 - first)) {
+        soft.push_back(static_cast<int>(t + 1));
+        first = t + 1;
+        miss = 0;
+        cache.Flush();
+      }
+    }
+  }
+  // Area weighted centroid and normal of each cluster
+  const size_t n_cluster = soft.size();
+  std::vector<Vertex> centroid(n_cluster);
+  std::vector<Vertex> normal(n_cluster);
+  Vertex mesh_centroid;
+  T mesh_area = T(0.0);
+  for (size_t i = 0; i < n_cluster; ++i) {
+    const size_t end = (i + 1 < n_cluster ?
+                        static_cast<size_t>(soft[i + 1]) : n_tri);
+    T area = T(0.0);
+    for (size_t t = static_cast<size_t>(soft[i]); t < end; ++t) {
+      const Triangle& triangle = (*tri)[t];
+      const Vertex& A = vertex[triangle.x_];
+      const Vertex& B = vertex[triangle.y_];
+      const Vertex& C = vertex[triangle.z_];
+      const Vertex n = (B - A) ^ (C - A);
+      const T a = n.Norm();
+      centroid[i] += (A + B + C) * (a / T(3.0));
+      normal[i] += n;
+      area += a;
+    }
+    mesh_centroid += centroid[i];
+    mesh_area += area;
+    centroid[i] = area > T(0.0) ? centroid[i] * (T(1.0) / area) : Vertex();
+  }
+  if (mesh_area > T(0.0)) {
+    mesh_centroid = mesh_centroid * (T(1.0) / mesh_area);
+  }
+  // Clusters facing outward first
+  std::vector<T> key(n_cluster);
+  std::vector<int> order(n_cluster);
+  for (size_t i = 0; i < n_cluster; ++i) {
+    const T n = normal[i].Norm();
+    key[i] = n > T(0.0) ? ((centroid[i] - mesh_centroid) * normal[i]) / n :
+             T(0.0);
+    order[i] = static_cast<int>(i);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return key[a] > key[b];
+  });
+  std::vector<Triangle> sorted;
+  sorted.reserve(n_tri);
+  cluster->clear();
+  for (const int i : order) {
+    const size_t end = (static_cast<size_t>(i) + 1 < n_cluster ?
+                        static_cast<size_t>(soft[i + 1]) : n_tri);
+    cluster->push_back(static_cast<int>(sorted.size()));
+    sorted.insert(sorted.end(), tri->begin() + soft[i], tri->begin() + end);
+  }
+  tri->swap(sorted);
+  return 0;
+}
+
+/*
+ *  @name VertexRemap
+ *  @fn static int VertexRemap(const std::vector<Vertex>& vertex,
+                               const std::vector<Triangle>& tri,
+                               const VertexOrder order,
+                               std::vector<int>* remap)
+ *  @brief  Compute the new location of every vertex. With kFirstUseOrder,
+ *          vertices never referenced are moved at the end in their
+ *          original order. Space filling curves quantize positions on 10
+ *          bits per axis within the bounding box, ties are broken by
+ *          index.
+ *  @param[in]  vertex  Positions
+ *  @param[in]  tri     Triangles
+ *  @param[in]  order   Ordering strategy
+ *  @param[out] remap   New index of each vertex, remap[old] = new
+ *  @return -1 if a triangle is out of range, 0 otherwise
+ */
+template<typename T>
+int MeshOptimizer<T>::VertexRemap(const std::vector<Vertex>& vertex,
+                                  const std::vector<Triangle>& tri,
+                                  const VertexOrder order,
+                                  std::vector<int>* remap) {
+  const int n = static_cast<int>(vertex.size());
+  for (const auto& t : tri) {
+    if (t.x_ < 0 || t.x_ >= n || t.y_ < 0 || t.y_ >= n ||
+        t.z_ < 0 || t.z_ >= n) {
+      return -1;
+    }
+  }
+  remap->assign(vertex.size(), -1);
+  if (order == kFirstUseOrder) {
+    int next = 0;
+    for (const auto& t : tri) {
+      const int* c = &t.x_;
+      for (int e = 0; e < 3; ++e) {
+        if ((*remap)[c[e]] < 0) {
+          (*remap)[c[e]] = next++;
+        }
+      }
+    }
+    for (auto& r : *remap) {
+      if (r < 0) {
+        r = next++;
+      }
+    }
+    return 0;
+  }
+  // Quantize within the bounding box
+  Vertex lo(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(),
+            std::numeric_limits<T>::max());
+  Vertex hi(std::numeric_limits<T>::lowest(),
+            std::numeric_limits<T>::lowest(),
+            std::numeric_limits<T>::lowest());
+  for (const auto& v : vertex) {
+    lo.x_ = std::min(lo.x_, v.x_);
+    lo.y_ = std::min(lo.y_, v.y_);
+    lo.z_ = std::min(lo.z_, v.z_);
+    hi.x_ = std::max(hi.x_, v.x_);
+    hi.y_ = std::max(hi.y_, v.y_);
+    hi.z_ = std::max(hi.z_, v.z_);
+  }
+  const T q_max = T((1 << kCurveBits) - 1);
+  const Vertex ext = hi - lo;
+  const T scale[] = {ext.x_ > T(0.0) ? q_max / ext.x_ : T(0.0),
+                     ext.y_ > T(0.0) ? q_max / ext.y_ : T(0.0),
+                     ext.z_ > T(0.0) ? q_max / ext.z_ : T(0.0)};
+  std::vector<std::pair<uint32_t, int>> key(vertex.size());
+  ThreadPool::Instance().ParallelFor(0, vertex.size(), 1 << 14,
+                                     [&](const size_t begin,
+                                         const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Vertex d = vertex[i] - lo;
+      const T* p = &d.x_;
+      uint32_t x[3];
+      for (int k = 0; k < 3; ++k) {
+        const T q = std::min(std::max(p[k] * scale[k] + T(0.5), T(0.0)),
+                             q_max);
+        x[k] = static_cast<uint32_t>(q);
+      }
+      if (order == kHilbertOrder) {
+        HilbertTranspose(x);
+      }
+      key[i] = std::make_pair(Interleave(x), static_cast<int>(i));
+    }
+  });
+  std::sort(key.begin(), key.end());
+  for (size_t i = 0; i < key.size(); ++i) {
+    (*remap)[key[i].second] = static_cast<int>(i);
+  }
+  return 0;
+}
+
+/*
+ *  @name AnalyzeVertexCache
+ *  @fn static void AnalyzeVertexCache(const std::vector<Triangle>& tri,
+                                       const size_t n_vertex,
+                                       const size_t cache_size,
+                                       CacheStatistic* stat)
+ *  @brief  Simulate a FIFO vertex cache
+ *  @param[in]  tri         Triangles, in drawing order
+ *  @param[in]  n_vertex    Number of vertex
+ *  @param[in]  cache_size  Simulated cache size
+ *  @param[out] stat        ACMR / ATVR
+ */
+template<typename T>
+void MeshOptimizer<T>::AnalyzeVertexCache(const std::vector<Triangle>& tri,
+                                          const size_t n_vertex,
+                                          const size_t cache_size,
+                                          CacheStatistic* stat) {
+  FifoCache cache(n_vertex, cache_size);
+  std::vector<bool> used(n_vertex, false);
+  size_t n_used = 0;
+  size_t miss = 0;
+  for (const auto& t : tri) {
+    const int* c = &t.x_;
+    for (int e = 0; e < 3; ++e) {
+      if (c[e] < 0 || static_cast<size_t>(c[e]) >= n_vertex) {
+        continue;
+      }
+      miss += cache.Access(c[e]);
+      n_used += used[c[e]] ? 0 : 1;
+      used[c[e]] = true;
+    }
+  }
+  stat->n_transform = miss;
+  stat->acmr = tri.empty() ? T(0.0) : T(miss) / T(tri.size());
+  stat->atvr = n_used == 0 ? T(0.0) : T(miss) / T(n_used);
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float optimizer */
+template class MeshOptimizer<float>;
+/** Double optimizer */
+template class MeshOptimizer<double>;
+
+}  // namespace OGLKit
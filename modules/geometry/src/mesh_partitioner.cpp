@@ -0,0 +1,255 @@
+/**
+ *  @file   mesh_partitioner.cpp
+ *  @brief  Split a triangulation into small clusters (meshlets) with their
+ *          own bounds for fine grained culling
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/bounding_box.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/mesh_partitioner.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Smallest cosine between a triangle's normal and the cone's axis */
+static const double kMinConeDot = 0.1;
+
+/** Default maximum number of vertex per cluster */
+template<typename T>
+const size_t MeshPartitioner<T>::kMaxVertex = 64;
+/** Default maximum number of triangle per cluster */
+template<typename T>
+const size_t MeshPartitioner<T>::kMaxTriangle = 124;
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name Partition
+ *  @fn static int Partition(const std::vector<Vertex>& vertex,
+                             const size_t max_vertex,
+                             const size_t max_tri,
+                             std::vector<Triangle>* tri,
+                             std::vector<Cluster>* cluster)
+ *  @brief  Split triangles into clusters, triangles are reordered cluster
+ *          after cluster. Bounds are computed on the thread pool.
+ *  @param[in]      vertex      Positions
+ *  @param[in]      max_vertex  Maximum number of vertex per cluster (>= 3)
+ *  @param[in]      max_tri     Maximum number of triangle per cluster
+ *  @param[in,out]  tri         Triangles to partition
+ *  @param[out]     cluster     Clusters
+ *  @return -1 if a triangle is out of range or the budgets are invalid,
+ *          0 otherwise
+ */
+template<typename T>
+int MeshPartitioner<T>::Partition(const std::vector<Vertex>& vertex,
+                                  const size_t max_vertex,
+                                  const size_t max_tri,
+                                  std::vector<Triangle>* tri,
+                                  std::vector<Cluster>* cluster) {
+  cluster->clear();
+  Connectivity conn;
+  if (max_vertex < 3 || max_tri == 0 ||
+      conn.Build(*tri, vertex.size(), true)) {
+    return -1;
+  }
+  const size_t n_tri = tri->size();
+  // Corners of each triangle not in the current cluster yet, valid if the
+  // triangle's stamp is the current cluster
+  std::vector<int> missing(n_tri, 3);
+  std::vector<int> stamp(n_tri, -1);
+  std::vector<bool> emitted(n_tri, false);
+  std::vector<int> owner(vertex.size(), -1);
+  // Candidates by number of missing corner, consumed in FIFO order
+  std::vector<int> bucket[3];
+  size_t head[3];
+  std::vector<Triangle> order;
+  order.reserve(n_tri);
+  size_t scan = 0;
+  int seed = -1;
+  int id = 0;
+  while (order.size() < n_tri) {
+    if (seed < 0) {
+      while (emitted[scan]) {
+        ++scan;
+      }
+      seed = static_cast<int>(scan);
+    }
+    Cluster c;
+    c.first_tri = order.size();
+    for (int b = 0; b < 3; ++b) {
+      bucket[b].clear();
+      head[b] = 0;
+    }
+    auto add = [&](const int f) {
+      emitted[f] = true;
+      order.push_back((*tri)[f]);
+      ++c.n_tri;
+      const int* corner = &(*tri)[f].x_;
+      for (int k = 0; k < 3; ++k) {
+        const int v = corner[k];
+        if (owner[v] == id) {
+          continue;
+        }
+        owner[v] = id;
+        ++c.n_vertex;
+        const auto row = conn[v];
+        for (size_t j = 0; j < row.size() / 2; ++j) {
+          const int g = row.corner[j] / 3;
+          if (emitted[g]) {
+            continue;
+          }
+          if (stamp[g] != id) {
+            stamp[g] = id;
+            missing[g] = 3;
+          }
+          if (--missing[g] >= 0) {
+            bucket[missing[g]].push_back(g);
+          }
+        }
+      }
+    };
+    add(seed);
+    while (c.n_tri < max_tri) {
+      // Fewest new vertices first, entries left behind are stale
+      int next = -1;
+      for (int b = 0; b < 3 && next < 0; ++b) {
+        if (c.n_vertex + b > max_vertex) {
+          break;
+        }
+        while (head[b] < bucket[b].size()) {
+          const int g = bucket[b][head[b]++];
+          if (!emitted[g] && missing[g] == b) {
+            next = g;
+            break;
+          }
+        }
+      }
+      if (next < 0) {
+        break;
+      }
+      add(next);
+    }
+    cluster->push_back(c);
+    // Continue along the frontier
+    seed = -1;
+    for (int b = 0; b < 3 && seed < 0; ++b) {
+      for (const int g : bucket[b]) {
+        if (!emitted[g]) {
+          seed = g;
+          break;
+        }
+      }
+    }
+    ++id;
+  }
+  tri->swap(order);
+  // Bounds
+  ThreadPool::Instance().ParallelFor(0, cluster->size(), 64,
+                                     [&](const size_t begin,
+                                         const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      ComputeBounds(vertex, *tri, &(*cluster)[i]);
+    }
+  });
+  return 0;
+}
+
+/*
+ *  @name ComputeBounds
+ *  @fn static void ComputeBounds(const std::vector<Vertex>& vertex,
+                                  const std::vector<Triangle>& tri,
+                                  Cluster* cluster)
+ *  @brief  Compute box, sphere and normal cone of a cluster's range (i.e.
+ *          after the vertices moved)
+ *  @param[in]      vertex  Positions
+ *  @param[in]      tri     Triangles
+ *  @param[in,out]  cluster Cluster, range given
+ */
+template<typename T>
+void MeshPartitioner<T>::ComputeBounds(const std::vector<Vertex>& vertex,
+                                       const std::vector<Triangle>& tri,
+                                       Cluster* cluster) {
+  const Triangle* first = tri.data() + cluster->first_tri;
+  const Triangle* last = first + cluster->n_tri;
+  if (first == last) {
+    return;
+  }
+  // Box, then the sphere centered on it
+  BoundingBox<T>::Compute(vertex,
+                          tri,
+                          cluster->first_tri,
+                          cluster->n_tri,
+                          &cluster->bbox);
+  Vertex axis;
+  for (const Triangle* t = first; t != last; ++t) {
+    Vertex n = ((vertex[t->y_] - vertex[t->x_]) ^
+                (vertex[t->z_] - vertex[t->x_]));
+    const T len = n.Norm();
+    if (len > T(0.0)) {
+      axis += n / len;
+    }
+  }
+  const Vertex center = cluster->bbox.center_;
+  T radius = T(0.0);
+  for (const Triangle* t = first; t != last; ++t) {
+    const int* corner = &t->x_;
+    for (int k = 0; k < 3; ++k) {
+      radius = std::max(radius, (vertex[corner[k]] - center).Norm());
+    }
+  }
+  cluster->center = center;
+  cluster->radius = radius;
+  // Normal cone, apex placed so that the cone contains every triangle's
+  // plane
+  cluster->cone_apex = center;
+  cluster->cone_axis = Vertex();
+  cluster->cone_cutoff = T(1.0);
+  const T axis_len = axis.Norm();
+  if (axis_len <= T(0.0)) {
+    return;
+  }
+  axis /= axis_len;
+  T min_dot = T(1.0);
+  T max_t = T(0.0);
+  for (const Triangle* t = first; t != last; ++t) {
+    const Vertex& p0 = vertex[t->x_];
+    Vertex n = (vertex[t->y_] - p0) ^ (vertex[t->z_] - p0);
+    const T len = n.Norm();
+    if (len <= T(0.0)) {
+      continue;
+    }
+    n /= len;
+    const T dn = axis * n;
+    min_dot = std::min(min_dot, dn);
+    if (dn > T(kMinConeDot)) {
+      max_t = std::max(max_t, ((center - p0) * n) / dn);
+    }
+  }
+  cluster->cone_axis = axis;
+  if (min_dot > T(kMinConeDot)) {
+    cluster->cone_apex = center - axis * max_t;
+    cluster->cone_cutoff = std::sqrt(T(1.0) - min_dot * min_dot);
+  }
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float partitioner */
+template class MeshPartitioner<float>;
+/** Double partitioner */
+template class MeshPartitioner<double>;
+
+}  // namespace OGLKit
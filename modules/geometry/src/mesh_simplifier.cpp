@@ -0,0 +1,834 @@
+/**
+ *  @file   mesh_simplifier.cpp
+ *  @brief  Quadric error metric decimation producing a chain of LODs
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include "oglkit/core/thread_pool.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/half_edge.hpp"
+#include "oglkit/geometry/mesh_simplifier.hpp"
+
+/**
+ *  @namespace  OGLKit
+ *  @brief      OpenGL development space
+ */
+namespace OGLKit {
+
+/** Number of triangle processed by a task */
+static const size_t kSimplifierBlockSize = 1 << 14;
+/** Weight of the planes constraining borders and seams */
+static const double kBoundaryWeight = 10.0;
+
+/**
+ *  @enum VertexKind
+ *  @brief  How a vertex is allowed to move
+ */
+enum VertexKind {
+  /** Interior vertex, collapses onto any neighbour */
+  kManifoldVertex = 0,
+  /** Open border, slides along the border */
+  kBorderVertex = 1,
+  /** Attribute seam (two wedges), slides along the seam */
+  kSeamVertex = 2,
+  /** Never removed */
+  kLockedVertex = 3
+};
+
+/**
+ *  @struct Quadric
+ *  @brief  Weighted sum of squared distances to planes, symmetric 4x4
+ *          matrix stored as its 10 distinct entries
+ *  @tparam T Data type
+ */
+template<typename T>
+struct Quadric {
+  /** Matrix entries */
+  T a00, a11, a22, a10, a20, a21, b0, b1, b2, c;
+  /** Sum of weights */
+  T w;
+
+  /**
+   *  @name Quadric
+   *  @fn Quadric(void)
+   *  @brief  Constructor, null quadric
+   */
+  Quadric(void) : a00(0), a11(0), a22(0), a10(0), a20(0), a21(0), b0(0),
+                  b1(0), b2(0), c(0), w(0) {}
+
+  /**
+   *  @name AddPlane
+   *  @fn void AddPlane(const Vector3<T>& n, const T d, const T weight)
+   *  @brief  Accumulate the plane n.x + d = 0
+   *  @param[in]  n       Unit normal
+   *  @param[in]  d       Offset
+   *  @param[in]  weight  Plane's weight
+   */
+  void AddPlane(const Vector3<T>& n, const T d, const T weight) {
+    a00 += weight * n.x_ * n.x_;
+    a11 += weight * n.y_ * n.y_;
+    a22 += weight * n.z_ * n.z_;
+    a10 += weight * n.y_ * n.x_;
+    a20 += weight * n.z_ * n.x_;
+    a21 += weight * n.z_ * n.y_;
+    b0 += weight * n.x_ * d;
+    b1 += weight * n.y_ * d;
+    b2 += weight * n.z_ * d;
+    c += weight * d * d;
+    w += weight;
+  }
+
+  /**
+   *  @name operator+=
+   *  @fn Quadric& operator+=(const Quadric& rhs)
+   *  @brief  Merge two quadrics
+   *  @param[in]  rhs Quadric to add
+   *  @return Updated quadric
+   */
+  Quadric& operator+=(const Quadric& rhs) {
+    a00 += rhs.a00;
+    a11 += rhs.a11;
+    a22 += rhs.a22;
+    a10 += rhs.a10;
+    a20 += rhs.a20;
+    a21 += rhs.a21;
+    b0 += rhs.b0;
+    b1 += rhs.b1;
+    b2 += rhs.b2;
+    c += rhs.c;
+    w += rhs.w;
+    return *this;
+  }
+
+  /**
+   *  @name Eval
+   *  @fn T Eval(const Vector3<T>& p) const
+   *  @brief  Weighted sum of squared distances of a point to the planes
+   *  @param[in]  p Point
+   *  @return Error
+   */
+  T Eval(const Vector3<T>& p) const {
+    const T x = p.x_;
+    const T y = p.y_;
+    const T z = p.z_;
+    const T r = (a00 * x * x + a11 * y * y + a22 * z * z +
+                 T(2.0) * (a10 * x * y + a20 * x * z + a21 * y * z) +
+                 T(2.0) * (b0 * x + b1 * y + b2 * z) + c);
+    return r > T(0.0) ? r : T(0.0);
+  }
+};
+
+/**
+ *  @struct Collapse
+ *  @brief  Candidate collapse of vertex u onto vertex v
+ */
+struct Collapse {
+  /** Removed vertex */
+  int u;
+  /** Kept vertex */
+  int v;
+  /** Squared relative error */
+  float error;
+};
+
+/**
+ *  @name SortCollapse
+ *  @fn static void SortCollapse(const std::vector<Collapse>& collapse,
+                                 std::vector<int>* order)
+ *  @brief  Stable radix sort of the candidates by increasing error, errors
+ *          are positive therefore their bits sort as unsigned integers
+ *  @param[in]  collapse  Candidates
+ *  @param[out] order     Sorted candidates' index
+ */
+static void SortCollapse(const std::vector<Collapse>& collapse,
+                         std::vector<int>* order) {
+  const size_t n = collapse.size();
+  std::vector<uint32_t> key(n);
+  for (size_t i = 0; i < n; ++i) {
+    std::memcpy(&key[i], &collapse[i].error, sizeof(uint32_t));
+  }
+  order->resize(n);
+  std::iota(order->begin(), order->end(), 0);
+  std::vector<int> tmp(n);
+  for (int shift = 0; shift < 32; shift += 11) {
+    size_t hist[2048] = {0};
+    for (size_t i = 0; i < n; ++i) {
+      ++hist[(key[i] >> shift) & 2047];
+    }
+    size_t sum = 0;
+    for (size_t b = 0; b < 2048; ++b) {
+      const size_t count = hist[b];
+      hist[b] = sum;
+      sum += count;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const int c = (*order)[i];
+      tmp[hist[(key[c] >> shift) & 2047]++] = c;
+    }
+    order->swap(tmp);
+  }
+}
+
+/**
+ *  @name HasEdge
+ *  @fn static bool HasEdge(const Connectivity& conn, const int a,
+                            const int b)
+ *  @brief  Check if the half-edge a -> b exists
+ *  @param[in]  conn  Connectivity
+ *  @param[in]  a     Origin
+ *  @param[in]  b     Target
+ *  @return True if a triangle holds a -> b
+ */
+static bool HasEdge(const Connectivity& conn, const int a, const int b) {
+  const auto row = conn[a];
+  for (size_t j = 0; j < row.size(); j += 2) {
+    if (row[j] == b) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ *  @struct SimplifierState
+ *  @brief  Vertex classification, quadrics and border / seam loops shared
+ *          by every pass of a LOD chain
+ *  @tparam T Data type
+ */
+template<typename T>
+struct SimplifierState {
+  /** Vertex */
+  using Vertex = Vector3<T>;
+  /** Triangle */
+  using Triangle = Vector3<int>;
+
+  /** Positions scaled within the unit cube */
+  std::vector<Vertex> pos;
+  /** Smallest vertex sharing the same position */
+  std::vector<int> weld;
+  /** Next vertex sharing the same position, circular */
+  std::vector<int> wedge;
+  /** VertexKind */
+  std::vector<unsigned char> kind;
+  /** Next vertex along the border / seam */
+  std::vector<int> next;
+  /** Previous vertex along the border / seam */
+  std::vector<int> prev;
+  /** Quadric of each position, indexed by weld */
+  std::vector<Quadric<T>> quadric;
+  /** Collapses of the current pass, identity elsewhere */
+  std::vector<int> remap;
+  /** Vertices touched by the current pass */
+  std::vector<unsigned char> lock;
+  /** Scratch one-ring of the removed vertex */
+  std::vector<int> ring_u;
+  /** Scratch one-ring of the kept vertex */
+  std::vector<int> ring_v;
+  /** Scratch vertices opposite to the collapsed edge */
+  std::vector<int> opposite;
+
+  /**
+   *  @name Init
+   *  @fn void Init(const std::vector<Vertex>& vertex,
+                    const std::vector<Triangle>& tri,
+                    const bool lock_boundary)
+   *  @brief  Weld positions, classify vertices and accumulate quadrics
+   *  @param[in]  vertex        Positions
+   *  @param[in]  tri           Triangles, in range
+   *  @param[in]  lock_boundary Lock open borders
+   */
+  void Init(const std::vector<Vertex>& vertex,
+            const std::vector<Triangle>& tri,
+            const bool lock_boundary) {
+    const size_t n = vertex.size();
+    // Scale within the unit cube, quadrics are kept well conditioned
+    Vertex lo = vertex[0];
+    Vertex hi = vertex[0];
+    for (const auto& v : vertex) {
+      lo.x_ = std::min(lo.x_, v.x_);
+      lo.y_ = std::min(lo.y_, v.y_);
+      lo.z_ = std::min(lo.z_, v.z_);
+      hi.x_ = std::max(hi.x_, v.x_);
+      hi.y_ = std::max(hi.y_, v.y_);
+      hi.z_ = std::max(hi.z_, v.z_);
+    }
+    const Vertex ext = hi - lo;
+    const T extent = std::max(ext.x_, std::max(ext.y_, ext.z_));
+    const T scale = extent > T(0.0) ? T(1.0) / extent : T(1.0);
+    pos.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      pos[i] = (vertex[i] - lo) * scale;
+    }
+    // Weld identical positions, wedges form a circular list
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    auto less = [&](const int a, const int b) {
+      const Vertex& p = vertex[a];
+      const Vertex& q = vertex[b];
+      return (p.x_ < q.x_ || (p.x_ == q.x_ && (p.y_ < q.y_ ||
+              (p.y_ == q.y_ && p.z_ < q.z_))));
+    };
+    std::sort(order.begin(), order.end(), [&](const int a, const int b) {
+      return less(a, b) || (!less(b, a) && a < b);
+    });
+    weld.resize(n);
+    wedge.resize(n);
+    std::vector<int> n_wedge(n);
+    for (size_t i = 0; i < n;) {
+      size_t j = i + 1;
+      while (j < n && !less(order[i], order[j])) {
+        ++j;
+      }
+      for (size_t k = i; k < j; ++k) {
+        weld[order[k]] = order[i];
+        wedge[order[k]] = order[k + 1 < j ? k + 1 : i];
+        n_wedge[order[k]] = static_cast<int>(j - i);
+      }
+      i = j;
+    }
+    // Topology of the welded triangulation
+    std::vector<Triangle> welded(tri.size());
+    for (size_t f = 0; f < tri.size(); ++f) {
+      welded[f] = Triangle(weld[tri[f].x_], weld[tri[f].y_],
+                           weld[tri[f].z_]);
+    }
+    HalfEdge he;
+    he.Build(welded, n, true);
+    std::vector<unsigned char> locked(n, 0);
+    std::vector<unsigned char> n_open(n, 0);
+    std::vector<unsigned char> n_seam(n, 0);
+    auto inc = [](unsigned char* count) {
+      if (*count < 255) {
+        ++(*count);
+      }
+    };
+    next.assign(n, -1);
+    prev.assign(n, -1);
+    quadric.assign(n, Quadric<T>());
+    for (size_t f = 0; f < tri.size(); ++f) {
+      const int* c = &tri[f].x_;
+      const int* w = &welded[f].x_;
+      if (w[0] == w[1] || w[1] == w[2] || w[2] == w[0]) {
+        locked[c[0]] = locked[c[1]] = locked[c[2]] = 1;
+        continue;
+      }
+      // Face plane, area weighted
+      const Vertex& p0 = pos[c[0]];
+      Vertex nf = (pos[c[1]] - p0) ^ (pos[c[2]] - p0);
+      const T area = nf.Norm();
+      if (area <= T(0.0)) {
+        continue;
+      }
+      nf /= area;
+      const T d = -(nf * p0);
+      for (int k = 0; k < 3; ++k) {
+        quadric[w[k]].AddPlane(nf, d, T(0.5) * area);
+      }
+      // Borders and seams
+      for (int k = 0; k < 3; ++k) {
+        const int h = static_cast<int>(3 * f) + k;
+        const int o = c[k];
+        const int t = c[(k + 1) % 3];
+        const int g = he.Twin(h);
+        bool open = g < 0;
+        bool seam = false;
+        if (!open) {
+          const int go = (&tri[g / 3].x_)[g % 3];
+          const int gt = (&tri[g / 3].x_)[(g % 3 + 1) % 3];
+          seam = go != t || gt != o;
+        }
+        if (!open && !seam) {
+          continue;
+        }
+        inc(open ? &n_open[o] : &n_seam[o]);
+        inc(open ? &n_open[t] : &n_seam[t]);
+        next[o] = t;
+        prev[t] = o;
+        // Plane through the edge, orthogonal to the face
+        const Vertex e = pos[t] - pos[o];
+        const T len = e.Norm();
+        Vertex m = e ^ nf;
+        const T m_len = m.Norm();
+        if (m_len > T(0.0)) {
+          m /= m_len;
+          const T weight = T(kBoundaryWeight) * len * len;
+          quadric[w[k]].AddPlane(m, -(m * pos[o]), weight);
+          quadric[w[(k + 1) % 3]].AddPlane(m, -(m * pos[o]), weight);
+        }
+      }
+    }
+    for (const int h : he.get_non_manifold_edge()) {
+      locked[he.Origin(h)] = locked[he.Target(h)] = 1;
+    }
+    // Classify, a border has one incoming and one outgoing open edge, a
+    // seam two wedges with one incoming and one outgoing seam edge each
+    kind.assign(n, kLockedVertex);
+    for (size_t v = 0; v < n; ++v) {
+      if (locked[weld[v]] || locked[v]) {
+        continue;
+      }
+      if (n_wedge[v] == 1 && n_seam[v] == 0) {
+        if (n_open[v] == 0) {
+          kind[v] = kManifoldVertex;
+        } else if (n_open[v] == 2 && !lock_boundary) {
+          kind[v] = kBorderVertex;
+        }
+      } else if (n_wedge[v] == 2 && n_open[v] == 0 && n_seam[v] == 2) {
+        kind[v] = kSeamVertex;
+      }
+    }
+    // Both wedges of a seam vertex have to be movable
+    for (size_t v = 0; v < n; ++v) {
+      if (kind[v] == kSeamVertex && kind[wedge[v]] != kSeamVertex) {
+        locked[v] = 1;
+      }
+    }
+    for (size_t v = 0; v < n; ++v) {
+      if (locked[v] && kind[v] == kSeamVertex) {
+        kind[v] = kLockedVertex;
+      }
+    }
+    remap.resize(n);
+    std::iota(remap.begin(), remap.end(), 0);
+    lock.assign(n, 0);
+  }
+
+  /**
+   *  @name Cost
+   *  @fn T Cost(const int u, const int v) const
+   *  @brief  Squared relative error of collapsing u onto v
+   *  @param[in]  u Removed vertex
+   *  @param[in]  v Kept vertex
+   *  @return Error
+   */
+  T Cost(const int u, const int v) const {
+    const Quadric<T>& qu = quadric[weld[u]];
+    const Quadric<T>& qv = quadric[weld[v]];
+    const T w = qu.w + qv.w;
+    const T e = qu.Eval(pos[v]) + qv.Eval(pos[v]);
+    return w > T(0.0) ? e / w : e;
+  }
+
+  /**
+   *  @name Target
+   *  @fn int Target(const int u, const int v) const
+   *  @brief  Check if u can collapse onto v given their classification
+   *  @param[in]  u Removed vertex
+   *  @param[in]  v Kept vertex
+   *  @return For seams the vertex u's second wedge collapses onto, v
+   *          otherwise, -1 if the collapse is not allowed
+   */
+  int Target(const int u, const int v) const {
+    switch (kind[u]) {
+      case kManifoldVertex:
+        return v;
+      case kBorderVertex:
+        return next[u] == v || prev[u] == v ? v : -1;
+      case kSeamVertex: {
+        // The other side runs in the opposite direction
+        const int u2 = wedge[u];
+        const int v2 = (next[u] == v ? prev[u2] :
+                        (prev[u] == v ? next[u2] : -1));
+        return v2 >= 0 && v2 != v && weld[v2] == weld[v] ? v2 : -1;
+      }
+      default:
+        return -1;
+    }
+  }
+
+  /**
+   *  @name Flip
+   *  @fn bool Flip(const Connectivity& conn, const int u, const int v) const
+   *  @brief  Check if moving u onto v flips one of the remaining triangles
+   *  @param[in]  conn  Connectivity of the current triangulation
+   *  @param[in]  u     Removed vertex
+   *  @param[in]  v     Kept vertex
+   *  @return True if a triangle flips (or becomes degenerated)
+   */
+  bool Flip(const Connectivity& conn, const int u, const int v) const {
+    const Vertex& pu = pos[u];
+    const Vertex& pv = pos[v];
+    const auto row = conn[u];
+    for (size_t j = 0; j < row.size(); j += 2) {
+      const int a = remap[row[j]];
+      const int b = remap[row[j + 1]];
+      if (weld[a] == weld[v] || weld[b] == weld[v] || weld[a] == weld[b]) {
+        continue;
+      }
+      const Vertex n0 = (pos[a] - pu) ^ (pos[b] - pu);
+      const Vertex n1 = (pos[a] - pv) ^ (pos[b] - pv);
+      if (n0 * n1 <= T(0.0)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   *  @name Ring
+   *  @fn void Ring(const Connectivity& conn, const int u, const int v,
+                    std::vector<int>* ring, std::vector<int>* opposite) const
+   *  @brief  Welded one-ring of u gathered over all its wedges, sorted
+   *  @param[in]  conn      Connectivity of the current triangulation
+   *  @param[in]  u         Vertex
+   *  @param[in]  v         Other end of the edge being collapsed
+   *  @param[out] ring      Neighbouring positions
+   *  @param[out] opposite  Positions opposite to the edge (u, v), if not
+   *                        null
+   */
+  void Ring(const Connectivity& conn,
+            const int u,
+            const int v,
+            std::vector<int>* ring,
+            std::vector<int>* opposite) const {
+    ring->clear();
+    int w = u;
+    do {
+      const auto row = conn[w];
+      for (size_t j = 0; j < row.size(); j += 2) {
+        const int a = weld[remap[row[j]]];
+        const int b = weld[remap[row[j + 1]]];
+        ring->push_back(a);
+        ring->push_back(b);
+        if (opposite && (a == weld[v] || b == weld[v])) {
+          opposite->push_back(a == weld[v] ? b : a);
+        }
+      }
+      w = wedge[w];
+    } while (w != u);
+    std::sort(ring->begin(), ring->end());
+    ring->erase(std::unique(ring->begin(), ring->end()), ring->end());
+  }
+
+  /**
+   *  @name Link
+   *  @fn bool Link(const Connectivity& conn, const int u, const int v)
+   *  @brief  Link condition: the one-rings of u and v may only share the
+   *          vertices opposite to the edge (u, v), and not the edge between
+   *          them (i.e. tetrahedron), otherwise the collapse pinches the
+   *          surface (non-manifold edge or folded triangles).
+   *  @param[in]  conn  Connectivity of the current triangulation
+   *  @param[in]  u     Removed vertex
+   *  @param[in]  v     Kept vertex
+   *  @return True if the collapse keeps the topology
+   */
+  bool Link(const Connectivity& conn, const int u, const int v) {
+    opposite.clear();
+    this->Ring(conn, u, v, &ring_u, &opposite);
+    this->Ring(conn, v, u, &ring_v, nullptr);
+    auto it = ring_v.begin();
+    for (const int a : ring_u) {
+      it = std::lower_bound(it, ring_v.end(), a);
+      if (it == ring_v.end()) {
+        break;
+      }
+      if (*it == a && a != weld[u] && a != weld[v] &&
+          std::find(opposite.begin(), opposite.end(), a) == opposite.end()) {
+        return false;
+      }
+    }
+    if (opposite.size() == 2 && opposite[0] != opposite[1]) {
+      return !(HasFace(conn, u, opposite[0], opposite[1]) &&
+               HasFace(conn, v, opposite[0], opposite[1]));
+    }
+    return true;
+  }
+
+  /**
+   *  @name HasFace
+   *  @fn bool HasFace(const Connectivity& conn, const int u, const int a,
+                       const int b) const
+   *  @brief  Check if a triangle joins u (any of its wedges) to the
+   *          positions a and b
+   *  @param[in]  conn  Connectivity of the current triangulation
+   *  @param[in]  u     Vertex
+   *  @param[in]  a     First position (welded)
+   *  @param[in]  b     Second position (welded)
+   *  @return True if such a triangle exists
+   */
+  bool HasFace(const Connectivity& conn,
+               const int u,
+               const int a,
+               const int b) const {
+    int w = u;
+    do {
+      const auto row = conn[w];
+      for (size_t j = 0; j < row.size(); j += 2) {
+        const int p = weld[remap[row[j]]];
+        const int q = weld[remap[row[j + 1]]];
+        if ((p == a && q == b) || (p == b && q == a)) {
+          return true;
+        }
+      }
+      w = wedge[w];
+    } while (w != u);
+    return false;
+  }
+
+  /**
+   *  @name Relink
+   *  @fn void Relink(const int u, const int v)
+   *  @brief  Remove u from its border / seam loop after collapsing onto v
+   *  @param[in]  u Removed vertex
+   *  @param[in]  v Kept vertex, next or previous of u
+   */
+  void Relink(const int u, const int v) {
+    if (next[u] == v) {
+      const int p = prev[u];
+      prev[v] = p;
+      if (p >= 0) {
+        next[p] = v;
+      }
+    } else {
+      const int q = next[u];
+      next[v] = q;
+      if (q >= 0) {
+        prev[q] = v;
+      }
+    }
+  }
+
+  /**
+   *  @name Pass
+   *  @fn size_t Pass(const size_t n_target, const T max_error,
+                      std::vector<Triangle>* tri, T* error)
+   *  @brief  Apply the cheapest independent collapses
+   *  @param[in]      n_target  Target number of triangle
+   *  @param[in]      max_error Maximum squared relative error
+   *  @param[in,out]  tri       Triangles
+   *  @param[in,out]  error     Largest squared error so far
+   *  @return Number of collapse
+   */
+  size_t Pass(const size_t n_target,
+              const T max_error,
+              std::vector<Triangle>* tri,
+              T* error) {
+    const size_t n_tri = tri->size();
+    Connectivity conn;
+    conn.Build(*tri, pos.size(), true);
+    // Candidates, one per edge in the cheapest allowed direction
+    auto& pool = ThreadPool::Instance();
+    const size_t n_block = ((n_tri + kSimplifierBlockSize - 1) /
+                            kSimplifierBlockSize);
+    std::vector<std::vector<Collapse>> block(n_block);
+    pool.ParallelFor(0, n_block, 1, [&](const size_t begin, const size_t end) {
+      for (size_t b = begin; b < end; ++b) {
+        const size_t last = std::min(n_tri, (b + 1) * kSimplifierBlockSize);
+        for (size_t f = b * kSimplifierBlockSize; f < last; ++f) {
+          const int* c = &(*tri)[f].x_;
+          for (int k = 0; k < 3; ++k) {
+            const int a = c[k];
+            const int d = c[(k + 1) % 3];
+            if (weld[a] == weld[d] || (a > d && HasEdge(conn, d, a))) {
+              continue;
+            }
+            const bool ad = Target(a, d) >= 0;
+            const bool da = Target(d, a) >= 0;
+            if (!ad && !da) {
+              continue;
+            }
+            const T e_ad = ad ? Cost(a, d) : std::numeric_limits<T>::max();
+            const T e_da = da ? Cost(d, a) : std::numeric_limits<T>::max();
+            Collapse col;
+            col.u = e_ad <= e_da ? a : d;
+            col.v = e_ad <= e_da ? d : a;
+            col.error = static_cast<float>(std::min(e_ad, e_da));
+            block[b].push_back(col);
+          }
+        }
+      }
+    });
+    std::vector<Collapse> collapse;
+    for (auto& b : block) {
+      collapse.insert(collapse.end(), b.begin(), b.end());
+      std::vector<Collapse>().swap(b);
+    }
+    if (collapse.empty()) {
+      return 0;
+    }
+    std::vector<int> order;
+    SortCollapse(collapse, &order);
+    // Limit the pass to errors close to the ones expected to reach the
+    // target, most candidates are rejected because of their neighbours. If
+    // nothing fits, the whole error budget is used.
+    const size_t n_remove = n_tri - n_target;
+    const size_t goal = n_remove / 2;
+    T pass_limit = max_error;
+    if (goal < order.size()) {
+      pass_limit = std::min(pass_limit,
+                            T(1.5) * T(collapse[order[goal]].error));
+    }
+    std::vector<int> collapsed;
+    for (int attempt = 0; attempt < 2 && collapsed.empty(); ++attempt) {
+      const T limit = attempt == 0 ? pass_limit : max_error;
+      size_t n_removed = 0;
+      for (const int i : order) {
+        const Collapse& col = collapse[i];
+        if (T(col.error) > limit || n_removed >= n_remove) {
+          break;
+        }
+        const int u = col.u;
+        const int v = col.v;
+        if (lock[u] || lock[v]) {
+          continue;
+        }
+        const int v2 = Target(u, v);
+        const int u2 = kind[u] == kSeamVertex ? wedge[u] : -1;
+        if (u2 >= 0 && (lock[u2] || lock[v2] || Flip(conn, u2, v2))) {
+          continue;
+        }
+        if (Flip(conn, u, v) || !Link(conn, u, v)) {
+          continue;
+        }
+        remap[u] = v;
+        lock[u] = lock[v] = 1;
+        collapsed.push_back(u);
+        if (kind[u] != kManifoldVertex) {
+          this->Relink(u, v);
+        }
+        if (u2 >= 0) {
+          remap[u2] = v2;
+          lock[u2] = lock[v2] = 1;
+          collapsed.push_back(u2);
+          this->Relink(u2, v2);
+        }
+        quadric[weld[v]] += quadric[weld[u]];
+        *error = std::max(*error, T(col.error));
+        n_removed += kind[u] == kBorderVertex ? 1 : 2;
+      }
+      if (pass_limit >= max_error) {
+        break;
+      }
+    }
+    // Update triangles, drop the ones collapsed
+    pool.ParallelFor(0, n_tri, kSimplifierBlockSize, [&](const size_t begin,
+                                                         const size_t end) {
+      for (size_t f = begin; f < end; ++f) {
+        Triangle& t = (*tri)[f];
+        t.x_ = remap[t.x_];
+        t.y_ = remap[t.y_];
+        t.z_ = remap[t.z_];
+      }
+    });
+    tri->erase(std::remove_if(tri->begin(), tri->end(),
+                              [&](const Triangle& t) {
+      return (weld[t.x_] == weld[t.y_] || weld[t.y_] == weld[t.z_] ||
+              weld[t.z_] == weld[t.x_]);
+    }), tri->end());
+    for (const int u : collapsed) {
+      lock[remap[u]] = 0;
+      lock[u] = 0;
+      remap[u] = u;
+    }
+    return collapsed.size();
+  }
+};
+
+#pragma mark -
+#pragma mark Usage
+
+/*
+ *  @name BuildLOD
+ *  @fn static int BuildLOD(const std::vector<Vertex>& vertex,
+                            const std::vector<Triangle>& tri,
+                            const std::vector<Level>& level,
+                            const bool lock_boundary,
+                            std::vector<LOD>* lod)
+ *  @brief  Simplify a triangulation into a chain of LODs, each level
+ *          continues from the previous one
+ *  @param[in]  vertex        Positions
+ *  @param[in]  tri           Triangles
+ *  @param[in]  level         Criteria of each level, coarser and coarser
+ *  @param[in]  lock_boundary Keep open borders untouched
+ *  @param[out] lod           One triangulation per level
+ *  @return -1 if a triangle is out of range, 0 otherwise
+ */
+template<typename T>
+int MeshSimplifier<T>::BuildLOD(const std::vector<Vertex>& vertex,
+                                const std::vector<Triangle>& tri,
+                                const std::vector<Level>& level,
+                                const bool lock_boundary,
+                                std::vector<LOD>* lod) {
+  const int n = static_cast<int>(vertex.size());
+  for (const auto& t : tri) {
+    if (t.x_ < 0 || t.x_ >= n || t.y_ < 0 || t.y_ >= n ||
+        t.z_ < 0 || t.z_ >= n) {
+      return -1;
+    }
+  }
+  lod->assign(level.size(), LOD());
+  if (level.empty()) {
+    return 0;
+  }
+  SimplifierState<T> state;
+  if (!tri.empty()) {
+    state.Init(vertex, tri, lock_boundary);
+  }
+  std::vector<Triangle> current = tri;
+  T error = T(0.0);
+  for (size_t l = 0; l < level.size(); ++l) {
+    const T max_error = level[l].max_error * level[l].max_error;
+    while (current.size() > level[l].n_tri &&
+           state.Pass(level[l].n_tri, max_error, &current, &error) != 0) {
+    }
+    (*lod)[l].tri = current;
+    (*lod)[l].error = std::sqrt(error);
+  }
+  return 0;
+}
+
+/*
+ *  @name Simplify
+ *  @fn static int Simplify(const std::vector<Vertex>& vertex,
+                            const size_t n_tri,
+                            const T max_error,
+                            const bool lock_boundary,
+                            std::vector<Triangle>* tri,
+                            T* error)
+ *  @brief  Simplify a triangulation in place, single level
+ *  @param[in]      vertex        Positions
+ *  @param[in]      n_tri         Target number of triangle
+ *  @param[in]      max_error     Maximum relative error
+ *  @param[in]      lock_boundary Keep open borders untouched
+ *  @param[in,out]  tri           Triangles to simplify
+ *  @param[out]     error         Error introduced (optional)
+ *  @return -1 if a triangle is out of range, 0 otherwise
+ */
+template<typename T>
+int MeshSimplifier<T>::Simplify(const std::vector<Vertex>& vertex,
+                                const size_t n_tri,
+                                const T max_error,
+                                const bool lock_boundary,
+                                std::vector<Triangle>* tri,
+                                T* error) {
+  std::vector<LOD> lod;
+  if (BuildLOD(vertex, *tri, std::vector<Level>(1, Level(n_tri, max_error)),
+               lock_boundary, &lod)) {
+    return -1;
+  }
+  tri->swap(lod[0].tri);
+  if (error) {
+    *error = lod[0].error;
+  }
+  return 0;
+}
+
+#pragma mark -
+#pragma mark Declaration
+
+/** Float simplifier */
+template class MeshSimplifier<float>;
+/** Double simplifier */
+template class MeshSimplifier<double>;
+
+}  // namespace OGLKit
@@ -0,0 +1,1944 @@
+/**
+ *  @file   test_mesh.cpp
+ *  @brief  Unit test for mesh container
+ *
+ *  @author Christophe Ecabert
+ *  @date   16.10.26
+ *  Copyright © 2026 Christophe Ecabert. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include <utime.h>
+#include <zlib.h>
+
+#include "gtest/gtest.h"
+
+#include "oglkit/geometry/bounding_box.hpp"
+#include "oglkit/geometry/connectivity.hpp"
+#include "oglkit/geometry/gltf.hpp"
+#include "oglkit/geometry/half_edge.hpp"
+#include "oglkit/geometry/mesh.hpp"
+#include "oglkit/geometry/mesh_codec.hpp"
+#include "oglkit/geometry/mesh_optimizer.hpp"
+#include "oglkit/geometry/mesh_partitioner.hpp"
+#include "oglkit/geometry/mesh_simplifier.hpp"
+
+using Mesh = OGLKit::Mesh<float>;
+
+/**
+ *  @name Near
+ *  @fn bool Near(const Mesh::Normal& a, const Mesh::Normal& b)
+ *  @brief  Compare two vectors up to rounding errors
+ *  @param[in]  a First vector
+ *  @param[in]  b Second vector
+ *  @return True if every component matches
+ */
+bool Near(const Mesh::Normal& a, const Mesh::Normal& b) {
+  return (std::abs(a.x_ - b.x_) < 1e-5f && std::abs(a.y_ - b.y_) < 1e-5f &&
+          std::abs(a.z_ - b.z_) < 1e-5f);
+}
+
+/**
+ *  @name NearTangent
+ *  @fn bool NearTangent(const Mesh::Tangent& a, const Mesh::Tangent& b)
+ *  @brief  Compare two tangents up to rounding errors
+ *  @param[in]  a First tangent
+ *  @param[in]  b Second tangent
+ *  @return True if direction and handedness match
+ */
+bool NearTangent(const Mesh::Tangent& a, const Mesh::Tangent& b) {
+  return (Near(Mesh::Normal(a.x_, a.y_, a.z_),
+               Mesh::Normal(b.x_, b.y_, b.z_)) && a.w_ == b.w_);
+}
+
+/**
+ *  @name WriteFile
+ *  @fn void WriteFile(const std::string& path, const std::string& content)
+ *  @brief  Dump a string into a file
+ *  @param[in]  path      Path to the file
+ *  @param[in]  content   File's content
+ */
+void WriteFile(const std::string& path, const std::string& content) {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary);
+  stream << content;
+}
+
+/**
+ *  @name WriteGzipFile
+ *  @fn void WriteGzipFile(const std::string& path, const std::string& content,
+                           const size_t n_member)
+ *  @brief  Dump a string into a gzip file
+ *  @param[in]  path      Path to the file
+ *  @param[in]  content   File's content
+ *  @param[in]  n_member  Number of concatenated gzip member to split into
+ */
+void WriteGzipFile(const std::string& path,
+                   const std::string& content,
+                   const size_t n_member) {
+  std::remove(path.c_str());
+  for (size_t m = 0; m < n_member; ++m) {
+    const size_t first = (m * content.size()) / n_member;
+    const size_t last = ((m + 1) * content.size()) / n_member;
+    gzFile file = gzopen(path.c_str(), "ab");
+    gzwrite(file, content.data() + first, static_cast<unsigned>(last - first));
+    gzclose(file);
+  }
+}
+
+/**
+ *  @name AppendRaw
+ *  @fn void AppendRaw(const V value, const bool big_endian, std::string* buffer)
+ *  @brief  Append the binary representation of a value to a buffer
+ *  @param[in]  value       Value to write
+ *  @param[in]  big_endian  If true, use big endian byte order
+ *  @param[out] buffer      Buffer to append to
+ */
+template<typename V>
+void AppendRaw(const V value, const bool big_endian, std::string* buffer) {
+  const uint16_t one = 1;
+  const bool host_le = *reinterpret_cast<const uint8_t*>(&one) == 1;
+  char bytes[sizeof(V)];
+  std::memcpy(bytes, &value, sizeof(V));
+  if (big_endian == host_le) {
+    std::reverse(bytes, bytes + sizeof(V));
+  }
+  buffer->append(bytes, sizeof(V));
+}
+
+/**
+ *  @name BinaryPLY
+ *  @fn std::string BinaryPLY(const bool big_endian, const bool quad)
+ *  @brief  Build a binary unit square with colored vertex
+ *  @param[in]  big_endian  If true, use big endian byte order
+ *  @param[in]  quad        If true the square is a single polygon, otherwise
+ *                          two triangles
+ *  @return File's content
+ */
+std::string BinaryPLY(const bool big_endian, const bool quad) {
+  std::string ply = "ply\n";
+  ply += big_endian ? "format binary_big_endian 1.0\n" :
+                      "format binary_little_endian 1.0\n";
+  ply += "comment generated by test_mesh\n"
+         "element vertex 4\n"
+         "property float x\n"
+         "property float y\n"
+         "property float z\n"
+         "property uchar red\n"
+         "property uchar green\n"
+         "property uchar blue\n"
+         "element edge 1\n"
+         "property int vertex1\n"
+         "property int vertex2\n";
+  ply += quad ? "element face 1\n" : "element face 2\n";
+  ply += "property list uchar int vertex_indices\n"
+         "end_header\n";
+  const float pts[] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                       1.f, 1.f, 0.f, 0.f, 1.f, 0.5f};
+  for (int i = 0; i < 4; ++i) {
+    AppendRaw(pts[3 * i], big_endian, &ply);
+    AppendRaw(pts[(3 * i) + 1], big_endian, &ply);
+    AppendRaw(pts[(3 * i) + 2], big_endian, &ply);
+    AppendRaw(uint8_t(255), big_endian, &ply);
+    AppendRaw(uint8_t(i * 85), big_endian, &ply);
+    AppendRaw(uint8_t(0), big_endian, &ply);
+  }
+  AppendRaw(int32_t(0), big_endian, &ply);
+  AppendRaw(int32_t(2), big_endian, &ply);
+  const int32_t idx[] = {0, 1, 2, 0, 2, 3};
+  if (quad) {
+    AppendRaw(uint8_t(4), big_endian, &ply);
+    for (int32_t k = 0; k < 4; ++k) {
+      AppendRaw(k, big_endian, &ply);
+    }
+  } else {
+    for (int f = 0; f < 2; ++f) {
+      AppendRaw(uint8_t(3), big_endian, &ply);
+      for (int k = 0; k < 3; ++k) {
+        AppendRaw(idx[(3 * f) + k], big_endian, &ply);
+      }
+    }
+  }
+  return ply;
+}
+
+TEST(MeshOBJ, LoadSimple) {
+  WriteFile("quad.obj",
+            "# comment\n"
+            "v 0 0 0\n"
+            "v 2 0 0\r\n"
+            "v 2 2.0 0\n"
+            "v\t0 2 -4e0\n"
+            "\n"
+            "f 1 2 3\n"
+            "f 1 3 -1\n");
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("quad.obj"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), 4);
+  ASSERT_EQ(mesh.get_triangle().size(), 2);
+  const auto& tri = mesh.get_triangle()[1];
+  EXPECT_EQ(tri.x_, 0);
+  EXPECT_EQ(tri.y_, 2);
+  EXPECT_EQ(tri.z_, 3);
+  // Mesh is centered at load time, cog = (1, 1, -1)
+  const auto& v = mesh.get_vertex()[3];
+  EXPECT_FLOAT_EQ(v.x_, -1.f);
+  EXPECT_FLOAT_EQ(v.y_, 1.f);
+  EXPECT_FLOAT_EQ(v.z_, -3.f);
+  EXPECT_FLOAT_EQ(mesh.bbox().min_.z_, -3.f);
+  EXPECT_FLOAT_EQ(mesh.bbox().max_.x_, 1.f);
+  std::remove("quad.obj");
+}
+
+TEST(MeshOBJ, LoadMalformed) {
+  WriteFile("bad.obj", "v 0 0\nf 1 2 3\n");
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("bad.obj"), -1);
+  std::remove("bad.obj");
+}
+
+TEST(MeshOBJ, LoadFaceRecord) {
+  // Two quads sharing an edge, the shared edge is a texture seam
+  WriteFile("seam.obj",
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\n"
+            "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\nvt 0.5 0\nvt 0.5 1\n"
+            "vn 0 0 1\n"
+            "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+            "f 2/5/1 5/2/1 6/3/-1 3/6/-1 # comment\n");
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("seam.obj"), 0);
+  // 6 positions + 2 duplicated along the seam
+  ASSERT_EQ(mesh.get_vertex().size(), 8);
+  ASSERT_EQ(mesh.get_normal().size(), 8);
+  ASSERT_EQ(mesh.get_tex_coord().size(), 8);
+  ASSERT_EQ(mesh.get_triangle().size(), 4);
+  // Fan triangulation
+  const auto& t0 = mesh.get_triangle()[0];
+  const auto& t1 = mesh.get_triangle()[1];
+  EXPECT_EQ(t0.x_, 0);
+  EXPECT_EQ(t0.y_, 1);
+  EXPECT_EQ(t0.z_, 2);
+  EXPECT_EQ(t1.x_, 0);
+  EXPECT_EQ(t1.y_, 2);
+  EXPECT_EQ(t1.z_, 3);
+  // Seam vertex share the position but not the texture coordinate
+  const auto& t2 = mesh.get_triangle()[2];
+  EXPECT_EQ(t2.x_, 4);
+  EXPECT_EQ(mesh.get_vertex()[4], mesh.get_vertex()[1]);
+  EXPECT_FLOAT_EQ(mesh.get_tex_coord()[4].x_, 0.5f);
+  EXPECT_FLOAT_EQ(mesh.get_tex_coord()[1].x_, 1.f);
+  EXPECT_FLOAT_EQ(mesh.get_normal()[7].z_, 1.f);
+  std::remove("seam.obj");
+}
+
+TEST(MeshOBJ, LoadFaceOutOfRange) {
+  WriteFile("range.obj", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1//1 2//1 3//1\n");
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("range.obj"), -1);
+  std::remove("range.obj");
+}
+
+TEST(MeshOBJ, LoadParallel) {
+  // Grid large enough to be split into chunks, with relative indices
+  const int n = 200;
+  std::ostringstream str;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      str << "v " << i << " " << j << " " << (i * j) % 7 << "\n";
+      str << "vn 0 0 1\n";
+    }
+  }
+  for (int i = 0; i < n - 1; ++i) {
+    for (int j = 0; j < n - 1; ++j) {
+      const int a = (i * n) + j + 1;
+      str << "f " << a << " " << a + 1 << " " << a + n << "\n";
+    }
+    str << "v 0.5 0.5 0.5\nv 1.5 0.5 0.5\nv 0.5 1.5 0.5\nf -3 -2 -1\n";
+  }
+  for (int i = 0; i < 2000; ++i) {
+    str << "# padding to get past the parallel threshold\n";
+  }
+  WriteFile("grid.obj", str.str());
+  Mesh serial, parallel;
+  serial.set_parallel_loading(false);
+  EXPECT_EQ(serial.Load("grid.obj"), 0);
+  EXPECT_EQ(parallel.Load("grid.obj"), 0);
+  ASSERT_EQ(serial.get_vertex().size(), parallel.get_vertex().size());
+  ASSERT_EQ(serial.get_normal().size(), parallel.get_normal().size());
+  ASSERT_EQ(serial.get_triangle().size(), parallel.get_triangle().size());
+  EXPECT_EQ(serial.get_triangle().size(), (n - 1) * n);
+  for (size_t i = 0; i < serial.get_vertex().size(); ++i) {
+    EXPECT_EQ(serial.get_vertex()[i], parallel.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < serial.get_triangle().size(); ++i) {
+    EXPECT_EQ(serial.get_triangle()[i], parallel.get_triangle()[i]);
+  }
+  // Relative face refers to the last three vertices read before it
+  const auto& tri = parallel.get_triangle()[n - 1];
+  EXPECT_EQ(tri.x_, n * n);
+  EXPECT_EQ(tri.z_, (n * n) + 2);
+  EXPECT_EQ(serial.bbox().min_, parallel.bbox().min_);
+  EXPECT_EQ(serial.bbox().max_, parallel.bbox().max_);
+  std::remove("grid.obj");
+}
+
+TEST(MeshOBJ, SaveRoundTrip) {
+  WriteFile("quad.obj",
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0.1\n"
+            "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+            "vn 0 0 1\nvn 0 0 1\nvn 0 0.6 0.8\nvn 0 0 1\n"
+            "f 1/1/1 2/2/2 3/3/3 4/4/4\n");
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("quad.obj"), 0);
+  EXPECT_EQ(mesh.Save("out.obj"), 0);
+  Mesh other;
+  ASSERT_EQ(other.Load("out.obj"), 0);
+  ASSERT_EQ(other.get_vertex().size(), 4);
+  ASSERT_EQ(other.get_normal().size(), 4);
+  ASSERT_EQ(other.get_tex_coord().size(), 4);
+  ASSERT_EQ(other.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(mesh.get_normal()[i], other.get_normal()[i]);
+    EXPECT_EQ(mesh.get_tex_coord()[i], other.get_tex_coord()[i]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(mesh.get_triangle()[i], other.get_triangle()[i]);
+  }
+  // Positions only
+  {
+    auto edit = mesh.Edit();
+    edit.normal().clear();
+    edit.tex_coord().clear();
+  }
+  EXPECT_EQ(mesh.Save("out.obj"), 0);
+  ASSERT_EQ(other.Load("out.obj"), 0);
+  EXPECT_EQ(other.get_vertex().size(), 4);
+  EXPECT_EQ(other.get_normal().size(), 0);
+  std::remove("quad.obj");
+  std::remove("out.obj");
+}
+
+TEST(MeshPLY, LoadBinary) {
+  WriteFile("square.ply",
+            "ply\n"
+            "format ascii 1.0\n"
+            "element vertex 4\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "element face 2\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n"
+            "0 0 0\n1 0 0\n1 1 0\n0 1 0.5\n"
+            "3 0 1 2\n3 0 2 3\n");
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh ascii, binary;
+  EXPECT_EQ(ascii.Load("square.ply"), 0);
+  EXPECT_EQ(binary.Load("square_bin.ply"), 0);
+  ASSERT_EQ(binary.get_vertex().size(), 4);
+  ASSERT_EQ(binary.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(ascii.get_vertex()[i], binary.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(ascii.get_triangle()[i], binary.get_triangle()[i]);
+  }
+  ASSERT_EQ(binary.get_vertex_color().size(), 4);
+  EXPECT_FLOAT_EQ(binary.get_vertex_color()[1].x_, 1.f);
+  EXPECT_FLOAT_EQ(binary.get_vertex_color()[1].y_, 1.f / 3.f);
+  EXPECT_FLOAT_EQ(binary.get_vertex_color()[1].w_, 1.f);
+  EXPECT_FLOAT_EQ(binary.bbox().max_.z_ - binary.bbox().min_.z_, 0.5f);
+  std::remove("square.ply");
+  std::remove("square_bin.ply");
+}
+
+TEST(MeshPLY, LoadBinaryPolygon) {
+  WriteFile("quad_le.ply", BinaryPLY(false, false));
+  WriteFile("quad_be.ply", BinaryPLY(true, true));
+  Mesh tri, quad;
+  EXPECT_EQ(tri.Load("quad_le.ply"), 0);
+  EXPECT_EQ(quad.Load("quad_be.ply"), 0);
+  ASSERT_EQ(quad.get_vertex().size(), 4);
+  ASSERT_EQ(quad.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(tri.get_vertex()[i], quad.get_vertex()[i]);
+  }
+  // Polygons are triangulated as fan
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(tri.get_triangle()[i], quad.get_triangle()[i]);
+  }
+  std::remove("quad_le.ply");
+  std::remove("quad_be.ply");
+}
+
+TEST(MeshPLY, LoadBinaryTruncated) {
+  std::string ply = BinaryPLY(false, false);
+  ply.resize(ply.size() - 5);
+  WriteFile("truncated.ply", ply);
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("truncated.ply"), -1);
+  std::remove("truncated.ply");
+}
+
+TEST(MeshPLY, LoadBinaryVertexList) {
+  // Vertex records holding a list do not have a fixed stride
+  std::string ply = "ply\n"
+                    "format binary_little_endian 1.0\n"
+                    "element vertex 4\n"
+                    "property float x\n"
+                    "property list uchar float extra\n"
+                    "property float y\n"
+                    "property float z\n"
+                    "property uchar red\n"
+                    "property uchar green\n"
+                    "property uchar blue\n"
+                    "element face 2\n"
+                    "property list uchar int vertex_indices\n"
+                    "end_header\n";
+  const float pts[] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+                       1.f, 1.f, 0.f, 0.f, 1.f, 0.5f};
+  for (int i = 0; i < 4; ++i) {
+    AppendRaw(pts[3 * i], false, &ply);
+    AppendRaw(uint8_t(i), false, &ply);
+    for (int k = 0; k < i; ++k) {
+      AppendRaw(-1.f, false, &ply);
+    }
+    AppendRaw(pts[(3 * i) + 1], false, &ply);
+    AppendRaw(pts[(3 * i) + 2], false, &ply);
+    AppendRaw(uint8_t(255), false, &ply);
+    AppendRaw(uint8_t(i * 85), false, &ply);
+    AppendRaw(uint8_t(0), false, &ply);
+  }
+  const int32_t idx[] = {0, 1, 2, 0, 2, 3};
+  for (int f = 0; f < 2; ++f) {
+    AppendRaw(uint8_t(3), false, &ply);
+    for (int k = 0; k < 3; ++k) {
+      AppendRaw(idx[(3 * f) + k], false, &ply);
+    }
+  }
+  WriteFile("list.ply", ply);
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh list, ref;
+  EXPECT_EQ(list.Load("list.ply"), 0);
+  EXPECT_EQ(ref.Load("square_bin.ply"), 0);
+  ASSERT_EQ(list.get_vertex().size(), 4);
+  ASSERT_EQ(list.get_vertex_color().size(), 4);
+  ASSERT_EQ(list.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(ref.get_vertex()[i], list.get_vertex()[i]);
+    EXPECT_EQ(ref.get_vertex_color()[i], list.get_vertex_color()[i]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(ref.get_triangle()[i], list.get_triangle()[i]);
+  }
+  EXPECT_EQ(ref.bbox().min_, list.bbox().min_);
+  EXPECT_EQ(ref.bbox().max_, list.bbox().max_);
+  // Truncated inside the last vertex record
+  ply.resize(ply.size() - 30);
+  WriteFile("list.ply", ply);
+  EXPECT_EQ(list.Load("list.ply"), -1);
+  std::remove("list.ply");
+  std::remove("square_bin.ply");
+}
+
+TEST(MeshPLY, LoadAsciiParallel) {
+  // Grid large enough to be split into chunks
+  const int n = 300;
+  std::ostringstream str;
+  str << "ply\nformat ascii 1.0\ncomment grid\n";
+  str << "element vertex " << n * n << "\n";
+  str << "property double x\nproperty double y\nproperty double z\n";
+  str << "property float nx\nproperty float ny\nproperty float nz\n";
+  str << "element face " << (n - 1) * (n - 1) << "\n";
+  str << "property list uchar int vertex_indices\nend_header\n";
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      str << i << " " << j << " " << (i * j) % 7 << " 0 0 1\n";
+    }
+  }
+  for (int i = 0; i < n - 1; ++i) {
+    for (int j = 0; j < n - 1; ++j) {
+      const int a = (i * n) + j;
+      str << "4 " << a << " " << a + 1 << " " << a + n + 1 << " " << a + n;
+      str << "\r\n";
+    }
+  }
+  WriteFile("grid.ply", str.str());
+  Mesh serial, parallel;
+  serial.set_parallel_loading(false);
+  EXPECT_EQ(serial.Load("grid.ply"), 0);
+  EXPECT_EQ(parallel.Load("grid.ply"), 0);
+  ASSERT_EQ(serial.get_vertex().size(), n * n);
+  ASSERT_EQ(parallel.get_vertex().size(), n * n);
+  ASSERT_EQ(serial.get_normal().size(), n * n);
+  ASSERT_EQ(serial.get_triangle().size(), 2 * (n - 1) * (n - 1));
+  ASSERT_EQ(parallel.get_triangle().size(), 2 * (n - 1) * (n - 1));
+  for (size_t i = 0; i < serial.get_vertex().size(); ++i) {
+    EXPECT_EQ(serial.get_vertex()[i], parallel.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < serial.get_triangle().size(); ++i) {
+    EXPECT_EQ(serial.get_triangle()[i], parallel.get_triangle()[i]);
+  }
+  const auto& tri = parallel.get_triangle()[1];
+  EXPECT_EQ(tri.x_, 0);
+  EXPECT_EQ(tri.y_, n + 1);
+  EXPECT_EQ(tri.z_, n);
+  EXPECT_EQ(serial.bbox().min_, parallel.bbox().min_);
+  EXPECT_EQ(serial.bbox().max_, parallel.bbox().max_);
+  std::remove("grid.ply");
+}
+
+TEST(MeshPLY, LoadAsciiUnaligned) {
+  const std::string header = "ply\n"
+                             "format ascii 1.0\n"
+                             "element vertex 4\n"
+                             "property float x\n"
+                             "property float y\n"
+                             "property float z\n"
+                             "element edge 1\n"
+                             "property int vertex1\n"
+                             "property int vertex2\n"
+                             "element face 2\n"
+                             "property list uchar int vertex_indices\n"
+                             "end_header\n";
+  WriteFile("square.ply",
+            header + "0 0 0\n1 0 0\n1 1 0\n0 1 0.5\n0 2\n"
+                     "3 0 1 2\n3 0 2 3\n");
+  // Records sharing lines
+  WriteFile("shared.ply",
+            header + "0 0 0 1 0 0\n1 1 0\n0 1 0.5 0 2\n"
+                     "3 0 1 2 3 0 2 3\n");
+  // Records spanning lines, from the faces on
+  WriteFile("spanning.ply",
+            header + "0 0 0\n1 0 0\n1 1 0\n0 1 0.5\n0 2\n"
+                     "3\n0 1 2\n\n3 0\n2 3\n");
+  Mesh ref;
+  ASSERT_EQ(ref.Load("square.ply"), 0);
+  for (const char* path : {"shared.ply", "spanning.ply"}) {
+    for (const bool parallel : {false, true}) {
+      Mesh mesh;
+      mesh.set_parallel_loading(parallel);
+      EXPECT_EQ(mesh.Load(path), 0);
+      ASSERT_EQ(mesh.get_vertex().size(), 4);
+      ASSERT_EQ(mesh.get_triangle().size(), 2);
+      for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(ref.get_vertex()[i], mesh.get_vertex()[i]);
+      }
+      for (size_t i = 0; i < 2; ++i) {
+        EXPECT_EQ(ref.get_triangle()[i], mesh.get_triangle()[i]);
+      }
+      EXPECT_EQ(ref.bbox().min_, mesh.bbox().min_);
+      EXPECT_EQ(ref.bbox().max_, mesh.bbox().max_);
+    }
+  }
+  std::remove("square.ply");
+  std::remove("shared.ply");
+  std::remove("spanning.ply");
+}
+
+TEST(MeshPLY, LoadAsciiMalformed) {
+  WriteFile("bad.ply",
+            "ply\n"
+            "format ascii 1.0\n"
+            "element vertex 3\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "end_header\n"
+            "0 0 0\n1 0 0\n1 1\n");
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("bad.ply"), -1);
+  std::remove("bad.ply");
+}
+
+TEST(MeshPLY, SaveRoundTrip) {
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square_bin.ply"), 0);
+  {
+    auto edit = mesh.Edit();
+    edit.normal().assign(4, Mesh::Normal(0.f, 0.f, 1.f));
+    edit.vertex()[3].z_ = 0.1f;
+  }
+  for (const bool binary : {true, false}) {
+    const std::string path = binary ? "out_bin.ply" : "out_ascii.ply";
+    EXPECT_EQ(mesh.Save(path, binary), 0);
+    Mesh other;
+    ASSERT_EQ(other.Load(path), 0);
+    ASSERT_EQ(other.get_vertex().size(), 4);
+    ASSERT_EQ(other.get_normal().size(), 4);
+    ASSERT_EQ(other.get_vertex_color().size(), 4);
+    ASSERT_EQ(other.get_triangle().size(), 2);
+    // Loaded mesh is centered again
+    const auto shift = mesh.get_vertex()[0] - other.get_vertex()[0];
+    for (size_t i = 0; i < 4; ++i) {
+      const auto v = other.get_vertex()[i] + shift;
+      EXPECT_NEAR(mesh.get_vertex()[i].x_, v.x_, 1e-6f);
+      EXPECT_NEAR(mesh.get_vertex()[i].y_, v.y_, 1e-6f);
+      EXPECT_NEAR(mesh.get_vertex()[i].z_, v.z_, 1e-6f);
+      EXPECT_EQ(mesh.get_normal()[i], other.get_normal()[i]);
+      EXPECT_EQ(mesh.get_vertex_color()[i], other.get_vertex_color()[i]);
+    }
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_EQ(mesh.get_triangle()[i], other.get_triangle()[i]);
+    }
+    std::remove(path.c_str());
+  }
+  std::remove("square_bin.ply");
+}
+
+TEST(MeshCache, SaveLoad) {
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square_bin.ply"), 0);
+  mesh.Edit().normal().assign(4, Mesh::Normal(0.f, 0.f, 1.f));
+  EXPECT_EQ(mesh.Save("square.oglmesh"), 0);
+  Mesh other;
+  ASSERT_EQ(other.Load("square.oglmesh"), 0);
+  ASSERT_EQ(other.get_vertex().size(), 4);
+  ASSERT_EQ(other.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+    EXPECT_EQ(mesh.get_normal()[i], other.get_normal()[i]);
+    EXPECT_EQ(mesh.get_vertex_color()[i], other.get_vertex_color()[i]);
+  }
+  EXPECT_EQ(mesh.get_triangle()[1], other.get_triangle()[1]);
+  EXPECT_EQ(mesh.bbox().min_, other.bbox().min_);
+  EXPECT_EQ(mesh.bbox().max_, other.bbox().max_);
+  // Scalar type must match
+  OGLKit::Mesh<double> dmesh;
+  EXPECT_EQ(dmesh.Load("square.oglmesh"), -1);
+  // Corrupted
+  WriteFile("bad.oglmesh", "OGLKMSH");
+  EXPECT_EQ(other.Load("bad.oglmesh"), -1);
+  std::remove("square_bin.ply");
+  std::remove("square.oglmesh");
+  std::remove("bad.oglmesh");
+}
+
+TEST(MeshCache, Sidecar) {
+  WriteFile("tri.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  Mesh mesh;
+  mesh.set_use_cache(true);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  std::ifstream cache("tri.obj.oglmesh");
+  EXPECT_TRUE(cache.good());
+  // Source edited but older than the cache, cached data are used
+  WriteFile("tri.obj", "v 0 0 0\nv 2 0 0\nv 0 2 0\nv 1 1 1\nf 1 2 3\n");
+  struct utimbuf old_time = {0, 0};
+  utime("tri.obj", &old_time);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 3);
+  EXPECT_EQ(mesh.get_triangle().size(), 1);
+  // Source newer than the cache, reparsed and cache refreshed
+  struct utimbuf new_time = {4000000000, 4000000000};
+  utime("tri.obj", &new_time);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 4);
+  Mesh other;
+  ASSERT_EQ(other.Load("tri.obj.oglmesh"), 0);
+  EXPECT_EQ(other.get_vertex().size(), 4);
+  // Cache written with other settings is stale, even if not older
+  WriteFile("tri.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  utime("tri.obj", &old_time);
+  mesh.set_post_process(Mesh::kNoPostProcess);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), 3);
+  EXPECT_EQ(mesh.get_vertex()[1], Mesh::Vertex(1.f, 0.f, 0.f));
+  WriteFile("tri.obj", "v 0 0 0\nv 2 0 0\nv 0 2 0\nf 1 2 3\n");
+  utime("tri.obj", &old_time);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  EXPECT_EQ(mesh.get_vertex()[1], Mesh::Vertex(1.f, 0.f, 0.f));
+  mesh.set_compact_cache(true);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  EXPECT_EQ(mesh.get_vertex()[1], Mesh::Vertex(2.f, 0.f, 0.f));
+  std::remove("tri.obj");
+  std::remove("tri.obj.oglmesh");
+}
+
+TEST(MeshCache, InvalidSidecar) {
+  // Cache with colors and an out of range index, valid up to the triangles
+  WriteFile("tri.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  Mesh mesh;
+  mesh.set_use_cache(true);
+  ASSERT_EQ(mesh.Load("tri.obj"), 0);
+  mesh.Edit().vertex_color().assign(3, Mesh::Color(1.f, 0.f, 0.f, 1.f));
+  mesh.Edit().triangle()[0].z_ = 7;
+  EXPECT_EQ(mesh.Save("tri.obj.oglmesh"), 0);
+  struct utimbuf old_time = {0, 0};
+  utime("tri.obj", &old_time);
+  // Rejected, the source is parsed without the cached attributes
+  Mesh other;
+  other.set_use_cache(true);
+  ASSERT_EQ(other.Load("tri.obj"), 0);
+  EXPECT_EQ(other.get_vertex().size(), 3);
+  EXPECT_EQ(other.get_triangle()[0].z_, 2);
+  EXPECT_TRUE(other.get_vertex_color().empty());
+  std::remove("tri.obj");
+  std::remove("tri.obj.oglmesh");
+}
+
+TEST(MeshCodec, RoundTrip) {
+  using Codec = OGLKit::MeshCodec<float>;
+  std::srand(7);
+  std::vector<Mesh::Vertex> vertex(1000);
+  std::vector<Mesh::Normal> normal(1000);
+  std::vector<Mesh::Triangle> tri(500);
+  AABB<float> bbox(-2.f, 3.f, -1.f, 1.f, 0.f, 10.f);
+  for (size_t i = 0; i < vertex.size(); ++i) {
+    const float r[] = {float(std::rand()) / RAND_MAX,
+                       float(std::rand()) / RAND_MAX,
+                       float(std::rand()) / RAND_MAX};
+    vertex[i] = Mesh::Vertex(-2.f + 5.f * r[0], -1.f + 2.f * r[1], 10.f * r[2]);
+    normal[i] = Mesh::Normal(r[0] - 0.5f, r[1] - 0.5f, r[2] - 0.5f);
+    normal[i].Normalize();
+  }
+  for (size_t i = 0; i < tri.size(); ++i) {
+    tri[i] = Mesh::Triangle(std::rand() % 1000, std::rand() % 1000, i);
+  }
+  Codec::Report report;
+  std::vector<uint16_t> q_vertex;
+  std::vector<int16_t> q_normal;
+  std::vector<uint8_t> q_tri;
+  Codec::EncodePosition(vertex, bbox, &q_vertex, &report);
+  Codec::EncodeNormal(normal, &q_normal, &report);
+  Codec::EncodeTriangle(tri, &q_tri, &report);
+  EXPECT_LE(report.position_error, report.position_bound * 1.001f);
+  EXPECT_NEAR(report.position_bound, 10.f / (2.f * 65535.f), 1e-7f);
+  EXPECT_LT(report.normal_error, 0.01f);
+  EXPECT_LT(report.encoded_size, report.raw_size / 2);
+  // Indices are lossless
+  std::vector<Mesh::Triangle> decoded;
+  ASSERT_EQ(Codec::DecodeTriangle(q_tri.data(), q_tri.size(), &decoded), 0);
+  ASSERT_EQ(decoded.size(), tri.size());
+  for (size_t i = 0; i < tri.size(); ++i) {
+    EXPECT_EQ(decoded[i], tri[i]);
+  }
+  EXPECT_EQ(Codec::DecodeTriangle(q_tri.data(), q_tri.size() - 1, &decoded),
+            -1);
+}
+
+TEST(MeshCodec, CompactCache) {
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square_bin.ply"), 0);
+  mesh.Edit().normal().assign(4, Mesh::Normal(0.f, 0.6f, -0.8f));
+  mesh.set_compact_cache(true);
+  EXPECT_EQ(mesh.Save("square.oglmesh"), 0);
+  Mesh other;
+  ASSERT_EQ(other.Load("square.oglmesh"), 0);
+  ASSERT_EQ(other.get_vertex().size(), 4);
+  ASSERT_EQ(other.get_normal().size(), 4);
+  ASSERT_EQ(other.get_triangle().size(), 2);
+  for (size_t i = 0; i < 4; ++i) {
+    const auto d = mesh.get_vertex()[i] - other.get_vertex()[i];
+    EXPECT_LT(std::abs(d.x_) + std::abs(d.y_) + std::abs(d.z_), 1e-4f);
+    EXPECT_GT(mesh.get_normal()[i] * other.get_normal()[i], 0.99999f);
+  }
+  EXPECT_EQ(mesh.get_triangle()[1], other.get_triangle()[1]);
+  std::remove("square_bin.ply");
+  std::remove("square.oglmesh");
+}
+
+TEST(MeshCompressed, LoadOBJ) {
+  // Several streaming chunks, members make the size estimation too small
+  const int n = 600;
+  std::ostringstream str;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      str << "v " << i << " " << j << " " << (i * j) % 7 << "\n";
+    }
+  }
+  for (int i = 0; i < n - 1; ++i) {
+    for (int j = 0; j < n - 1; ++j) {
+      const int a = (i * n) + j + 1;
+      str << "f " << a << " " << a + 1 << " " << a + n << "\n";
+    }
+    str << "v 0.5 0.5 0.5\nv 1.5 0.5 0.5\nv 0.5 1.5 0.5\nf -3 -2 -1\n";
+  }
+  WriteFile("grid.obj", str.str());
+  WriteGzipFile("grid.obj.gz", str.str(), 3);
+  Mesh mesh, other;
+  ASSERT_EQ(mesh.Load("grid.obj"), 0);
+  ASSERT_EQ(other.Load("grid.obj.gz"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), other.get_vertex().size());
+  ASSERT_EQ(mesh.get_triangle().size(), other.get_triangle().size());
+  for (size_t i = 0; i < mesh.get_vertex().size(); ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < mesh.get_triangle().size(); ++i) {
+    EXPECT_EQ(mesh.get_triangle()[i], other.get_triangle()[i]);
+  }
+  std::remove("grid.obj");
+  std::remove("grid.obj.gz");
+}
+
+TEST(MeshCompressed, LoadPLY) {
+  WriteGzipFile("square.ply.gz", BinaryPLY(true, false), 1);
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square.ply.gz"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), 4);
+  ASSERT_EQ(mesh.get_vertex_color().size(), 4);
+  ASSERT_EQ(mesh.get_triangle().size(), 2);
+  EXPECT_EQ(mesh.get_triangle()[1], Mesh::Triangle(0, 2, 3));
+  // Format detected from the content
+  WriteGzipFile("square.gz", BinaryPLY(false, true), 2);
+  Mesh other;
+  ASSERT_EQ(other.Load("square.gz"), 0);
+  ASSERT_EQ(other.get_triangle().size(), 2);
+  EXPECT_EQ(other.get_triangle()[1], Mesh::Triangle(0, 2, 3));
+  // Ascii
+  WriteGzipFile("square_ascii.ply.gz",
+                "ply\nformat ascii 1.0\nelement vertex 3\n"
+                "property float x\nproperty float y\nproperty float z\n"
+                "element face 1\nproperty list uchar int vertex_indices\n"
+                "end_header\n0 0 0\n1 0 0\n0 1 0\n3 0 1 2\n", 1);
+  ASSERT_EQ(other.Load("square_ascii.ply.gz"), 0);
+  EXPECT_EQ(other.get_vertex().size(), 3);
+  EXPECT_EQ(other.get_triangle().size(), 1);
+  // Truncated stream
+  std::string data;
+  {
+    std::ifstream stream("square.ply.gz", std::ios_base::binary);
+    data.assign(std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>());
+  }
+  WriteFile("square.ply.gz", data.substr(0, data.size() / 2));
+  EXPECT_EQ(mesh.Load("square.ply.gz"), -1);
+  std::remove("square.ply.gz");
+  std::remove("square.gz");
+  std::remove("square_ascii.ply.gz");
+}
+
+TEST(MeshMemory, LoadBuffer) {
+  const std::string obj = "# quad\nv 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                          "f 1 2 3 4\n";
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load(obj.data(), obj.size()), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 4);
+  EXPECT_EQ(mesh.get_triangle().size(), 2);
+  // Post-processing as when loading from file
+  EXPECT_EQ(mesh.bbox().center_, Mesh::Vertex(0.f, 0.f, 0.f));
+  const std::string ply = BinaryPLY(false, true);
+  ASSERT_EQ(mesh.Load(ply.data(), ply.size()), 0);
+  EXPECT_EQ(mesh.get_vertex_color().size(), 4);
+  EXPECT_EQ(mesh.get_triangle()[1], Mesh::Triangle(0, 2, 3));
+  // Unknown content
+  const std::string bad = "\x01\x02 not a mesh";
+  EXPECT_EQ(mesh.Load(bad.data(), bad.size()), -1);
+  EXPECT_EQ(mesh.Load(bad.data(), 0), -1);
+}
+
+TEST(MeshMemory, LoadStream) {
+  std::istringstream ply(BinaryPLY(true, false));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load(ply), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 4);
+  EXPECT_EQ(mesh.get_triangle().size(), 2);
+  // Compressed content
+  WriteGzipFile("square.ply.gz", BinaryPLY(false, false), 1);
+  std::ifstream stream("square.ply.gz", std::ios_base::binary);
+  Mesh other;
+  ASSERT_EQ(other.Load(stream), 0);
+  ASSERT_EQ(other.get_vertex().size(), 4);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+  }
+  std::remove("square.ply.gz");
+}
+
+TEST(MeshAsync, Load) {
+  WriteFile("square_bin.ply", BinaryPLY(false, false));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square_bin.ply"), 0);
+  Mesh other;
+  int status = 1;
+  auto res = other.LoadAsync("square_bin.ply", [&](const int err) {
+    status = err;
+  });
+  ASSERT_EQ(res.get(), 0);
+  EXPECT_EQ(status, 0);
+  ASSERT_EQ(other.get_vertex().size(), mesh.get_vertex().size());
+  for (size_t i = 0; i < mesh.get_vertex().size(); ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+  }
+  EXPECT_EQ(mesh.bbox().min_, other.bbox().min_);
+  EXPECT_EQ(mesh.bbox().max_, other.bbox().max_);
+  // Several meshes in flight
+  Mesh a, b;
+  auto res_a = a.LoadAsync("square_bin.ply");
+  auto res_b = b.LoadAsync("missing.ply");
+  EXPECT_EQ(res_a.get(), 0);
+  EXPECT_EQ(res_b.get(), -1);
+  EXPECT_EQ(a.get_triangle().size(), 2);
+  std::remove("square_bin.ply");
+}
+
+/**
+ *  @name GridSTL
+ *  @fn std::string GridSTL(const int n)
+ *  @brief  Create a binary .stl file of a n x n grid (2 facets per cell)
+ *  @param[in]  n Number of cell per side
+ *  @return File's content
+ */
+std::string GridSTL(const int n) {
+  std::string stl(80, ' ');
+  AppendRaw(static_cast<uint32_t>(2 * n * n), false, &stl);
+  auto corner = [&](const int i, const int j) {
+    AppendRaw(static_cast<float>(i), false, &stl);
+    AppendRaw(static_cast<float>(j), false, &stl);
+    AppendRaw(0.f, false, &stl);
+  };
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        AppendRaw(k == 2 ? 1.f : 0.f, false, &stl);
+      }
+      corner(i, j);
+      corner(i + 1, j);
+      corner(i + 1, j + 1);
+      AppendRaw(uint16_t(0), false, &stl);
+      for (int k = 0; k < 3; ++k) {
+        AppendRaw(k == 2 ? 1.f : 0.f, false, &stl);
+      }
+      corner(i, j);
+      corner(i + 1, j + 1);
+      corner(i, j + 1);
+      AppendRaw(uint16_t(0), false, &stl);
+    }
+  }
+  return stl;
+}
+
+TEST(MeshSTL, LoadAscii) {
+  // Shared corners written with different notations, -0 equals 0
+  const std::string stl = "solid square\n"
+                          "  facet normal 0 0 1\n"
+                          "    outer loop\n"
+                          "      vertex 0 0 0\n"
+                          "      vertex 1 0 0\n"
+                          "      vertex 1 1 0\n"
+                          "    endloop\n"
+                          "  endfacet\n"
+                          "  facet normal 0 0 1\n"
+                          "    outer loop\n"
+                          "      vertex -0.0 0 0\n"
+                          "      vertex 1.0e0 1 0\n"
+                          "      vertex 0 1 0\n"
+                          "    endloop\n"
+                          "  endfacet\n"
+                          "endsolid square\n";
+  WriteFile("square.stl", stl);
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("square.stl"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), 4);
+  ASSERT_EQ(mesh.get_triangle().size(), 2);
+  EXPECT_EQ(mesh.get_triangle()[0], Mesh::Triangle(0, 1, 2));
+  EXPECT_EQ(mesh.get_triangle()[1], Mesh::Triangle(0, 2, 3));
+  EXPECT_EQ(mesh.bbox().min_, Mesh::Vertex(-0.5f, -0.5f, 0.f));
+  EXPECT_EQ(mesh.bbox().max_, Mesh::Vertex(0.5f, 0.5f, 0.f));
+  // Detected from content
+  Mesh other;
+  ASSERT_EQ(other.Load(stl.data(), stl.size()), 0);
+  EXPECT_EQ(other.get_vertex().size(), 4);
+  // Incomplete facet
+  WriteFile("bad.stl", "solid bad\nfacet normal 0 0 1\nouter loop\n"
+                       "vertex 0 0 0\nvertex 1 0 0\nendloop\nendfacet\n");
+  EXPECT_EQ(mesh.Load("bad.stl"), -1);
+  std::remove("square.stl");
+  std::remove("bad.stl");
+}
+
+TEST(MeshSTL, LoadBinaryParallel) {
+  // Larger than the parallel loading threshold
+  const int n = 120;
+  const std::string stl = GridSTL(n);
+  WriteFile("grid.stl", stl);
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("grid.stl"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), (n + 1) * (n + 1));
+  ASSERT_EQ(mesh.get_triangle().size(), 2 * n * n);
+  EXPECT_EQ(mesh.bbox().min_, Mesh::Vertex(-0.5f * n, -0.5f * n, 0.f));
+  Mesh serial;
+  serial.set_parallel_loading(false);
+  ASSERT_EQ(serial.Load("grid.stl"), 0);
+  ASSERT_EQ(serial.get_vertex().size(), mesh.get_vertex().size());
+  for (size_t i = 0; i < mesh.get_vertex().size(); ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], serial.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < mesh.get_triangle().size(); ++i) {
+    EXPECT_EQ(mesh.get_triangle()[i], serial.get_triangle()[i]);
+  }
+  // Compressed, and truncated
+  WriteGzipFile("grid.stl.gz", stl, 1);
+  ASSERT_EQ(serial.Load("grid.stl.gz"), 0);
+  EXPECT_EQ(serial.get_vertex().size(), mesh.get_vertex().size());
+  WriteFile("grid.stl", stl.substr(0, stl.size() - 10));
+  EXPECT_EQ(serial.Load("grid.stl"), -1);
+  std::remove("grid.stl");
+  std::remove("grid.stl.gz");
+}
+
+TEST(MeshSTL, SaveRoundTrip) {
+  const std::string stl = GridSTL(2);
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load(stl.data(), stl.size()), 0);
+  ASSERT_EQ(mesh.Save("out.stl"), 0);
+  std::ifstream file("out.stl", std::ios_base::binary);
+  const std::string out((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+  ASSERT_EQ(out.size(), stl.size());
+  // Binary header must not look like an ascii file
+  EXPECT_NE(out.compare(0, 5, "solid"), 0);
+  Mesh other;
+  ASSERT_EQ(other.Load("out.stl"), 0);
+  ASSERT_EQ(other.get_vertex().size(), mesh.get_vertex().size());
+  for (size_t i = 0; i < mesh.get_vertex().size(); ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+  }
+  for (size_t i = 0; i < mesh.get_triangle().size(); ++i) {
+    EXPECT_EQ(mesh.get_triangle()[i], other.get_triangle()[i]);
+  }
+  std::remove("out.stl");
+}
+
+/**
+ *  @name GLTFBuffer
+ *  @fn std::string GLTFBuffer(void)
+ *  @brief  Binary buffer of the test asset: an indexed quad (position,
+ *          normal, uint16 indices) and a triangle strip with interleaved
+ *          position / normalized uint8 color
+ *  @return Buffer's content (172 bytes)
+ */
+std::string GLTFBuffer(void) {
+  std::string bin;
+  const float quad[] = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+  for (const float v : quad) {
+    AppendRaw(v, false, &bin);
+  }
+  for (int i = 0; i < 4; ++i) {
+    AppendRaw(0.f, false, &bin);
+    AppendRaw(0.f, false, &bin);
+    AppendRaw(1.f, false, &bin);
+  }
+  for (const uint16_t i : {0, 1, 2, 0, 2, 3}) {
+    AppendRaw(i, false, &bin);
+  }
+  const float strip[] = {0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1};
+  for (int i = 0; i < 4; ++i) {
+    for (int k = 0; k < 3; ++k) {
+      AppendRaw(strip[(3 * i) + k], false, &bin);
+    }
+    bin.append(1, static_cast<char>(i == 0 ? 255 : 0));
+    bin.append(1, static_cast<char>(i == 1 ? 255 : 0));
+    bin.append(1, static_cast<char>(i == 2 ? 255 : 0));
+    bin.append(1, static_cast<char>(255));
+  }
+  return bin;
+}
+
+/**
+ *  @name GLTFDocument
+ *  @fn std::string GLTFDocument(const std::string& buffer)
+ *  @brief  JSON part of the test asset, node 0 holds the quad and has node
+ *          1 (strip) as child
+ *  @param[in]  buffer  Buffer's definition
+ *  @return Document
+ */
+std::string GLTFDocument(const std::string& buffer) {
+  return "{\"asset\": {\"version\": \"2.0\"},\n"
+         " \"scene\": 0, \"scenes\": [{\"nodes\": [0]}],\n"
+         " \"nodes\": [{\"mesh\": 0, \"children\": [1]}, {\"mesh\": 1}],\n"
+         " \"meshes\": [\n"
+         "  {\"primitives\": [{\"attributes\": {\"POSITION\": 0,"
+         " \"NORMAL\": 1}, \"indices\": 2, \"material\": 0}]},\n"
+         "  {\"primitives\": [{\"attributes\": {\"POSITION\": 3,"
+         " \"COLOR_0\": 4}, \"mode\": 5},\n"
+         "                  {\"attributes\": {\"POSITION\": 3},"
+         " \"mode\": 1}]}],\n"
+         " \"materials\": [{\"pbrMetallicRoughness\":"
+         " {\"baseColorTexture\": {\"index\": 0}}}],\n"
+         " \"textures\": [{\"source\": 0}],\n"
+         " \"images\": [{\"uri\": \"base%20color.png\"}],\n"
+         " \"buffers\": [" + buffer + "],\n"
+         " \"bufferViews\": [\n"
+         "  {\"buffer\": 0, \"byteOffset\": 0, \"byteLength\": 48},\n"
+         "  {\"buffer\": 0, \"byteOffset\": 48, \"byteLength\": 48},\n"
+         "  {\"buffer\": 0, \"byteOffset\": 96, \"byteLength\": 12},\n"
+         "  {\"buffer\": 0, \"byteOffset\": 108, \"byteLength\": 64,"
+         " \"byteStride\": 16}],\n"
+         " \"accessors\": [\n"
+         "  {\"bufferView\": 0, \"componentType\": 5126, \"count\": 4,"
+         " \"type\": \"VEC3\", \"min\": [0, 0, 0], \"max\": [1, 1, 0]},\n"
+         "  {\"bufferView\": 1, \"componentType\": 5126, \"count\": 4,"
+         " \"type\": \"VEC3\"},\n"
+         "  {\"bufferView\": 2, \"componentType\": 5123, \"count\": 6,"
+         " \"type\": \"SCALAR\"},\n"
+         "  {\"bufferView\": 3, \"componentType\": 5126, \"count\": 4,"
+         " \"type\": \"VEC3\", \"min\": [0, 0, 1], \"max\": [1, 1, 1]},\n"
+         "  {\"bufferView\": 3, \"byteOffset\": 12, \"componentType\": 5121,"
+         " \"normalized\": true, \"count\": 4, \"type\": \"VEC4\"}]\n"
+         "}\n";
+}
+
+/**
+ *  @name GLBFile
+ *  @fn std::string GLBFile(void)
+ *  @brief  Test asset packed into a .glb container
+ *  @return File's content
+ */
+std::string GLBFile(void) {
+  std::string json = GLTFDocument("{\"byteLength\": 172}");
+  json.append((4 - (json.size() % 4)) % 4, ' ');
+  const std::string bin = GLTFBuffer();
+  std::string glb = "glTF";
+  AppendRaw(uint32_t(2), false, &glb);
+  AppendRaw(static_cast<uint32_t>(28 + json.size() + bin.size()), false, &glb);
+  AppendRaw(static_cast<uint32_t>(json.size()), false, &glb);
+  glb += "JSON" + json;
+  AppendRaw(static_cast<uint32_t>(bin.size()), false, &glb);
+  glb.append("BIN\0", 4);
+  return glb + bin;
+}
+
+TEST(MeshGLTF, Asset) {
+  WriteFile("asset.bin", GLTFBuffer());
+  WriteFile("asset.gltf",
+            GLTFDocument("{\"uri\": \"asset.bin\", \"byteLength\": 172}"));
+  OGLKit::GLTFAsset asset;
+  ASSERT_EQ(asset.Load("asset.gltf"), 0);
+  // Line primitive is skipped, nodes are walked from the root
+  const auto& prim = asset.get_primitive();
+  ASSERT_EQ(prim.size(), 2);
+  EXPECT_EQ(prim[0].mesh, 0);
+  EXPECT_EQ(prim[0].texture, "base color.png");
+  EXPECT_EQ(prim[1].mesh, 1);
+  EXPECT_EQ(prim[1].texture, "");
+  Mesh quad;
+  ASSERT_EQ(asset.Extract(0, &quad), 0);
+  ASSERT_EQ(quad.get_vertex().size(), 4);
+  EXPECT_EQ(quad.get_vertex()[2], Mesh::Vertex(1.f, 1.f, 0.f));
+  ASSERT_EQ(quad.get_normal().size(), 4);
+  EXPECT_EQ(quad.get_normal()[3], Mesh::Normal(0.f, 0.f, 1.f));
+  ASSERT_EQ(quad.get_triangle().size(), 2);
+  EXPECT_EQ(quad.get_triangle()[1], Mesh::Triangle(0, 2, 3));
+  // Interleaved + converted attributes, strip with alternating winding
+  OGLKit::Mesh<double> strip;
+  ASSERT_EQ(asset.Extract(1, &strip), 0);
+  ASSERT_EQ(strip.get_vertex().size(), 4);
+  EXPECT_EQ(strip.get_vertex()[3], OGLKit::Mesh<double>::Vertex(1, 1, 1));
+  ASSERT_EQ(strip.get_vertex_color().size(), 4);
+  EXPECT_EQ(strip.get_vertex_color()[1],
+            OGLKit::Mesh<double>::Color(0, 1, 0, 1));
+  EXPECT_TRUE(strip.get_normal().empty());
+  ASSERT_EQ(strip.get_triangle().size(), 2);
+  EXPECT_EQ(strip.get_triangle()[0], Mesh::Triangle(0, 1, 2));
+  EXPECT_EQ(strip.get_triangle()[1], Mesh::Triangle(2, 1, 3));
+  // Primitives are merged, attributes missing in one of them are dropped
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("asset.gltf"), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 8);
+  EXPECT_EQ(mesh.get_triangle().size(), 4);
+  EXPECT_EQ(mesh.get_triangle()[3], Mesh::Triangle(6, 5, 7));
+  EXPECT_TRUE(mesh.get_normal().empty());
+  EXPECT_TRUE(mesh.get_vertex_color().empty());
+  EXPECT_EQ(mesh.bbox().max_ - mesh.bbox().min_, Mesh::Vertex(1.f, 1.f, 1.f));
+  std::remove("asset.gltf");
+  std::remove("asset.bin");
+}
+
+TEST(MeshGLTF, LoadGLB) {
+  const std::string glb = GLBFile();
+  WriteFile("asset.glb", glb);
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("asset.glb"), 0);
+  EXPECT_EQ(mesh.get_vertex().size(), 8);
+  EXPECT_EQ(mesh.get_triangle().size(), 4);
+  // Detected from content
+  Mesh other;
+  ASSERT_EQ(other.Load(glb.data(), glb.size()), 0);
+  ASSERT_EQ(other.get_vertex().size(), 8);
+  for (size_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(mesh.get_vertex()[i], other.get_vertex()[i]);
+  }
+  // Truncated binary chunk
+  WriteFile("asset.glb", glb.substr(0, glb.size() - 4));
+  EXPECT_EQ(mesh.Load("asset.glb"), -1);
+  std::remove("asset.glb");
+}
+
+TEST(MeshGLTF, LoadMalformed) {
+  WriteFile("asset.bin", GLTFBuffer());
+  // Accessor exceeding its buffer view
+  const std::string buffer = "{\"uri\": \"asset.bin\", \"byteLength\": 172}";
+  std::string doc = GLTFDocument(buffer);
+  const std::string count = "\"count\": 6,";
+  doc.replace(doc.find(count), count.size(), "\"count\": 7,");
+  WriteFile("asset.gltf", doc);
+  Mesh mesh;
+  EXPECT_EQ(mesh.Load("asset.gltf"), -1);
+  // Missing buffer, not glTF 2.0
+  WriteFile("asset.gltf",
+            GLTFDocument("{\"uri\": \"missing.bin\", \"byteLength\": 172}"));
+  EXPECT_EQ(mesh.Load("asset.gltf"), -1);
+  WriteFile("asset.gltf", "{\"asset\": {\"version\": \"1.0\"}}");
+  EXPECT_EQ(mesh.Load("asset.gltf"), -1);
+  std::remove("asset.gltf");
+  std::remove("asset.bin");
+}
+
+TEST(MeshPostProcess, Stages) {
+  const std::string obj = "v 1 1 1\nv 3 1 1\nv 3 3 1\nv 1 3 1\nf 1 2 3 4\n";
+  Mesh mesh;
+  EXPECT_EQ(mesh.post_process(), Mesh::kDefaultPostProcess);
+  ASSERT_EQ(mesh.Load(obj.data(), obj.size()), 0);
+  EXPECT_EQ(mesh.get_vertex()[0], Mesh::Vertex(-1.f, -1.f, 0.f));
+  EXPECT_EQ(mesh.get_vertex_connectivity().size(), 4);
+  EXPECT_TRUE(mesh.get_normal().empty());
+  // Keep original coordinates, no connectivity
+  mesh.set_post_process(Mesh::kBoundingBox);
+  ASSERT_EQ(mesh.Load(obj.data(), obj.size()), 0);
+  EXPECT_EQ(mesh.get_vertex()[0], Mesh::Vertex(1.f, 1.f, 1.f));
+  EXPECT_EQ(mesh.bbox().center_, Mesh::Vertex(2.f, 2.f, 1.f));
+  EXPECT_TRUE(mesh.get_vertex_connectivity().empty());
+  // Normals only, connectivity is released afterwards
+  mesh.set_post_process(Mesh::kNormal);
+  ASSERT_EQ(mesh.Load(obj.data(), obj.size()), 0);
+  ASSERT_EQ(mesh.get_normal().size(), 4);
+  EXPECT_EQ(mesh.get_normal()[2], Mesh::Normal(0.f, 0.f, 1.f));
+  EXPECT_TRUE(mesh.get_vertex_connectivity().empty());
+}
+
+TEST(MeshPostProcess, Parallel) {
+  // More than one block of vertices
+  const int n = 260;
+  WriteFile("grid.stl", GridSTL(n));
+  Mesh mesh;
+  ASSERT_EQ(mesh.Load("grid.stl"), 0);
+  Mesh serial;
+  serial.set_parallel_loading(false);
+  ASSERT_EQ(serial.Load("grid.stl"), 0);
+  ASSERT_EQ(mesh.get_vertex().size(), (n + 1) * (n + 1));
+  ASSERT_EQ(serial.get_vertex().size(), mesh.get_vertex().size());
+  EXPECT_EQ(0, std::memcmp(mesh.get_vertex().data(),
+                           serial.get_vertex().data(),
+                           mesh.get_vertex().size() * sizeof(Mesh::Vertex)));
+  EXPECT_EQ(mesh.bbox().min_, Mesh::Vertex(-0.5f * n, -0.5f * n, 0.f));
+  EXPECT_EQ(mesh.bbox().max_, serial.bbox().max_);
+  const auto& con = mesh.get_vertex_connectivity();
+  ASSERT_EQ(con.size(), mesh.get_vertex().size());
+  EXPECT_EQ(con.get_offset(), serial.get_vertex_connectivity().get_offset());
+  EXPECT_EQ(con.get_index(), serial.get_vertex_connectivity().get_index());
+  std::remove("grid.stl");
+}
+
+TEST(MeshDerived, Lazy) {
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    edit.vertex() = {Mesh::Vertex(0.f, 0.f, 0.f), Mesh::Vertex(1.f, 0.f, 0.f),
+                     Mesh::Vertex(1.f, 1.f, 0.f), Mesh::Vertex(0.f, 1.f, 0.f)};
+    edit.triangle() = {Mesh::Triangle(0, 1, 2), Mesh::Triangle(0, 2, 3)};
+    edit.tex_coord() = {Mesh::TCoord(0.f, 0.f), Mesh::TCoord(1.f, 0.f),
+                        Mesh::TCoord(1.f, 1.f), Mesh::TCoord(0.f, 1.f)};
+    // Flagged once the editor goes out of scope
+    EXPECT_EQ(mesh.version(), 0);
+  }
+  const size_t version = mesh.version();
+  EXPECT_GT(version, 0);
+  ASSERT_EQ(mesh.UpdateNormal().size(), 4);
+  EXPECT_EQ(mesh.get_normal()[1], Mesh::Normal(0.f, 0.f, 1.f));
+  EXPECT_EQ(mesh.get_vertex_connectivity().size(), 4);
+  ASSERT_EQ(mesh.UpdateTangent().size(), 4);
+  EXPECT_PRED2(NearTangent, mesh.get_tangent()[3],
+               Mesh::Tangent(1.f, 0.f, 0.f, 1.f));
+  EXPECT_EQ(mesh.UpdateBoundingBox().max_, Mesh::Vertex(1.f, 1.f, 0.f));
+  // Nothing changed, provided normals are kept
+  mesh.Edit().normal()[0] = Mesh::Normal(1.f, 0.f, 0.f);
+  EXPECT_EQ(mesh.UpdateNormal()[0], Mesh::Normal(1.f, 0.f, 0.f));
+  EXPECT_EQ(mesh.version(), version);
+  // Deform, derived data follow
+  {
+    auto edit = mesh.Edit();
+    for (auto& v : edit.vertex()) {
+      v.z_ = v.x_;
+    }
+  }
+  EXPECT_GT(mesh.version(), version);
+  // Plain accesses, const or not, change no version
+  const size_t deformed = mesh.version();
+  EXPECT_EQ(mesh.get_vertex().size(), 4);
+  EXPECT_EQ(mesh.get_triangle().size(), 2);
+  EXPECT_EQ(mesh.get_tex_coord().size(), 4);
+  EXPECT_EQ(mesh.get_normal().size(), 4);
+  EXPECT_EQ(mesh.get_tangent().size(), 4);
+  EXPECT_EQ(mesh.version(), deformed);
+  const float s = std::sqrt(0.5f);
+  EXPECT_PRED2(Near, mesh.UpdateNormal()[0], Mesh::Normal(-s, 0.f, s));
+  EXPECT_PRED2(NearTangent, mesh.UpdateTangent()[0],
+               Mesh::Tangent(s, 0.f, s, 1.f));
+  EXPECT_EQ(mesh.UpdateBoundingBox().max_, Mesh::Vertex(1.f, 1.f, 1.f));
+  // Colors only bump the version
+  mesh.Edit().vertex_color().assign(4, Mesh::Color(1.f, 1.f, 1.f, 1.f));
+  EXPECT_GT(mesh.version(), deformed);
+  EXPECT_PRED2(Near, mesh.UpdateNormal()[0], Mesh::Normal(-s, 0.f, s));
+  // Topology change
+  mesh.Edit().triangle().pop_back();
+  EXPECT_TRUE(mesh.UpdateConnectivity()[3].empty());
+}
+
+TEST(MeshDerived, NormalWeighting) {
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    edit.vertex() = {Mesh::Vertex(0.f, 0.f, 0.f), Mesh::Vertex(1.f, 0.f, 0.f),
+                     Mesh::Vertex(0.f, 1.f, 0.f), Mesh::Vertex(0.f, 2.f, 0.f),
+                     Mesh::Vertex(0.f, 2.f, 2.f)};
+    // Right angle facing z, 45 degrees four times larger facing x, and a
+    // degenerate triangle that must not contribute
+    edit.triangle() = {Mesh::Triangle(0, 1, 2), Mesh::Triangle(0, 3, 4),
+                       Mesh::Triangle(0, 1, 1)};
+  }
+  EXPECT_EQ(mesh.normal_weighting(), Mesh::kAngleWeighting);
+  const float s = std::sqrt(0.2f);
+  EXPECT_PRED2(Near, mesh.UpdateNormal()[0], Mesh::Normal(s, 0.f, 2.f * s));
+  EXPECT_EQ(mesh.get_normal()[1], Mesh::Normal(0.f, 0.f, 1.f));
+  mesh.set_normal_weighting(Mesh::kAreaWeighting);
+  const float a = std::sqrt(1.f / 17.f);
+  EXPECT_PRED2(Near, mesh.UpdateNormal()[0], Mesh::Normal(4.f * a, 0.f, a));
+  mesh.set_normal_weighting(Mesh::kUniformWeighting);
+  const float u = std::sqrt(0.5f);
+  EXPECT_PRED2(Near, mesh.UpdateNormal()[0], Mesh::Normal(u, 0.f, u));
+  // Corners are part of the connectivity
+  const auto row = mesh.get_vertex_connectivity()[1];
+  ASSERT_EQ(row.size(), 6);
+  EXPECT_EQ(row.corner[0], 1);
+  EXPECT_EQ(row.corner[1], 7);
+  EXPECT_EQ(row.corner[2], 8);
+  // Called directly, the stale connectivity is rebuilt first
+  mesh.Edit().triangle().pop_back();
+  mesh.ComputeVertexNormal();
+  EXPECT_EQ(mesh.get_vertex_connectivity()[1].size(), 2);
+  EXPECT_EQ(mesh.get_normal()[1], Mesh::Normal(0.f, 0.f, 1.f));
+}
+
+TEST(MeshDerived, Tangent) {
+  Mesh mesh;
+  {
+    // Texture mirrored along u
+    auto edit = mesh.Edit();
+    edit.vertex() = {Mesh::Vertex(0.f, 0.f, 0.f), Mesh::Vertex(1.f, 0.f, 0.f),
+                     Mesh::Vertex(1.f, 1.f, 0.f), Mesh::Vertex(0.f, 1.f, 0.f),
+                     Mesh::Vertex(2.f, 0.f, 0.f)};
+    edit.triangle() = {Mesh::Triangle(0, 1, 2), Mesh::Triangle(0, 2, 3),
+                       Mesh::Triangle(1, 4, 2)};
+    edit.tex_coord() = {Mesh::TCoord(1.f, 0.f), Mesh::TCoord(0.f, 0.f),
+                        Mesh::TCoord(0.f, 1.f), Mesh::TCoord(1.f, 1.f),
+                        Mesh::TCoord(0.f, 0.f)};
+  }
+  // Normals and connectivity are built when needed
+  mesh.ComputeVertexTangent();
+  ASSERT_EQ(mesh.get_tangent().size(), 5);
+  EXPECT_EQ(mesh.get_normal().size(), 5);
+  EXPECT_PRED2(NearTangent, mesh.get_tangent()[3],
+               Mesh::Tangent(-1.f, 0.f, 0.f, -1.f));
+  // Degenerated texture coordinates, still a valid frame
+  EXPECT_PRED2(NearTangent, mesh.get_tangent()[4],
+               Mesh::Tangent(1.f, 0.f, 0.f, 1.f));
+  // Without texture coordinate
+  mesh.Edit().tex_coord().clear();
+  EXPECT_TRUE(mesh.UpdateTangent().empty());
+}
+
+TEST(MeshConnectivity, Build) {
+  using Connectivity = OGLKit::Connectivity;
+  // Fan around vertex 0, plus an isolated vertex
+  std::vector<Connectivity::Triangle> tri = {Connectivity::Triangle(0, 1, 2),
+                                             Connectivity::Triangle(0, 2, 3),
+                                             Connectivity::Triangle(3, 2, 0)};
+  Connectivity con;
+  ASSERT_EQ(con.Build(tri, 5, false), 0);
+  ASSERT_EQ(con.size(), 5);
+  const std::vector<int> row0 = {1, 2, 2, 3, 3, 2};
+  EXPECT_TRUE(std::equal(row0.begin(), row0.end(), con[0].begin()));
+  EXPECT_EQ(con[0].size(), row0.size());
+  EXPECT_EQ(con[2][0], 0);
+  EXPECT_EQ(con[2][1], 1);
+  EXPECT_TRUE(con[4].empty());
+  // Out of range
+  tri.push_back(Connectivity::Triangle(0, 1, 5));
+  EXPECT_EQ(con.Build(tri, 5, false), -1);
+  EXPECT_TRUE(con.empty());
+  EXPECT_EQ(con.Build(tri, 5, true), -1);
+  // Parallel build gives the same rows, whatever the triangle order
+  const int n = 400;
+  tri.clear();
+  for (int i = 0; i < 3 * n * n; ++i) {
+    const int a = static_cast<int>((i * 7919LL) % (n * n));
+    tri.push_back(Connectivity::Triangle(a, (a + 1) % (n * n),
+                                         (a + n) % (n * n)));
+  }
+  Connectivity serial;
+  ASSERT_EQ(serial.Build(tri, n * n, false), 0);
+  ASSERT_EQ(con.Build(tri, n * n, true), 0);
+  EXPECT_EQ(con.get_offset(), serial.get_offset());
+  EXPECT_EQ(con.get_index(), serial.get_index());
+  EXPECT_EQ(con.get_corner(), serial.get_corner());
+  tri.back().y_ = -1;
+  EXPECT_EQ(con.Build(tri, n * n, true), -1);
+}
+
+TEST(MeshOptimizer, VertexCache) {
+  using MeshOptimizer = OGLKit::MeshOptimizer<float>;
+  // Grid with shuffled triangles
+  const int n = 64;
+  std::vector<Mesh::Vertex> vertex;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      vertex.push_back(Mesh::Vertex(float(j), float(i), 0.f));
+    }
+  }
+  std::vector<Mesh::Triangle> tri;
+  const int n_tri = 2 * (n - 1) * (n - 1);
+  for (int k = 0; k < n_tri; ++k) {
+    const int q = static_cast<int>((k * 7919LL) % n_tri);
+    const int v = ((q / 2) / (n - 1)) * n + ((q / 2) % (n - 1));
+    tri.push_back(q % 2 ? Mesh::Triangle(v, v + n + 1, v + n) :
+                          Mesh::Triangle(v, v + 1, v + n + 1));
+  }
+  auto sorted = [](std::vector<Mesh::Triangle> t) {
+    std::sort(t.begin(), t.end(), [](const Mesh::Triangle& a,
+                                     const Mesh::Triangle& b) {
+      return (a.x_ < b.x_ || (a.x_ == b.x_ && (a.y_ < b.y_ ||
+              (a.y_ == b.y_ && a.z_ < b.z_))));
+    });
+    return t;
+  };
+  MeshOptimizer::CacheStatistic stat;
+  MeshOptimizer::AnalyzeVertexCache(tri, vertex.size(), 16, &stat);
+  EXPECT_GT(stat.acmr, 2.f);
+  // Same triangles, better locality
+  std::vector<Mesh::Triangle> opt = tri;
+  MeshOptimizer::Report report;
+  ASSERT_EQ(MeshOptimizer::Optimize(vertex, false, &opt, &report), 0);
+  EXPECT_FLOAT_EQ(report.before.acmr, stat.acmr);
+  EXPECT_LT(report.after.acmr, 0.8f);
+  EXPECT_LT(report.after.atvr, report.before.atvr);
+  EXPECT_TRUE(sorted(opt) == sorted(tri));
+  // Overdraw ordering keeps most of the gain
+  std::vector<int> cluster;
+  opt = tri;
+  ASSERT_EQ(MeshOptimizer::OptimizeVertexCache(vertex.size(), 16, &opt,
+                                               &cluster), 0);
+  ASSERT_EQ(MeshOptimizer::OptimizeOverdraw(vertex, 16, 1.05f, &opt,
+                                            &cluster), 0);
+  ASSERT_FALSE(cluster.empty());
+  EXPECT_EQ(cluster[0], 0);
+  EXPECT_TRUE(sorted(opt) == sorted(tri));
+  MeshOptimizer::AnalyzeVertexCache(opt, vertex.size(), 16, &stat);
+  EXPECT_LT(stat.acmr, 0.85f);
+  // Invalid input
+  opt.push_back(Mesh::Triangle(0, 1, n * n));
+  EXPECT_EQ(MeshOptimizer::Optimize(vertex, true, &opt, nullptr), -1);
+  // As a loading stage
+  WriteFile("grid.stl", GridSTL(40));
+  Mesh mesh;
+  mesh.set_post_process(Mesh::kDefaultPostProcess | Mesh::kOverdraw);
+  ASSERT_EQ(mesh.Load("grid.stl"), 0);
+  const auto& t = static_cast<const Mesh&>(mesh).get_triangle();
+  MeshOptimizer::AnalyzeVertexCache(t, mesh.get_vertex().size(), 16, &stat);
+  EXPECT_EQ(t.size(), 2 * 40 * 40);
+  EXPECT_LT(stat.acmr, 0.85f);
+  std::remove("grid.stl");
+}
+
+TEST(MeshOptimizer, VertexFetch) {
+  using MeshOptimizer = OGLKit::MeshOptimizer<float>;
+  // Unit cube corners, reversed
+  std::vector<Mesh::Vertex> cube;
+  for (int k = 7; k >= 0; --k) {
+    cube.push_back(Mesh::Vertex(float(k >> 2), float((k >> 1) & 1),
+                                float(k & 1)));
+  }
+  std::vector<Mesh::Triangle> tri = {Mesh::Triangle(5, 0, 2)};
+  std::vector<int> remap;
+  ASSERT_EQ(MeshOptimizer::VertexRemap(cube, tri,
+                                       MeshOptimizer::kFirstUseOrder,
+                                       &remap), 0);
+  EXPECT_EQ(remap, std::vector<int>({1, 3, 2, 4, 5, 0, 6, 7}));
+  // Z-order, x being the most significant
+  ASSERT_EQ(MeshOptimizer::VertexRemap(cube, tri,
+                                       MeshOptimizer::kMortonOrder,
+                                       &remap), 0);
+  EXPECT_EQ(remap, std::vector<int>({7, 6, 5, 4, 3, 2, 1, 0}));
+  // Hilbert visits octants in Gray code order, one axis change at a time
+  ASSERT_EQ(MeshOptimizer::VertexRemap(cube, tri,
+                                       MeshOptimizer::kHilbertOrder,
+                                       &remap), 0);
+  std::vector<Mesh::Vertex> curve(cube.size());
+  for (size_t i = 0; i < cube.size(); ++i) {
+    curve[remap[i]] = cube[i];
+  }
+  EXPECT_EQ(curve[0], Mesh::Vertex(0.f, 0.f, 0.f));
+  for (size_t i = 1; i < curve.size(); ++i) {
+    EXPECT_FLOAT_EQ((curve[i] - curve[i - 1]).Norm(), 1.f);
+  }
+  tri.push_back(Mesh::Triangle(0, 1, 8));
+  EXPECT_EQ(MeshOptimizer::VertexRemap(cube, tri,
+                                       MeshOptimizer::kMortonOrder,
+                                       &remap), -1);
+  // Every attribute follows its vertex
+  const int n = 16;
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        edit.vertex().push_back(Mesh::Vertex(float(j), float(i), 0.f));
+        edit.tex_coord().push_back(Mesh::TCoord(float(j), float(i)));
+      }
+    }
+    const int n_tri = 2 * (n - 1) * (n - 1);
+    for (int k = 0; k < n_tri; ++k) {
+      const int q = static_cast<int>((k * 211LL) % n_tri);
+      const int v = ((q / 2) / (n - 1)) * n + ((q / 2) % (n - 1));
+      edit.triangle().push_back(q % 2 ? Mesh::Triangle(v, v + n + 1, v + n) :
+                                        Mesh::Triangle(v, v + 1, v + n + 1));
+    }
+  }
+  // Builds the connectivity as well
+  mesh.UpdateNormal();
+  const Mesh& source = mesh;
+  const std::vector<Mesh::Triangle> before = source.get_triangle();
+  const std::vector<Mesh::Vertex> position = source.get_vertex();
+  ASSERT_EQ(mesh.ReorderVertex(Mesh::kFirstUseOrder), 0);
+  const auto& t = source.get_triangle();
+  const auto& v = source.get_vertex();
+  ASSERT_EQ(t.size(), before.size());
+  int next = 0;
+  for (size_t k = 0; k < t.size(); ++k) {
+    EXPECT_EQ(v[t[k].x_], position[before[k].x_]);
+    EXPECT_EQ(v[t[k].y_], position[before[k].y_]);
+    EXPECT_EQ(v[t[k].z_], position[before[k].z_]);
+    for (const int c : {t[k].x_, t[k].y_, t[k].z_}) {
+      EXPECT_LE(c, next);
+      next = std::max(next, c + 1);
+    }
+  }
+  for (size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(source.get_tex_coord()[i], Mesh::TCoord(v[i].x_, v[i].y_));
+  }
+  // Derived data remain valid
+  const size_t version = mesh.version();
+  EXPECT_EQ(source.get_normal().size(), v.size());
+  mesh.UpdateNormal();
+  EXPECT_EQ(mesh.version(), version);
+  EXPECT_EQ(source.get_vertex_connectivity().size(), v.size());
+  EXPECT_EQ(mesh.UpdateHalfEdge().n_vertex(), v.size());
+  ASSERT_EQ(mesh.ReorderVertex(Mesh::kHilbertOrder), 0);
+  for (size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(source.get_tex_coord()[i], Mesh::TCoord(v[i].x_, v[i].y_));
+  }
+}
+
+TEST(MeshSimplifier, LOD) {
+  using MeshSimplifier = OGLKit::MeshSimplifier<float>;
+  // Flat grid, texture seam along x = 16 (right side uses duplicates)
+  const int n = 32;
+  std::vector<Mesh::Vertex> vertex;
+  for (int i = 0; i <= n; ++i) {
+    for (int j = 0; j <= n; ++j) {
+      vertex.push_back(Mesh::Vertex(float(j), float(i), 0.f));
+    }
+  }
+  const int seam = static_cast<int>(vertex.size());
+  for (int i = 0; i <= n; ++i) {
+    vertex.push_back(Mesh::Vertex(16.f, float(i), 0.f));
+  }
+  std::vector<Mesh::Triangle> tri;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      auto idx = [&](const int r, const int c) {
+        return c == 16 && j >= 16 ? seam + r : r * (n + 1) + c;
+      };
+      tri.push_back(Mesh::Triangle(idx(i, j), idx(i, j + 1),
+                                   idx(i + 1, j + 1)));
+      tri.push_back(Mesh::Triangle(idx(i, j), idx(i + 1, j + 1),
+                                   idx(i + 1, j)));
+    }
+  }
+  std::vector<MeshSimplifier::Level> level = {
+    MeshSimplifier::Level(512, 1e-3f), MeshSimplifier::Level(64, 1e-3f)};
+  std::vector<MeshSimplifier::LOD> lod;
+  ASSERT_EQ(MeshSimplifier::BuildLOD(vertex, tri, level, false, &lod), 0);
+  ASSERT_EQ(lod.size(), 2);
+  for (size_t l = 0; l < lod.size(); ++l) {
+    EXPECT_LE(lod[l].tri.size(), level[l].n_tri);
+    EXPECT_LT(lod[l].error, 1e-3f);
+    // Same surface, corners kept, no flip and seam wedges never mixed
+    float area = 0.f;
+    for (const auto& t : lod[l].tri) {
+      const Mesh::Vertex& a = vertex[t.x_];
+      const Mesh::Vertex& b = vertex[t.y_];
+      const Mesh::Vertex& c = vertex[t.z_];
+      const Mesh::Vertex nrm = (b - a) ^ (c - a);
+      EXPECT_GT(nrm.z_, 0.f);
+      area += 0.5f * nrm.z_;
+      auto right = [&](const int v) {
+        return v >= seam || vertex[v].x_ > 16.f;
+      };
+      EXPECT_EQ(right(t.x_), right(t.y_));
+      EXPECT_EQ(right(t.x_), right(t.z_));
+    }
+    EXPECT_NEAR(area, float(n * n), 1e-2f);
+  }
+  // Locked borders keep every border vertex
+  std::vector<Mesh::Triangle> coarse = tri;
+  float error = -1.f;
+  ASSERT_EQ(MeshSimplifier::Simplify(vertex, 8, 1.f, true, &coarse, &error),
+            0);
+  EXPECT_GE(error, 0.f);
+  std::vector<bool> used(vertex.size(), false);
+  for (const auto& t : coarse) {
+    used[t.x_] = used[t.y_] = used[t.z_] = true;
+  }
+  for (int k = 0; k <= n; ++k) {
+    EXPECT_TRUE(used[k]);
+    EXPECT_TRUE(used[n * (n + 1) + k]);
+  }
+  coarse.push_back(Mesh::Triangle(0, 1, static_cast<int>(vertex.size())));
+  EXPECT_EQ(MeshSimplifier::Simplify(vertex, 8, 1.f, true, &coarse, &error),
+            -1);
+  // Stand-alone level
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    edit.vertex() = vertex;
+    edit.triangle() = lod.back().tri;
+  }
+  ASSERT_EQ(mesh.RemoveUnusedVertex(), 0);
+  const Mesh& source = mesh;
+  EXPECT_LT(source.get_vertex().size(), 64);
+  EXPECT_EQ(source.get_triangle().size(), lod.back().tri.size());
+}
+
+TEST(MeshSimplifier, Link) {
+  using MeshSimplifier = OGLKit::MeshSimplifier<float>;
+  using HalfEdge = OGLKit::HalfEdge;
+  // Closed sphere, poles + rings
+  const int n_ring = 8;
+  const int n_seg = 12;
+  const float pi = 3.14159265f;
+  std::vector<Mesh::Vertex> vertex = {Mesh::Vertex(0.f, 0.f, 1.f),
+                                      Mesh::Vertex(0.f, 0.f, -1.f)};
+  for (int i = 1; i < n_ring; ++i) {
+    const float theta = pi * float(i) / float(n_ring);
+    for (int j = 0; j < n_seg; ++j) {
+      const float phi = 2.f * pi * float(j) / float(n_seg);
+      vertex.push_back(Mesh::Vertex(std::sin(theta) * std::cos(phi),
+                                    std::sin(theta) * std::sin(phi),
+                                    std::cos(theta)));
+    }
+  }
+  auto idx = [&](const int i, const int j) {
+    return 2 + ((i - 1) * n_seg) + (j % n_seg);
+  };
+  std::vector<Mesh::Triangle> tri;
+  for (int j = 0; j < n_seg; ++j) {
+    tri.push_back(Mesh::Triangle(0, idx(1, j), idx(1, j + 1)));
+    tri.push_back(Mesh::Triangle(1, idx(n_ring - 1, j + 1),
+                                 idx(n_ring - 1, j)));
+    for (int i = 1; i < n_ring - 1; ++i) {
+      tri.push_back(Mesh::Triangle(idx(i, j), idx(i + 1, j),
+                                   idx(i + 1, j + 1)));
+      tri.push_back(Mesh::Triangle(idx(i, j), idx(i + 1, j + 1),
+                                   idx(i, j + 1)));
+    }
+  }
+  // Collapsed as far as possible, the surface must stay closed and manifold
+  float error = 0.f;
+  ASSERT_EQ(MeshSimplifier::Simplify(vertex, 1, 1e3f, false, &tri, &error),
+            0);
+  ASSERT_GE(tri.size(), 4);
+  HalfEdge he;
+  ASSERT_EQ(he.Build(tri, vertex.size(), false), 0);
+  EXPECT_TRUE(he.get_non_manifold_edge().empty());
+  for (size_t h = 0; h < he.size(); ++h) {
+    EXPECT_GE(he.Twin(static_cast<int>(h)), 0);
+  }
+}
+
+TEST(MeshPartitioner, Cluster) {
+  using MeshPartitioner = OGLKit::MeshPartitioner<float>;
+  // Flat grid facing +z
+  const int n = 32;
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    for (int i = 0; i <= n; ++i) {
+      for (int j = 0; j <= n; ++j) {
+        edit.vertex().push_back(Mesh::Vertex(float(j), float(i), 0.f));
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        const int v = i * (n + 1) + j;
+        edit.triangle().push_back(Mesh::Triangle(v, v + 1, v + n + 2));
+        edit.triangle().push_back(Mesh::Triangle(v, v + n + 2, v + n + 1));
+      }
+    }
+  }
+  const Mesh& source = mesh;
+  const std::vector<Mesh::Triangle> before = source.get_triangle();
+  ASSERT_EQ(mesh.BuildCluster(MeshPartitioner::kMaxVertex,
+                              MeshPartitioner::kMaxTriangle), 0);
+  const auto& cluster = source.get_cluster();
+  const auto& v = source.get_vertex();
+  const auto& t = source.get_triangle();
+  ASSERT_FALSE(cluster.empty());
+  // Triangles are a permutation, clusters cover them contiguously
+  auto key = [](const Mesh::Triangle& f) {
+    return std::make_tuple(f.x_, f.y_, f.z_);
+  };
+  std::vector<std::tuple<int, int, int>> a, b;
+  for (size_t k = 0; k < t.size(); ++k) {
+    a.push_back(key(before[k]));
+    b.push_back(key(t[k]));
+  }
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  EXPECT_EQ(a, b);
+  size_t first = 0;
+  for (const auto& c : cluster) {
+    EXPECT_EQ(c.first_tri, first);
+    EXPECT_LE(c.n_tri, MeshPartitioner::kMaxTriangle);
+    EXPECT_LE(c.n_vertex, MeshPartitioner::kMaxVertex);
+    first += c.n_tri;
+    std::vector<int> used;
+    for (size_t k = c.first_tri; k < c.first_tri + c.n_tri; ++k) {
+      for (const int p : {t[k].x_, t[k].y_, t[k].z_}) {
+        used.push_back(p);
+        const Mesh::Vertex& q = v[p];
+        EXPECT_LE((q - c.center).Norm(), c.radius * 1.0001f);
+        EXPECT_TRUE(q.x_ >= c.bbox.min_.x_ && q.x_ <= c.bbox.max_.x_ &&
+                    q.y_ >= c.bbox.min_.y_ && q.y_ <= c.bbox.max_.y_);
+      }
+    }
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+    EXPECT_EQ(used.size(), c.n_vertex);
+    // Flat, the cone collapses onto the normal
+    EXPECT_PRED2(Near, c.cone_axis, Mesh::Vertex(0.f, 0.f, 1.f));
+    EXPECT_LT(c.cone_cutoff, 1e-3f);
+    EXPECT_TRUE(c.IsBackfacing(c.center - Mesh::Vertex(0.f, 0.f, 10.f)));
+    EXPECT_FALSE(c.IsBackfacing(c.center + Mesh::Vertex(0.f, 0.f, 10.f)));
+  }
+  EXPECT_EQ(first, t.size());
+  // Most clusters are close to their budget
+  EXPECT_LE(cluster.size(), 2 * t.size() / MeshPartitioner::kMaxTriangle);
+  // Frustum : keep x >= 0 and x <= 8
+  const OGLKit::Vector4<float> plane[2] = {
+    OGLKit::Vector4<float>(1.f, 0.f, 0.f, 0.f),
+    OGLKit::Vector4<float>(-2.f, 0.f, 0.f, 16.f)};
+  for (const auto& c : cluster) {
+    EXPECT_EQ(c.IsOutside(plane, 2), c.center.x_ > 8.f + c.radius);
+  }
+  // Moving vertices updates the bounds, editing triangles drops clusters
+  const size_t n_cluster = cluster.size();
+  {
+    auto edit = mesh.Edit();
+    for (auto& p : edit.vertex()) {
+      p.z_ += 2.f;
+    }
+  }
+  ASSERT_EQ(mesh.UpdateCluster().size(), n_cluster);
+  for (const auto& c : cluster) {
+    EXPECT_FLOAT_EQ(c.center.z_, 2.f);
+  }
+  mesh.Edit().triangle().pop_back();
+  EXPECT_TRUE(mesh.UpdateCluster().empty());
+  EXPECT_EQ(mesh.BuildCluster(2, 8), -1);
+}
+
+TEST(MeshBoundingBox, Reduce) {
+  using BoundingBox = OGLKit::BoundingBox<float>;
+  // Pseudo random positions, sizes cover partial registers and the
+  // multithreaded split
+  uint32_t seed = 12345;
+  auto rnd = [&](void) {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / float(1 << 24) - 0.5f;
+  };
+  auto naive = [](const std::vector<Mesh::Vertex>& v,
+                  const std::vector<int>& index) {
+    AABB<float> bbox = BoundingBox::Empty();
+    for (const int i : index) {
+      bbox.min_.x_ = std::min(bbox.min_.x_, v[i].x_);
+      bbox.min_.y_ = std::min(bbox.min_.y_, v[i].y_);
+      bbox.min_.z_ = std::min(bbox.min_.z_, v[i].z_);
+      bbox.max_.x_ = std::max(bbox.max_.x_, v[i].x_);
+      bbox.max_.y_ = std::max(bbox.max_.y_, v[i].y_);
+      bbox.max_.z_ = std::max(bbox.max_.z_, v[i].z_);
+    }
+    return bbox;
+  };
+  auto same = [](const AABB<float>& a, const AABB<float>& b) {
+    return (a.min_.x_ == b.min_.x_ && a.min_.y_ == b.min_.y_ &&
+            a.min_.z_ == b.min_.z_ && a.max_.x_ == b.max_.x_ &&
+            a.max_.y_ == b.max_.y_ && a.max_.z_ == b.max_.z_);
+  };
+  for (const size_t n : {size_t(1), size_t(7), size_t(13), size_t(1000),
+                         3 * BoundingBox::kBlockSize + 5}) {
+    std::vector<Mesh::Vertex> vertex(n);
+    std::vector<int> all(n);
+    for (size_t i = 0; i < n; ++i) {
+      vertex[i] = Mesh::Vertex(rnd(), 10.f * rnd(), rnd() - 100.f);
+      all[i] = static_cast<int>(i);
+    }
+    // Extremes anywhere, including the tail
+    vertex[n / 2].x_ = 5.f;
+    vertex[n - 1].z_ = -500.f;
+    AABB<float> bbox;
+    BoundingBox::Compute(vertex, &bbox);
+    const AABB<float> ref = naive(vertex, all);
+    EXPECT_TRUE(same(bbox, ref));
+    EXPECT_EQ(bbox.max_.x_, 5.f);
+    EXPECT_EQ(bbox.min_.z_, -500.f);
+    EXPECT_PRED2(Near, bbox.center_, (ref.min_ + ref.max_) * 0.5f);
+    // Every other vertex
+    std::vector<int> subset;
+    for (size_t i = 0; i < n; i += 2) {
+      subset.push_back(static_cast<int>(i));
+    }
+    ASSERT_EQ(BoundingBox::Compute(vertex, subset, &bbox), 0);
+    EXPECT_TRUE(same(bbox, naive(vertex, subset)));
+  }
+  // Triangle ranges
+  std::vector<Mesh::Vertex> vertex(64);
+  for (auto& v : vertex) {
+    v = Mesh::Vertex(rnd(), rnd(), rnd());
+  }
+  std::vector<Mesh::Triangle> tri;
+  for (int k = 0; k < 40; ++k) {
+    tri.push_back(Mesh::Triangle((7 * k) % 64, (7 * k + 1) % 64,
+                                 (11 * k + 5) % 64));
+  }
+  AABB<float> bbox;
+  ASSERT_EQ(BoundingBox::Compute(vertex, tri, 10, 20, &bbox), 0);
+  std::vector<int> corner(&tri[10].x_, &tri[30].x_);
+  EXPECT_TRUE(same(bbox, naive(vertex, corner)));
+  ASSERT_EQ(BoundingBox::Compute(vertex, tri, 40, 0, &bbox), 0);
+  EXPECT_GT(bbox.min_.x_, bbox.max_.x_);
+  EXPECT_EQ(BoundingBox::Compute(vertex, tri, 30, 11, &bbox), -1);
+  tri[5].y_ = 64;
+  EXPECT_EQ(BoundingBox::Compute(vertex, tri, 0, 10, &bbox), -1);
+  EXPECT_EQ(BoundingBox::Compute(vertex, std::vector<int>({0, -1}), &bbox),
+            -1);
+  // Mesh, box follows deformations
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    edit.vertex() = vertex;
+    tri[5].y_ = 0;
+    edit.triangle() = tri;
+  }
+  std::vector<int> all(vertex.size());
+  for (size_t i = 0; i < all.size(); ++i) {
+    all[i] = static_cast<int>(i);
+  }
+  EXPECT_TRUE(same(mesh.UpdateBoundingBox(), naive(vertex, all)));
+  mesh.Edit().vertex()[3].y_ = 42.f;
+  EXPECT_EQ(mesh.UpdateBoundingBox().max_.y_, 42.f);
+  ASSERT_EQ(mesh.ComputeBoundingBox(10, 20, &bbox), 0);
+  EXPECT_TRUE(same(bbox, naive(mesh.get_vertex(), corner)));
+  EXPECT_EQ(mesh.ComputeBoundingBox(40, 1, &bbox), -1);
+}
+
+TEST(MeshHalfEdge, Build) {
+  using HalfEdge = OGLKit::HalfEdge;
+  using Tri = HalfEdge::Triangle;
+  // Quad, single boundary loop
+  HalfEdge he;
+  ASSERT_EQ(he.Build({Tri(0, 1, 2), Tri(0, 2, 3)}, 4, false), 0);
+  ASSERT_EQ(he.size(), 6);
+  EXPECT_EQ(he.Twin(2), 3);
+  EXPECT_EQ(he.OppositeFace(3), 0);
+  EXPECT_EQ(he.Twin(0), -1);
+  EXPECT_TRUE(he.IsBoundaryVertex(0));
+  std::vector<int> ring;
+  he.OneRing(0, &ring);
+  EXPECT_EQ(ring, std::vector<int>({1, 2, 3}));
+  std::vector<std::vector<int>> loops;
+  he.BoundaryLoops(&loops);
+  ASSERT_EQ(loops.size(), 1);
+  EXPECT_EQ(loops[0], std::vector<int>({0, 1, 4, 5}));
+  // Closed tetrahedron
+  ASSERT_EQ(he.Build({Tri(0, 2, 1), Tri(0, 1, 3), Tri(0, 3, 2),
+                      Tri(1, 2, 3)}, 4, false), 0);
+  he.BoundaryLoops(&loops);
+  EXPECT_TRUE(loops.empty());
+  EXPECT_FALSE(he.IsBoundaryVertex(0));
+  he.OneRing(3, &ring);
+  EXPECT_EQ(ring.size(), 3);
+  EXPECT_TRUE(he.get_non_manifold_edge().empty());
+  // Edge shared by three triangles, inconsistent orientation
+  ASSERT_EQ(he.Build({Tri(0, 1, 2), Tri(1, 0, 3), Tri(0, 1, 4)}, 5, false), 0);
+  EXPECT_EQ(he.get_non_manifold_edge(), std::vector<int>({0, 3, 6}));
+  ASSERT_EQ(he.Build({Tri(0, 1, 2), Tri(0, 1, 3)}, 4, false), 0);
+  EXPECT_EQ(he.get_non_manifold_edge(), std::vector<int>({0, 3}));
+  EXPECT_EQ(he.Twin(0), -1);
+  EXPECT_EQ(he.Build({Tri(0, 1, 4)}, 4, false), -1);
+  // Parallel build on a grid
+  const int n = 200;
+  std::vector<Tri> tri;
+  for (int i = 0; i < n - 1; ++i) {
+    for (int j = 0; j < n - 1; ++j) {
+      const int v = (i * n) + j;
+      tri.push_back(Tri(v, v + 1, v + n + 1));
+      tri.push_back(Tri(v, v + n + 1, v + n));
+    }
+  }
+  HalfEdge serial;
+  ASSERT_EQ(serial.Build(tri, n * n, false), 0);
+  ASSERT_EQ(he.Build(tri, n * n, true), 0);
+  size_t n_boundary = 0;
+  for (size_t h = 0; h < he.size(); ++h) {
+    const int twin = he.Twin(static_cast<int>(h));
+    EXPECT_EQ(twin, serial.Twin(static_cast<int>(h)));
+    n_boundary += twin < 0;
+  }
+  EXPECT_EQ(n_boundary, 4 * (n - 1));
+  for (int v = 0; v < n * n; ++v) {
+    EXPECT_EQ(he.Outgoing(v), serial.Outgoing(v));
+  }
+  he.BoundaryLoops(&loops);
+  ASSERT_EQ(loops.size(), 1);
+  EXPECT_EQ(loops[0].size(), 4 * (n - 1));
+  he.OneRing(n + 1, &ring);
+  EXPECT_EQ(ring.size(), 6);
+  // Built on request, follows the topology
+  Mesh mesh;
+  {
+    auto edit = mesh.Edit();
+    edit.vertex().resize(4);
+    edit.triangle() = {Mesh::Triangle(0, 1, 2), Mesh::Triangle(0, 2, 3)};
+  }
+  EXPECT_TRUE(mesh.get_half_edge().empty());
+  EXPECT_EQ(mesh.UpdateHalfEdge().Twin(2), 3);
+  mesh.Edit().triangle().pop_back();
+  EXPECT_EQ(mesh.UpdateHalfEdge().Twin(2), -1);
+}
+
+int main(int argc, const char * argv[]) {
+  ::testing::InitGoogleTest(&argc, const_cast<char**>(argv));
+  return RUN_ALL_TESTS();
+}
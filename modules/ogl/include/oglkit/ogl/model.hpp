@@ -21,6 +21,11 @@
 /** aiScene type forwarding */
 struct aiScene;
 
+namespace OGLKit {
+/** GLTFAsset type forwarding */
+class GLTFAsset;
+}  // namespace OGLKit
+
 /**
  *  @namespace  OGLKit
  *  @brief      OpenGL development space
@@ -81,7 +86,8 @@ class OGLKIT_EXPORTS OGLModel {
   /** 
    *  @name Load
    *  @fn int Load(const std::string& filename)
-   *  @brief  Load model into memory
+   *  @brief  Load model into memory, .gltf / .glb files are read by the
+   *          native glTF loader, other formats through Assimp
    *  @param[in]  filename  Path to the model
    *  @return -1 if error, 0 otherwise
    */
@@ -110,6 +116,16 @@ class OGLKIT_EXPORTS OGLModel {
    *  @return -1 if error, 0 otherwise
    */
   int ProcessScene(const aiScene& scene);
+
+  /**
+   *  @name ProcessGLTF
+   *  @fn int ProcessGLTF(const GLTFAsset& asset)
+   *  @brief  Convert glTF primitives to OGLModel format, one mesh per
+   *          primitive
+   *  @param[in]  asset Loaded glTF asset
+   *  @return -1 if error, 0 otherwise
+   */
+  int ProcessGLTF(const GLTFAsset& asset);
   
   
   /** Mesh by parts */
@@ -114,6 +114,20 @@ class OGLKIT_EXPORTS OGLMesh : public OGLKit::Mesh<T> {
    */
   void Render(const OGLShader& shader) const;
   
+  /**
+   *  @name RenderCluster
+   *  @fn void RenderCluster(const OGLShader& shader,
+                             const std::vector<size_t>& cluster) const
+   *  @brief  Render a subset of the clusters (i.e. the ones surviving
+   *          frustum / backface culling) with a single draw call. Clusters
+   *          must be built before the OpenGL context is initialized.
+   *  @param[in] shader   Shader to use while rendering
+   *  @param[in] cluster  Index of the clusters to draw, see get_cluster().
+   *                      Out of range ones are skipped.
+   */
+  void RenderCluster(const OGLShader& shader,
+                     const std::vector<size_t>& cluster) const;
+  
   /**
    *  @name Unbind
    *  @fn void Unbind(void) const
@@ -158,6 +172,21 @@ class OGLKIT_EXPORTS OGLMesh : public OGLKit::Mesh<T> {
 #pragma mark Private
  private:
   
+  /**
+   *  @name BindTexture
+   *  @fn void BindTexture(const OGLShader& shader) const
+   *  @brief  Activate textures and set their sampler uniforms
+   *  @param[in] shader Shader to use while rendering
+   */
+  void BindTexture(const OGLShader& shader) const;
+  
+  /**
+   *  @name UnbindTexture
+   *  @fn void UnbindTexture(void) const
+   *  @brief  Release textures
+   */
+  void UnbindTexture(void) const;
+  
   /** OpenGL Context */
   OGLMeshContext* ctx_;
   /** Textures */
@@ -15,6 +15,7 @@
 #include "assimp/postprocess.h"
 
 #include "oglkit/core/string_util.hpp"
+#include "oglkit/geometry/gltf.hpp"
 #include "oglkit/ogl/model.hpp"
 #include "oglkit/ogl/texture_manager.hpp"
 
@@ -53,7 +54,8 @@ OGLModel<T>::~OGLModel(void) {
 /*
  *  @name
  *  @fn
- *  @brief  Load model into memory
+ *  @brief  Load model into memory, .gltf / .glb files are read by the
+ *          native glTF loader, other formats through Assimp
  *  @param[in]  filename  Path to the model
  *  @return -1 if error, 0 otherwise
  */
@@ -63,8 +65,18 @@ int OGLModel<T>::Load(const std::string& filename) {
   // Recover folder
   std::string file, ext;
   StringUtil::ExtractDirectory(filename, &directory_, &file, &ext);
+  if (ext == "gltf" || ext == "glb") {
+    // Buffers are mapped and copied straight into the meshes
+    GLTFAsset asset;
+    if (asset.Load(filename)) {
+      std::cout << "Unable to load : " << filename << std::endl;
+      return err;
+    }
+    return this->ProcessGLTF(asset);
+  }
   // Load scene
-  auto flag = aiProcess_Triangulate | aiProcess_FlipUVs;
+  auto flag = (aiProcess_Triangulate | aiProcess_FlipUVs |
+               aiProcess_CalcTangentSpace);
   Assimp::Importer importer;
   const aiScene* scene = importer.ReadFile(filename.c_str(), flag);
   if (scene &&
@@ -109,6 +121,7 @@ int OGLModel<T>::ProcessScene(const aiScene& scene) {
   using Vertex = typename OGLKit::OGLMesh<T>::Vertex;
   using Normal = typename OGLKit::OGLMesh<T>::Normal;
   using TCoord = typename OGLKit::OGLMesh<T>::TCoord;
+  using Tangent = typename OGLKit::OGLMesh<T>::Tangent;
   using Triangle = typename OGLKit::OGLMesh<T>::Triangle;
   // Avoid recursion by using stack
   int err = 0;
@@ -125,46 +138,66 @@ int OGLModel<T>::ProcessScene(const aiScene& scene) {
       // Add new mesh
       auto* m = new OGLMesh();
       meshes_.push_back(m);
-      // Process Vertex + Normal + Tex Coord
-      auto& vertex = m->get_vertex();
-      auto& normal = m->get_normal();
-      auto& tcoord = m->get_tex_coord();
-      vertex.reserve(mesh->mNumVertices);
-      normal.reserve(mesh->mNumVertices);
-      tcoord.reserve(mesh->mNumVertices);
-      for (int k = 0; k < mesh->mNumVertices; ++k) {
-        // Vertex
-        Vertex vert;
-        vert.x_ = mesh->mVertices[k].x;
-        vert.y_ = mesh->mVertices[k].y;
-        vert.z_ = mesh->mVertices[k].z;
-        vertex.push_back(vert);
-        // Normal
-        Normal n;
-        n.x_ = mesh->mNormals[k].x;
-        n.y_ = mesh->mNormals[k].y;
-        n.z_ = mesh->mNormals[k].z;
-        normal.push_back(n);
-        // Tex Coord
-        if (mesh->mTextureCoords[0]) {
-          TCoord tc;
-          tc.x_ = mesh->mTextureCoords[0][k].x;
-          tc.y_ = mesh->mTextureCoords[0][k].y;
-          tcoord.push_back(tc);
+      // Process Vertex + Normal + Tex Coord, flagged once the editor is
+      // released
+      {
+        auto edit = m->Edit();
+        auto& vertex = edit.vertex();
+        auto& normal = edit.normal();
+        auto& tcoord = edit.tex_coord();
+        const bool has_tangent = mesh->HasTangentsAndBitangents();
+        std::vector<Tangent>* tangent = has_tangent ? &edit.tangent() : nullptr;
+        vertex.reserve(mesh->mNumVertices);
+        normal.reserve(mesh->mNumVertices);
+        tcoord.reserve(mesh->mNumVertices);
+        if (has_tangent) {
+          tangent->reserve(mesh->mNumVertices);
         }
-      }
-      // Process triangle
-      auto& tri = m->get_triangle();
-      for (int i = 0; i < mesh->mNumFaces; ++i) {
-        aiFace face = mesh->mFaces[i];
-        // Retrieve all indices of the face and store them in the indices vector
-        assert(face.mNumIndices % 3 == 0);
-        for(int j = 0; j < face.mNumIndices; j += 3) {
-          Triangle t;
-          t.x_ = face.mIndices[j];
-          t.y_ = face.mIndices[j + 1];
-          t.z_ = face.mIndices[j + 2];
-          tri.push_back(t);
+        for (int k = 0; k < mesh->mNumVertices; ++k) {
+          // Vertex
+          Vertex vert;
+          vert.x_ = mesh->mVertices[k].x;
+          vert.y_ = mesh->mVertices[k].y;
+          vert.z_ = mesh->mVertices[k].z;
+          vertex.push_back(vert);
+          // Normal
+          Normal n;
+          n.x_ = mesh->mNormals[k].x;
+          n.y_ = mesh->mNormals[k].y;
+          n.z_ = mesh->mNormals[k].z;
+          normal.push_back(n);
+          // Tex Coord
+          if (mesh->mTextureCoords[0]) {
+            TCoord tc;
+            tc.x_ = mesh->mTextureCoords[0][k].x;
+            tc.y_ = mesh->mTextureCoords[0][k].y;
+            tcoord.push_back(tc);
+          }
+          // Tangent, handedness from the bitangent
+          if (has_tangent) {
+            const auto& t = mesh->mTangents[k];
+            const auto& b = mesh->mBitangents[k];
+            const Normal nxt(n.y_ * t.z - n.z_ * t.y,
+                             n.z_ * t.x - n.x_ * t.z,
+                             n.x_ * t.y - n.y_ * t.x);
+            const T w = (nxt.x_ * b.x + nxt.y_ * b.y + nxt.z_ * b.z) < T(0.0) ?
+                        T(-1.0) : T(1.0);
+            tangent->push_back(Tangent(t.x, t.y, t.z, w));
+          }
+        }
+        // Process triangle
+        auto& tri = edit.triangle();
+        for (int i = 0; i < mesh->mNumFaces; ++i) {
+          aiFace face = mesh->mFaces[i];
+          // Retrieve all indices of the face and store them as triangles
+          assert(face.mNumIndices % 3 == 0);
+          for(int j = 0; j < face.mNumIndices; j += 3) {
+            Triangle t;
+            t.x_ = face.mIndices[j];
+            t.y_ = face.mIndices[j + 1];
+            t.z_ = face.mIndices[j + 2];
+            tri.push_back(t);
+          }
         }
       }
       // Process Material
@@ -203,6 +236,52 @@ int OGLModel<T>::ProcessScene(const aiScene& scene) {
   return err;
 }
   
+/*
+ *  @name ProcessGLTF
+ *  @fn int ProcessGLTF(const GLTFAsset& asset)
+ *  @brief  Convert glTF primitives to OGLModel format, one mesh per
+ *          primitive
+ *  @param[in]  asset Loaded glTF asset
+ *  @return -1 if error, 0 otherwise
+ */
+template<typename T>
+int OGLModel<T>::ProcessGLTF(const GLTFAsset& asset) {
+  int err = 0;
+  const auto& primitive = asset.get_primitive();
+  for (size_t i = 0; i < primitive.size(); ++i) {
+    // Add new mesh
+    auto* m = new OGLMesh();
+    meshes_.push_back(m);
+    if (asset.Extract(i, m)) {
+      err |= -1;
+      continue;
+    }
+    // Normals are optional in glTF
+    if (m->get_normal().empty()) {
+      m->BuildConnectivity();
+      m->ComputeVertexNormal();
+    }
+    // As are tangents, needed for normal mapping
+    if (m->get_tangent().empty() && !m->get_tex_coord().empty()) {
+      m->ComputeVertexTangent();
+    }
+    // Process Material, base color only
+    if (!primitive[i].texture.empty()) {
+      auto& tex_manager = OGLTextureManager::Instance();
+      OGLTexture* tex = tex_manager.Add(primitive[i].texture, "");
+      if (tex) {
+        m->get_texture().push_back(tex);
+      } else {
+        err |= -1;
+        std::cout << primitive[i].texture << std::endl;
+      }
+    }
+    // Init opengl for this mesh
+    err |= m->InitOpenGLContext();
+  }
+  return err;
+}
+
 #pragma mark -
 #pragma mark Instance
   
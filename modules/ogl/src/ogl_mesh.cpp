@@ -169,7 +169,7 @@ template<typename T>
                  reinterpret_cast<GLvoid*>(this->tangent_.data()),
                  GL_STATIC_DRAW);
     glEnableVertexAttribArray(BufferType::kTangent);
-    glVertexAttribPointer(BufferType::kTangent, 3, data_t, GL_FALSE, 0, NULL);
+    glVertexAttribPointer(BufferType::kTangent, 4, data_t, GL_FALSE, 0, NULL);
   }
   // Vertex color
   if (this->vertex_color_.size() > 0) {
@@ -219,26 +219,7 @@ template<typename T>
 void OGLMesh<T>::Render(const OGLShader& shader) const {
   
   // Activate texture if any
-  int cnt_normal = 0;
-  int cnt_diffuse = 0;
-  int cnt_specular = 0;
-  int idx = 0;
-  for (int i = 0; i < textures_.size(); ++i) {
-    const auto* tex = textures_[i];
-    // Activate + bind
-    tex->Bind(i);
-    // Set uniform
-    if (tex->get_type() == OGLTexture::Type::kDiffuse) {
-      idx = cnt_diffuse++;
-    } else if(tex->get_type() == OGLTexture::Type::kNormal) {
-      idx = cnt_normal++;
-    } else {
-      idx = cnt_specular++;
-    }
-    std::string name = "texture_material[" + std::to_string(idx) + "].";
-    name += tex->get_type_str();
-    shader.SetUniform(name.c_str(), i);
-  }
+  this->BindTexture(shader);
   
   // Bind
   this->Bind();
@@ -252,10 +233,58 @@ void OGLMesh<T>::Render(const OGLShader& shader) const {
   
   // Unbind
   this->Unbind();
+  this->UnbindTexture();
+}
   
-  for (int i = 0; i < textures_.size(); ++i) {
-    textures_[i]->Unbind();
+/*
+ *  @name RenderCluster
+ *  @fn void RenderCluster(const OGLShader& shader,
+                           const std::vector<size_t>& cluster) const
+ *  @brief  Render a subset of the clusters (i.e. the ones surviving
+ *          frustum / backface culling) with a single draw call. Clusters
+ *          must be built before the OpenGL context is initialized.
+ *  @param[in] shader   Shader to use while rendering
+ *  @param[in] cluster  Index of the clusters to draw, see get_cluster().
+ *                      Out of range ones are skipped.
+ */
+template<typename T>
+void OGLMesh<T>::RenderCluster(const OGLShader& shader,
+                               const std::vector<size_t>& cluster) const {
+  // Each cluster is a contiguous range of the index buffer
+  const auto& range = this->get_cluster();
+  std::vector<GLsizei> count;
+  std::vector<const GLvoid*> offset;
+  count.reserve(cluster.size());
+  offset.reserve(cluster.size());
+  for (const size_t k : cluster) {
+    if (k >= range.size()) {
+      continue;
+    }
+    const auto& c = range[k];
+    count.push_back(static_cast<GLsizei>(c.n_tri * 3));
+    offset.push_back(reinterpret_cast<const GLvoid*>(c.first_tri *
+                                                     sizeof(Triangle)));
+  }
+  if (count.empty()) {
+    return;
   }
+  
+  // Activate texture if any
+  this->BindTexture(shader);
+  
+  // Bind
+  this->Bind();
+  
+  // Render selected ranges
+  glMultiDrawElements(GL_TRIANGLES,
+                      count.data(),
+                      GL_UNSIGNED_INT,
+                      offset.data(),
+                      static_cast<GLsizei>(count.size()));
+  
+  // Unbind
+  this->Unbind();
+  this->UnbindTexture();
 }
 
 /*
@@ -268,6 +297,51 @@ void OGLMesh<T>::Unbind(void) const {
   glBindVertexArray(0);
 }
   
+#pragma mark -
+#pragma mark Private
+  
+/*
+ *  @name BindTexture
+ *  @fn void BindTexture(const OGLShader& shader) const
+ *  @brief  Activate textures and set their sampler uniforms
+ *  @param[in] shader Shader to use while rendering
+ */
+template<typename T>
+void OGLMesh<T>::BindTexture(const OGLShader& shader) const {
+  int cnt_normal = 0;
+  int cnt_diffuse = 0;
+  int cnt_specular = 0;
+  int idx = 0;
+  for (int i = 0; i < textures_.size(); ++i) {
+    const auto* tex = textures_[i];
+    // Activate + bind
+    tex->Bind(i);
+    // Set uniform
+    if (tex->get_type() == OGLTexture::Type::kDiffuse) {
+      idx = cnt_diffuse++;
+    } else if(tex->get_type() == OGLTexture::Type::kNormal) {
+      idx = cnt_normal++;
+    } else {
+      idx = cnt_specular++;
+    }
+    std::string name = "texture_material[" + std::to_string(idx) + "].";
+    name += tex->get_type_str();
+    shader.SetUniform(name.c_str(), i);
+  }
+}
+  
+/*
+ *  @name UnbindTexture
+ *  @fn void UnbindTexture(void) const
+ *  @brief  Release textures
+ */
+template<typename T>
+void OGLMesh<T>::UnbindTexture(void) const {
+  for (int i = 0; i < textures_.size(); ++i) {
+    textures_[i]->Unbind();
+  }
+}
+  
 #pragma mark -
 #pragma mark Declaration
   